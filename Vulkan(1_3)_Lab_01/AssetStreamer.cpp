@@ -0,0 +1,344 @@
+#include "AssetStreamer.h"
+#include "OBJLoader.h"
+#include <algorithm>
+#include <iostream>
+
+void AssetStreamer::init(VkDevice device, DeviceMemoryAllocator& allocator, UploadManager& uploadManager,
+                         TextureManager& textureManager, MeshCache* meshCache, const Settings& settings) {
+    m_device = device;
+    m_allocator = &allocator;
+    m_uploadManager = &uploadManager;
+    m_textureManager = &textureManager;
+    m_meshCache = meshCache;
+    m_settings = settings;
+    m_settings.framesInFlight = std::max(m_settings.framesInFlight, 1u);
+
+    // Neutral grey, shown until a streamed texture is resident
+    const std::vector<uint8_t> grey = { 128, 128, 128, 255 };
+    m_placeholder = m_textureManager->createTexture(1, 1, grey, false);
+
+    m_stopping = false;
+    for (uint32_t i = 0; i < std::max(m_settings.loaderThreads, 1u); i++) {
+        m_loaders.emplace_back(&AssetStreamer::loaderLoop, this);
+    }
+}
+
+void AssetStreamer::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (std::thread& loader : m_loaders) {
+        loader.join();
+    }
+    m_loaders.clear();
+    m_requests.clear();
+    m_results.clear();
+    m_backlog = 0;
+
+    for (Asset& asset : m_assets) {
+        release(asset);
+    }
+    m_assets.clear();
+    m_handles.clear();
+    m_decoded.clear();
+    m_uploading.clear();
+    m_residentBytes = 0;
+
+    if (m_placeholder >= 0) {
+        m_textureManager->releaseTexture(m_placeholder);
+        m_placeholder = -1;
+    }
+}
+
+AssetStreamer::Handle AssetStreamer::requestTexture(const std::string& filepath) {
+    return request(Kind::Texture, filepath);
+}
+
+AssetStreamer::Handle AssetStreamer::requestMesh(const std::string& filepath) {
+    return request(Kind::Mesh, filepath);
+}
+
+VkDescriptorImageInfo AssetStreamer::getTextureDescriptor(Handle handle) {
+    Asset& asset = m_assets.at(handle);
+    asset.lastUsedFrame = m_frame;
+    if (asset.state == State::Resident) {
+        return m_textureManager->getDescriptorInfo(asset.texture);
+    }
+    if (asset.state == State::Evicted) {
+        enqueue(handle);
+    }
+    return m_textureManager->getDescriptorInfo(m_placeholder);
+}
+
+const AssetStreamer::StreamedMesh* AssetStreamer::getMesh(Handle handle) {
+    Asset& asset = m_assets.at(handle);
+    asset.lastUsedFrame = m_frame;
+    if (asset.state == State::Resident) {
+        return &asset.mesh;
+    }
+    if (asset.state == State::Evicted) {
+        enqueue(handle);
+    }
+    return nullptr;
+}
+
+void AssetStreamer::update() {
+    m_frame++;
+
+    // Promote finished transfers
+    for (size_t i = 0; i < m_uploading.size();) {
+        Asset& asset = m_assets[m_uploading[i]];
+        if (m_uploadManager->isComplete(asset.ticket)) {
+            asset.state = State::Resident;
+            m_uploading[i] = m_uploading.back();
+            m_uploading.pop_back();
+            continue;
+        }
+        i++;
+    }
+
+    uint32_t consumed = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        while (!m_results.empty()) {
+            m_decoded.push_back(std::move(m_results.front()));
+            m_results.pop_front();
+        }
+    }
+    for (const Result& result : m_decoded) {
+        Asset& asset = m_assets[result.handle];
+        if (result.valid && asset.state == State::Queued) {
+            asset.state = State::Decoded;
+        }
+    }
+
+    // Upload in request order until the frame's bandwidth or the budget runs out
+    std::vector<Handle> started;
+    VkDeviceSize uploaded = 0;
+    while (!m_decoded.empty() && uploaded < m_settings.uploadBytesPerFrame) {
+        Result& result = m_decoded.front();
+        Asset& asset = m_assets[result.handle];
+        if (!result.valid) {
+            std::cerr << "AssetStreamer: Failed to load " << asset.path << std::endl;
+            asset.state = State::Failed;
+            m_failures++;
+        }
+        else if (!beginUpload(result)) {
+            break;      // Budget full of assets still in use: retry next frame
+        }
+        else if (asset.state == State::Uploading) {
+            started.push_back(result.handle);
+            uploaded += asset.bytes;
+        }
+        m_decoded.pop_front();
+        consumed++;
+    }
+
+    if (!started.empty()) {
+        UploadManager::Ticket ticket = m_uploadManager->submit();
+        for (Handle handle : started) {
+            m_assets[handle].ticket = ticket;
+            m_uploading.push_back(handle);
+        }
+    }
+
+    if (consumed > 0) {
+        {
+            std::lock_guard<std::mutex> lock(m_queueMutex);
+            m_backlog -= consumed;
+        }
+        m_wake.notify_all();
+    }
+}
+
+AssetStreamer::Stats AssetStreamer::getStats() const {
+    Stats stats;
+    for (const Asset& asset : m_assets) {
+        if (asset.state == State::Resident) stats.resident++;
+        if (asset.state == State::Queued || asset.state == State::Decoded || asset.state == State::Uploading) stats.pending++;
+    }
+    stats.evictions = m_evictions;
+    stats.failures = m_failures;
+    stats.residentBytes = m_residentBytes;
+    return stats;
+}
+
+// Private helper implementations
+
+AssetStreamer::Handle AssetStreamer::request(Kind kind, const std::string& filepath) {
+    std::string key = (kind == Kind::Texture ? "texture:" : "mesh:") + filepath;
+    auto it = m_handles.find(key);
+    if (it != m_handles.end()) {
+        return it->second;
+    }
+
+    Handle handle = static_cast<Handle>(m_assets.size());
+    Asset asset;
+    asset.kind = kind;
+    asset.path = filepath;
+    asset.state = State::Evicted;   // enqueue() moves it to Queued
+    asset.lastUsedFrame = m_frame;
+    m_assets.push_back(asset);
+    m_handles[key] = handle;
+    enqueue(handle);
+    return handle;
+}
+
+void AssetStreamer::enqueue(Handle handle) {
+    Asset& asset = m_assets[handle];
+    asset.state = State::Queued;
+
+    Request request;
+    request.handle = handle;
+    request.kind = asset.kind;
+    request.path = asset.path;
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_requests.push_back(std::move(request));
+    }
+    m_wake.notify_one();
+}
+
+void AssetStreamer::loaderLoop() {
+    while (true) {
+        Request request;
+        {
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            m_wake.wait(lock, [this]() {
+                return m_stopping || (!m_requests.empty() && m_backlog < MAX_DECODED_AHEAD);
+            });
+            if (m_stopping) return;
+            request = std::move(m_requests.front());
+            m_requests.pop_front();
+            m_backlog++;
+        }
+
+        // CPU-only work: file I/O, image decode and mip generation, OBJ parse and packing
+        Result result;
+        result.handle = request.handle;
+        if (request.kind == Kind::Texture) {
+            result.valid = TextureManager::decodeFile(request.path, result.texture);
+        }
+        else {
+            result.mesh = m_meshCache ? OBJLoader::loadCached(request.path, *m_meshCache)
+                                      : OBJLoader::load(request.path);
+            result.valid = !result.mesh.isEmpty() && result.mesh.getIndexCount() > 0;
+            if (result.valid && m_settings.vertexFormat == VertexFormat::Packed) {
+                result.packedVertices = PackedVertex::packAll(result.mesh.getVertices(),
+                    m_settings.positionEncoding, result.decode);
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_results.push_back(std::move(result));
+    }
+}
+
+bool AssetStreamer::beginUpload(Result& result) {
+    Asset& asset = m_assets[result.handle];
+    const bool packed = m_settings.vertexFormat == VertexFormat::Packed;
+    const bool shortIndices = result.mesh.getVertexCount() <= UINT16_MAX;
+    VkDeviceSize estimate = asset.kind == Kind::Texture
+        ? static_cast<VkDeviceSize>(result.texture.data.size())
+        : static_cast<VkDeviceSize>(result.mesh.getVertexCount() * (packed ? sizeof(PackedVertex) : sizeof(Vertex)) +
+                                    result.mesh.getIndexCount() * (shortIndices ? sizeof(uint16_t) : sizeof(uint32_t)));
+    if (!makeRoom(estimate)) {
+        return false;
+    }
+
+    if (asset.kind == Kind::Texture) {
+        asset.texture = m_textureManager->createFromData(result.texture, asset.path, true);
+        if (asset.texture < 0) {
+            asset.state = State::Failed;
+            m_failures++;
+            return true;
+        }
+        asset.bytes = m_textureManager->getTexture(asset.texture).allocation.size;
+    }
+    else {
+        const std::vector<Vertex>& vertices = result.mesh.getVertices();
+        const std::vector<uint32_t>& indices = result.mesh.getIndices();
+        StreamedMesh& mesh = asset.mesh;
+
+        // Same layout as the Scene's vertex buffer, so the scene pipelines can draw it
+        const void* vertexData = vertices.data();
+        VkDeviceSize vertexBytes = sizeof(Vertex) * vertices.size();
+        if (packed) {
+            vertexData = result.packedVertices.data();
+            vertexBytes = sizeof(PackedVertex) * result.packedVertices.size();
+            mesh.decode = result.decode;
+        }
+
+        std::vector<uint16_t> indices16;
+        const void* indexData = indices.data();
+        VkDeviceSize indexBytes = sizeof(uint32_t) * indices.size();
+        mesh.indexType = VK_INDEX_TYPE_UINT32;
+        if (shortIndices) {
+            indices16.reserve(indices.size());
+            for (uint32_t index : indices) indices16.push_back(static_cast<uint16_t>(index));
+            indexData = indices16.data();
+            indexBytes = sizeof(uint16_t) * indices16.size();
+            mesh.indexType = VK_INDEX_TYPE_UINT16;
+        }
+
+        m_allocator->createBuffer(vertexBytes, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                                  DeviceMemoryAllocator::Pool::DeviceLocal, mesh.vertexBuffer, mesh.vertexAllocation);
+        m_allocator->createBuffer(indexBytes, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+                                  DeviceMemoryAllocator::Pool::DeviceLocal, mesh.indexBuffer, mesh.indexAllocation);
+        m_uploadManager->uploadBuffer(mesh.vertexBuffer, vertexData, vertexBytes, 0, true);
+        m_uploadManager->uploadBuffer(mesh.indexBuffer, indexData, indexBytes, 0, true);
+        mesh.vertexCount = static_cast<uint32_t>(vertices.size());
+        mesh.indexCount = static_cast<uint32_t>(indices.size());
+        mesh.minBounds = result.mesh.getMinBounds();
+        mesh.maxBounds = result.mesh.getMaxBounds();
+        asset.bytes = mesh.vertexAllocation.size + mesh.indexAllocation.size;
+    }
+
+    asset.state = State::Uploading;
+    m_residentBytes += asset.bytes;
+    return true;
+}
+
+bool AssetStreamer::makeRoom(VkDeviceSize bytes) {
+    if (m_residentBytes + bytes <= m_settings.budgetBytes) return true;
+
+    // Least recently used first, skipping anything a frame in flight may read
+    std::vector<Handle> candidates;
+    for (Handle handle = 0; handle < static_cast<Handle>(m_assets.size()); handle++) {
+        const Asset& asset = m_assets[handle];
+        if (asset.state == State::Resident && asset.lastUsedFrame + m_settings.framesInFlight <= m_frame) {
+            candidates.push_back(handle);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [this](Handle a, Handle b) {
+        return m_assets[a].lastUsedFrame < m_assets[b].lastUsedFrame;
+    });
+
+    for (Handle handle : candidates) {
+        if (m_residentBytes + bytes <= m_settings.budgetBytes) break;
+        release(m_assets[handle]);
+        m_evictions++;
+    }
+
+    // Oversized assets still load once nothing else is resident
+    return m_residentBytes + bytes <= m_settings.budgetBytes || m_residentBytes == 0;
+}
+
+void AssetStreamer::release(Asset& asset) {
+    if (asset.state != State::Resident && asset.state != State::Uploading) return;
+
+    if (asset.kind == Kind::Texture) {
+        m_textureManager->releaseTexture(asset.texture);
+        asset.texture = -1;
+    }
+    else {
+        m_allocator->destroyBuffer(asset.mesh.vertexBuffer, asset.mesh.vertexAllocation);
+        m_allocator->destroyBuffer(asset.mesh.indexBuffer, asset.mesh.indexAllocation);
+        asset.mesh = StreamedMesh();
+    }
+    m_residentBytes -= asset.bytes;
+    asset.bytes = 0;
+    asset.state = State::Evicted;
+}
@@ -0,0 +1,216 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <glm/glm.hpp>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "DeviceMemoryAllocator.h"
+#include "Mesh.h"
+#include "PackedVertex.h"
+#include "TextureManager.h"
+#include "UploadManager.h"
+
+class MeshCache;
+
+/**
+ * @brief Asynchronous texture and mesh streaming under a device memory budget
+ *
+ * Role: Load file assets in the background while the frame loop keeps running
+ * Responsibilities:
+ * - Decode requested files on a small pool of loader threads
+ *   (TextureManager::decodeFile, OBJLoader)
+ * - Record their uploads as streamed batches on the UploadManager and
+ *   promote each asset once its transfer has completed
+ * - Hand out a placeholder texture (or no mesh) until an asset is resident
+ * - Evict least recently used assets to stay under the residency budget
+ *
+ * Design Notes:
+ * - Loader threads are separate from the JobSystem: JobSystem::wait()
+ *   runs queued jobs on the waiting thread, so a decode could otherwise
+ *   land on the render thread in the middle of the particle update
+ * - Requests, lookups and update() are render-thread only; loaders only
+ *   touch the request and result queues. At most MAX_DECODED_AHEAD
+ *   decoded assets wait for upload, so CPU memory is bounded too
+ * - Handles stay valid after eviction: using an evicted asset queues it
+ *   again, so the working set streams back in on demand
+ * - An asset is evicted only once no frame in flight can still use it,
+ *   and uploads wait while the budget is full, so streaming never
+ *   overcommits device memory (one asset larger than the whole budget is
+ *   still loaded once nothing else is resident)
+ * - Fetch descriptors every frame (getTextureDescriptor): the view
+ *   changes on promotion and eviction
+ * - Streamed meshes own their vertex/index buffers instead of joining the
+ *   Scene's shared buffers. They are stored in Settings::vertexFormat, so
+ *   the scene pipelines draw them as they are; packed meshes carry their
+ *   own PositionDecode, which the caller folds into the model matrix
+ */
+class AssetStreamer {
+public:
+    using Handle = uint32_t;
+    static constexpr Handle INVALID_HANDLE = UINT32_MAX;
+    static constexpr uint32_t MAX_DECODED_AHEAD = 8;
+
+    enum class State {
+        Queued,         // Waiting for (or on) a loader thread
+        Decoded,        // In memory, waiting for budget or upload bandwidth
+        Uploading,      // Transfer submitted
+        Resident,
+        Evicted,        // Released; queued again on next use
+        Failed          // Missing file, bad data or unsupported format
+    };
+
+    struct Settings {
+        uint32_t loaderThreads = 2;
+        VkDeviceSize budgetBytes = 256ull << 20;            // Device memory for streamed assets
+        VkDeviceSize uploadBytesPerFrame = 32ull << 20;     // Staging copies per update()
+        uint32_t framesInFlight = 2;                        // Frames that may still use an asset
+        VertexFormat vertexFormat = VertexFormat::Full;     // Layout of streamed vertex buffers
+        PositionEncoding positionEncoding = PositionEncoding::Unorm16;
+    };
+
+    struct StreamedMesh {
+        VkBuffer vertexBuffer = VK_NULL_HANDLE;
+        DeviceMemoryAllocator::Allocation vertexAllocation;
+        VkBuffer indexBuffer = VK_NULL_HANDLE;
+        DeviceMemoryAllocator::Allocation indexAllocation;
+        VkIndexType indexType = VK_INDEX_TYPE_UINT32;      // UINT16 when the mesh fits
+        uint32_t vertexCount = 0;
+        uint32_t indexCount = 0;
+        PositionDecode decode;                              // Packed format only, else identity
+        glm::vec3 minBounds{ 0.0f };
+        glm::vec3 maxBounds{ 0.0f };
+    };
+
+    struct Stats {
+        uint32_t resident = 0;
+        uint32_t pending = 0;       // Queued, decoded or uploading
+        uint32_t evictions = 0;
+        uint32_t failures = 0;
+        VkDeviceSize residentBytes = 0;     // Including uploads in flight
+    };
+
+    AssetStreamer() = default;
+    ~AssetStreamer() { shutdown(); }
+
+    // Non-copyable
+    AssetStreamer(const AssetStreamer&) = delete;
+    AssetStreamer& operator=(const AssetStreamer&) = delete;
+
+    /**
+     * @brief Start the loader threads and create the placeholder texture
+     * @param meshCache Used for OBJ loads when set (see OBJLoader::loadCached)
+     */
+    void init(VkDevice device, DeviceMemoryAllocator& allocator, UploadManager& uploadManager,
+              TextureManager& textureManager, MeshCache* meshCache, const Settings& settings);
+
+    /**
+     * @brief Join the loaders and release every streamed asset (device must be idle)
+     */
+    void shutdown();
+
+    /**
+     * @brief Queue a texture file (image or .ktx2); repeated paths share a handle
+     */
+    Handle requestTexture(const std::string& filepath);
+
+    /**
+     * @brief Queue an OBJ mesh; repeated paths share a handle
+     */
+    Handle requestMesh(const std::string& filepath);
+
+    /**
+     * @brief Descriptor for this frame: the texture if resident, else the placeholder
+     * Marks the asset used this frame.
+     */
+    VkDescriptorImageInfo getTextureDescriptor(Handle handle);
+
+    /**
+     * @brief Descriptor of the placeholder, without touching any asset
+     */
+    VkDescriptorImageInfo getPlaceholderDescriptor() const { return m_textureManager->getDescriptorInfo(m_placeholder); }
+
+    /**
+     * @brief Mesh buffers for this frame, or nullptr if not resident yet
+     * Marks the asset used this frame.
+     */
+    const StreamedMesh* getMesh(Handle handle);
+
+    State getState(Handle handle) const { return m_assets.at(handle).state; }
+
+    /**
+     * @brief Per-frame step: promote finished uploads, evict, upload decoded assets
+     * Call once per frame after the frame's fence wait, before UploadManager::update().
+     */
+    void update();
+
+    Stats getStats() const;
+
+private:
+    enum class Kind { Texture, Mesh };
+
+    struct Asset {
+        Kind kind = Kind::Texture;
+        std::string path;
+        State state = State::Queued;
+        uint64_t lastUsedFrame = 0;
+        VkDeviceSize bytes = 0;                 // Device memory while uploading/resident
+        UploadManager::Ticket ticket = 0;
+        int32_t texture = -1;
+        StreamedMesh mesh;
+    };
+
+    struct Request {
+        Handle handle = INVALID_HANDLE;
+        Kind kind = Kind::Texture;
+        std::string path;
+    };
+
+    struct Result {
+        Handle handle = INVALID_HANDLE;
+        bool valid = false;
+        TextureManager::TextureData texture;
+        Mesh mesh;
+        std::vector<PackedVertex> packedVertices;   // Settings::vertexFormat == Packed
+        PositionDecode decode;
+    };
+
+    VkDevice m_device = VK_NULL_HANDLE;
+    DeviceMemoryAllocator* m_allocator = nullptr;
+    UploadManager* m_uploadManager = nullptr;
+    TextureManager* m_textureManager = nullptr;
+    MeshCache* m_meshCache = nullptr;
+    Settings m_settings;
+
+    // Render thread
+    std::vector<Asset> m_assets;
+    std::unordered_map<std::string, Handle> m_handles;     // Kind prefix + path
+    std::deque<Result> m_decoded;
+    std::vector<Handle> m_uploading;
+    int32_t m_placeholder = -1;
+    uint64_t m_frame = 0;
+    VkDeviceSize m_residentBytes = 0;
+    uint32_t m_evictions = 0;
+    uint32_t m_failures = 0;
+
+    // Shared with the loaders
+    std::vector<std::thread> m_loaders;
+    std::mutex m_queueMutex;
+    std::condition_variable m_wake;
+    std::deque<Request> m_requests;
+    std::deque<Result> m_results;
+    uint32_t m_backlog = 0;         // Taken by loaders and not yet consumed by update()
+    bool m_stopping = false;
+
+    Handle request(Kind kind, const std::string& filepath);
+    void enqueue(Handle handle);
+    void loaderLoop();
+    bool beginUpload(Result& result);
+    bool makeRoom(VkDeviceSize bytes);
+    void release(Asset& asset);
+};
@@ -0,0 +1,293 @@
+#include "Benchmark.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+    void printUsage(const char* program) {
+        std::cout << "Usage: " << program << " [--benchmark [frames]] [--offscreen] [--warmup N]\n"
+            << "       [--seed N] [--size WxH] [--time-of-day 0..1] [--camera-path FILE] [--output FILE]\n"
+            << "       [--cpu-culling] [--no-instancing] [--cacti N] [--no-lod]\n"
+            << "       [--no-meshlets] [--meshlet-compute] [--no-mesh-cache] [--no-texture-cache]\n"
+            << "       [--no-pipeline-cache] [--serial-recording] [--no-depth-prepass]\n"
+            << "       [--no-particle-sort] [--vertex-format full|unorm16|half]\n"
+            << "       [--present-mode fifo|fifo-relaxed|mailbox|immediate] [--frames-in-flight N] [--fps-cap N]\n"
+            << "       [--sim-rate N] [--model FILE.obj [TEXTURE]]...\n";
+    }
+
+    bool invalidOption(const char* program, const std::string& option) {
+        std::cerr << "Unknown or malformed option: " << option << "\n";
+        printUsage(program);
+        return false;
+    }
+
+    bool parseUnsigned(const char* text, uint32_t& value) {
+        char* end = nullptr;
+        unsigned long parsed = std::strtoul(text, &end, 10);
+        if (end == text || *end != '\0') return false;
+        value = static_cast<uint32_t>(parsed);
+        return true;
+    }
+}
+
+bool Benchmark::parseCommandLine(int argc, char** argv, Settings& settings) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--benchmark") {
+            settings.enabled = true;
+            // Frame count is optional
+            if (hasValue && argv[i + 1][0] != '-') {
+                if (!parseUnsigned(argv[++i], settings.frameCount)) return invalidOption(argv[0], arg);
+            }
+        }
+        else if (arg == "--offscreen") {
+            settings.offscreen = true;
+            settings.enabled = true;   // Offscreen only makes sense for a benchmark run
+        }
+        else if (arg == "--cpu-culling") {
+            settings.gpuCulling = false;
+        }
+        else if (arg == "--no-instancing") {
+            settings.cactusInstancing = false;
+        }
+        else if (arg == "--no-lod") {
+            settings.lod = false;
+        }
+        else if (arg == "--no-meshlets") {
+            settings.meshlets = false;
+        }
+        else if (arg == "--meshlet-compute") {
+            settings.meshShaders = false;
+        }
+        else if (arg == "--no-mesh-cache") {
+            settings.meshCache = false;
+        }
+        else if (arg == "--no-texture-cache") {
+            settings.textureCache = false;
+        }
+        else if (arg == "--no-pipeline-cache") {
+            settings.pipelineCache = false;
+        }
+        else if (arg == "--serial-recording") {
+            settings.parallelRecording = false;
+        }
+        else if (arg == "--no-depth-prepass") {
+            settings.depthPrepass = false;
+        }
+        else if (arg == "--no-particle-sort") {
+            settings.particleSort = false;
+        }
+        else if (arg == "--vertex-format" && hasValue) {
+            std::string format = argv[++i];
+            if (format != "full" && format != "unorm16" && format != "half") return invalidOption(argv[0], arg);
+            settings.packedVertices = format != "full";
+            settings.halfPositions = format == "half";
+        }
+        else if (arg == "--present-mode" && hasValue) {
+            std::string mode = argv[++i];
+            if (mode != "fifo" && mode != "fifo-relaxed" && mode != "mailbox" && mode != "immediate") return invalidOption(argv[0], arg);
+            settings.presentMode = mode;
+        }
+        else if (arg == "--frames-in-flight" && hasValue) {
+            if (!parseUnsigned(argv[++i], settings.framesInFlight) || settings.framesInFlight == 0) return invalidOption(argv[0], arg);
+        }
+        else if (arg == "--fps-cap" && hasValue) {
+            char* end = nullptr;
+            settings.frameCap = std::strtof(argv[++i], &end);
+            if (*end != '\0' || settings.frameCap < 0.0f) return invalidOption(argv[0], arg);
+        }
+        else if (arg == "--sim-rate" && hasValue) {
+            char* end = nullptr;
+            settings.simulationRate = std::strtof(argv[++i], &end);
+            if (*end != '\0' || !(settings.simulationRate >= 1.0f && settings.simulationRate <= 1000.0f)) return invalidOption(argv[0], arg);
+        }
+        else if (arg == "--cacti" && hasValue) {
+            if (!parseUnsigned(argv[++i], settings.extraCacti)) return invalidOption(argv[0], arg);
+        }
+        else if (arg == "--warmup" && hasValue) {
+            if (!parseUnsigned(argv[++i], settings.warmupFrames)) return invalidOption(argv[0], arg);
+        }
+        else if (arg == "--seed" && hasValue) {
+            if (!parseUnsigned(argv[++i], settings.seed)) return invalidOption(argv[0], arg);
+        }
+        else if (arg == "--size" && hasValue) {
+            unsigned width = 0, height = 0;
+            if (std::sscanf(argv[++i], "%ux%u", &width, &height) != 2 || width == 0 || height == 0) return invalidOption(argv[0], arg);
+            settings.width = width;
+            settings.height = height;
+        }
+        else if (arg == "--time-of-day" && hasValue) {
+            settings.timeOfDay = std::strtof(argv[++i], nullptr);
+        }
+        else if (arg == "--camera-path" && hasValue) {
+            settings.cameraPathFile = argv[++i];
+        }
+        else if (arg == "--output" && hasValue) {
+            settings.outputPath = argv[++i];
+        }
+        else if (arg == "--model" && hasValue) {
+            ModelFile model;
+            model.meshPath = argv[++i];
+            // Texture is optional
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                model.texturePath = argv[++i];
+            }
+            settings.models.push_back(model);
+        }
+        else {
+            return invalidOption(argv[0], arg);
+        }
+    }
+
+    if (settings.enabled && settings.frameCount == 0) {
+        printUsage(argv[0]);
+        return false;
+    }
+
+    // One simulation tick per benchmark frame, whatever --sim-rate says
+    settings.fixedDelta = 1.0f / settings.simulationRate;
+    return true;
+}
+
+void Benchmark::init(const Settings& settings) {
+    m_settings = settings;
+    m_frameIndex = 0;
+    m_frameTimes.clear();
+    m_frameTimes.reserve(settings.frameCount);
+    m_metrics.clear();
+}
+
+void Benchmark::endFrame(float frameMilliseconds) {
+    if (!isWarmingUp() && !isComplete()) {
+        m_frameTimes.push_back(frameMilliseconds);
+    }
+    m_frameIndex++;
+}
+
+void Benchmark::recordMetric(const std::string& name, float value) {
+    if (isWarmingUp() || isComplete()) return;
+    findMetric(name).values.push_back(value);
+}
+
+void Benchmark::recordStartup(const std::string& name, float milliseconds) {
+    m_startup.emplace_back(name, milliseconds);
+}
+
+bool Benchmark::writeReport(const std::string& deviceName) const {
+    Summary frame = summarize(m_frameTimes);
+
+    std::ofstream file(m_settings.outputPath);
+    if (!file) {
+        std::cerr << "Benchmark: failed to open " << m_settings.outputPath << "\n";
+        return false;
+    }
+
+    auto writeSummary = [&file](const Summary& s) {
+        file << "{\"avg\":" << s.average << ",\"p50\":" << s.p50 << ",\"p95\":" << s.p95
+            << ",\"p99\":" << s.p99 << ",\"min\":" << s.min << ",\"max\":" << s.max << "}";
+    };
+
+    file << std::fixed << std::setprecision(4);
+    file << "{\n";
+    file << "  \"device\": \"" << escapeJson(deviceName) << "\",\n";
+    file << "  \"settings\": {\"frames\":" << m_settings.frameCount
+        << ",\"warmupFrames\":" << m_settings.warmupFrames
+        << ",\"offscreen\":" << (m_settings.offscreen ? "true" : "false")
+        << ",\"seed\":" << m_settings.seed
+        << ",\"timeOfDay\":" << m_settings.timeOfDay
+        << ",\"fixedDelta\":" << m_settings.fixedDelta
+        << ",\"gpuCulling\":" << (m_settings.gpuCulling ? "true" : "false")
+        << ",\"cactusInstancing\":" << (m_settings.cactusInstancing ? "true" : "false")
+        << ",\"extraCacti\":" << m_settings.extraCacti
+        << ",\"lod\":" << (m_settings.lod ? "true" : "false")
+        << ",\"meshlets\":" << (m_settings.meshlets ? "true" : "false")
+        << ",\"meshShaders\":" << (m_settings.meshShaders ? "true" : "false")
+        << ",\"meshCache\":" << (m_settings.meshCache ? "true" : "false")
+        << ",\"textureCache\":" << (m_settings.textureCache ? "true" : "false")
+        << ",\"pipelineCache\":" << (m_settings.pipelineCache ? "true" : "false")
+        << ",\"parallelRecording\":" << (m_settings.parallelRecording ? "true" : "false")
+        << ",\"depthPrepass\":" << (m_settings.depthPrepass ? "true" : "false")
+        << ",\"particleSort\":" << (m_settings.particleSort ? "true" : "false")
+        << ",\"presentMode\":\"" << escapeJson(m_settings.presentMode) << "\""
+        << ",\"framesInFlight\":" << m_settings.framesInFlight
+        << ",\"frameCap\":" << m_settings.frameCap
+        << ",\"simulationRate\":" << m_settings.simulationRate
+        << ",\"vertexFormat\":\"" << (!m_settings.packedVertices ? "full" : m_settings.halfPositions ? "half" : "unorm16") << "\""
+        << ",\"cameraPath\":\"" << escapeJson(m_settings.cameraPathFile.empty() ? "default" : m_settings.cameraPathFile) << "\""
+        << ",\"models\":[";
+    for (size_t i = 0; i < m_settings.models.size(); i++) {
+        file << (i == 0 ? "" : ",") << "\"" << escapeJson(m_settings.models[i].meshPath) << "\"";
+    }
+    file << "]},\n";
+    file << "  \"startupMs\": {";
+    for (size_t i = 0; i < m_startup.size(); i++) {
+        file << (i == 0 ? "" : ",") << "\"" << escapeJson(m_startup[i].first) << "\":" << m_startup[i].second;
+    }
+    file << "},\n";
+    file << "  \"measuredFrames\": " << m_frameTimes.size() << ",\n";
+    file << "  \"frameTimeMs\": ";
+    writeSummary(frame);
+    file << ",\n  \"fps\": " << (frame.average > 0.0 ? 1000.0 / frame.average : 0.0) << ",\n";
+    file << "  \"metrics\": {";
+    for (size_t i = 0; i < m_metrics.size(); i++) {
+        file << (i == 0 ? "\n" : ",\n") << "    \"" << escapeJson(m_metrics[i].name) << "\": ";
+        writeSummary(summarize(m_metrics[i].values));
+    }
+    file << "\n  }\n}\n";
+
+    std::cout << std::fixed << std::setprecision(3)
+        << "Benchmark: " << m_frameTimes.size() << " frames, avg " << frame.average
+        << " ms, p95 " << frame.p95 << " ms, p99 " << frame.p99 << " ms -> "
+        << m_settings.outputPath << std::endl;
+    return static_cast<bool>(file);
+}
+
+// Private helper implementations
+
+Benchmark::Metric& Benchmark::findMetric(const std::string& name) {
+    for (Metric& metric : m_metrics) {
+        if (metric.name == name) return metric;
+    }
+    Metric& metric = m_metrics.emplace_back();
+    metric.name = name;
+    metric.values.reserve(m_settings.frameCount);
+    return metric;
+}
+
+Benchmark::Summary Benchmark::summarize(std::vector<float> values) {
+    Summary summary;
+    if (values.empty()) return summary;
+
+    std::sort(values.begin(), values.end());
+    auto percentile = [&values](double p) {
+        size_t index = static_cast<size_t>(p * static_cast<double>(values.size() - 1) + 0.5);
+        return static_cast<double>(values[index]);
+    };
+
+    double sum = 0.0;
+    for (float value : values) sum += value;
+
+    summary.average = sum / static_cast<double>(values.size());
+    summary.p50 = percentile(0.50);
+    summary.p95 = percentile(0.95);
+    summary.p99 = percentile(0.99);
+    summary.min = values.front();
+    summary.max = values.back();
+    return summary;
+}
+
+std::string Benchmark::escapeJson(const std::string& text) {
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (char c : text) {
+        if (c == '"' || c == '\\') escaped.push_back('\\');
+        if (static_cast<unsigned char>(c) < 0x20) continue;
+        escaped.push_back(c);
+    }
+    return escaped;
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Reproducible benchmark run: fixed inputs in, frame statistics out
+ * 
+ * Role: Make performance comparable between builds and machines
+ * Responsibilities:
+ * - Parse the benchmark command line switches
+ * - Collect per-frame samples (frame time, per-subsystem CPU/GPU time,
+ *   particle counts) after a warm-up period
+ * - Write avg/p50/p95/p99/min/max of every metric as JSON
+ * 
+ * Design Notes:
+ * - Holds only numbers; the application drives the fixed time step,
+ *   camera path, RNG seeds and time of day from Settings
+ * - Keeps every sample for the run (not a rolling window) so percentiles
+ *   cover the whole camera path
+ * - Metrics are kept in first-recorded order so reports diff cleanly
+ */
+class Benchmark {
+public:
+    // File model added to the scene and streamed in (AssetStreamer)
+    struct ModelFile {
+        std::string meshPath;               // OBJ
+        std::string texturePath;            // Albedo image or .ktx2, empty = vertex colors
+    };
+
+    struct Settings {
+        bool enabled = false;
+        uint32_t frameCount = 1000;         // Measured frames
+        uint32_t warmupFrames = 60;         // Discarded (pipeline/cache warm-up)
+        bool offscreen = false;             // Render to images, no window or swapchain
+        uint32_t width = 1280;              // Offscreen target size
+        uint32_t height = 720;
+        uint32_t seed = 1234;               // Particle RNG seed
+        float timeOfDay = 0.3f;             // Fixed DayNightCycle progress
+        float fixedDelta = 1.0f / 60.0f;    // Simulation step per frame (seconds), 1 / simulationRate
+        bool gpuCulling = true;             // GPU-driven scene path when supported
+        bool cactusInstancing = true;       // Shared cactus meshes, instanced draws
+        uint32_t extraCacti = 0;            // Procedural cacti added to the scene
+        bool lod = true;                    // Generate and select LOD chains
+        bool meshlets = true;               // Cluster-cull large meshes (globe)
+        bool meshShaders = true;            // Task/mesh path when supported, else compute
+        bool meshCache = true;              // Reuse cached meshes (off = cold-start timing)
+        bool textureCache = true;           // Reuse cached procedural textures
+        bool pipelineCache = true;          // Seed pipelines from the on-disk VkPipelineCache
+        bool parallelRecording = true;      // Draw passes in secondary buffers on the job system
+        bool depthPrepass = true;           // Depth-only pass, then shade with EQUAL
+        bool particleSort = true;           // Back-to-front sort of alpha-blended particles
+        bool packedVertices = false;        // PackedVertex buffer and pipelines (any mode)
+        bool halfPositions = false;         // Packed positions as half floats, not unorm16
+        std::string presentMode = "mailbox";  // fifo | fifo-relaxed | mailbox | immediate (FIFO if unsupported)
+        uint32_t framesInFlight = 2;        // CPU frames recorded ahead of the GPU
+        float frameCap = 0.0f;              // Frames per second, 0 = uncapped
+        float simulationRate = 60.0f;       // Fixed simulation ticks per second
+        std::string cameraPathFile;         // Empty = built-in path
+        std::vector<ModelFile> models;      // Repeatable --model, in placement order
+        std::string outputPath = "benchmark.json";
+    };
+
+    Benchmark() = default;
+
+    // Non-copyable
+    Benchmark(const Benchmark&) = delete;
+    Benchmark& operator=(const Benchmark&) = delete;
+
+    /**
+     * @brief Parse --benchmark [frames], --offscreen, --warmup N, --seed N,
+     *        --size WxH, --time-of-day F, --camera-path FILE, --output FILE,
+     *        --cpu-culling, --no-instancing, --cacti N, --no-lod,
+     *        --no-meshlets, --meshlet-compute, --no-mesh-cache, --no-texture-cache,
+     *        --no-pipeline-cache, --serial-recording, --no-depth-prepass,
+     *        --no-particle-sort, --vertex-format full|unorm16|half,
+     *        --present-mode MODE, --frames-in-flight N, --fps-cap N, --sim-rate N,
+     *        --model FILE.obj [TEXTURE] (repeatable)
+     * The presentation, --sim-rate and --model switches apply to interactive runs as well;
+     * fixedDelta is derived from --sim-rate so benchmark frames are one tick each
+     * @return False (after printing usage) on unknown or malformed switches
+     */
+    static bool parseCommandLine(int argc, char** argv, Settings& settings);
+
+    void init(const Settings& settings);
+
+    bool isEnabled() const { return m_settings.enabled; }
+    const Settings& getSettings() const { return m_settings; }
+
+    /**
+     * @brief Close the current frame; samples recorded before this belong to it
+     * @param frameMilliseconds Wall-clock time of the frame
+     */
+    void endFrame(float frameMilliseconds);
+
+    /**
+     * @brief Record one value for the current frame (ignored during warm-up)
+     */
+    void recordMetric(const std::string& name, float value);
+
+    /**
+     * @brief Record a one-off startup timing (reported as-is, not per frame)
+     */
+    void recordStartup(const std::string& name, float milliseconds);
+
+    bool isWarmingUp() const { return m_frameIndex < m_settings.warmupFrames; }
+    bool isComplete() const { return m_frameIndex >= m_settings.warmupFrames + m_settings.frameCount; }
+    uint32_t getFrameIndex() const { return m_frameIndex; }
+
+    /**
+     * @brief Write the JSON report to Settings::outputPath and a summary to stdout
+     * @param deviceName GPU name recorded alongside the results
+     */
+    bool writeReport(const std::string& deviceName) const;
+
+private:
+    struct Metric {
+        std::string name;
+        std::vector<float> values;
+    };
+
+    struct Summary {
+        double average = 0.0;
+        double p50 = 0.0;
+        double p95 = 0.0;
+        double p99 = 0.0;
+        double min = 0.0;
+        double max = 0.0;
+    };
+
+    Settings m_settings;
+    uint32_t m_frameIndex = 0;
+    std::vector<float> m_frameTimes;
+    std::vector<Metric> m_metrics;
+    std::vector<std::pair<std::string, float>> m_startup;
+
+    Metric& findMetric(const std::string& name);
+    static Summary summarize(std::vector<float> values);
+    static std::string escapeJson(const std::string& text);
+};
@@ -0,0 +1,8 @@
+#pragma once
+
+class JobSystem;
+
+// Job system shared by every benchmark that measures a parallel path.
+// Started on first use from the benchmark (main) thread, which becomes
+// its queue 0 like the render thread does in the application.
+JobSystem& benchmarkJobSystem();
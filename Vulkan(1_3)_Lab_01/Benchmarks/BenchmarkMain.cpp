@@ -0,0 +1,27 @@
+#include "MicroBenchmark.h"
+#include "BenchmarkFixtures.h"
+#include "../JobSystem.h"
+
+// ============================================================
+// MICROBENCHMARKS
+// ============================================================
+// CPU-side engine code timed outside the renderer: mesh
+// generation, OBJ parsing, particle kernels and vertex packing.
+// Results go to microbenchmarks.json (see MicroBenchmark::run).
+//
+// Build the Release configuration for meaningful numbers.
+// ============================================================
+
+JobSystem& benchmarkJobSystem() {
+    static JobSystem jobSystem;
+    static bool started = false;
+    if (!started) {
+        jobSystem.init();
+        started = true;
+    }
+    return jobSystem;
+}
+
+int main(int argc, char** argv) {
+    return MicroBenchmark::run(argc, argv);
+}
@@ -0,0 +1,190 @@
+#include "MicroBenchmark.h"
+#include "../Cactus.h"
+#include "../Mesh.h"
+#include "../MeshGenerator.h"
+#include "../PackedVertex.h"
+#include "../Vertex.h"
+#include <algorithm>
+#include <functional>
+#include <tuple>
+#include <vector>
+
+// ============================================================
+// MESH BENCHMARKS
+// ============================================================
+// Procedural generation, mesh fix-up passes, vertex packing (the
+// CPU half of a vertex upload) and the quality of std::hash<Vertex>,
+// which every vertex-deduplicating map depends on.
+// Argument = segments (rings and plane subdivisions follow it).
+// ============================================================
+
+static void createSphere(MicroBenchmark::State& state) {
+    uint32_t segments = static_cast<uint32_t>(state.arg());
+    size_t vertices = 0;
+    while (state.keepRunning()) {
+        Mesh mesh = MeshGenerator::createSphere(100.0f, segments, segments / 2);
+        vertices = mesh.getVertexCount();
+        doNotOptimize(mesh);
+    }
+    state.setItemsProcessed(state.iterations() * vertices);
+    state.setCounter("vertices", static_cast<double>(vertices));
+}
+MICRO_BENCHMARK(createSphere)->range(16, 1024, 4);
+
+static void createPlane(MicroBenchmark::State& state) {
+    uint32_t subdivisions = static_cast<uint32_t>(state.arg());
+    size_t vertices = 0;
+    while (state.keepRunning()) {
+        Mesh mesh = MeshGenerator::createPlane(200.0f, 200.0f, subdivisions, subdivisions);
+        vertices = mesh.getVertexCount();
+        doNotOptimize(mesh);
+    }
+    state.setItemsProcessed(state.iterations() * vertices);
+    state.setCounter("vertices", static_cast<double>(vertices));
+}
+MICRO_BENCHMARK(createPlane)->range(16, 1024, 4);
+
+static void createCylinder(MicroBenchmark::State& state) {
+    uint32_t segments = static_cast<uint32_t>(state.arg());
+    size_t vertices = 0;
+    while (state.keepRunning()) {
+        Mesh mesh = MeshGenerator::createCylinder(0.5f, 5.0f, segments);
+        vertices = mesh.getVertexCount();
+        doNotOptimize(mesh);
+    }
+    state.setItemsProcessed(state.iterations() * vertices);
+    state.setCounter("vertices", static_cast<double>(vertices));
+}
+MICRO_BENCHMARK(createCylinder)->range(8, 4096, 8);
+
+// Arguments: segments, arms
+static void cactusGenerateMesh(MicroBenchmark::State& state) {
+    Cactus::Config config;
+    config.segments = static_cast<uint32_t>(state.arg(0));
+    config.numArms = static_cast<int>(state.arg(1));
+    Cactus cactus(config);
+
+    size_t vertices = 0;
+    while (state.keepRunning()) {
+        Mesh mesh = cactus.generateMesh();
+        vertices = mesh.getVertexCount();
+        doNotOptimize(mesh);
+    }
+    state.setItemsProcessed(state.iterations() * vertices);
+    state.setCounter("vertices", static_cast<double>(vertices));
+}
+MICRO_BENCHMARK(cactusGenerateMesh)->args({ 6, 0 })->args({ 12, 2 })->args({ 12, 4 })->args({ 48, 4 });
+
+static void recalculateNormals(MicroBenchmark::State& state) {
+    uint32_t segments = static_cast<uint32_t>(state.arg());
+    Mesh mesh = MeshGenerator::createSphere(100.0f, segments, segments / 2);
+    while (state.keepRunning()) {
+        mesh.recalculateNormals();
+        doNotOptimize(mesh);
+    }
+    state.setItemsProcessed(state.iterations() * mesh.getVertexCount());
+}
+MICRO_BENCHMARK(recalculateNormals)->range(16, 1024, 4);
+
+static void recalculateBounds(MicroBenchmark::State& state) {
+    uint32_t segments = static_cast<uint32_t>(state.arg());
+    Mesh mesh = MeshGenerator::createSphere(100.0f, segments, segments / 2);
+    while (state.keepRunning()) {
+        mesh.recalculateBounds();
+        doNotOptimize(mesh);
+    }
+    state.setItemsProcessed(state.iterations() * mesh.getVertexCount());
+    state.setBytesProcessed(state.iterations() * mesh.getVertexCount() * sizeof(Vertex));
+}
+MICRO_BENCHMARK(recalculateBounds)->range(16, 1024, 4);
+
+// Argument: 0 = unorm16 positions, 1 = half positions
+static void packVertices(MicroBenchmark::State& state) {
+    PositionEncoding encoding = state.arg() == 0 ? PositionEncoding::Unorm16 : PositionEncoding::Half;
+    Mesh mesh = MeshGenerator::createSphere(100.0f, 512, 256);
+    PositionDecode decode;
+    while (state.keepRunning()) {
+        std::vector<PackedVertex> packed = PackedVertex::packAll(mesh.getVertices(), encoding, decode);
+        doNotOptimize(packed);
+    }
+    state.setItemsProcessed(state.iterations() * mesh.getVertexCount());
+    state.setBytesProcessed(state.iterations() * mesh.getVertexCount() * sizeof(PackedVertex));
+    state.setCounter("uploadRatio", static_cast<double>(sizeof(PackedVertex)) / sizeof(Vertex));
+}
+MICRO_BENCHMARK(packVertices)->arg(0)->arg(1);
+
+// Distinct vertices shaped like the scene's: a sphere and a plane at the
+// given resolution, duplicates (seams, poles) removed
+static std::vector<Vertex> uniqueVertices(uint32_t segments) {
+    std::vector<Vertex> vertices = MeshGenerator::createSphere(100.0f, segments, segments / 2).getVertices();
+    Mesh plane = MeshGenerator::createPlane(200.0f, 200.0f, segments, segments);
+    vertices.insert(vertices.end(), plane.getVertices().begin(), plane.getVertices().end());
+
+    std::sort(vertices.begin(), vertices.end(), [](const Vertex& a, const Vertex& b) {
+        return std::tie(a.position.x, a.position.y, a.position.z, a.normal.x, a.normal.y, a.normal.z,
+                        a.texCoord.x, a.texCoord.y, a.color.x, a.color.y, a.color.z)
+             < std::tie(b.position.x, b.position.y, b.position.z, b.normal.x, b.normal.y, b.normal.z,
+                        b.texCoord.x, b.texCoord.y, b.color.x, b.color.y, b.color.z);
+    });
+    vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+    return vertices;
+}
+
+// Throughput of std::hash<Vertex>, plus how evenly it fills a table.
+// Counters, all over distinct vertices:
+// - collisions: pairs sharing the full size_t hash (ideal ~0)
+// - lowBitsChi2 / highBitsChi2: chi-squared per degree of freedom of bucket
+//   loads in a power-of-two table indexed by the low (MSVC unordered_map)
+//   or high (Fibonacci-style tables) bits; ~1.0 is uniform, much more is clustering
+// - maxBucket: fullest bucket at load factor ~1
+static void vertexHash(MicroBenchmark::State& state) {
+    std::vector<Vertex> vertices = uniqueVertices(static_cast<uint32_t>(state.arg()));
+    std::hash<Vertex> hasher;
+
+    std::vector<size_t> hashes(vertices.size());
+    while (state.keepRunning()) {
+        for (size_t i = 0; i < vertices.size(); i++) {
+            hashes[i] = hasher(vertices[i]);
+        }
+        doNotOptimize(hashes.data());
+    }
+    state.setItemsProcessed(state.iterations() * vertices.size());
+
+    size_t bucketBits = 1;
+    while ((size_t(1) << bucketBits) < vertices.size()) bucketBits++;
+    size_t bucketCount = size_t(1) << bucketBits;
+    double expected = static_cast<double>(vertices.size()) / static_cast<double>(bucketCount);
+
+    auto chiSquared = [&](auto&& bucketOf, uint32_t& maxBucket) {
+        std::vector<uint32_t> loads(bucketCount, 0);
+        for (size_t hash : hashes) {
+            loads[bucketOf(static_cast<uint64_t>(hash))]++;
+        }
+        double chi = 0.0;
+        for (uint32_t load : loads) {
+            double delta = static_cast<double>(load) - expected;
+            chi += delta * delta / expected;
+            maxBucket = std::max(maxBucket, load);
+        }
+        return chi / static_cast<double>(bucketCount - 1);
+    };
+
+    uint32_t maxLow = 0, maxHigh = 0;
+    double lowChi = chiSquared([&](uint64_t hash) { return hash & (bucketCount - 1); }, maxLow);
+    const size_t hashBits = sizeof(size_t) * 8;
+    double highChi = chiSquared([&](uint64_t hash) { return hash >> (hashBits - bucketBits); }, maxHigh);
+
+    std::vector<size_t> sorted = hashes;
+    std::sort(sorted.begin(), sorted.end());
+    size_t collisions = 0;
+    for (size_t i = 1; i < sorted.size(); i++) {
+        if (sorted[i] == sorted[i - 1]) collisions++;
+    }
+
+    state.setCounter("vertices", static_cast<double>(vertices.size()));
+    state.setCounter("collisions", static_cast<double>(collisions));
+    state.setCounter("lowBitsChi2", lowChi);
+    state.setCounter("highBitsChi2", highChi);
+    state.setCounter("maxBucket", static_cast<double>(std::max(maxLow, maxHigh)));
+}
+MICRO_BENCHMARK(vertexHash)->arg(64)->arg(512);
@@ -0,0 +1,292 @@
+#include "MicroBenchmark.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+namespace {
+    const uint64_t MAX_ITERATIONS = 1'000'000'000;
+
+    const volatile void* volatile escapeSink = nullptr;   // Written by MicroBenchmark::escape
+
+    std::string escapeJson(const std::string& text) {
+        std::string escaped;
+        for (char c : text) {
+            if (c == '"' || c == '\\') escaped += '\\';
+            escaped += c;
+        }
+        return escaped;
+    }
+
+    std::string formatTime(double nanoseconds) {
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(nanoseconds < 10.0 ? 2 : nanoseconds < 1000.0 ? 1 : 0);
+        if (nanoseconds < 1e4) out << nanoseconds << " ns";
+        else if (nanoseconds < 1e7) out << nanoseconds / 1e3 << " us";
+        else out << nanoseconds / 1e6 << " ms";
+        return out.str();
+    }
+
+    std::string formatRate(double perSecond, const char* unit) {
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(2);
+        if (perSecond >= 1e9) out << perSecond / 1e9 << " G" << unit << "/s";
+        else if (perSecond >= 1e6) out << perSecond / 1e6 << " M" << unit << "/s";
+        else if (perSecond >= 1e3) out << perSecond / 1e3 << " k" << unit << "/s";
+        else out << perSecond << " " << unit << "/s";
+        return out.str();
+    }
+
+    void printUsage(const char* program) {
+        std::cout << "Usage: " << program << " [--filter TEXT] [--min-time SECONDS] [--repetitions N]\n"
+            << "       [--output FILE] [--list]\n";
+    }
+}
+
+void MicroBenchmark::State::start() {
+    m_running = true;
+    m_startCpu = std::clock();
+    m_startTime = Clock::now();
+}
+
+void MicroBenchmark::State::stop() {
+    if (!m_running) return;
+    Clock::time_point now = Clock::now();
+    m_realSeconds += std::chrono::duration<double>(now - m_startTime).count();
+    m_cpuSeconds += static_cast<double>(std::clock() - m_startCpu) / CLOCKS_PER_SEC;
+    m_running = false;
+}
+
+void MicroBenchmark::State::pauseTiming() {
+    stop();
+}
+
+void MicroBenchmark::State::resumeTiming() {
+    start();
+}
+
+void MicroBenchmark::State::setCounter(const std::string& name, double value) {
+    for (auto& counter : m_counters) {
+        if (counter.first == name) {
+            counter.second = value;
+            return;
+        }
+    }
+    m_counters.emplace_back(name, value);
+}
+
+MicroBenchmark::Registration* MicroBenchmark::Registration::range(int64_t first, int64_t last, int64_t multiplier) {
+    for (int64_t value = first; value < last; value *= std::max<int64_t>(multiplier, 2)) {
+        m_argSets.push_back({ value });
+    }
+    m_argSets.push_back({ last });
+    return this;
+}
+
+std::vector<MicroBenchmark::Registration*>& MicroBenchmark::registry() {
+    static std::vector<Registration*> registrations;
+    return registrations;
+}
+
+MicroBenchmark::Registration* MicroBenchmark::add(const char* name, Function function) {
+    // Lives for the whole process, like the static that holds the pointer
+    static std::vector<std::unique_ptr<Registration>> storage;
+    storage.emplace_back(new Registration(name, function));
+    registry().push_back(storage.back().get());
+    return storage.back().get();
+}
+
+void MicroBenchmark::escape(const volatile void* pointer) {
+    escapeSink = pointer;
+}
+
+MicroBenchmark::Result MicroBenchmark::measure(const Registration& registration, const std::vector<int64_t>& args,
+                                               double minTime, uint32_t repetitions) {
+    Result result;
+    result.name = registration.m_name;
+    for (int64_t arg : args) {
+        result.name += "/" + std::to_string(arg);
+    }
+
+    // Grow the iteration count until one trial lasts minTime
+    uint64_t iterations = 1;
+    std::vector<State> trials;
+    for (;;) {
+        State state(args, iterations);
+        registration.m_function(state);
+        if (!state.m_error.empty()) {
+            result.error = state.m_error;
+            return result;
+        }
+        if (state.m_realSeconds >= minTime || iterations >= MAX_ITERATIONS) {
+            trials.push_back(std::move(state));
+            break;
+        }
+
+        // Aim 40% past minTime so the next trial very likely qualifies
+        double scale = state.m_realSeconds > 0.0 ? minTime * 1.4 / state.m_realSeconds : 10.0;
+        scale = std::clamp(scale, 2.0, 10.0);
+        iterations = std::min(MAX_ITERATIONS, static_cast<uint64_t>(static_cast<double>(iterations) * scale));
+    }
+
+    for (uint32_t i = 1; i < repetitions; i++) {
+        State state(args, iterations);
+        registration.m_function(state);
+        trials.push_back(std::move(state));
+    }
+
+    // Median trial by real time; its counters are the ones reported
+    std::sort(trials.begin(), trials.end(), [](const State& a, const State& b) {
+        return a.m_realSeconds < b.m_realSeconds;
+    });
+    const State& median = trials[trials.size() / 2];
+
+    double perIteration = 1e9 / static_cast<double>(iterations);
+    result.iterations = iterations;
+    result.realNanoseconds = median.m_realSeconds * perIteration;
+    result.cpuNanoseconds = median.m_cpuSeconds * perIteration;
+    if (median.m_realSeconds > 0.0) {
+        result.itemsPerSecond = static_cast<double>(median.m_items) / median.m_realSeconds;
+        result.bytesPerSecond = static_cast<double>(median.m_bytes) / median.m_realSeconds;
+    }
+    result.counters = median.m_counters;
+    return result;
+}
+
+bool MicroBenchmark::writeJson(const std::string& path, const std::vector<Result>& results) {
+    std::ofstream file(path);
+    if (!file) return false;
+
+    file << std::setprecision(9);
+    file << "{\n";
+    file << "  \"context\": {\"library_build_type\":"
+#ifdef NDEBUG
+        << "\"release\""
+#else
+        << "\"debug\""
+#endif
+        << ",\"num_cpus\":" << std::thread::hardware_concurrency() << "},\n";
+
+    file << "  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& result = results[i];
+        file << "    {\"name\":\"" << escapeJson(result.name) << "\",\"run_type\":\"iteration\"";
+        if (!result.error.empty()) {
+            file << ",\"error_occurred\":true,\"error_message\":\"" << escapeJson(result.error) << "\"";
+        }
+        else {
+            file << ",\"iterations\":" << result.iterations
+                << ",\"real_time\":" << result.realNanoseconds
+                << ",\"cpu_time\":" << result.cpuNanoseconds
+                << ",\"time_unit\":\"ns\"";
+            if (result.itemsPerSecond > 0.0) file << ",\"items_per_second\":" << result.itemsPerSecond;
+            if (result.bytesPerSecond > 0.0) file << ",\"bytes_per_second\":" << result.bytesPerSecond;
+            for (const auto& counter : result.counters) {
+                file << ",\"" << escapeJson(counter.first) << "\":" << counter.second;
+            }
+        }
+        file << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    file << "  ]\n}\n";
+    return static_cast<bool>(file);
+}
+
+int MicroBenchmark::run(int argc, char** argv) {
+    std::string filter;
+    std::string outputPath = "microbenchmarks.json";
+    double minTime = 0.25;
+    uint32_t repetitions = 3;
+    bool listOnly = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        char* end = nullptr;
+        if (arg == "--filter" && hasValue) {
+            filter = argv[++i];
+        }
+        else if (arg == "--min-time" && hasValue) {
+            minTime = std::strtod(argv[++i], &end);
+            if (*end != '\0' || minTime <= 0.0) {
+                printUsage(argv[0]);
+                return EXIT_FAILURE;
+            }
+        }
+        else if (arg == "--repetitions" && hasValue) {
+            unsigned long value = std::strtoul(argv[++i], &end, 10);
+            if (*end != '\0' || value == 0) {
+                printUsage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            repetitions = static_cast<uint32_t>(value);
+        }
+        else if (arg == "--output" && hasValue) {
+            outputPath = argv[++i];
+        }
+        else if (arg == "--list") {
+            listOnly = true;
+        }
+        else {
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::vector<Result> results;
+    bool anyError = false;
+    if (!listOnly) {
+        std::cout << std::left << std::setw(48) << "Benchmark" << std::right
+            << std::setw(14) << "Time" << std::setw(14) << "CPU" << std::setw(14) << "Iterations" << "  Rate / counters\n";
+        std::cout << std::string(110, '-') << "\n";
+    }
+
+    for (const Registration* registration : registry()) {
+        std::vector<std::vector<int64_t>> argSets = registration->m_argSets;
+        if (argSets.empty()) argSets.push_back({});
+
+        for (const std::vector<int64_t>& args : argSets) {
+            std::string name = registration->m_name;
+            for (int64_t arg : args) {
+                name += "/" + std::to_string(arg);
+            }
+            if (!filter.empty() && name.find(filter) == std::string::npos) continue;
+            if (listOnly) {
+                std::cout << name << "\n";
+                continue;
+            }
+
+            Result result = measure(*registration, args, minTime, repetitions);
+            std::cout << std::left << std::setw(48) << result.name << std::right;
+            if (!result.error.empty()) {
+                std::cout << "  SKIPPED: " << result.error << "\n";
+                anyError = true;
+            }
+            else {
+                std::cout << std::setw(14) << formatTime(result.realNanoseconds)
+                    << std::setw(14) << formatTime(result.cpuNanoseconds)
+                    << std::setw(14) << result.iterations;
+                if (result.itemsPerSecond > 0.0) std::cout << "  " << formatRate(result.itemsPerSecond, "items");
+                if (result.bytesPerSecond > 0.0) std::cout << "  " << formatRate(result.bytesPerSecond, "B");
+                for (const auto& counter : result.counters) {
+                    std::cout << "  " << counter.first << "=" << counter.second;
+                }
+                std::cout << "\n";
+            }
+            results.push_back(std::move(result));
+        }
+    }
+
+    if (listOnly) return EXIT_SUCCESS;
+
+    if (!writeJson(outputPath, results)) {
+        std::cerr << "Failed to write " << outputPath << "\n";
+        return EXIT_FAILURE;
+    }
+    std::cout << "Results written to " << outputPath << "\n";
+    return anyError ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <initializer_list>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * @brief Minimal Google-Benchmark-style microbenchmark harness
+ *
+ * Role: Time CPU-side engine code in isolation, outside the renderer
+ * Responsibilities:
+ * - Register benchmark functions and their argument lists (MICRO_BENCHMARK)
+ * - Grow the iteration count until a run lasts at least --min-time,
+ *   repeat it --repetitions times and keep the median
+ * - Print a console table and write JSON for tracking over time
+ *
+ * Design Notes:
+ * - The function body before the first keepRunning() is setup and is not
+ *   timed; the function is called again for every trial, so expensive
+ *   fixtures (synthetic OBJ files) are cached by the benchmark itself
+ * - JSON follows Google Benchmark's layout (context + benchmarks with
+ *   name, iterations, real_time, cpu_time, time_unit, counters), so its
+ *   comparison tooling reads our reports
+ * - No dependencies beyond the standard library
+ */
+class MicroBenchmark {
+public:
+    class State {
+    public:
+        /**
+         * @brief Loop condition: while (state.keepRunning()) { ...measured work... }
+         * Timing starts on the first call and stops when it returns false.
+         */
+        bool keepRunning() {
+            if (!m_started) {
+                m_started = true;
+                start();
+            }
+            if (m_remaining > 0) {
+                m_remaining--;
+                return true;
+            }
+            stop();
+            return false;
+        }
+
+        int64_t arg(size_t index = 0) const { return index < m_args.size() ? m_args[index] : 0; }
+        uint64_t iterations() const { return m_iterations; }
+
+        // Exclude per-iteration setup from the measurement (costs two clock reads)
+        void pauseTiming();
+        void resumeTiming();
+
+        // Totals over every iteration; reported per second
+        void setItemsProcessed(uint64_t items) { m_items = items; }
+        void setBytesProcessed(uint64_t bytes) { m_bytes = bytes; }
+
+        // Reported as is (quality metrics, sizes)
+        void setCounter(const std::string& name, double value);
+
+        // Abort the benchmark with a message instead of a timing
+        void skip(const std::string& message) { m_error = message; m_remaining = 0; }
+
+    private:
+        friend class MicroBenchmark;
+        using Clock = std::chrono::steady_clock;
+
+        State(std::vector<int64_t> args, uint64_t iterations)
+            : m_args(std::move(args)), m_iterations(iterations), m_remaining(iterations) {}
+
+        void start();
+        void stop();
+
+        std::vector<int64_t> m_args;
+        uint64_t m_iterations;
+        uint64_t m_remaining;
+        bool m_started = false;
+        bool m_running = false;
+        Clock::time_point m_startTime{};
+        std::clock_t m_startCpu = 0;
+        double m_realSeconds = 0.0;
+        double m_cpuSeconds = 0.0;
+        uint64_t m_items = 0;
+        uint64_t m_bytes = 0;
+        std::vector<std::pair<std::string, double>> m_counters;
+        std::string m_error;
+    };
+
+    using Function = void(*)(State&);
+
+    /**
+     * @brief Argument sets of one registered function (none = run once without)
+     */
+    class Registration {
+    public:
+        Registration* arg(int64_t value) { m_argSets.push_back({ value }); return this; }
+        Registration* args(std::initializer_list<int64_t> values) { m_argSets.emplace_back(values); return this; }
+
+        // first, first * multiplier, ... up to and including last
+        Registration* range(int64_t first, int64_t last, int64_t multiplier = 8);
+
+    private:
+        friend class MicroBenchmark;
+
+        Registration(std::string name, Function function) : m_name(std::move(name)), m_function(function) {}
+
+        std::string m_name;
+        Function m_function;
+        std::vector<std::vector<int64_t>> m_argSets;
+    };
+
+    MicroBenchmark() = delete;
+
+    static Registration* add(const char* name, Function function);
+
+    /**
+     * @brief Run every registered benchmark whose name contains --filter
+     * Switches: --filter TEXT, --min-time SECONDS, --repetitions N,
+     * --output FILE (JSON, default microbenchmarks.json), --list
+     * @return Process exit code (non-zero if a switch is malformed or a benchmark is skipped)
+     */
+    static int run(int argc, char** argv);
+
+    // Out-of-line sink for doNotOptimize on compilers without inline asm
+    static void escape(const volatile void* pointer);
+
+private:
+    struct Result {
+        std::string name;
+        uint64_t iterations = 0;
+        double realNanoseconds = 0.0;       // Per iteration, median of the repetitions
+        double cpuNanoseconds = 0.0;
+        double itemsPerSecond = 0.0;
+        double bytesPerSecond = 0.0;
+        std::vector<std::pair<std::string, double>> counters;
+        std::string error;
+    };
+
+    static std::vector<Registration*>& registry();
+    static Result measure(const Registration& registration, const std::vector<int64_t>& args,
+                          double minTime, uint32_t repetitions);
+    static bool writeJson(const std::string& path, const std::vector<Result>& results);
+};
+
+/**
+ * @brief Keep a value (and the work producing it) from being optimized away
+ */
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(_MSC_VER)
+    MicroBenchmark::escape(&value);
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+#define MICRO_BENCHMARK_CONCAT_INNER(a, b) a##b
+#define MICRO_BENCHMARK_CONCAT(a, b) MICRO_BENCHMARK_CONCAT_INNER(a, b)
+
+// MICRO_BENCHMARK(function)->arg(1000)->range(8, 512) at namespace scope
+#define MICRO_BENCHMARK(function) \
+    static MicroBenchmark::Registration* MICRO_BENCHMARK_CONCAT(s_microBenchmark, __LINE__) = \
+        MicroBenchmark::add(#function, function)
@@ -0,0 +1,107 @@
+#include "MicroBenchmark.h"
+#include "BenchmarkFixtures.h"
+#include "../JobSystem.h"
+#include "../OBJLoader.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+
+// ============================================================
+// OBJ LOADER BENCHMARKS
+// ============================================================
+// OBJLoader::load on synthetic files: an N x N grid of quads with
+// positions, UVs and normals, written once per size to the temp
+// directory and removed at exit. Corners are shared between
+// neighbouring quads, so deduplication does real work. The loader's
+// per-load summary line is switched off so it doesn't interleave
+// with the results table.
+// Arguments: grid size, 0 = calling thread / 1 = job system.
+// ============================================================
+
+namespace {
+    class SyntheticObjFiles {
+    public:
+        ~SyntheticObjFiles() {
+            std::error_code error;
+            for (const auto& entry : m_paths) {
+                std::filesystem::remove(entry.second, error);
+            }
+        }
+
+        const std::string& get(uint32_t gridSize) {
+            auto found = m_paths.find(gridSize);
+            if (found != m_paths.end()) return found->second;
+
+            std::filesystem::path path = std::filesystem::temp_directory_path() /
+                ("microbench_grid_" + std::to_string(gridSize) + ".obj");
+            write(path.string(), gridSize);
+            return m_paths.emplace(gridSize, path.string()).first->second;
+        }
+
+    private:
+        std::map<uint32_t, std::string> m_paths;
+
+        static void write(const std::string& path, uint32_t gridSize) {
+            std::ofstream file(path, std::ios::binary);
+            char line[128];
+            uint32_t side = gridSize + 1;
+            for (uint32_t z = 0; z < side; z++) {
+                for (uint32_t x = 0; x < side; x++) {
+                    float u = static_cast<float>(x) / gridSize;
+                    float v = static_cast<float>(z) / gridSize;
+                    // Gentle dunes so positions and normals are not all alike
+                    float height = 0.5f * std::sin(u * 17.0f) * std::cos(v * 11.0f);
+                    int length = std::snprintf(line, sizeof(line), "v %.6f %.6f %.6f\nvt %.6f %.6f\nvn 0.0 1.0 0.0\n",
+                        u * 100.0f - 50.0f, height, v * 100.0f - 50.0f, u, v);
+                    file.write(line, length);
+                }
+            }
+            for (uint32_t z = 0; z < gridSize; z++) {
+                for (uint32_t x = 0; x < gridSize; x++) {
+                    uint32_t a = z * side + x + 1;      // OBJ indices are 1-based
+                    uint32_t b = a + 1;
+                    uint32_t c = a + side + 1;
+                    uint32_t d = a + side;
+                    int length = std::snprintf(line, sizeof(line), "f %u/%u/%u %u/%u/%u %u/%u/%u %u/%u/%u\n",
+                        a, a, a, b, b, b, c, c, c, d, d, d);
+                    file.write(line, length);
+                }
+            }
+        }
+    };
+
+    SyntheticObjFiles& syntheticObjFiles() {
+        static SyntheticObjFiles files;
+        return files;
+    }
+}
+
+static void objLoad(MicroBenchmark::State& state) {
+    OBJLoader::setLogLoads(false);
+    const std::string& path = syntheticObjFiles().get(static_cast<uint32_t>(state.arg(0)));
+    JobSystem* jobSystem = state.arg(1) != 0 ? &benchmarkJobSystem() : nullptr;
+    uintmax_t fileSize = std::filesystem::file_size(path);
+
+    size_t triangles = 0;
+    while (state.keepRunning()) {
+        Mesh mesh = OBJLoader::load(path, jobSystem);
+        triangles = mesh.getIndexCount() / 3;
+        doNotOptimize(mesh);
+    }
+    if (triangles == 0) {
+        state.skip("OBJLoader::load returned an empty mesh");
+        return;
+    }
+    state.setItemsProcessed(state.iterations() * triangles);
+    state.setBytesProcessed(state.iterations() * fileSize);
+    state.setCounter("triangles", static_cast<double>(triangles));
+    state.setCounter("fileMB", static_cast<double>(fileSize) / (1024.0 * 1024.0));
+}
+MICRO_BENCHMARK(objLoad)
+    ->args({ 64, 0 })->args({ 64, 1 })
+    ->args({ 256, 0 })->args({ 256, 1 })
+    ->args({ 768, 0 })->args({ 768, 1 });
@@ -0,0 +1,118 @@
+#include "MicroBenchmark.h"
+#include "BenchmarkFixtures.h"
+#include "../JobSystem.h"
+#include "../ParticleSystem.h"
+#include "../RadixSort.h"
+#include <vector>
+
+// ============================================================
+// PARTICLE BENCHMARKS
+// ============================================================
+// The CPU particle kernels at 1k to 1M live particles: one
+// simulation tick (serial and split across the job system the way
+// kickParticleSimulation does it), instance generation, batched
+// emission and the back-to-front depth sort.
+// Argument = live particles.
+// ============================================================
+
+namespace {
+    const float TICK = 1.0f / 60.0f;
+    const uint32_t JOB_CHUNK = 4096;    // PARTICLE_JOB_CHUNK in the application
+
+    // Pool of count particles that all stay alive for the whole run
+    // (no emission, lifetimes far longer than any benchmark)
+    void initFullEmitter(ParticleSystem& emitter, int64_t count) {
+        ParticleSystem::EmitterConfig config;
+        config.maxParticles = static_cast<int>(count);
+        config.emissionRate = 0.0f;
+        config.minLife = 1.0e6f;
+        config.maxLife = 1.0e6f;
+        config.positionVariance = glm::vec3(50.0f);
+        config.velocityVariance = glm::vec3(5.0f);
+        emitter.setSeed(1234);
+        emitter.init(config);
+        emitter.emitBurst(static_cast<uint32_t>(count));
+    }
+}
+
+static void particleUpdate(MicroBenchmark::State& state) {
+    ParticleSystem emitter;
+    initFullEmitter(emitter, state.arg());
+    while (state.keepRunning()) {
+        emitter.update(TICK);
+    }
+    state.setItemsProcessed(state.iterations() * emitter.getAliveCount());
+}
+MICRO_BENCHMARK(particleUpdate)->range(1000, 1000000, 10);
+
+static void particleUpdateParallel(MicroBenchmark::State& state) {
+    JobSystem& jobSystem = benchmarkJobSystem();
+    ParticleSystem emitter;
+    initFullEmitter(emitter, state.arg());
+    while (state.keepRunning()) {
+        uint32_t liveCount = static_cast<uint32_t>(emitter.beginUpdate(TICK));
+        JobSystem::Counter chunkJobs;
+        jobSystem.parallelFor(chunkJobs, liveCount, JOB_CHUNK, [&emitter](uint32_t begin, uint32_t end) {
+            emitter.integrateRange(begin, end, TICK);
+        });
+        jobSystem.wait(chunkJobs);
+        emitter.endUpdate();
+    }
+    state.setItemsProcessed(state.iterations() * emitter.getAliveCount());
+    state.setCounter("threads", static_cast<double>(jobSystem.getWorkerCount() + 1));
+}
+MICRO_BENCHMARK(particleUpdateParallel)->range(1000, 1000000, 10);
+
+// The instance records the CPU particles upload every frame
+static void particleGenerateInstances(MicroBenchmark::State& state) {
+    ParticleSystem emitter;
+    initFullEmitter(emitter, state.arg());
+    std::vector<ParticleInstance> instances(static_cast<size_t>(state.arg()));
+    while (state.keepRunning()) {
+        size_t written = emitter.generateInstances(instances.data(), instances.size());
+        doNotOptimize(written);
+        doNotOptimize(instances.data());
+    }
+    state.setItemsProcessed(state.iterations() * instances.size());
+    state.setBytesProcessed(state.iterations() * instances.size() * sizeof(ParticleInstance));
+}
+MICRO_BENCHMARK(particleGenerateInstances)->range(1000, 1000000, 10);
+
+// Batched emission into an empty pool (emitParticle through emitBurst)
+static void particleEmit(MicroBenchmark::State& state) {
+    ParticleSystem emitter;
+    initFullEmitter(emitter, state.arg());
+    ParticleSystem::EmitterConfig config = emitter.getConfig();
+    uint32_t count = static_cast<uint32_t>(state.arg());
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        emitter.init(config);   // Empties the pool
+        state.resumeTiming();
+
+        doNotOptimize(emitter.emitBurst(count));
+    }
+    state.setItemsProcessed(state.iterations() * count);
+}
+MICRO_BENCHMARK(particleEmit)->range(1000, 1000000, 10);
+
+// Depth keys plus the radix sort, as for alpha-blended emitters each frame
+static void particleDepthSort(MicroBenchmark::State& state) {
+    JobSystem& jobSystem = benchmarkJobSystem();
+    ParticleSystem emitter;
+    initFullEmitter(emitter, state.arg());
+    size_t count = static_cast<size_t>(emitter.getAliveCount());
+    std::vector<uint32_t> keys(count);
+    std::vector<uint32_t> values(count);
+    RadixSort sorter;
+
+    const glm::vec3 eye(0.0f, 20.0f, 150.0f);
+    const glm::vec3 forward(0.0f, 0.0f, -1.0f);
+    while (state.keepRunning()) {
+        emitter.writeSortKeys(keys.data(), values.data(), 0, count, eye, forward, 1000.0f, 0);
+        sorter.sort(keys.data(), values.data(), count, 16, &jobSystem);
+        doNotOptimize(values.data());
+    }
+    state.setItemsProcessed(state.iterations() * count);
+    state.setCounter("passes", static_cast<double>(sorter.getLastPassCount()));
+}
+MICRO_BENCHMARK(particleDepthSort)->range(1000, 1000000, 10);
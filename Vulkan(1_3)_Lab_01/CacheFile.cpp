@@ -0,0 +1,66 @@
+#include "CacheFile.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+uint64_t CacheFile::hashBytes(const void* data, size_t size, uint64_t seed) {
+    // Multiply-xorshift over 8-byte words, tail bytes folded into the last word
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    uint64_t h = seed ^ (0x9E3779B97F4A7C15ull * (size + 1));
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, sizeof(word));
+        h = (h ^ word) * 0xBF58476D1CE4E5B9ull;
+        h ^= h >> 31;
+    }
+    if (i < size) {
+        uint64_t word = 0;
+        std::memcpy(&word, bytes + i, size - i);
+        h = (h ^ word) * 0xBF58476D1CE4E5B9ull;
+        h ^= h >> 31;
+    }
+    h *= 0x94D049BB133111EBull;
+    h ^= h >> 32;
+    return h;
+}
+
+std::string CacheFile::pathFor(const std::string& directory, uint64_t key, const char* extension) {
+    std::ostringstream name;
+    name << directory << '/' << std::hex << std::setw(16) << std::setfill('0') << key << extension;
+    return name.str();
+}
+
+bool CacheFile::writeFileAtomically(const std::string& path, const void* header, size_t headerSize,
+                                    const void* body, size_t bodySize) {
+    std::error_code error;
+    std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty()) std::filesystem::create_directories(parent, error);
+
+    std::string tempPath = path + ".tmp";
+    bool written = false;
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (file) {
+            file.write(static_cast<const char*>(header), static_cast<std::streamsize>(headerSize));
+            if (bodySize > 0) file.write(static_cast<const char*>(body), static_cast<std::streamsize>(bodySize));
+            written = static_cast<bool>(file);
+        }
+    }
+    if (!written) {
+        std::cerr << "CacheFile: Failed to write " << tempPath << std::endl;
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+
+    std::filesystem::rename(tempPath, path, error);
+    if (error) {
+        std::cerr << "CacheFile: Failed to replace " << path << std::endl;
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+    return true;
+}
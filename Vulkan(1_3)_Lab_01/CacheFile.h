@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+/**
+ * @brief Hashing, naming and writing shared by the on-disk caches
+ * 
+ * Role: One implementation of the pieces MeshCache, PipelineCache and the
+ *       procedural texture cache all need
+ * Responsibilities:
+ * - 64-bit content hash stored in every cache file header
+ * - Incremental keys from typed values (generator name, parameters)
+ * - Cache file names: 16 hex digits of the key plus an extension
+ * - Crash-safe writes: temporary file next to the target, renamed over it
+ * 
+ * Design Notes:
+ * - Static utility class (no state needed)
+ * - hashBytes is not cryptographic; it detects truncation and corruption
+ * - Writers create the target's directory on first use
+ */
+class CacheFile {
+public:
+    // Prevent instantiation - utility class
+    CacheFile() = delete;
+
+    /**
+     * @brief Incremental key from typed values
+     * @param seed Mixed in first; bump it to invalidate every key of a kind
+     */
+    class Key {
+    public:
+        explicit Key(const std::string& kind, uint64_t seed = 0) : m_hash(seed) { add(kind); }
+
+        template<typename T>
+        Key& add(const T& value) {
+            static_assert(std::is_trivially_copyable_v<T>, "Key values must be plain data");
+            m_hash = hashBytes(&value, sizeof(T), m_hash);
+            return *this;
+        }
+        Key& add(const std::string& text) {
+            m_hash = hashBytes(text.data(), text.size(), m_hash ^ text.size());
+            return *this;
+        }
+        Key& add(const char* text) { return add(std::string(text)); }
+
+        uint64_t get() const { return m_hash; }
+
+    private:
+        uint64_t m_hash;
+    };
+
+    /**
+     * @brief 64-bit hash of a byte range (8 bytes per step)
+     */
+    static uint64_t hashBytes(const void* data, size_t size, uint64_t seed = 0);
+
+    /**
+     * @brief directory/<key as 16 hex digits><extension>
+     */
+    static std::string pathFor(const std::string& directory, uint64_t key, const char* extension);
+
+    /**
+     * @brief Write header then body to path without ever exposing a partial file
+     * 
+     * The bytes go to path + ".tmp", which is then renamed over path; on any
+     * failure the temporary file is removed and the old file left untouched.
+     * @return True if path now holds the new contents
+     */
+    static bool writeFileAtomically(const std::string& path, const void* header, size_t headerSize,
+                                    const void* body, size_t bodySize);
+
+    template<typename Header>
+    static bool writeFileAtomically(const std::string& path, const Header& header, const void* body, size_t bodySize) {
+        static_assert(std::is_trivially_copyable_v<Header>, "Cache headers are written as raw bytes");
+        return writeFileAtomically(path, &header, sizeof(Header), body, bodySize);
+    }
+};
@@ -7,29 +7,94 @@ Cactus::Cactus(const Config& config)
 }
 
 Mesh Cactus::generateMesh() const {
+    return buildMesh(m_config.position);
+}
+
+Mesh Cactus::generateLocalMesh() const {
+    return buildMesh(glm::vec3(0.0f));
+}
+
+glm::mat4 Cactus::getTransform() const {
+    return glm::translate(glm::mat4(1.0f), m_config.position);
+}
+
+std::vector<Mesh> Cactus::generateLocalMeshLods(uint32_t levels) const {
+    std::vector<Mesh> chain;
+    for (uint32_t segments : getLodSegments(levels)) {
+        chain.push_back(buildMesh(glm::vec3(0.0f), m_config.height * m_growthFactor,
+            m_config.trunkRadius * m_growthFactor, m_config.color, segments));
+    }
+    return chain;
+}
+
+Mesh Cactus::generateInstanceMesh() const {
+    return buildMesh(glm::vec3(0.0f), 1.0f, INSTANCE_REFERENCE_RADIUS, glm::vec3(1.0f), m_config.segments);
+}
+
+std::vector<Mesh> Cactus::generateInstanceMeshLods(uint32_t levels) const {
+    std::vector<Mesh> chain;
+    for (uint32_t segments : getLodSegments(levels)) {
+        chain.push_back(buildMesh(glm::vec3(0.0f), 1.0f, INSTANCE_REFERENCE_RADIUS, glm::vec3(1.0f), segments));
+    }
+    return chain;
+}
+
+glm::vec3 Cactus::getInstanceScale() const {
+    // The instance mesh is unit height; XZ follows the trunk radius, so the
+    // arms' reach scales with the trunk rather than with height
+    float radial = m_config.trunkRadius / INSTANCE_REFERENCE_RADIUS;
+    return glm::vec3(radial, m_config.height, radial);
+}
+
+uint64_t Cactus::getInstanceKey() const {
+    // Everything that changes the shape after scaling
+    uint32_t armHeightBits = static_cast<uint32_t>(glm::clamp(m_config.armHeight, 0.0f, 1.0f) * 1000.0f + 0.5f);
+    return (static_cast<uint64_t>(m_config.numArms) << 48) |
+           (static_cast<uint64_t>(m_config.segments & 0xFFFF) << 32) |
+           armHeightBits;
+}
+
+std::vector<uint32_t> Cactus::getLodSegments(uint32_t levels) const {
+    // A 4-sided trunk is the coarsest shape that still reads as a cactus
+    std::vector<uint32_t> segmentCounts;
+    for (uint32_t level = 0; level < levels; ++level) {
+        uint32_t segments = MeshGenerator::lodSegments(m_config.segments, level, 4);
+        if (!segmentCounts.empty() && segments == segmentCounts.back()) break;
+        segmentCounts.push_back(segments);
+    }
+    return segmentCounts;
+}
+
+Mesh Cactus::buildMesh(const glm::vec3& origin) const {
+    return buildMesh(origin, m_config.height * m_growthFactor,
+        m_config.trunkRadius * m_growthFactor, m_config.color, m_config.segments);
+}
+
+Mesh Cactus::buildMesh(const glm::vec3& origin, float height, float trunkRadius,
+                       const glm::vec3& color, uint32_t segments) const {
     std::vector<Vertex> allVertices;
     std::vector<uint32_t> allIndices;
 
-    float actualHeight = m_config.height * m_growthFactor;
-    float actualRadius = m_config.trunkRadius * m_growthFactor;
+    float actualHeight = height;
+    float actualRadius = trunkRadius;
 
     // Generate main trunk (capped cylinder)
     Mesh trunk = MeshGenerator::createCylinder(
         actualRadius,
         actualHeight,
-        m_config.segments,
-        m_config.color
+        segments,
+        color
     );
 
-    // Transform trunk to world position (centered at base)
+    // Transform trunk to origin (centered at base)
     const auto& trunkVerts = trunk.getVertices();
     const auto& trunkInds = trunk.getIndices();
     
     for (const auto& v : trunkVerts) {
         Vertex transformed = v;
-        // Move from center to base, then to world position
+        // Move from center to base, then to origin
         transformed.position.y += actualHeight * 0.5f;
-        transformed.position += m_config.position;
+        transformed.position += origin;
         allVertices.push_back(transformed);
     }
     allIndices.insert(allIndices.end(), trunkInds.begin(), trunkInds.end());
@@ -42,7 +107,7 @@ Mesh Cactus::generateMesh() const {
         float attachHeight = actualHeight * m_config.armHeight;
         float armLength = actualHeight * 0.4f;
         
-        Mesh arm = generateArm(attachHeight, angle, armLength);
+        Mesh arm = generateArm(origin, attachHeight, angle, armLength, actualRadius, color, segments);
         
         uint32_t indexOffset = static_cast<uint32_t>(allVertices.size());
         const auto& armVerts = arm.getVertices();
@@ -57,30 +122,31 @@ Mesh Cactus::generateMesh() const {
     return Mesh(std::move(allVertices), std::move(allIndices));
 }
 
-Mesh Cactus::generateArm(float attachHeight, float angle, float armLength) const {
+Mesh Cactus::generateArm(const glm::vec3& origin, float attachHeight, float angle, float armLength,
+                         float trunkRadius, const glm::vec3& color, uint32_t segments) const {
     std::vector<Vertex> armVertices;
     std::vector<uint32_t> armIndices;
 
-    float armRadius = m_config.trunkRadius * 0.6f * m_growthFactor;
+    float armRadius = trunkRadius * 0.6f;
     float elbowLength = armLength * 0.5f;
 
     // Horizontal section (elbow)
     Mesh horizontal = MeshGenerator::createCylinder(
-        armRadius, elbowLength, m_config.segments, m_config.color
+        armRadius, elbowLength, segments, color
     );
 
     // Vertical section (upper arm)
     Mesh vertical = MeshGenerator::createCylinder(
-        armRadius, armLength * 0.6f, m_config.segments, m_config.color
+        armRadius, armLength * 0.6f, segments, color
     );
 
     // Position horizontal section
     glm::mat4 transform = glm::mat4(1.0f);
-    transform = glm::translate(transform, m_config.position);
+    transform = glm::translate(transform, origin);
     transform = glm::translate(transform, glm::vec3(0.0f, attachHeight, 0.0f));
     transform = glm::rotate(transform, angle, glm::vec3(0.0f, 1.0f, 0.0f));
     transform = glm::rotate(transform, glm::radians(90.0f), glm::vec3(0.0f, 0.0f, 1.0f));
-    transform = glm::translate(transform, glm::vec3(0.0f, elbowLength * 0.5f + m_config.trunkRadius, 0.0f));
+    transform = glm::translate(transform, glm::vec3(0.0f, elbowLength * 0.5f + trunkRadius, 0.0f));
 
     const auto& hVerts = horizontal.getVertices();
     const auto& hInds = horizontal.getIndices();
@@ -98,10 +164,10 @@ Mesh Cactus::generateArm(float attachHeight, float angle, float armLength) const
 
     // Position vertical section at end of horizontal
     glm::mat4 vertTransform = glm::mat4(1.0f);
-    vertTransform = glm::translate(vertTransform, m_config.position);
+    vertTransform = glm::translate(vertTransform, origin);
     vertTransform = glm::translate(vertTransform, glm::vec3(0.0f, attachHeight, 0.0f));
     vertTransform = glm::rotate(vertTransform, angle, glm::vec3(0.0f, 1.0f, 0.0f));
-    vertTransform = glm::translate(vertTransform, glm::vec3(elbowLength + m_config.trunkRadius, armLength * 0.3f, 0.0f));
+    vertTransform = glm::translate(vertTransform, glm::vec3(elbowLength + trunkRadius, armLength * 0.3f, 0.0f));
 
     uint32_t indexOffset = static_cast<uint32_t>(armVertices.size());
     const auto& vVerts = vertical.getVertices();
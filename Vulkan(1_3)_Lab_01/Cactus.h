@@ -33,7 +33,7 @@ public:
         int numArms = 2;                // Number of side arms (0-4)
         float armHeight = 0.6f;         // Arm height as fraction of trunk
         glm::vec3 color{0.2f, 0.6f, 0.2f}; // Green color
-        uint32_t segments = 12;         // Cylinder segments (LOD)
+        uint32_t segments = 12;         // Cylinder segments (LOD 0)
     };
 
     Cactus() = default;
@@ -41,10 +41,54 @@ public:
 
     /**
      * @brief Generate the cactus mesh from primitives
-     * @return Combined mesh of trunk and arms
+     * @return Combined mesh of trunk and arms, in world space
      */
     Mesh generateMesh() const;
 
+    /**
+     * @brief Generate the cactus mesh around the origin (base at Y=0)
+     * @return Combined mesh of trunk and arms; place it with getTransform()
+     */
+    Mesh generateLocalMesh() const;
+
+    /**
+     * @brief Local mesh LOD chain (level 0 = generateLocalMesh())
+     * @param levels Maximum number of levels; segments halve per level
+     */
+    std::vector<Mesh> generateLocalMeshLods(uint32_t levels) const;
+
+    /**
+     * @brief Model matrix placing the local mesh at the configured position
+     */
+    glm::mat4 getTransform() const;
+
+    /**
+     * @brief Generate the shared mesh used by instanced rendering
+     * 
+     * Unit height, reference trunk radius, white vertex color and no growth,
+     * so every cactus with the same getInstanceKey() can draw it.
+     * Place it with getInstanceScale(), growth factor and color tint.
+     */
+    Mesh generateInstanceMesh() const;
+
+    /**
+     * @brief Instance mesh LOD chain (level 0 = generateInstanceMesh())
+     */
+    std::vector<Mesh> generateInstanceMeshLods(uint32_t levels) const;
+
+    /**
+     * @brief Per-instance scale of the instance mesh (trunk radius in XZ, height in Y)
+     */
+    glm::vec3 getInstanceScale() const;
+
+    /**
+     * @brief Shape key: cacti with equal keys share one instance mesh
+     */
+    uint64_t getInstanceKey() const;
+
+    // Trunk radius of the unit-height instance mesh
+    static constexpr float INSTANCE_REFERENCE_RADIUS = 1.0f / 15.0f;
+
     // Accessors
     glm::vec3 getPosition() const { return m_config.position; }
     float getHeight() const { return m_config.height; }
@@ -61,14 +105,35 @@ public:
     const Config& getConfig() const { return m_config; }
 
 private:
+    /**
+     * @brief Build trunk and arms with the cactus base at origin
+     */
+    Mesh buildMesh(const glm::vec3& origin) const;
+
+    /**
+     * @brief Same as buildMesh(), with explicit dimensions, color and resolution
+     */
+    Mesh buildMesh(const glm::vec3& origin, float height, float trunkRadius,
+                   const glm::vec3& color, uint32_t segments) const;
+
+    /**
+     * @brief Segment counts of the LOD chain (stops when they stop shrinking)
+     */
+    std::vector<uint32_t> getLodSegments(uint32_t levels) const;
+
     /**
      * @brief Generate a single arm attached to trunk
+     * @param origin Base of the trunk
      * @param attachHeight Height on trunk where arm attaches
      * @param angle Rotation angle around trunk (radians)
      * @param armLength Length of the arm
+     * @param trunkRadius Radius of the trunk the arm grows from
+     * @param color Vertex color
+     * @param segments Cylinder segments
      * @return Mesh for the arm
      */
-    Mesh generateArm(float attachHeight, float angle, float armLength) const;
+    Mesh generateArm(const glm::vec3& origin, float attachHeight, float angle, float armLength,
+                     float trunkRadius, const glm::vec3& color, uint32_t segments) const;
 
     Config m_config;
     float m_growthFactor = 1.0f;    // Multiplier for growth effects
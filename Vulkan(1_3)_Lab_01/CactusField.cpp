@@ -0,0 +1,112 @@
+#include "CactusField.h"
+#include "MeshOptimizer.h"
+#include "Particle.h"
+#include <algorithm>
+#include <map>
+
+void CactusField::build(const std::vector<Cactus>& cacti, Scene& scene, uint32_t lodLevels, MeshCache* meshCache) {
+    clear();
+
+    // Group by shape; std::map keeps batch order stable between runs
+    std::map<uint64_t, std::vector<uint32_t>> groups;
+    for (uint32_t i = 0; i < static_cast<uint32_t>(cacti.size()); i++) {
+        groups[cacti[i].getInstanceKey()].push_back(i);
+    }
+
+    m_instances.reserve(cacti.size());
+    m_cactusToInstance.resize(cacti.size());
+
+    for (const auto& group : groups) {
+        const std::vector<uint32_t>& members = group.second;
+
+        // Any member can generate the shared meshes: same key, same shape
+        Batch batch;
+        const Cactus& shape = cacti[members.front()];
+        uint32_t levels = std::min(lodLevels, MAX_LOD_LEVELS);
+        auto generate = [&]() {
+            std::vector<Mesh> lods = shape.generateInstanceMeshLods(levels);
+            MeshOptimizer::optimizeLods(lods, "cactus shape");
+            return lods;
+        };
+        std::vector<Mesh> chain = meshCache
+            ? meshCache->getOrCreateLods(MeshCache::Key("cactus-instance").add(group.first).add(levels).get(), generate)
+            : generate();
+        batch.lodCount = static_cast<uint32_t>(chain.size());
+        for (uint32_t level = 0; level < batch.lodCount; level++) {
+            batch.lods[level] = scene.addMesh(chain[level]);
+        }
+        batch.firstInstance = static_cast<uint32_t>(m_instances.size());
+        batch.instanceCount = static_cast<uint32_t>(members.size());
+
+        for (uint32_t cactusIndex : members) {
+            const Cactus& cactus = cacti[cactusIndex];
+
+            CactusInstance instance{};
+            instance.position = cactus.getPosition();
+            instance.growth = cactus.getGrowthFactor();
+            instance.scale = cactus.getInstanceScale();
+            instance.tint = packColorRGBA8(glm::vec4(cactus.getConfig().color, 1.0f));
+
+            m_cactusToInstance[cactusIndex] = static_cast<uint32_t>(m_instances.size());
+            m_instances.push_back(instance);
+        }
+        m_batches.push_back(batch);
+    }
+    m_instanceLods.assign(m_instances.size(), 0);
+}
+
+void CactusField::setGrowthFactor(uint32_t cactusIndex, float growthFactor) {
+    m_instances[m_cactusToInstance[cactusIndex]].growth = growthFactor;
+}
+
+uint32_t CactusField::cull(const Frustum& frustum, const glm::vec3& cameraPosition, float projectionScale,
+                           const LodSettings& lodSettings, CactusInstance* output, std::vector<Draw>& draws) {
+    draws.clear();
+    uint32_t written = 0;
+
+    for (uint32_t b = 0; b < static_cast<uint32_t>(m_batches.size()); b++) {
+        const Batch& batch = m_batches[b];
+        const SceneMesh& bounds = batch.lods[0];
+        uint32_t levelCounts[MAX_LOD_LEVELS] = {};
+        m_visible.clear();
+
+        // Pass 1: cull and select a level
+        for (uint32_t i = batch.firstInstance; i < batch.firstInstance + batch.instanceCount; i++) {
+            const CactusInstance& instance = m_instances[i];
+
+            // Scale is positive, so the local box maps straight to world space
+            glm::vec3 scale = instance.scale * instance.growth;
+            glm::vec3 worldMin = instance.position + bounds.localMin * scale;
+            glm::vec3 worldMax = instance.position + bounds.localMax * scale;
+            if (!frustum.intersects(worldMin, worldMax)) continue;
+
+            float screenRadius = lodScreenRadius((worldMin + worldMax) * 0.5f,
+                glm::length(worldMax - worldMin) * 0.5f, cameraPosition, projectionScale);
+            m_instanceLods[i] = selectLod(screenRadius, m_instanceLods[i], batch.lodCount, lodSettings);
+            levelCounts[m_instanceLods[i]]++;
+            m_visible.push_back(i);
+        }
+
+        // Pass 2: scatter into one contiguous range per level
+        uint32_t levelCursor[MAX_LOD_LEVELS];
+        for (uint32_t level = 0; level < batch.lodCount; level++) {
+            levelCursor[level] = written;
+            if (levelCounts[level] > 0) {
+                draws.push_back({ b, level, written, levelCounts[level] });
+            }
+            written += levelCounts[level];
+        }
+        for (uint32_t i : m_visible) {
+            output[levelCursor[m_instanceLods[i]]++] = m_instances[i];
+        }
+    }
+    return written;
+}
+
+void CactusField::clear() {
+    m_batches.clear();
+    m_instances.clear();
+    m_cactusToInstance.clear();
+    m_instanceLods.clear();
+    m_visible.clear();
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "Cactus.h"
+#include "MeshCache.h"
+#include "Scene.h"
+#include <glm/glm.hpp>
+#include <vulkan/vulkan.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Per-instance record for instanced cactus rendering (32 bytes).
+// cactus_instanced.vert scales the shared unit mesh, then offsets it.
+struct CactusInstance {
+    glm::vec3 position;     // Base of the trunk (world space)
+    float growth;           // Cactus::getGrowthFactor(), applied on top of scale
+    glm::vec3 scale;        // Cactus::getInstanceScale()
+    uint32_t tint;          // RGBA8 (see packColorRGBA8), multiplies the white mesh
+
+    // Binding 1 sits next to the shared Vertex buffer at binding 0
+    static VkVertexInputBindingDescription getBindingDescription() {
+        VkVertexInputBindingDescription binding{};
+        binding.binding = 1;
+        binding.stride = sizeof(CactusInstance);
+        binding.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+        return binding;
+    }
+
+    // Locations 4-7 follow the four Vertex attributes
+    static std::array<VkVertexInputAttributeDescription, 4> getAttributeDescriptions() {
+        std::array<VkVertexInputAttributeDescription, 4> attributes{};
+
+        // Position
+        attributes[0].binding = 1;
+        attributes[0].location = 4;
+        attributes[0].format = VK_FORMAT_R32G32B32_SFLOAT;
+        attributes[0].offset = offsetof(CactusInstance, position);
+
+        // Growth
+        attributes[1].binding = 1;
+        attributes[1].location = 5;
+        attributes[1].format = VK_FORMAT_R32_SFLOAT;
+        attributes[1].offset = offsetof(CactusInstance, growth);
+
+        // Scale
+        attributes[2].binding = 1;
+        attributes[2].location = 6;
+        attributes[2].format = VK_FORMAT_R32G32B32_SFLOAT;
+        attributes[2].offset = offsetof(CactusInstance, scale);
+
+        // Tint (normalized to vec4 by the input assembler)
+        attributes[3].binding = 1;
+        attributes[3].location = 7;
+        attributes[3].format = VK_FORMAT_R8G8B8A8_UNORM;
+        attributes[3].offset = offsetof(CactusInstance, tint);
+
+        return attributes;
+    }
+};
+static_assert(sizeof(CactusInstance) == 32, "CactusInstance must stay tightly packed");
+
+/**
+ * @brief Instanced cactus population
+ *
+ * Role: Draw many cacti from a handful of shared meshes
+ * Responsibilities:
+ * - Group cacti by shape (arm count, arm height, segments) and generate
+ *   one unit-height LOD chain per group into the scene's shared buffers
+ * - Keep one CactusInstance per cactus (position, scale, growth, tint)
+ * - Frustum-cull instances each frame, pick their LOD and emit one
+ *   instanced draw per group and level
+ *
+ * Design Notes:
+ * - Vertex memory and build time scale with the number of shapes, not
+ *   the number of cacti
+ * - Instances are stored grouped by shape; cull() regroups the visible
+ *   ones by LOD, so each (shape, LOD) pair is one contiguous range and
+ *   one vkCmdDrawIndexed with instanceCount > 1
+ * - The visible list is written straight into caller memory (a mapped
+ *   per-frame ring), so culling needs no extra copy
+ */
+class CactusField {
+public:
+    /**
+     * @brief One shared LOD chain and the instances that use it
+     */
+    struct Batch {
+        SceneMesh lods[MAX_LOD_LEVELS]; // Level 0 = full detail
+        uint32_t lodCount = 1;
+        uint32_t firstInstance = 0;     // Into getInstances()
+        uint32_t instanceCount = 0;
+    };
+
+    /**
+     * @brief One instanced draw produced by cull()
+     */
+    struct Draw {
+        uint32_t batch = 0;
+        uint32_t lod = 0;
+        uint32_t firstInstance = 0;     // Into the cull() output
+        uint32_t instanceCount = 0;
+    };
+
+    CactusField() = default;
+
+    /**
+     * @brief Build the shared mesh LOD chains (into scene) and the instance list
+     * @param lodLevels Maximum LOD levels per shape (1 = no LOD)
+     * @param meshCache Reuses shape meshes from earlier runs; nullptr = always generate
+     */
+    void build(const std::vector<Cactus>& cacti, Scene& scene, uint32_t lodLevels = MAX_LOD_LEVELS,
+               MeshCache* meshCache = nullptr);
+
+    /**
+     * @brief Update the growth of one cactus (index into the build() list)
+     */
+    void setGrowthFactor(uint32_t cactusIndex, float growthFactor);
+
+    /**
+     * @brief Write visible instances to output (capacity getInstanceCount())
+     * 
+     * Also updates every visible instance's LOD (see selectLod), which is
+     * why culling is not const: the previous level drives hysteresis.
+     * @param projectionScale See lodProjectionScale()
+     * @return Number of instances written
+     */
+    uint32_t cull(const Frustum& frustum, const glm::vec3& cameraPosition, float projectionScale,
+                  const LodSettings& lodSettings, CactusInstance* output, std::vector<Draw>& draws);
+
+    void clear();
+
+    // Accessors
+    const std::vector<Batch>& getBatches() const { return m_batches; }
+    const std::vector<CactusInstance>& getInstances() const { return m_instances; }
+    uint32_t getInstanceCount() const { return static_cast<uint32_t>(m_instances.size()); }
+    uint32_t getBatchCount() const { return static_cast<uint32_t>(m_batches.size()); }
+
+private:
+    std::vector<Batch> m_batches;
+    std::vector<CactusInstance> m_instances;    // Grouped by batch
+    std::vector<uint32_t> m_cactusToInstance;   // build() order -> m_instances
+    std::vector<uint32_t> m_instanceLods;       // Current level per instance
+    std::vector<uint32_t> m_visible;            // cull() scratch, reused every frame
+};
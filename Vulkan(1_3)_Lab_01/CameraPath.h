@@ -0,0 +1,122 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// ============================================================
+// CAMERA PATH
+// ============================================================
+// Keyframed camera flight used by the benchmark mode, so every
+// run renders exactly the same sequence of views.
+//
+// File format (one keyframe per line, '#' starts a comment):
+//   time  posX posY posZ  targetX targetY targetZ
+//
+// Key concepts for defense:
+// - Catmull-Rom spline through the keyframes: smooth, passes
+//   through every recorded point, needs no tangents in the file
+// - Evaluated from simulated time, not wall time, so the path is
+//   identical regardless of frame rate
+// - Path loops when the benchmark runs longer than it
+// ============================================================
+
+class CameraPath {
+public:
+    struct Keyframe {
+        float time;             // Seconds from path start
+        glm::vec3 position;
+        glm::vec3 target;
+    };
+
+    void addKeyframe(float time, const glm::vec3& position, const glm::vec3& target) {
+        keyframes.push_back({ time, position, target });
+        std::sort(keyframes.begin(), keyframes.end(),
+            [](const Keyframe& a, const Keyframe& b) { return a.time < b.time; });
+    }
+
+    // Load keyframes from a text file, returns false if none were read
+    bool loadFromFile(const std::string& path) {
+        std::ifstream file(path);
+        if (!file) return false;
+
+        keyframes.clear();
+        std::string line;
+        while (std::getline(file, line)) {
+            if (line.empty() || line[0] == '#') continue;
+            std::istringstream stream(line);
+            Keyframe key{};
+            if (stream >> key.time
+                       >> key.position.x >> key.position.y >> key.position.z
+                       >> key.target.x >> key.target.y >> key.target.z) {
+                keyframes.push_back(key);
+            }
+        }
+        std::sort(keyframes.begin(), keyframes.end(),
+            [](const Keyframe& a, const Keyframe& b) { return a.time < b.time; });
+        return !keyframes.empty();
+    }
+
+    // Built-in flight: overview, dive into the globe, cactus close-up, back out
+    static CameraPath createDefault() {
+        CameraPath path;
+        path.addKeyframe(0.0f,  glm::vec3(0.0f, 100.0f, 300.0f),  glm::vec3(0.0f, 0.0f, 0.0f));
+        path.addKeyframe(4.0f,  glm::vec3(200.0f, 60.0f, 150.0f), glm::vec3(0.0f, 0.0f, 0.0f));
+        path.addKeyframe(8.0f,  glm::vec3(60.0f, 15.0f, 60.0f),   glm::vec3(0.0f, 0.0f, 0.0f));
+        path.addKeyframe(12.0f, glm::vec3(30.0f, 8.0f, 30.0f),    glm::vec3(20.0f, 6.0f, 15.0f));
+        path.addKeyframe(16.0f, glm::vec3(-40.0f, 10.0f, 50.0f),  glm::vec3(0.0f, 2.0f, 0.0f));
+        path.addKeyframe(20.0f, glm::vec3(0.0f, 100.0f, 300.0f),  glm::vec3(0.0f, 0.0f, 0.0f));
+        return path;
+    }
+
+    float getDuration() const {
+        return keyframes.empty() ? 0.0f : keyframes.back().time;
+    }
+
+    bool isEmpty() const { return keyframes.empty(); }
+
+    // Sample the path at time t (wraps past the end)
+    void evaluate(float t, glm::vec3& position, glm::vec3& target) const {
+        if (keyframes.empty()) return;
+        if (keyframes.size() == 1 || getDuration() <= 0.0f) {
+            position = keyframes.front().position;
+            target = keyframes.front().target;
+            return;
+        }
+
+        t = std::fmod(t, getDuration());
+
+        // Segment [i, i+1] containing t
+        size_t i = 0;
+        while (i + 2 < keyframes.size() && keyframes[i + 1].time <= t) {
+            i++;
+        }
+        const Keyframe& k1 = keyframes[i];
+        const Keyframe& k2 = keyframes[i + 1];
+        const Keyframe& k0 = keyframes[i > 0 ? i - 1 : i];
+        const Keyframe& k3 = keyframes[std::min(i + 2, keyframes.size() - 1)];
+
+        float span = std::max(k2.time - k1.time, 1e-6f);
+        float u = std::clamp((t - k1.time) / span, 0.0f, 1.0f);
+
+        position = catmullRom(k0.position, k1.position, k2.position, k3.position, u);
+        target = catmullRom(k0.target, k1.target, k2.target, k3.target, u);
+    }
+
+private:
+    std::vector<Keyframe> keyframes;
+
+    static glm::vec3 catmullRom(const glm::vec3& p0, const glm::vec3& p1,
+                                const glm::vec3& p2, const glm::vec3& p3, float u) {
+        float u2 = u * u;
+        float u3 = u2 * u;
+        return 0.5f * ((2.0f * p1) +
+                       (-p0 + p2) * u +
+                       (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * u2 +
+                       (-p0 + 3.0f * p1 - 3.0f * p2 + p3) * u3);
+    }
+};
@@ -42,6 +42,7 @@ private:
     
     // Current state
     float currentTime = 0.0f;       // Accumulated time
+    float previousTime = 0.0f;      // currentTime before the latest update (for interpolation)
     float cycleProgress = 0.0f;     // 0.0 to 1.0 (full day)
     
     // Colors
@@ -68,8 +69,9 @@ public:
         orbitRadius = radius;
     }
     
-    // Update with delta time and time scale
+    // Update with delta time and time scale (one fixed simulation tick)
     void update(float deltaTime, float timeScale = 1.0f) {
+        previousTime = currentTime;
         currentTime += deltaTime * timeScale;
         cycleProgress = fmod(currentTime / cycleDuration, 1.0f);
     }
@@ -87,13 +89,16 @@ public:
         return cycleProgress;
     }
     
-    // Calculate current light state
-    LightState getLightState() const {
+    // Calculate light state; alpha < 1 interpolates between the previous
+    // and latest update so a fixed-rate cycle moves smoothly every frame
+    LightState getLightState(float alpha = 1.0f) const {
         LightState state;
+        float progress = alpha >= 1.0f ? cycleProgress
+            : fmod(glm::mix(previousTime, currentTime, alpha) / cycleDuration, 1.0f);
         
         // Convert cycle progress to angle (0 = dawn horizon, 0.5 = dusk horizon)
         // Sun rises from East, sets in West
-        float sunAngle = cycleProgress * glm::two_pi<float>();
+        float sunAngle = progress * glm::two_pi<float>();
         
         // Sun/Moon position calculation
         // Y component = height (sin gives arc motion)
@@ -139,7 +144,7 @@ public:
         }
         
         // Sky color interpolation
-        state.skyColor = calculateSkyColor();
+        state.skyColor = calculateSkyColor(progress);
         
         return state;
     }
@@ -148,38 +153,40 @@ public:
     void setTimeOfDay(float progress) {
         cycleProgress = fmod(progress, 1.0f);
         currentTime = cycleProgress * cycleDuration;
+        previousTime = currentTime;
     }
     
     void reset() {
         currentTime = 0.0f;
+        previousTime = 0.0f;
         cycleProgress = 0.0f;
     }
 
 private:
-    glm::vec3 calculateSkyColor() const {
+    glm::vec3 calculateSkyColor(float progress) const {
         // Smooth transitions between sky colors
-        if (cycleProgress < 0.15f) {
+        if (progress < 0.15f) {
             // Night to Dawn
-            float t = cycleProgress / 0.15f;
+            float t = progress / 0.15f;
             return glm::mix(skyNight, skyDawn, t);
         } 
-        else if (cycleProgress < 0.3f) {
+        else if (progress < 0.3f) {
             // Dawn to Day
-            float t = (cycleProgress - 0.15f) / 0.15f;
+            float t = (progress - 0.15f) / 0.15f;
             return glm::mix(skyDawn, skyDay, t);
         } 
-        else if (cycleProgress < 0.5f) {
+        else if (progress < 0.5f) {
             // Full Day
             return skyDay;
         } 
-        else if (cycleProgress < 0.65f) {
+        else if (progress < 0.65f) {
             // Day to Dusk
-            float t = (cycleProgress - 0.5f) / 0.15f;
+            float t = (progress - 0.5f) / 0.15f;
             return glm::mix(skyDay, skyDusk, t);
         } 
-        else if (cycleProgress < 0.8f) {
+        else if (progress < 0.8f) {
             // Dusk to Night
-            float t = (cycleProgress - 0.65f) / 0.15f;
+            float t = (progress - 0.65f) / 0.15f;
             return glm::mix(skyDusk, skyNight, t);
         }
         // Full Night
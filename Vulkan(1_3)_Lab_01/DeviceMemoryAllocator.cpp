@@ -0,0 +1,345 @@
+#include "DeviceMemoryAllocator.h"
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+
+void DeviceMemoryAllocator::init(VkDevice device, VkPhysicalDevice physicalDevice,
+                                 VkDeviceSize blockSize) {
+    m_device = device;
+    m_physicalDevice = physicalDevice;
+    m_blockSize = blockSize;
+    vkGetPhysicalDeviceMemoryProperties(m_physicalDevice, &m_memoryProperties);
+}
+
+DeviceMemoryAllocator::Allocation DeviceMemoryAllocator::allocate(
+    const VkMemoryRequirements& requirements, Pool pool, bool linearResource) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    uint32_t memoryTypeIndex = findMemoryType(requirements.memoryTypeBits, pool);
+    uint32_t heapIndex = findHeap(pool, memoryTypeIndex, linearResource);
+    Heap& heap = m_heaps[heapIndex];
+
+    const VkDeviceSize alignment = std::max<VkDeviceSize>(requirements.alignment, 1);
+    VkDeviceSize offset = 0;
+    uint32_t blockIndex = UINT32_MAX;
+
+    if (requirements.size > m_blockSize / 2) {
+        // Big resources get their own block instead of fragmenting shared ones
+        blockIndex = createBlock(heap, requirements.size, true);
+        allocateFromBlock(heap.blocks[blockIndex], requirements.size, alignment, offset);
+    }
+    else {
+        // First fit across existing blocks, new block if none has room
+        for (uint32_t i = 0; i < heap.blocks.size(); i++) {
+            Block& block = heap.blocks[i];
+            if (block.memory == VK_NULL_HANDLE || block.dedicated) continue;
+            if (allocateFromBlock(block, requirements.size, alignment, offset)) {
+                blockIndex = i;
+                break;
+            }
+        }
+        if (blockIndex == UINT32_MAX) {
+            blockIndex = createBlock(heap, m_blockSize, false);
+            allocateFromBlock(heap.blocks[blockIndex], requirements.size, alignment, offset);
+        }
+    }
+
+    Block& block = heap.blocks[blockIndex];
+    block.used += requirements.size;
+    block.allocationCount++;
+
+    Allocation allocation;
+    allocation.memory = block.memory;
+    allocation.offset = offset;
+    allocation.size = requirements.size;
+    allocation.mapped = block.mapped ? block.mapped + offset : nullptr;
+    allocation.heapIndex = heapIndex;
+    allocation.blockIndex = blockIndex;
+    return allocation;
+}
+
+void DeviceMemoryAllocator::free(Allocation& allocation) {
+    if (!allocation.valid()) return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    Block& block = m_heaps[allocation.heapIndex].blocks[allocation.blockIndex];
+    block.used -= allocation.size;
+    block.allocationCount--;
+
+    // Insert keeping offset order, then merge with neighbours
+    FreeRange range{ allocation.offset, allocation.size };
+    auto it = std::lower_bound(block.freeRanges.begin(), block.freeRanges.end(), range,
+        [](const FreeRange& a, const FreeRange& b) { return a.offset < b.offset; });
+    it = block.freeRanges.insert(it, range);
+
+    if (std::next(it) != block.freeRanges.end() && it->offset + it->size == std::next(it)->offset) {
+        it->size += std::next(it)->size;
+        block.freeRanges.erase(std::next(it));
+    }
+    if (it != block.freeRanges.begin() && std::prev(it)->offset + std::prev(it)->size == it->offset) {
+        std::prev(it)->size += it->size;
+        block.freeRanges.erase(it);
+    }
+
+    // Dedicated blocks hold exactly one resource: release them right away.
+    // The slot is kept (null) so other allocations' block indices stay valid.
+    if (block.dedicated && block.allocationCount == 0) {
+        vkFreeMemory(m_device, block.memory, nullptr);
+        block = Block{};
+    }
+
+    allocation = Allocation{};
+}
+
+void DeviceMemoryAllocator::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, Pool pool,
+                                         VkBuffer& buffer, Allocation& allocation) {
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = size;
+    bufferInfo.usage = usage;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    if (vkCreateBuffer(m_device, &bufferInfo, nullptr, &buffer) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create buffer!");
+    }
+
+    VkMemoryRequirements memRequirements;
+    vkGetBufferMemoryRequirements(m_device, buffer, &memRequirements);
+
+    allocation = allocate(memRequirements, pool, true);
+    vkBindBufferMemory(m_device, buffer, allocation.memory, allocation.offset);
+}
+
+void DeviceMemoryAllocator::createImage(const VkImageCreateInfo& imageInfo, Pool pool,
+                                        VkImage& image, Allocation& allocation) {
+    if (vkCreateImage(m_device, &imageInfo, nullptr, &image) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create image!");
+    }
+
+    VkMemoryRequirements memRequirements;
+    vkGetImageMemoryRequirements(m_device, image, &memRequirements);
+
+    allocation = allocate(memRequirements, pool, imageInfo.tiling == VK_IMAGE_TILING_LINEAR);
+    vkBindImageMemory(m_device, image, allocation.memory, allocation.offset);
+}
+
+void DeviceMemoryAllocator::destroyBuffer(VkBuffer& buffer, Allocation& allocation) {
+    if (buffer != VK_NULL_HANDLE) {
+        vkDestroyBuffer(m_device, buffer, nullptr);
+        buffer = VK_NULL_HANDLE;
+    }
+    free(allocation);
+}
+
+void DeviceMemoryAllocator::destroyImage(VkImage& image, Allocation& allocation) {
+    if (image != VK_NULL_HANDLE) {
+        vkDestroyImage(m_device, image, nullptr);
+        image = VK_NULL_HANDLE;
+    }
+    free(allocation);
+}
+
+DeviceMemoryAllocator::Stats DeviceMemoryAllocator::getStats(Pool pool) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    Stats stats;
+    VkDeviceSize totalFree = 0;
+    VkDeviceSize largestFreeSum = 0;
+    for (const Heap& heap : m_heaps) {
+        if (heap.pool == pool) accumulateStats(heap, stats, totalFree, largestFreeSum);
+    }
+    stats.fragmentation = fragmentation(totalFree, largestFreeSum);
+    return stats;
+}
+
+DeviceMemoryAllocator::Stats DeviceMemoryAllocator::getTotalStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    Stats stats;
+    VkDeviceSize totalFree = 0;
+    VkDeviceSize largestFreeSum = 0;
+    for (const Heap& heap : m_heaps) {
+        accumulateStats(heap, stats, totalFree, largestFreeSum);
+    }
+    stats.fragmentation = fragmentation(totalFree, largestFreeSum);
+    return stats;
+}
+
+void DeviceMemoryAllocator::printStats() const {
+    const double mb = 1024.0 * 1024.0;
+    for (uint32_t p = 0; p < static_cast<uint32_t>(Pool::Count); p++) {
+        Pool pool = static_cast<Pool>(p);
+        Stats stats = getStats(pool);
+        std::cout << "GPU memory [" << poolName(pool) << "]: "
+            << stats.allocationCount << " allocations in " << stats.blockCount << " blocks, "
+            << stats.bytesUsed / mb << " / " << stats.bytesReserved / mb << " MB used, "
+            << "fragmentation " << stats.fragmentation * 100.0f << "%\n";
+    }
+}
+
+void DeviceMemoryAllocator::cleanup() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (Heap& heap : m_heaps) {
+        for (Block& block : heap.blocks) {
+            if (block.memory != VK_NULL_HANDLE) {
+                if (block.allocationCount > 0) {
+                    std::cerr << "DeviceMemoryAllocator: " << block.allocationCount
+                        << " allocations still live in " << poolName(heap.pool) << " block\n";
+                }
+                vkFreeMemory(m_device, block.memory, nullptr);  // Unmaps implicitly
+            }
+        }
+    }
+    m_heaps.clear();
+}
+
+// Private helper implementations
+
+uint32_t DeviceMemoryAllocator::findHeap(Pool pool, uint32_t memoryTypeIndex, bool linear) {
+    for (uint32_t i = 0; i < m_heaps.size(); i++) {
+        const Heap& heap = m_heaps[i];
+        if (heap.pool == pool && heap.memoryTypeIndex == memoryTypeIndex && heap.linear == linear) {
+            return i;
+        }
+    }
+
+    Heap heap;
+    heap.pool = pool;
+    heap.memoryTypeIndex = memoryTypeIndex;
+    heap.linear = linear;
+    m_heaps.push_back(std::move(heap));
+    return static_cast<uint32_t>(m_heaps.size() - 1);
+}
+
+uint32_t DeviceMemoryAllocator::findMemoryType(uint32_t typeFilter, Pool pool) const {
+    VkMemoryPropertyFlags required = 0;
+    VkMemoryPropertyFlags avoided = 0;
+
+    switch (pool) {
+        case Pool::DeviceLocal:
+            required = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+            break;
+        case Pool::HostVisible:
+            required = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+            break;
+        case Pool::Staging:
+            // Plain system memory: keep scarce device-local host-visible memory free
+            required = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+            avoided = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+            break;
+        default:
+            break;
+    }
+
+    // First pass honours the "avoided" preference, second pass drops it
+    for (int pass = 0; pass < 2; pass++) {
+        for (uint32_t i = 0; i < m_memoryProperties.memoryTypeCount; i++) {
+            VkMemoryPropertyFlags flags = m_memoryProperties.memoryTypes[i].propertyFlags;
+            if ((typeFilter & (1u << i)) &&
+                (flags & required) == required &&
+                (pass == 1 || (flags & avoided) == 0)) {
+                return i;
+            }
+        }
+    }
+
+    throw std::runtime_error("Failed to find suitable memory type!");
+}
+
+bool DeviceMemoryAllocator::allocateFromBlock(Block& block, VkDeviceSize size,
+                                              VkDeviceSize alignment, VkDeviceSize& offset) {
+    for (size_t i = 0; i < block.freeRanges.size(); i++) {
+        FreeRange range = block.freeRanges[i];
+        VkDeviceSize aligned = (range.offset + alignment - 1) / alignment * alignment;
+        VkDeviceSize padding = aligned - range.offset;
+        if (padding + size > range.size) continue;
+
+        // Split: [padding][allocation][tail] - padding and tail stay free
+        VkDeviceSize tail = range.size - padding - size;
+        block.freeRanges.erase(block.freeRanges.begin() + i);
+        if (tail > 0) {
+            block.freeRanges.insert(block.freeRanges.begin() + i, FreeRange{ aligned + size, tail });
+        }
+        if (padding > 0) {
+            block.freeRanges.insert(block.freeRanges.begin() + i, FreeRange{ range.offset, padding });
+        }
+
+        offset = aligned;
+        return true;
+    }
+    return false;
+}
+
+uint32_t DeviceMemoryAllocator::createBlock(Heap& heap, VkDeviceSize size, bool dedicated) {
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = size;
+    allocInfo.memoryTypeIndex = heap.memoryTypeIndex;
+
+    Block block;
+    block.size = size;
+    block.dedicated = dedicated;
+    block.freeRanges.push_back(FreeRange{ 0, size });
+
+    if (vkAllocateMemory(m_device, &allocInfo, nullptr, &block.memory) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to allocate device memory block!");
+    }
+
+    // Host-visible blocks stay mapped for their whole lifetime
+    VkMemoryPropertyFlags flags = m_memoryProperties.memoryTypes[heap.memoryTypeIndex].propertyFlags;
+    if (flags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+        void* mapped = nullptr;
+        if (vkMapMemory(m_device, block.memory, 0, VK_WHOLE_SIZE, 0, &mapped) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to map device memory block!");
+        }
+        block.mapped = static_cast<uint8_t*>(mapped);
+    }
+
+    // Reuse a released dedicated slot before growing the list
+    for (uint32_t i = 0; i < heap.blocks.size(); i++) {
+        if (heap.blocks[i].memory == VK_NULL_HANDLE) {
+            heap.blocks[i] = std::move(block);
+            return i;
+        }
+    }
+    heap.blocks.push_back(std::move(block));
+    return static_cast<uint32_t>(heap.blocks.size() - 1);
+}
+
+void DeviceMemoryAllocator::accumulateStats(const Heap& heap, Stats& stats,
+                                            VkDeviceSize& totalFree, VkDeviceSize& largestFreeSum) const {
+    for (const Block& block : heap.blocks) {
+        if (block.memory == VK_NULL_HANDLE) continue;
+
+        VkDeviceSize largestInBlock = 0;
+        stats.blockCount++;
+        stats.allocationCount += block.allocationCount;
+        stats.bytesReserved += block.size;
+        stats.bytesUsed += block.used;
+        stats.freeRangeCount += static_cast<uint32_t>(block.freeRanges.size());
+        for (const FreeRange& range : block.freeRanges) {
+            totalFree += range.size;
+            largestInBlock = std::max(largestInBlock, range.size);
+        }
+        largestFreeSum += largestInBlock;
+        stats.largestFreeRange = std::max(stats.largestFreeRange, largestInBlock);
+    }
+}
+
+float DeviceMemoryAllocator::fragmentation(VkDeviceSize totalFree, VkDeviceSize largestFreeSum) {
+    // Share of free memory that is not in its block's largest free range
+    if (totalFree == 0) return 0.0f;
+    return 1.0f - static_cast<float>(largestFreeSum) / static_cast<float>(totalFree);
+}
+
+const char* DeviceMemoryAllocator::poolName(Pool pool) {
+    switch (pool) {
+        case Pool::DeviceLocal: return "device-local";
+        case Pool::HostVisible: return "host-visible";
+        case Pool::Staging:     return "staging";
+        default:                return "unknown";
+    }
+}
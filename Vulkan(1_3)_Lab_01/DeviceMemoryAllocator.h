@@ -0,0 +1,173 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Block-based GPU memory sub-allocator
+ * 
+ * Role: Replace one vkAllocateMemory per resource with a few large blocks
+ *       that buffers and images are placed into
+ * Responsibilities:
+ * - Reserve large blocks per memory type and sub-allocate from them
+ * - Honour each resource's alignment requirement
+ * - Keep device-local, host-visible and staging memory in separate pools
+ * - Map host-visible blocks once and hand out CPU pointers per allocation
+ * - Report bytes used and fragmentation per pool
+ * 
+ * Design Notes:
+ * - Each block keeps an offset-sorted free list; frees merge neighbours
+ * - Buffers and optimal-tiling images live in different blocks, so
+ *   bufferImageGranularity never has to be padded for
+ * - Requests larger than half a block get a dedicated block, released
+ *   as soon as it is freed
+ * - Staging is its own pool so short-lived upload buffers do not
+ *   fragment the long-lived host-visible blocks
+ * - One mutex guards all state; allocation is not a per-frame operation
+ */
+class DeviceMemoryAllocator {
+public:
+    /**
+     * @brief Memory pool a resource is placed in
+     */
+    enum class Pool : uint32_t {
+        DeviceLocal,   // GPU-only resources (vertex/index buffers, images)
+        HostVisible,   // Long-lived CPU-written buffers (uniforms, rings)
+        Staging,       // Short-lived upload sources
+        Count
+    };
+
+    /**
+     * @brief One sub-allocation (bind with memory + offset)
+     */
+    struct Allocation {
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkDeviceSize offset = 0;
+        VkDeviceSize size = 0;
+        void* mapped = nullptr;    // Persistent CPU pointer (host-visible pools only)
+
+        bool valid() const { return memory != VK_NULL_HANDLE; }
+
+    private:
+        friend class DeviceMemoryAllocator;
+        uint32_t heapIndex = UINT32_MAX;
+        uint32_t blockIndex = UINT32_MAX;
+    };
+
+    /**
+     * @brief Usage summary for one pool (or all pools)
+     */
+    struct Stats {
+        uint32_t blockCount = 0;
+        uint32_t allocationCount = 0;
+        uint32_t freeRangeCount = 0;
+        VkDeviceSize bytesReserved = 0;     // Sum of block sizes
+        VkDeviceSize bytesUsed = 0;         // Sum of live allocations
+        VkDeviceSize largestFreeRange = 0;
+        float fragmentation = 0.0f;         // 0 = every block's free space is one range
+    };
+
+    DeviceMemoryAllocator() = default;
+    ~DeviceMemoryAllocator() = default;
+
+    // Non-copyable
+    DeviceMemoryAllocator(const DeviceMemoryAllocator&) = delete;
+    DeviceMemoryAllocator& operator=(const DeviceMemoryAllocator&) = delete;
+
+    /**
+     * @brief Initialize with Vulkan handles
+     * @param blockSize Size of each regular block (default 64 MB)
+     */
+    void init(VkDevice device, VkPhysicalDevice physicalDevice,
+              VkDeviceSize blockSize = 64ull * 1024 * 1024);
+
+    /**
+     * @brief Sub-allocate memory matching the requirements
+     * @param linearResource true for buffers, false for optimal-tiling images
+     */
+    Allocation allocate(const VkMemoryRequirements& requirements, Pool pool, bool linearResource);
+
+    /**
+     * @brief Return an allocation to its block (resets it)
+     */
+    void free(Allocation& allocation);
+
+    /**
+     * @brief Create a buffer and bind it to a sub-allocation
+     */
+    void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, Pool pool,
+                      VkBuffer& buffer, Allocation& allocation);
+
+    /**
+     * @brief Create an image and bind it to a sub-allocation
+     */
+    void createImage(const VkImageCreateInfo& imageInfo, Pool pool,
+                     VkImage& image, Allocation& allocation);
+
+    void destroyBuffer(VkBuffer& buffer, Allocation& allocation);
+    void destroyImage(VkImage& image, Allocation& allocation);
+
+    /**
+     * @brief Query usage for a single pool
+     */
+    Stats getStats(Pool pool) const;
+
+    /**
+     * @brief Query usage across all pools
+     */
+    Stats getTotalStats() const;
+
+    /**
+     * @brief Print per-pool usage to stdout
+     */
+    void printStats() const;
+
+    /**
+     * @brief Free every block (all resources must already be destroyed)
+     */
+    void cleanup();
+
+private:
+    struct FreeRange {
+        VkDeviceSize offset = 0;
+        VkDeviceSize size = 0;
+    };
+
+    struct Block {
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkDeviceSize size = 0;
+        VkDeviceSize used = 0;
+        uint8_t* mapped = nullptr;
+        uint32_t allocationCount = 0;
+        bool dedicated = false;
+        std::vector<FreeRange> freeRanges;  // Sorted by offset
+    };
+
+    struct Heap {
+        Pool pool = Pool::DeviceLocal;
+        uint32_t memoryTypeIndex = 0;
+        bool linear = true;
+        std::vector<Block> blocks;
+    };
+
+    VkDevice m_device = VK_NULL_HANDLE;
+    VkPhysicalDevice m_physicalDevice = VK_NULL_HANDLE;
+    VkPhysicalDeviceMemoryProperties m_memoryProperties{};
+    VkDeviceSize m_blockSize = 0;
+
+    std::vector<Heap> m_heaps;
+    mutable std::mutex m_mutex;
+
+    uint32_t findHeap(Pool pool, uint32_t memoryTypeIndex, bool linear);
+    uint32_t findMemoryType(uint32_t typeFilter, Pool pool) const;
+    bool allocateFromBlock(Block& block, VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset);
+    uint32_t createBlock(Heap& heap, VkDeviceSize size, bool dedicated);
+    void accumulateStats(const Heap& heap, Stats& stats,
+                         VkDeviceSize& totalFree, VkDeviceSize& largestFreeSum) const;
+    static float fragmentation(VkDeviceSize totalFree, VkDeviceSize largestFreeSum);
+
+    static const char* poolName(Pool pool);
+};
@@ -0,0 +1,46 @@
+#include "DynamicUploadRing.h"
+
+void DynamicUploadRing::init(DeviceMemoryAllocator& allocator,
+                             VkDeviceSize bytesPerFrame, uint32_t frameCount,
+                             VkBufferUsageFlags usage) {
+    m_allocator = &allocator;
+    m_frameCount = frameCount;
+
+    // Keep every region start 256-byte aligned (covers any binding offset rule)
+    const VkDeviceSize regionAlignment = 256;
+    m_frameSize = (bytesPerFrame + regionAlignment - 1) & ~(regionAlignment - 1);
+
+    // HostVisible pool blocks are mapped for their lifetime (coherent: no flushes)
+    m_allocator->createBuffer(m_frameSize * m_frameCount, usage,
+        DeviceMemoryAllocator::Pool::HostVisible, m_buffer, m_allocation);
+    m_mapped = static_cast<uint8_t*>(m_allocation.mapped);
+
+    beginFrame(0);
+}
+
+void DynamicUploadRing::beginFrame(uint32_t frameIndex) {
+    m_frameBase = m_frameSize * (frameIndex % m_frameCount);
+    m_head = m_frameBase;
+}
+
+DynamicUploadRing::Allocation DynamicUploadRing::allocate(VkDeviceSize size, VkDeviceSize alignment) {
+    Allocation allocation;
+
+    VkDeviceSize offset = (m_head + alignment - 1) / alignment * alignment;
+    if (size == 0 || offset + size > m_frameBase + m_frameSize) {
+        return allocation;  // Region exhausted - caller skips this upload
+    }
+
+    allocation.data = m_mapped + offset;
+    allocation.offset = offset;
+    allocation.size = size;
+    m_head = offset + size;
+    return allocation;
+}
+
+void DynamicUploadRing::cleanup() {
+    if (m_allocator) {
+        m_allocator->destroyBuffer(m_buffer, m_allocation);
+    }
+    m_mapped = nullptr;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include "DeviceMemoryAllocator.h"
+
+/**
+ * @brief Persistently mapped ring buffer for per-frame dynamic GPU data
+ * 
+ * Role: Give the CPU a place to write data that changes every frame
+ *       (particle instances, etc.) without map/unmap or staging copies
+ * Responsibilities:
+ * - Own one host-visible buffer, placed in the allocator's persistently
+ *   mapped HostVisible pool
+ * - Partition it into one region per frame in flight
+ * - Hand out aligned sub-allocations (pointer + offset) from the
+ *   current frame's region
+ * 
+ * Design Notes:
+ * - A region is only reset in beginFrame(), which the caller invokes
+ *   after waiting on that frame's fence, so the GPU is never reading
+ *   memory the CPU is overwriting
+ * - Linear (bump) allocation inside a region: O(1), no per-frame frees
+ * - Offsets are passed straight to vkCmdBindVertexBuffers
+ */
+class DynamicUploadRing {
+public:
+    /**
+     * @brief One sub-allocation from the current frame's region
+     */
+    struct Allocation {
+        void* data = nullptr;        // CPU write pointer (nullptr if out of space)
+        VkDeviceSize offset = 0;     // Offset into getBuffer() for binding
+        VkDeviceSize size = 0;
+    };
+
+    DynamicUploadRing() = default;
+    ~DynamicUploadRing() = default;
+
+    // Non-copyable
+    DynamicUploadRing(const DynamicUploadRing&) = delete;
+    DynamicUploadRing& operator=(const DynamicUploadRing&) = delete;
+
+    /**
+     * @brief Create and map the ring
+     * @param bytesPerFrame Capacity of each frame's region
+     * @param frameCount Number of frames in flight
+     * @param usage Buffer usage (e.g. VK_BUFFER_USAGE_VERTEX_BUFFER_BIT)
+     */
+    void init(DeviceMemoryAllocator& allocator,
+              VkDeviceSize bytesPerFrame, uint32_t frameCount,
+              VkBufferUsageFlags usage);
+
+    /**
+     * @brief Start writing into a frame's region, discarding its old contents
+     * Call only after that frame's fence has signalled
+     */
+    void beginFrame(uint32_t frameIndex);
+
+    /**
+     * @brief Sub-allocate from the current frame's region
+     * @return Allocation with data == nullptr if the region is exhausted
+     */
+    Allocation allocate(VkDeviceSize size, VkDeviceSize alignment = 16);
+
+    /**
+     * @brief Destroy the buffer and return its memory to the allocator
+     */
+    void cleanup();
+
+    VkBuffer getBuffer() const { return m_buffer; }
+    VkDeviceSize getFrameCapacity() const { return m_frameSize; }
+    VkDeviceSize getFrameUsage() const { return m_head - m_frameBase; }
+
+private:
+    DeviceMemoryAllocator* m_allocator = nullptr;
+
+    VkBuffer m_buffer = VK_NULL_HANDLE;
+    DeviceMemoryAllocator::Allocation m_allocation;
+    uint8_t* m_mapped = nullptr;
+
+    VkDeviceSize m_frameSize = 0;
+    uint32_t m_frameCount = 0;
+    VkDeviceSize m_frameBase = 0;    // Start of current frame's region
+    VkDeviceSize m_head = 0;         // Next free byte in current region
+};
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+/**
+ * @brief Fixed-rate simulation clock driven by variable frame times
+ *
+ * Role: Decouple simulation rate from render rate
+ * Responsibilities:
+ * - Accumulate frame time and turn it into a whole number of fixed ticks
+ * - Clamp the ticks run per frame so one hitch can't snowball
+ * - Report how far the frame is between the last two ticks (alpha), so
+ *   rendering can interpolate simulation state
+ *
+ * Design Notes:
+ * - Every tick integrates exactly getTick() seconds, so simulation results
+ *   no longer depend on the frame rate and one long frame can't produce a
+ *   huge (unstable) integration step
+ * - Time beyond maxSteps ticks is dropped: after a hitch the simulation
+ *   slows down for a frame instead of running ever more ticks to catch up
+ * - The accumulator is double precision and a tick is taken within a small
+ *   tolerance, so a frame time equal to the tick (benchmark fixedDelta)
+ *   always yields exactly one tick
+ */
+class FixedTimestep {
+public:
+    explicit FixedTimestep(float tickSeconds = 1.0f / 60.0f, uint32_t maxSteps = 5) {
+        configure(tickSeconds, maxSteps);
+    }
+
+    void configure(float tickSeconds, uint32_t maxSteps) {
+        m_tick = std::max(static_cast<double>(tickSeconds), 1e-4);
+        m_maxSteps = std::max(maxSteps, 1u);
+        m_accumulator = 0.0;
+    }
+
+    /**
+     * @brief Add one frame's time and return the ticks to run for it
+     * @param frameSeconds Elapsed (optionally time-scaled) seconds, negative treated as 0
+     */
+    uint32_t advance(float frameSeconds) {
+        m_accumulator += std::max(static_cast<double>(frameSeconds), 0.0);
+
+        uint32_t steps = 0;
+        while (m_accumulator >= m_tick - TOLERANCE * m_tick && steps < m_maxSteps) {
+            m_accumulator -= m_tick;
+            steps++;
+        }
+
+        // Clamped: drop whole ticks, keep the fraction so alpha stays continuous
+        if (m_accumulator >= m_tick) {
+            double kept = std::fmod(m_accumulator, m_tick);
+            m_droppedSeconds += m_accumulator - kept;
+            m_accumulator = kept;
+        }
+
+        m_tickCount += steps;
+        return steps;
+    }
+
+    float getTick() const { return static_cast<float>(m_tick); }
+    uint32_t getMaxSteps() const { return m_maxSteps; }
+    uint64_t getTickCount() const { return m_tickCount; }           // Ticks since construction
+    double getDroppedSeconds() const { return m_droppedSeconds; }   // Time lost to the clamp
+
+    // [0, 1): fraction of a tick the render time is past the latest tick
+    float getAlpha() const {
+        return static_cast<float>(std::clamp(m_accumulator / m_tick, 0.0, 1.0));
+    }
+
+private:
+    static constexpr double TOLERANCE = 1e-6;   // Relative to the tick
+
+    double m_tick = 1.0 / 60.0;
+    double m_accumulator = 0.0;
+    uint32_t m_maxSteps = 5;
+    uint64_t m_tickCount = 0;
+    double m_droppedSeconds = 0.0;
+};
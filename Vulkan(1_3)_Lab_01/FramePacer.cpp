@@ -0,0 +1,122 @@
+#include "FramePacer.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <timeapi.h>
+#pragma comment(lib, "winmm.lib")
+#endif
+
+FramePacer::~FramePacer() {
+    setFrameCap(0.0f);   // Releases the high-resolution timer
+}
+
+void FramePacer::init(uint32_t framesInFlight, float frameCap) {
+    m_slots.assign(framesInFlight, Slot{});
+    setFrameCap(frameCap);
+}
+
+void FramePacer::setFrameCap(float frameCap) {
+    m_frameCap = std::max(frameCap, 0.0f);
+    m_framePeriod = m_frameCap > 0.0f
+        ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / m_frameCap))
+        : Clock::duration{ 0 };
+    m_nextDeadline = {};
+
+    // The default Windows timer tick (~15.6 ms) would make every sleep overshoot
+    bool wantTimer = m_frameCap > 0.0f;
+#ifdef _WIN32
+    if (wantTimer && !m_highResolutionTimer) timeBeginPeriod(1);
+    if (!wantTimer && m_highResolutionTimer) timeEndPeriod(1);
+#endif
+    m_highResolutionTimer = wantTimer;
+}
+
+void FramePacer::waitForNextFrame() {
+    if (m_framePeriod.count() == 0) return;
+
+    Clock::time_point now = Clock::now();
+    if (m_nextDeadline == Clock::time_point{} || now - m_nextDeadline > m_framePeriod) {
+        // First frame, or too late to keep the old schedule
+        m_nextDeadline = now;
+    }
+    else {
+        if (m_nextDeadline - now > SPIN_MARGIN) {
+            std::this_thread::sleep_until(m_nextDeadline - SPIN_MARGIN);
+        }
+        while (Clock::now() < m_nextDeadline) {
+            std::this_thread::yield();
+        }
+    }
+    m_nextDeadline += m_framePeriod;
+}
+
+void FramePacer::markInputSampled(uint32_t frame) {
+    m_slots[frame].inputTime = Clock::now();
+}
+
+void FramePacer::markSubmitted(uint32_t frame) {
+    Slot& slot = m_slots[frame];
+    Profiler::instance().recordLatency("Latency: input to submit", slot.inputTime, Clock::now());
+    slot.awaitingGpu = true;
+}
+
+void FramePacer::markGpuComplete(uint32_t frame) {
+    Slot& slot = m_slots[frame];
+    if (!slot.awaitingGpu) return;
+
+    Profiler::instance().recordLatency("Latency: input to GPU done", slot.inputTime, Clock::now());
+    slot.awaitingGpu = false;
+}
+
+bool FramePacer::parsePresentMode(const std::string& name, PresentMode& mode) {
+    for (PresentMode candidate : { PresentMode::Fifo, PresentMode::FifoRelaxed, PresentMode::Mailbox, PresentMode::Immediate }) {
+        if (name == getName(candidate)) {
+            mode = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* FramePacer::getName(PresentMode mode) {
+    switch (mode) {
+        case PresentMode::Fifo:        return "fifo";
+        case PresentMode::FifoRelaxed: return "fifo-relaxed";
+        case PresentMode::Mailbox:     return "mailbox";
+        case PresentMode::Immediate:   return "immediate";
+    }
+    return "fifo";
+}
+
+FramePacer::PresentMode FramePacer::next(PresentMode mode) {
+    switch (mode) {
+        case PresentMode::Fifo:        return PresentMode::FifoRelaxed;
+        case PresentMode::FifoRelaxed: return PresentMode::Mailbox;
+        case PresentMode::Mailbox:     return PresentMode::Immediate;
+        case PresentMode::Immediate:   return PresentMode::Fifo;
+    }
+    return PresentMode::Fifo;
+}
+
+VkPresentModeKHR FramePacer::toVulkan(PresentMode mode) {
+    switch (mode) {
+        case PresentMode::Fifo:        return VK_PRESENT_MODE_FIFO_KHR;
+        case PresentMode::FifoRelaxed: return VK_PRESENT_MODE_FIFO_RELAXED_KHR;
+        case PresentMode::Mailbox:     return VK_PRESENT_MODE_MAILBOX_KHR;
+        case PresentMode::Immediate:   return VK_PRESENT_MODE_IMMEDIATE_KHR;
+    }
+    return VK_PRESENT_MODE_FIFO_KHR;
+}
+
+VkPresentModeKHR FramePacer::choosePresentMode(PresentMode requested, const std::vector<VkPresentModeKHR>& available) {
+    VkPresentModeKHR mode = toVulkan(requested);
+    if (std::find(available.begin(), available.end(), mode) != available.end()) {
+        return mode;
+    }
+    return VK_PRESENT_MODE_FIFO_KHR;   // The only mode the spec guarantees
+}
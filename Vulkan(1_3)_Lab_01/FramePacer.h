@@ -0,0 +1,95 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Presentation policy, frame cap and input latency tracking
+ *
+ * Role: Let a deployment trade input latency against power draw
+ * Responsibilities:
+ * - Map a requested present mode to one the surface supports
+ * - Optionally cap the frame rate by sleeping until each frame's deadline
+ * - Time every frame slot from input sampling to submit and to GPU
+ *   completion, and report both spans to the Profiler
+ *
+ * Design Notes:
+ * - The cap sleeps coarsely, then yields for the last SPIN_MARGIN so the
+ *   deadline is hit despite OS timer granularity; a frame that is more
+ *   than one period late re-anchors the schedule instead of bursting
+ * - GPU completion is observed on the CPU (fence wait or fence poll), so
+ *   "input to GPU done" is an upper bound quantized to where we look.
+ *   Scan-out time needs VK_KHR_present_wait and is not measured
+ * - Frames in flight is fixed at startup: every per-frame resource is
+ *   sized from it, so changing it would mean rebuilding them all
+ */
+class FramePacer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class PresentMode {
+        Fifo,           // Vsync, never tears, always supported
+        FifoRelaxed,    // Vsync, tears instead of waiting when a frame is late
+        Mailbox,        // Newest frame replaces the queued one: low latency, no tearing
+        Immediate       // No vsync: lowest latency, tears
+    };
+
+    FramePacer() = default;
+    ~FramePacer();
+
+    // Non-copyable
+    FramePacer(const FramePacer&) = delete;
+    FramePacer& operator=(const FramePacer&) = delete;
+
+    /**
+     * @param framesInFlight Frame slots whose latency is tracked
+     * @param frameCap Frames per second to pace to (0 = uncapped)
+     */
+    void init(uint32_t framesInFlight, float frameCap);
+
+    void setFrameCap(float frameCap);
+    float getFrameCap() const { return m_frameCap; }
+
+    /**
+     * @brief Sleep until the next frame may start (returns at once when uncapped)
+     */
+    void waitForNextFrame();
+
+    /**
+     * @brief Latency markers for one frame slot, in frame order
+     * markGpuComplete is a no-op unless the slot was submitted and not yet reported
+     */
+    void markInputSampled(uint32_t frame);
+    void markSubmitted(uint32_t frame);
+    void markGpuComplete(uint32_t frame);
+    bool isAwaitingGpu(uint32_t frame) const { return m_slots[frame].awaitingGpu; }
+
+    // Present mode names as used on the command line: fifo, fifo-relaxed, mailbox, immediate
+    static bool parsePresentMode(const std::string& name, PresentMode& mode);
+    static const char* getName(PresentMode mode);
+    static PresentMode next(PresentMode mode);
+
+    /**
+     * @brief The requested mode if the surface supports it, otherwise FIFO
+     */
+    static VkPresentModeKHR choosePresentMode(PresentMode requested, const std::vector<VkPresentModeKHR>& available);
+
+private:
+    static constexpr std::chrono::microseconds SPIN_MARGIN{ 2000 };
+
+    struct Slot {
+        Clock::time_point inputTime{};
+        bool awaitingGpu = false;
+    };
+
+    std::vector<Slot> m_slots;
+    float m_frameCap = 0.0f;
+    Clock::duration m_framePeriod{ 0 };
+    Clock::time_point m_nextDeadline{};
+    bool m_highResolutionTimer = false;     // Windows: timeBeginPeriod(1) is active
+
+    static VkPresentModeKHR toVulkan(PresentMode mode);
+};
@@ -28,6 +28,30 @@ void InputHandler::keyCallback(GLFWwindow* window, int key, int scancode, int ac
             case GLFW_KEY_F4:
                 if (handler->m_onParticleEffect) handler->m_onParticleEffect();
                 break;
+            case GLFW_KEY_F5:
+                if (handler->m_onProfilerReport) handler->m_onProfilerReport();
+                break;
+            case GLFW_KEY_F6:
+                if (handler->m_onProfilerCapture) handler->m_onProfilerCapture();
+                break;
+            case GLFW_KEY_F7:
+                if (handler->m_onToggleGpuCulling) handler->m_onToggleGpuCulling();
+                break;
+            case GLFW_KEY_F8:
+                if (handler->m_onToggleMeshShaders) handler->m_onToggleMeshShaders();
+                break;
+            case GLFW_KEY_F9:
+                if (handler->m_onToggleShading) handler->m_onToggleShading();
+                break;
+            case GLFW_KEY_F10:
+                if (handler->m_onToggleDepthPrepass) handler->m_onToggleDepthPrepass();
+                break;
+            case GLFW_KEY_F11:
+                if (handler->m_onToggleParticleSort) handler->m_onToggleParticleSort();
+                break;
+            case GLFW_KEY_F12:
+                if (handler->m_onCyclePresentMode) handler->m_onCyclePresentMode();
+                break;
             case GLFW_KEY_T:
                 if (mods & GLFW_MOD_SHIFT) {
                     if (handler->m_onTimeIncrease) handler->m_onTimeIncrease();
@@ -27,6 +27,14 @@ public:
     void onParticleEffect(KeyCallback callback) { m_onParticleEffect = callback; }
     void onTimeDecrease(KeyCallback callback) { m_onTimeDecrease = callback; }
     void onTimeIncrease(KeyCallback callback) { m_onTimeIncrease = callback; }
+    void onProfilerReport(KeyCallback callback) { m_onProfilerReport = callback; }
+    void onProfilerCapture(KeyCallback callback) { m_onProfilerCapture = callback; }
+    void onToggleGpuCulling(KeyCallback callback) { m_onToggleGpuCulling = callback; }
+    void onToggleMeshShaders(KeyCallback callback) { m_onToggleMeshShaders = callback; }
+    void onToggleShading(KeyCallback callback) { m_onToggleShading = callback; }
+    void onToggleDepthPrepass(KeyCallback callback) { m_onToggleDepthPrepass = callback; }
+    void onToggleParticleSort(KeyCallback callback) { m_onToggleParticleSort = callback; }
+    void onCyclePresentMode(KeyCallback callback) { m_onCyclePresentMode = callback; }
 
     // Camera movement callbacks
     void onRotateLeft(KeyCallback callback) { m_onRotateLeft = callback; }
@@ -49,6 +57,14 @@ private:
     KeyCallback m_onParticleEffect;
     KeyCallback m_onTimeDecrease;
     KeyCallback m_onTimeIncrease;
+    KeyCallback m_onProfilerReport;
+    KeyCallback m_onProfilerCapture;
+    KeyCallback m_onToggleGpuCulling;
+    KeyCallback m_onToggleMeshShaders;
+    KeyCallback m_onToggleShading;
+    KeyCallback m_onToggleDepthPrepass;
+    KeyCallback m_onToggleParticleSort;
+    KeyCallback m_onCyclePresentMode;
     std::unordered_map<int, KeyCallback> m_cameraSwitchCallbacks;
 
     // Continuous (held) callbacks
@@ -0,0 +1,141 @@
+#include "JobSystem.h"
+#include <algorithm>
+
+thread_local uint32_t JobSystem::t_queueIndex = 0;
+
+void JobSystem::init(uint32_t workerCount) {
+    if (m_running.load()) return;
+
+    if (workerCount == 0) {
+        uint32_t hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = std::max(1u, hardwareThreads > 1 ? hardwareThreads - 1 : 1u);
+    }
+
+    // One queue per thread, including the calling thread (index 0)
+    m_queues.clear();
+    for (uint32_t i = 0; i <= workerCount; i++) {
+        m_queues.push_back(std::make_unique<WorkQueue>());
+    }
+
+    t_queueIndex = 0;
+    m_running.store(true);
+
+    m_workers.reserve(workerCount);
+    for (uint32_t i = 1; i <= workerCount; i++) {
+        m_workers.emplace_back(&JobSystem::workerLoop, this, i);
+    }
+}
+
+void JobSystem::shutdown() {
+    if (!m_running.load()) return;
+
+    // Drain outstanding work so no counter is left pending
+    while (runOne(t_queueIndex)) {}
+
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_running.store(false);
+    }
+    m_wakeCondition.notify_all();
+
+    for (std::thread& worker : m_workers) {
+        worker.join();
+    }
+    m_workers.clear();
+    m_queues.clear();
+}
+
+void JobSystem::submit(Counter& counter, Job job) {
+    counter.pending.fetch_add(1, std::memory_order_relaxed);
+    push(Task{ std::move(job), &counter });
+}
+
+void JobSystem::parallelFor(Counter& counter, uint32_t count, uint32_t chunkSize, RangeJob job) {
+    if (count == 0) return;
+    chunkSize = std::max(1u, chunkSize);
+
+    // Shared by all chunks, so the callable is copied once, not per chunk
+    auto shared = std::make_shared<RangeJob>(std::move(job));
+
+    for (uint32_t begin = 0; begin < count; begin += chunkSize) {
+        uint32_t end = std::min(count, begin + chunkSize);
+        submit(counter, [shared, begin, end]() { (*shared)(begin, end); });
+    }
+}
+
+void JobSystem::wait(Counter& counter) {
+    while (!counter.done()) {
+        if (!runOne(t_queueIndex)) {
+            // Remaining jobs are running on other threads
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::workerLoop(uint32_t queueIndex) {
+    t_queueIndex = queueIndex;
+
+    while (m_running.load(std::memory_order_acquire)) {
+        if (runOne(queueIndex)) continue;
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wakeCondition.wait(lock, [this]() {
+            return !m_running.load() || m_queuedTasks.load() > 0;
+        });
+    }
+}
+
+bool JobSystem::runOne(uint32_t queueIndex) {
+    Task task;
+    if (!popLocal(queueIndex, task) && !steal(queueIndex, task)) {
+        return false;
+    }
+
+    m_queuedTasks.fetch_sub(1, std::memory_order_relaxed);
+    task.job();
+    task.counter->pending.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+bool JobSystem::popLocal(uint32_t queueIndex, Task& task) {
+    WorkQueue& queue = *m_queues[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+
+    // LIFO for the owner: most recently pushed data is still in cache
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool JobSystem::steal(uint32_t thiefIndex, Task& task) {
+    const uint32_t queueCount = static_cast<uint32_t>(m_queues.size());
+
+    // Start at the neighbour so thieves spread across victims
+    for (uint32_t i = 1; i < queueCount; i++) {
+        WorkQueue& victim = *m_queues[(thiefIndex + i) % queueCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.tasks.empty()) continue;
+
+        // FIFO for thieves: take the oldest job
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::push(Task task) {
+    {
+        WorkQueue& queue = *m_queues[t_queueIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+
+    {
+        // Increment under the sleep mutex so a worker cannot miss the wake-up
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_queuedTasks.fetch_add(1, std::memory_order_relaxed);
+    }
+    m_wakeCondition.notify_one();
+}
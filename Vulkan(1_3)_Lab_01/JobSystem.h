@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Small work-stealing job system for per-frame CPU work
+ * 
+ * Role: Spread independent per-frame tasks (particle emitters, chunks
+ *       of large emitters) across all cores
+ * Responsibilities:
+ * - Own a fixed set of worker threads (one per core minus the caller)
+ * - Give every thread its own job queue; idle threads steal from others
+ * - Track completion through counters that callers can wait on
+ * 
+ * Design Notes:
+ * - Queue 0 belongs to the thread that called init() (the render thread);
+ *   only that thread and the workers may submit jobs
+ * - Owners pop LIFO (cache-warm), thieves steal FIFO (oldest, largest work)
+ * - wait() never blocks idle: the waiting thread runs queued jobs until the
+ *   counter reaches zero, so jobs may safely submit and wait on sub-jobs
+ * - A Counter must outlive every job submitted against it
+ */
+class JobSystem {
+public:
+    using Job = std::function<void()>;
+    using RangeJob = std::function<void(uint32_t begin, uint32_t end)>;
+
+    /**
+     * @brief Completion counter shared by a group of jobs
+     */
+    struct Counter {
+        std::atomic<uint32_t> pending{ 0 };
+        bool done() const { return pending.load(std::memory_order_acquire) == 0; }
+    };
+
+    JobSystem() = default;
+    ~JobSystem() { shutdown(); }
+
+    // Non-copyable
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    /**
+     * @brief Start the worker threads
+     * @param workerCount Number of workers (0 = hardware threads - 1)
+     */
+    void init(uint32_t workerCount = 0);
+
+    /**
+     * @brief Run remaining jobs and join all workers
+     */
+    void shutdown();
+
+    /**
+     * @brief Queue one job on the calling thread's queue
+     */
+    void submit(Counter& counter, Job job);
+
+    /**
+     * @brief Split [0, count) into chunks of chunkSize and queue one job per chunk
+     */
+    void parallelFor(Counter& counter, uint32_t count, uint32_t chunkSize, RangeJob job);
+
+    /**
+     * @brief Help run jobs until every job on the counter has finished
+     */
+    void wait(Counter& counter);
+
+    uint32_t getWorkerCount() const { return static_cast<uint32_t>(m_workers.size()); }
+
+    /**
+     * @brief Index of the calling thread: 1..workers for workers, 0 otherwise
+     * Stable for the thread's lifetime, so it can index per-thread resources
+     */
+    static uint32_t getThreadIndex() { return t_queueIndex; }
+
+private:
+    struct Task {
+        Job job;
+        Counter* counter = nullptr;
+    };
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> m_queues;  // [0] = init thread, [1..] = workers
+    std::vector<std::thread> m_workers;
+
+    std::atomic<bool> m_running{ false };
+    std::atomic<uint32_t> m_queuedTasks{ 0 };
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wakeCondition;
+
+    static thread_local uint32_t t_queueIndex;
+
+    void workerLoop(uint32_t queueIndex);
+    bool runOne(uint32_t queueIndex);
+    bool popLocal(uint32_t queueIndex, Task& task);
+    bool steal(uint32_t thiefIndex, Task& task);
+    void push(Task task);
+};
@@ -22,6 +22,8 @@
 #include <array>
 #include <optional>
 #include <set>
+#include <random>
+#include <functional>
 
 // stb_image implementation - compile this once
 #define STB_IMAGE_IMPLEMENTATION
@@ -33,24 +35,92 @@
 
 // Mesh and Model Loading
 #include "Vertex.h"
+#include "PackedVertex.h"
 #include "Mesh.h"
 #include "OBJLoader.h"
 #include "MeshGenerator.h"
+#include "Scene.h"
+#include "Meshlet.h"
+#include "MeshCache.h"
+#include "MeshOptimizer.h"
+#include "DeviceMemoryAllocator.h"
+#include "DynamicUploadRing.h"
+#include "UploadManager.h"
+#include "PipelineCache.h"
+#include "PipelineRegistry.h"
+#include "ThreadCommandPools.h"
 
 //Cactus
 #include "Cactus.h"
+#include "CactusField.h"
 
 // Texture Manager
 #include "TextureManager.h"
+#include "AssetStreamer.h"
+#include "MaterialLibrary.h"
 
 // Day-Night Cycle
 #include "DayNightCycle.h"
 #include "ParticleSystem.h"
+#include "JobSystem.h"
+#include "RadixSort.h"
+
+// Profiling and benchmarking
+#include "Profiler.h"
+#include "Benchmark.h"
+#include "CameraPath.h"
+#include "FramePacer.h"
+#include "FixedTimestep.h"
 
 // --- Configuration ---
 const uint32_t WIDTH = 800;
 const uint32_t HEIGHT = 600;
-const int MAX_FRAMES_IN_FLIGHT = 2;
+
+// Upper bound for --frames-in-flight (default 2); per-frame resources are sized at startup
+const uint32_t MAX_FRAMES_IN_FLIGHT = 4;
+
+// Most fixed simulation ticks one frame may run (--sim-rate sets the tick rate)
+const uint32_t MAX_SIMULATION_STEPS = 5;
+
+// Held-key camera steps per second (every step moves the camera a fixed amount)
+const float INPUT_TICK_RATE = 60.0f;
+
+// GPU particle capacity (power of two for ring-buffer emission)
+const uint32_t GPU_SAND_PARTICLES = 1u << 18;  // 262,144
+
+// CPU particles per job when an emitter is split across threads
+const uint32_t PARTICLE_JOB_CHUNK = 4096;
+
+// View depth the CPU particle sort quantizes over (the far plane)
+const float PARTICLE_SORT_MAX_DEPTH = 1000.0f;
+
+// CPU sort values are emitter << 24 | particle: up to 16M particles per emitter
+const uint32_t PARTICLE_SORT_INDEX_BITS = 24;
+
+// Entries one particle_sort.comp workgroup sorts in shared memory (2 per invocation)
+const uint32_t PARTICLE_SORT_BLOCK = 1024;
+static_assert((GPU_SAND_PARTICLES & (GPU_SAND_PARTICLES - 1)) == 0 && GPU_SAND_PARTICLES >= PARTICLE_SORT_BLOCK,
+    "The bitonic sort needs a power-of-two capacity of at least one block");
+
+// Ground sand texture (procedural, generated once then read from cache/textures)
+const uint32_t SAND_TEXTURE_SIZE = 2048;
+
+// Slots in the bindless texture array (descriptor indexing guarantees 500k)
+const uint32_t MAX_BINDLESS_TEXTURES = 1024;
+
+// Device memory streamed textures and meshes may occupy before LRU eviction
+const VkDeviceSize STREAMING_BUDGET = 256ull << 20;
+
+// --model files: one bindless slot each at the top of the array, below it TextureManager's
+const uint32_t MAX_STREAMED_MODELS = 64;
+const uint32_t STREAMED_TEXTURE_SLOT_BASE = MAX_BINDLESS_TEXTURES - MAX_STREAMED_MODELS;
+
+// Streamed models are scaled to this size (largest extent) and stood on the desert floor
+const float STREAMED_MODEL_SIZE = 10.0f;
+const float STREAMED_MODEL_RING_RADIUS = 60.0f;
+
+// Visible objects per secondary command buffer when recording in parallel
+const uint32_t SCENE_DRAWS_PER_RECORD_JOB = 64;
 
 const std::vector<const char*> validationLayers = {
     "VK_LAYER_KHRONOS_validation"
@@ -71,6 +141,7 @@ const bool enableValidationLayers = true;
 struct QueueFamilyIndices {
     std::optional<uint32_t> graphicsFamily;
     std::optional<uint32_t> presentFamily;
+    std::optional<uint32_t> transferFamily;   // Dedicated (non-graphics) transfer family, if any
 
     bool isComplete() const {
         return graphicsFamily.has_value() && presentFamily.has_value();
@@ -95,8 +166,82 @@ struct UniformBufferObject {
     alignas(4)  float lightIntensity;    // Light brightness
     alignas(16) glm::vec3 lightColor;    // Light color
     alignas(4)  float ambientStrength;   // Ambient light level
+
+    alignas(16) glm::vec4 positionScale; // PackedVertex decode (xyz), see PositionDecode
+    alignas(16) glm::vec4 positionBias;
 };
 
+// Per-draw transform and material (116 of the guaranteed 128 push constant bytes)
+struct ObjectPushConstants {
+    glm::mat4 model;
+    glm::vec4 normalMatrix[3];  // mat3 columns, padded to vec4 as in std430
+    uint32_t material;          // Into the material buffer
+
+    static ObjectPushConstants forObject(const SceneObject& object) {
+        ObjectPushConstants push{};
+        push.model = object.transform;
+        for (int column = 0; column < 3; column++) {
+            push.normalMatrix[column] = glm::vec4(glm::vec3(object.normalMatrix[column]), 0.0f);
+        }
+        push.material = object.material;
+        return push;
+    }
+};
+static_assert(sizeof(ObjectPushConstants) == 116, "ObjectPushConstants must match ObjectPush in the shaders");
+
+// GPU-driven path: one record per scene object (std430, matches scene_cull.comp)
+struct GpuSceneObject {
+    glm::mat4 model;
+    glm::mat4 normalMatrix;
+    glm::vec4 boundsMin;
+    glm::vec4 boundsMax;
+    glm::uvec4 lodFirstIndex;
+    glm::uvec4 lodIndexCount;
+    glm::ivec4 lodVertexOffset;
+    uint32_t lodCount;
+    uint32_t currentLod;        // Owned by the shader after upload
+    uint32_t clustered;         // 1 = drawn as meshlets, skipped by scene culling
+    uint32_t material;          // Into the material buffer
+};
+
+struct SceneCullPush {
+    glm::vec4 planes[6];
+    glm::vec4 cameraPosition;   // w = LOD projection scale
+    uint32_t objectCount;
+    float lodBaseRadius;
+    float lodHysteresis;
+};
+
+// Draw buffer layout: count at 0, commands from here (16 keeps std430 happy)
+const VkDeviceSize SCENE_DRAW_COMMANDS_OFFSET = 16;
+
+// One meshlet (std430, matches meshlet_cull.comp, meshlet.task and meshlet.mesh)
+struct GpuMeshlet {
+    glm::vec4 sphere;           // World-space center, w = radius
+    glm::vec4 cone;             // World-space axis, w = cutoff (1 = never back-facing)
+    uint32_t vertexOffset;      // Into the meshlet vertex buffer (global vertex indices)
+    uint32_t vertexCount;
+    uint32_t triangleOffset;    // Into the meshlet triangle buffer (packed local indices)
+    uint32_t triangleCount;
+    uint32_t clusterObject;     // Owning entry of clusterObjects / draw command
+    uint32_t padding[3];
+};
+
+struct MeshletCullPush {
+    glm::vec4 planes[6];
+    glm::vec4 cameraPosition;
+    uint32_t meshletCount;
+};
+
+struct MeshletDrawPush {
+    glm::mat4 model;
+    uint32_t firstMeshlet;
+    uint32_t meshletCount;
+    uint32_t material;          // Into the material buffer
+};
+
+const uint32_t MESHLETS_PER_TASK = 32;  // local_size_x in meshlet.task
+
 const std::vector<Vertex> Quad_vertices = {
     // position              normal                texCoord      color
     {{-0.5f, -0.5f, 0.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}},
@@ -109,25 +254,71 @@ const std::vector<uint32_t> Quad_indices = {
     0, 1, 2, 2, 3, 0
 };
 
-std::vector<Vertex> vertices;
-std::vector<uint32_t> indices;
+// Scatter extra procedural cacti over the desert floor (benchmark "forest")
+void scatterCacti(std::vector<Cactus>& cacti, uint32_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    for (uint32_t i = 0; i < count; i++) {
+        // Uniform over a disc that stays on the ground plane, inside the globe
+        float radius = 85.0f * std::sqrt(unit(rng));
+        float angle = unit(rng) * glm::two_pi<float>();
+
+        Cactus::Config config;
+        config.position = glm::vec3(radius * std::cos(angle), 0.0f, radius * std::sin(angle));
+        config.height = 3.0f + unit(rng) * 12.0f;
+        config.trunkRadius = config.height * (0.06f + unit(rng) * 0.04f);
+        config.numArms = static_cast<int>(unit(rng) * 4.99f);
+        config.color = glm::vec3(0.15f, 0.5f, 0.15f) + unit(rng) * glm::vec3(0.1f, 0.1f, 0.1f);
+        cacti.emplace_back(config);
+    }
+}
+
+// Scene construction switches (benchmarks can turn each feature off)
+struct SceneOptions {
+    bool instanceCacti = true;          // Shared cactus meshes (CactusField)
+    uint32_t extraCacti = 0;            // Procedural cacti, see scatterCacti
+    uint32_t seed = 1234;
+    uint32_t lodLevels = MAX_LOD_LEVELS;
+    bool meshlets = true;               // Draw the globe as culled meshlets
+
+    // MaterialLibrary indices (see createMaterials); instanced cacti push theirs per draw
+    uint32_t globeMaterial = 0;
+    uint32_t groundMaterial = 0;
+    uint32_t cactusMaterial = 0;
+};
 
-void loadModel() {
-    Mesh globeMesh = MeshGenerator::createSphere(
-        100.0f,                         // radius
-        64,                             // segments
-        32,                             // rings
-        glm::vec3(0.3f, 0.6f, 0.9f)    // light blue color
-    );
+// Instanced: cacti share one mesh per shape (CactusField); otherwise
+// each cactus is its own scene object with its own copy of the geometry.
+// Generated meshes go through meshCache, keyed by their generator parameters.
+void loadModel(Scene& scene, CactusField& cactusField, MeshCache& meshCache, const SceneOptions& options) {
+    const float globeRadius = 100.0f;
+    const uint32_t globeSegments = 64;  // LOD 0
+    const uint32_t globeRings = 32;     // LOD 0
+    const glm::vec3 globeColor(0.3f, 0.6f, 0.9f);      // light blue color
+    std::vector<Mesh> globeLods = meshCache.getOrCreateLods(
+        MeshCache::Key("globe").add(globeRadius).add(globeSegments).add(globeRings)
+            .add(options.lodLevels).add(globeColor).get(),
+        [&]() {
+            std::vector<Mesh> lods = MeshGenerator::createSphereLods(globeRadius, globeSegments, globeRings, options.lodLevels, globeColor);
+            MeshOptimizer::optimizeLods(lods, "Globe");
+            return lods;
+        });
+    const Mesh& globeMesh = globeLods.front();
 
     // Generate ground plane (desert floor at Y=0, inside globe)
-    Mesh groundMesh = MeshGenerator::createPlane(
-        180.0f,                         // width (slightly smaller than globe diameter)
-        180.0f,                         // depth
-        16,                             // subdivisions X
-        16,                             // subdivisions Z
-        glm::vec3(0.76f, 0.70f, 0.50f) // sandy/desert color
-    );
+    const float groundSize = 180.0f;    // slightly smaller than globe diameter
+    const uint32_t groundSubdivisions = 16;
+    const glm::vec3 groundColor(0.76f, 0.70f, 0.50f);  // sandy/desert color
+    std::vector<Mesh> groundLods = meshCache.getOrCreateLods(
+        MeshCache::Key("ground").add(groundSize).add(groundSubdivisions).add(groundColor).get(),
+        [&]() {
+            std::vector<Mesh> lods{ MeshGenerator::createPlane(groundSize, groundSize,
+                groundSubdivisions, groundSubdivisions, groundColor) };
+            MeshOptimizer::optimizeLods(lods, "Ground");
+            return lods;
+        });
+    const Mesh& groundMesh = groundLods.front();
 
     // Generate cacti
     std::vector<Cactus> cacti;
@@ -159,44 +350,51 @@ void loadModel() {
     cactus3Config.color = glm::vec3(0.25f, 0.6f, 0.25f);
     cacti.emplace_back(cactus3Config);
 
-    // Combine meshes
-    vertices.clear();
-    indices.clear();
-
-    // Add globe
-    const auto& globeVerts = globeMesh.getVertices();
-    const auto& globeInds = globeMesh.getIndices();
-    vertices.insert(vertices.end(), globeVerts.begin(), globeVerts.end());
-    indices.insert(indices.end(), globeInds.begin(), globeInds.end());
-
-    // Add ground plane (offset indices by globe vertex count)
-    uint32_t indexOffset = static_cast<uint32_t>(globeVerts.size());
-    const auto& groundVerts = groundMesh.getVertices();
-    const auto& groundInds = groundMesh.getIndices();
+    scatterCacti(cacti, options.extraCacti, options.seed);
 
-    vertices.insert(vertices.end(), groundVerts.begin(), groundVerts.end());
-    for (uint32_t idx : groundInds) {
-        indices.push_back(idx + indexOffset);
+    // One object per mesh; geometry is shared, transforms are per draw
+    scene.clear();
+    cactusField.clear();
+    uint32_t globeIndex = scene.addObject("Globe", globeLods);
+    scene.setMaterial(globeIndex, options.globeMaterial);
+    scene.setMaterial(scene.addObject("Ground", groundMesh), options.groundMaterial);
+    if (options.instanceCacti) {
+        cactusField.build(cacti, scene, options.lodLevels, &meshCache);
     }
-
-    // Add all cacti
-    for (const auto& cactus : cacti) {
-        Mesh cactusMesh = cactus.generateMesh();
-        indexOffset = static_cast<uint32_t>(vertices.size());
-        const auto& cactusVerts = cactusMesh.getVertices();
-        const auto& cactusInds = cactusMesh.getIndices();
-
-        vertices.insert(vertices.end(), cactusVerts.begin(), cactusVerts.end());
-        for (uint32_t idx : cactusInds) {
-            indices.push_back(idx + indexOffset);
+    else {
+        for (const auto& cactus : cacti) {
+            const Cactus::Config& config = cactus.getConfig();
+            uint64_t key = MeshCache::Key("cactus-local").add(config.height).add(config.trunkRadius)
+                .add(config.numArms).add(config.armHeight).add(config.color).add(config.segments)
+                .add(cactus.getGrowthFactor()).add(options.lodLevels).get();
+            uint32_t cactusIndex = scene.addObject("Cactus", meshCache.getOrCreateLods(key,
+                [&]() {
+                    std::vector<Mesh> lods = cactus.generateLocalMeshLods(options.lodLevels);
+                    MeshOptimizer::optimizeLods(lods, "Cactus");
+                    return lods;
+                }), cactus.getTransform());
+            scene.setMaterial(cactusIndex, options.cactusMaterial);
         }
     }
 
-    std::cout << "Loaded scene: " << vertices.size() << " vertices, "
-        << indices.size() / 3 << " triangles" << std::endl;
-    std::cout << "  - Globe: " << globeVerts.size() << " vertices" << std::endl;
-    std::cout << "  - Ground: " << groundVerts.size() << " vertices" << std::endl;
-    std::cout << "  - Cacti: " << cacti.size() << " instances" << std::endl;
+    // From inside, most of the globe is behind or beside the camera: cull it per meshlet
+    if (options.meshlets) {
+        scene.setClustered(globeIndex, true);
+    }
+
+    std::cout << "Loaded scene: " << scene.getVertices().size() << " vertices, "
+        << scene.getIndices().size() / 3 << " triangles, "
+        << scene.getObjectCount() << " objects" << std::endl;
+    std::cout << "  - Globe: " << globeMesh.getVertexCount() << " vertices, "
+        << globeLods.size() << " LOD levels" << (options.meshlets ? ", meshlets" : "") << std::endl;
+    std::cout << "  - Ground: " << groundMesh.getVertexCount() << " vertices" << std::endl;
+    std::cout << "  - Cacti: " << cacti.size() << " instances";
+    if (options.instanceCacti) std::cout << " of " << cactusField.getBatchCount() << " shared meshes";
+    std::cout << std::endl;
+    if (meshCache.isEnabled()) {
+        std::cout << "  - Mesh cache: " << meshCache.getHits() << " hits, "
+            << meshCache.getMisses() << " misses" << std::endl;
+    }
 }
 
 // --- Vulkan Debug Messenger ---
@@ -223,12 +421,22 @@ class HelloTriangleApplication {
 public:
     void run();
 
+    // Must be called before run(); a disabled config keeps the interactive app
+    void configureBenchmark(const Benchmark::Settings& settings) { benchmark.init(settings); }
+
 private:
     // --- Core Application Members ---
     GLFWwindow* window = {};
     bool framebufferResized = false;
     uint32_t currentFrame = 0;
 
+    // --- Presentation and pacing ---
+    uint32_t framesInFlight = 2;          // Chosen at startup, at most MAX_FRAMES_IN_FLIGHT
+    FramePacer framePacer;                // Frame cap and input latency
+    FramePacer::PresentMode requestedPresentMode = FramePacer::PresentMode::Mailbox;
+    VkPresentModeKHR activePresentMode = VK_PRESENT_MODE_FIFO_KHR;
+    bool presentModeChanged = false;      // Recreate the swapchain after this frame's present
+
     // --- Vulkan Core Components ---
     VkInstance instance = VK_NULL_HANDLE;
     VkDebugUtilsMessengerEXT debugMessenger = VK_NULL_HANDLE;
@@ -237,6 +445,7 @@ private:
     VkDevice device = VK_NULL_HANDLE;
     VkQueue graphicsQueue = VK_NULL_HANDLE;
     VkQueue presentQueue = VK_NULL_HANDLE;
+    VkQueue transferQueue = VK_NULL_HANDLE;   // == graphicsQueue without a dedicated family
     VkCommandPool commandPool = VK_NULL_HANDLE;
 
     // --- Swapchain ---
@@ -246,24 +455,139 @@ private:
     VkExtent2D swapChainExtent{0, 0};
     std::vector<VkImageView> swapChainImageViews;
 
+    // --- Scene ---
+    Scene scene;                          // Per-object ranges into the shared vertex/index buffers
+    MeshCache meshCache;                  // Generated meshes and meshlets from earlier runs
+    Frustum viewFrustum;                  // Active camera, updated with the uniform buffer
+    std::vector<uint32_t> visibleObjects; // Rebuilt every frame (CPU culling path)
+
+    // LOD selection inputs, refreshed with the uniform buffer
+    LodSettings lodSettings;
+    glm::vec3 lodCameraPosition{ 0.0f };
+    float lodProjectionScaleFactor = 1.0f;
+
+    // --- GPU-Driven Scene Rendering ---
+    // A compute pass culls every object and writes indirect draws;
+    // one vkCmdDrawIndexedIndirectCount replaces the per-object loop
+    bool gpuDrivenSupported = false;      // drawIndirectCount + drawIndirectFirstInstance
+    bool useGpuCulling = false;
+    VkDescriptorSetLayout sceneCullSetLayout = VK_NULL_HANDLE;
+    VkPipelineLayout sceneCullPipelineLayout = VK_NULL_HANDLE;
+    VkPipeline sceneCullPipeline = VK_NULL_HANDLE;
+    VkPipelineLayout indirectPipelineLayout = VK_NULL_HANDLE;
+    VkPipeline indirectGraphicsPipeline = VK_NULL_HANDLE;
+    VkBuffer sceneObjectBuffer = VK_NULL_HANDLE;
+    DeviceMemoryAllocator::Allocation sceneObjectBufferAllocation;
+    std::vector<VkBuffer> sceneDrawBuffers;   // Per frame: count + commands
+    std::vector<DeviceMemoryAllocator::Allocation> sceneDrawBuffersAllocations;
+    std::vector<VkDescriptorSet> sceneCullDescriptorSets;
+
+    void createSceneCullPipeline();
+    void createSceneCullBuffers();
+    void createSceneCullDescriptorSets();
+    void dispatchSceneCulling(VkCommandBuffer commandBuffer);
+
+    // --- Meshlet Rendering ---
+    // Clustered scene objects are split into meshlets and culled per
+    // cluster (frustum + normal cone): by a task shader where mesh shaders
+    // are supported, else by a compute pass that writes the surviving
+    // triangles into a per-frame index buffer for an indirect draw
+    struct ClusterObject {
+        uint32_t objectIndex = 0;       // Into scene
+        uint32_t firstMeshlet = 0;      // Into meshletBuffer
+        uint32_t meshletCount = 0;
+        uint32_t firstIndex = 0;        // Region of meshletIndexBuffers (compute path)
+        uint32_t triangleCount = 0;     // Before culling
+    };
+    bool meshShaderSupported = false;     // VK_EXT_mesh_shader with task + mesh stages
+    bool useMeshShaders = false;
+    PFN_vkCmdDrawMeshTasksEXT cmdDrawMeshTasks = nullptr;   // Extension entry point
+    std::vector<ClusterObject> clusterObjects;
+    std::vector<VkDrawIndexedIndirectCommand> meshletDrawTemplate;  // indexCount 0, copied every frame
+    uint32_t meshletCount = 0;
+    VkDescriptorSetLayout meshletSetLayout = VK_NULL_HANDLE;
+    VkPipelineLayout meshletCullPipelineLayout = VK_NULL_HANDLE;
+    VkPipeline meshletCullPipeline = VK_NULL_HANDLE;
+    VkPipelineLayout meshletPipelineLayout = VK_NULL_HANDLE;
+    VkPipeline meshletGraphicsPipeline = VK_NULL_HANDLE;
+    VkBuffer meshletBuffer = VK_NULL_HANDLE;
+    DeviceMemoryAllocator::Allocation meshletBufferAllocation;
+    VkBuffer meshletVertexBuffer = VK_NULL_HANDLE;
+    DeviceMemoryAllocator::Allocation meshletVertexBufferAllocation;
+    VkBuffer meshletTriangleBuffer = VK_NULL_HANDLE;
+    DeviceMemoryAllocator::Allocation meshletTriangleBufferAllocation;
+    std::vector<VkBuffer> meshletIndexBuffers;    // Per frame: surviving triangles
+    std::vector<DeviceMemoryAllocator::Allocation> meshletIndexBuffersAllocations;
+    std::vector<VkBuffer> meshletDrawBuffers;     // Per frame: one command per cluster object
+    std::vector<DeviceMemoryAllocator::Allocation> meshletDrawBuffersAllocations;
+    std::vector<VkDescriptorSet> meshletDescriptorSets;
+
+    void createMeshletPipelines();
+    void createMeshletBuffers();
+    void createMeshletDescriptorSets();
+    void dispatchMeshletCulling(VkCommandBuffer commandBuffer);
+    void renderMeshlets(VkCommandBuffer commandBuffer);
+
     // --- Graphics Pipeline ---
     VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
     VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
-    VkPipeline graphicsPipeline = VK_NULL_HANDLE;
+    VkPipeline graphicsPipeline = VK_NULL_HANDLE;    // Phong (per-pixel)
+    VkPipeline gouraudPipeline = VK_NULL_HANDLE;     // Per-vertex lighting, same layout and inputs
+    bool useGouraud = false;
+
+    // Depth pre-pass: opaque geometry is first drawn depth-only, then shaded
+    // with EQUAL and depth writes off, so each pixel runs shader.frag once.
+    // Opaque color pipelines take depth compare/write as dynamic state
+    bool useDepthPrepass = true;
+    VkPipeline depthPrepassPipeline = VK_NULL_HANDLE;           // Per-object draws
+    VkPipeline depthPrepassIndirectPipeline = VK_NULL_HANDLE;   // GPU-driven draws
+    VkPipeline depthPrepassCactusPipeline = VK_NULL_HANDLE;     // Instanced cacti
+
+    // create*Pipeline functions queue into the registry; initVulkan builds them all at once
+    PipelineCache pipelineCache;
+    PipelineRegistry pipelineRegistry;
 
     // --- Buffers and Memory ---
+    DeviceMemoryAllocator memoryAllocator;   // All buffers/images are sub-allocated from here
+    UploadManager uploadManager;             // Batched staging copies, timeline-signalled
     VkBuffer vertexBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory vertexBufferMemory = VK_NULL_HANDLE;
+    DeviceMemoryAllocator::Allocation vertexBufferAllocation;
+    VertexFormat vertexFormat = VertexFormat::Full;    // Layout of vertexBuffer, fixed at startup
+    PositionEncoding positionEncoding = PositionEncoding::Unorm16;
+    PositionDecode positionDecode;                     // Packed positions -> mesh space (via the UBO)
     VkBuffer indexBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory indexBufferMemory = VK_NULL_HANDLE;
+    VkIndexType indexType = VK_INDEX_TYPE_UINT32;      // UINT16 when every scene mesh fits
+    DeviceMemoryAllocator::Allocation indexBufferAllocation;
     std::vector<VkBuffer> uniformBuffers;
-    std::vector<VkDeviceMemory> uniformBuffersMemory;
+    std::vector<DeviceMemoryAllocator::Allocation> uniformBuffersAllocations;
     std::vector<void*> uniformBuffersMapped;
 
     // --- Descriptors ---
     VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
     std::vector<VkDescriptorSet> descriptorSets;
 
+    // --- Parallel Recording ---
+    // Everything inside the rendering scope is split into draw passes; each
+    // pass is recorded into its own secondary command buffer on the job
+    // system and the primary executes them in order
+    struct DrawPass {
+        const char* name;                               // GPU profiler scope
+        bool depthEqual;                                // After the pre-pass: EQUAL, no depth writes
+        std::function<void(VkCommandBuffer)> record;
+    };
+    ThreadCommandPools recordPools;                     // JobSystem thread x frame in flight
+    bool parallelRecording = true;
+    std::vector<DrawPass> drawPasses;                   // This frame's passes, in draw order
+    std::vector<VkCommandBuffer> drawPassBuffers;       // Secondary per pass (parallel only)
+    JobSystem::Counter drawPassJobs;
+
+    void collectDrawPasses();
+    void kickDrawPassRecording();
+    void waitDrawPassRecording();
+    VkCommandBuffer recordDrawPass(const DrawPass& pass);
+    void bindDrawState(VkCommandBuffer commandBuffer, const DrawPass& pass);
+    void renderScene(VkCommandBuffer commandBuffer, uint32_t firstVisible, uint32_t lastVisible, bool depthOnly);
+
     // --- Synchronization ---
     std::vector<VkCommandBuffer> commandBuffers;
     std::vector<VkSemaphore> imageAvailableSemaphores;
@@ -298,6 +622,8 @@ private:
 
     // --- Drawing and Swapchain Handling ---
     void drawFrame();
+    void sampleInput();
+    void pollGpuLatency();
     void recreateSwapChain();
     void cleanupSwapChain();
     void recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex);
@@ -307,6 +633,7 @@ private:
     // --- Helper Functions ---
     void populateDebugMessengerCreateInfo(VkDebugUtilsMessengerCreateInfoEXT& createInfo);
     bool isDeviceSuitable(VkPhysicalDevice device);
+    static bool hasBindlessSupport(const VkPhysicalDeviceVulkan12Features& features);
     bool checkDeviceExtensionSupport(VkPhysicalDevice device);
     QueueFamilyIndices findQueueFamilies(VkPhysicalDevice device);
     SwapChainSupportDetails querySwapChainSupport(VkPhysicalDevice device);
@@ -315,11 +642,7 @@ private:
     VkExtent2D chooseSwapExtent(const VkSurfaceCapabilitiesKHR& capabilities);
     std::vector<const char*> getRequiredExtensions();
     bool checkValidationLayerSupport();
-    static std::vector<char> readFile(const std::string& filename);
-    VkShaderModule createShaderModule(const std::vector<char>& code);
-    void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& bufferMemory);
-    void copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size);
-    uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
+    void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, DeviceMemoryAllocator::Pool pool, VkBuffer& buffer, DeviceMemoryAllocator::Allocation& allocation);
 
 
     // --- Callbacks ---
@@ -342,14 +665,33 @@ private:
     float deltaTime = 0.0f;
     std::chrono::high_resolution_clock::time_point lastFrameTime;
 
+    // Fixed-rate simulation: scaled time ticks the day/night cycle and the
+    // particles, real time ticks held-key camera motion. Rendering blends
+    // the last two ticks by each clock's alpha.
+    struct CameraSnapshot {
+        int cameraIndex = -1;             // -1 = none, render the camera as is
+        glm::vec3 position{ 0.0f };
+        glm::vec3 target{ 0.0f };
+    };
+    FixedTimestep simulationClock;
+    FixedTimestep inputClock;
+    uint32_t simulationSteps = 0;         // Simulation ticks this frame
+    CameraSnapshot previousCamera;        // Active camera before its latest input tick
+    DayNightCycle::LightState renderLightState{};
+    glm::mat4 renderView{ 1.0f };         // Interpolated view of this frame's UBO
+    glm::vec3 renderCameraPosition{ 0.0f };
+
+    void stepSimulation();
+
     void initCameras();
     void setupInputCallbacks();
 
 
 
     // --- Depth Buffer ---
+    VkFormat depthFormat = VK_FORMAT_UNDEFINED;   // Chosen in createDepthResources
     VkImage depthImage = VK_NULL_HANDLE;
-    VkDeviceMemory depthImageMemory = VK_NULL_HANDLE;
+    DeviceMemoryAllocator::Allocation depthImageAllocation;
     VkImageView depthImageView = VK_NULL_HANDLE;
 
     // --- Depth Buffer Helpers ---
@@ -360,8 +702,8 @@ private:
         VkFormatFeatureFlags features);
     void createImage(uint32_t width, uint32_t height, VkFormat format,
         VkImageTiling tiling, VkImageUsageFlags usage,
-        VkMemoryPropertyFlags properties, VkImage& image,
-        VkDeviceMemory& imageMemory);
+        DeviceMemoryAllocator::Pool pool, VkImage& image,
+        DeviceMemoryAllocator::Allocation& imageAllocation);
 
 
 
@@ -369,6 +711,59 @@ private:
 	// --- Texture Manager ---
     TextureManager textureManager;
     int32_t sandTextureIndex = -1;
+    bool samplerAnisotropySupported = false;
+
+    // --- Bindless Materials ---
+    // Set 0 binding 1 is an array of every texture (slot = TextureManager
+    // index, streamed models own the top slots) and binding 2 the material
+    // buffer; draws only pass an index
+    MaterialLibrary materials;
+    uint32_t globeMaterial = 0;
+    uint32_t groundMaterial = 0;
+    uint32_t cactusMaterial = 0;
+    VkBuffer materialBuffer = VK_NULL_HANDLE;
+    DeviceMemoryAllocator::Allocation materialBufferAllocation;
+    // Per frame: TextureManager::getSlotVersion() of what each slot last got
+    std::vector<std::vector<uint32_t>> bindlessSlotVersions;
+
+    void createMaterials();
+    void createMaterialBuffer();
+    void updateBindlessTextures(uint32_t frame);
+
+    // File textures/meshes load on background threads under a VRAM budget.
+    // Each --model is drawn once its mesh is resident; its material samples
+    // a slot of its own, rewritten every frame with the streamer's descriptor
+    // (the placeholder until the texture is resident)
+    struct StreamedModel {
+        AssetStreamer::Handle mesh = AssetStreamer::INVALID_HANDLE;
+        AssetStreamer::Handle texture = AssetStreamer::INVALID_HANDLE;
+        uint32_t textureSlot = 0;               // STREAMED_TEXTURE_SLOT_BASE + model index
+        uint32_t material = 0;
+        glm::vec3 position{ 0.0f };             // Base center on the desert floor
+        bool placed = false;                    // Transform below is known (mesh was resident once)
+        glm::mat4 transform{ 1.0f };
+        glm::mat4 normalMatrix{ 1.0f };
+        glm::vec3 worldMin{ 0.0f };
+        glm::vec3 worldMax{ 0.0f };
+    };
+
+    // Resolved on the render thread; the draw passes only read these
+    struct StreamedDraw {
+        VkBuffer vertexBuffer = VK_NULL_HANDLE;
+        VkBuffer indexBuffer = VK_NULL_HANDLE;
+        VkIndexType indexType = VK_INDEX_TYPE_UINT32;
+        uint32_t indexCount = 0;
+        ObjectPushConstants push{};
+    };
+
+    AssetStreamer assetStreamer;
+    std::vector<StreamedModel> streamedModels;
+    std::vector<StreamedDraw> streamedDraws;    // Rebuilt every frame
+
+    void requestStreamedModels();
+    void placeStreamedModel(StreamedModel& model, const AssetStreamer::StreamedMesh& mesh);
+    void updateStreamedModels();
+    void renderStreamedModels(VkCommandBuffer commandBuffer, bool depthOnly);
 
 
 	// Day-Night Cycle
@@ -377,22 +772,102 @@ private:
 
 
     // --- Particle System ---
-    ParticleSystem fireParticles;
-    ParticleSystem sandParticles;
+    // Emitters are built from a table in initParticleSystems; CPU emitters
+    // are simulated on the job system, one job per emitter (chunked if large)
+    std::vector<ParticleSystem> particleEmitters;
+    size_t fireEmitterIndex = 0;
+    size_t smokeEmitterIndex = 0;  // Follows the fire on F4
+    size_t sandEmitterIndex = 0;   // The single GPU-simulated emitter
     bool fireActive = false;
 
+    JobSystem jobSystem;
+    JobSystem::Counter particleSimJobs;   // Simulation of the next frame, in flight
+    float particleRewind = 0.0f;          // Interpolation of the kicked ticks (see generateInstanceRange)
+
     // Particle rendering resources
-    VkPipeline particlePipeline = VK_NULL_HANDLE;
+    VkPipeline particlePipeline = VK_NULL_HANDLE;        // Additive emitters
+    VkPipeline particleAlphaPipeline = VK_NULL_HANDLE;   // Alpha-blended emitters, drawn back to front
     VkPipelineLayout particlePipelineLayout = VK_NULL_HANDLE;
-    VkBuffer particleVertexBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory particleVertexBufferMemory = VK_NULL_HANDLE;
-    VkBuffer particleIndexBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory particleIndexBufferMemory = VK_NULL_HANDLE;
+    DynamicUploadRing particleUploadRing;   // Persistently mapped, 1 region per frame in flight
+    VkDeviceSize particleInstanceOffset = 0;
+    uint32_t particleInstanceCount = 0;
+    uint32_t particleAlphaInstanceCount = 0;   // Leading instances that use particleAlphaPipeline
+
+    // Depth sorting of alpha-blended particles, CPU and GPU. Only keys and
+    // indices are sorted: particle state stays where the simulation put it
+    bool useParticleSort = true;
+    RadixSort particleSorter;
+    std::vector<uint32_t> particleSortKeys;
+    std::vector<uint32_t> particleSortValues;
+    std::vector<const ParticleSystem*> particleSortEmitters;   // Indexed by a value's high bits
+
+    // --- Cactus Instancing ---
+    // Cacti are culled on the CPU each frame; the visible instances go
+    // straight into a mapped ring and draw as one call per shared mesh
+    CactusField cactusField;
+    VkPipeline cactusInstancedPipeline = VK_NULL_HANDLE;
+    DynamicUploadRing cactusInstanceRing;   // 1 region per frame in flight
+    std::vector<CactusField::Draw> cactusDraws;
+    VkDeviceSize cactusInstanceOffset = 0;
+    uint32_t visibleCactusCount = 0;
+
+    void initCactusInstances();
+    void updateCactusInstances();
+    void renderCactusInstances(VkCommandBuffer commandBuffer, bool depthOnly);
 
     void createParticlePipeline();
     void initParticleSystems();
     void updateParticles();
+    void kickParticleSimulation(uint32_t steps, float tick);
+    void waitParticleSimulation();
+    uint32_t generateSortedParticleInstances(ParticleInstance* dst);
     void renderParticles(VkCommandBuffer commandBuffer);
+
+    // --- GPU Particle Simulation (compute) ---
+    // Sand is simulated entirely on the GPU; fire stays on the CPU path.
+    VkDescriptorSetLayout computeParticleSetLayout = VK_NULL_HANDLE;
+    VkPipelineLayout computeParticlePipelineLayout = VK_NULL_HANDLE;
+    VkPipeline computeParticleSimPipeline = VK_NULL_HANDLE;
+    VkPipeline computeParticleRenderPipeline = VK_NULL_HANDLE;
+    VkBuffer computeParticleBuffer = VK_NULL_HANDLE;
+    DeviceMemoryAllocator::Allocation computeParticleBufferAllocation;
+    std::vector<VkDescriptorSet> computeParticleDescriptorSets;
+    std::vector<ParticleComputePush> computeParticleTicks;   // One sim dispatch per simulation tick
+    ParticleComputePush computeParticlePush{};               // Draw: latest tick's emitter, w = interpolation rewind
+    uint32_t computeParticleEmitted = 0;      // Running serial, wraps with the ring
+    bool computeParticlesNeedClear = true;    // Zero the buffer on first use
+
+    // Bitonic sort of (depth key, index) pairs that particle_gpu.vert draws in order
+    VkPipelineLayout particleSortPipelineLayout = VK_NULL_HANDLE;
+    VkPipeline particleSortPipeline = VK_NULL_HANDLE;
+    VkBuffer particleSortBuffer = VK_NULL_HANDLE;
+    DeviceMemoryAllocator::Allocation particleSortBufferAllocation;
+
+    void createComputeParticlePipelines();
+    void createComputeParticleBuffer();
+    void createComputeParticleDescriptorSets();
+    void dispatchComputeParticles(VkCommandBuffer commandBuffer);
+    void dispatchParticleSort(VkCommandBuffer commandBuffer);
+
+    // --- Profiling ---
+    std::chrono::steady_clock::time_point lastTitleUpdate{};
+    void updateProfilerTitle();
+
+    // --- Benchmark Mode ---
+    // Fixed time step, seeded particles, fixed time of day and a scripted
+    // camera path; offscreen runs render into plain images (no window)
+    Benchmark benchmark;
+    CameraPath benchmarkPath;
+    std::vector<DeviceMemoryAllocator::Allocation> offscreenImageAllocations;
+    VkImageLayout finalColorLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    float elapsedTime = 0.0f;   // Simulated seconds, drives shader animation
+
+    bool isOffscreen() const { return benchmark.isEnabled() && benchmark.getSettings().offscreen; }
+    std::vector<const char*> getDeviceExtensions() const;
+    void initBenchmark();
+    void createOffscreenTargets();
+    void updateBenchmarkCamera();
+    void recordBenchmarkFrame(float frameMilliseconds);
 };
 
 // --- Implementation ---
@@ -405,63 +880,206 @@ void HelloTriangleApplication::run() {
 }
 
 void HelloTriangleApplication::initWindow() {
-    glfwInit();
-    glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
-    window = glfwCreateWindow(WIDTH, HEIGHT, "Vulkan 1.3 - Refactored", nullptr, nullptr);
-    glfwSetWindowUserPointer(window, this);
-    glfwSetFramebufferSizeCallback(window, framebufferResizeCallback);
+    // Offscreen benchmark runs need no window (nor a display)
+    if (!isOffscreen()) {
+        glfwInit();
+        glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+        window = glfwCreateWindow(WIDTH, HEIGHT, "Vulkan 1.3 - Refactored", nullptr, nullptr);
+        glfwSetWindowUserPointer(window, this);
+        glfwSetFramebufferSizeCallback(window, framebufferResizeCallback);
+    }
 
     // Initialize camera system
     initCameras();
     setupInputCallbacks();
-    inputHandler.setupCallbacks(window);
+    if (window) {
+        inputHandler.setupCallbacks(window);
+    }
+    if (benchmark.isEnabled()) {
+        initBenchmark();
+    }
+
+    simulationClock.configure(1.0f / benchmark.getSettings().simulationRate, MAX_SIMULATION_STEPS);
+    inputClock.configure(1.0f / INPUT_TICK_RATE, MAX_SIMULATION_STEPS);
+    std::cout << "Simulation: " << benchmark.getSettings().simulationRate << " Hz fixed step, up to "
+        << MAX_SIMULATION_STEPS << " ticks per frame" << std::endl;
 
     lastFrameTime = std::chrono::high_resolution_clock::now();
 }
 
 void HelloTriangleApplication::initVulkan() {
+    // Presentation policy: the switches apply to interactive runs too
+    const Benchmark::Settings& presentation = benchmark.getSettings();
+    framesInFlight = std::clamp(presentation.framesInFlight, 1u, MAX_FRAMES_IN_FLIGHT);
+    FramePacer::parsePresentMode(presentation.presentMode, requestedPresentMode);
+    framePacer.init(framesInFlight, presentation.frameCap);
+    std::cout << "Frames in flight: " << framesInFlight << ", frame cap: ";
+    if (presentation.frameCap > 0.0f) std::cout << presentation.frameCap << " FPS" << std::endl;
+    else std::cout << "off" << std::endl;
+
     createInstance();
     setupDebugMessenger();
     createSurface();
     pickPhysicalDevice();
     createLogicalDevice();
+    memoryAllocator.init(device, physicalDevice);
     createSwapChain();
     createImageViews();
     createDepthResources();
     createCommandPool();
 
-    // Initialize texture manager
-    textureManager.init(device, physicalDevice, commandPool, graphicsQueue);
-    sandTextureIndex = textureManager.generateSandTexture(512, 512);
+    // All startup copies (textures, vertex/index data) go into one upload batch
+    QueueFamilyIndices queueFamilies = findQueueFamilies(physicalDevice);
+    uint32_t transferFamily = queueFamilies.transferFamily.value_or(queueFamilies.graphicsFamily.value());
+    uploadManager.init(device, memoryAllocator,
+        queueFamilies.graphicsFamily.value(), graphicsQueue, transferFamily, transferQueue);
+
+    // Initialize texture manager (16x anisotropy where the device allows it)
+    float maxAnisotropy = 1.0f;
+    if (samplerAnisotropySupported) {
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+        maxAnisotropy = std::min(16.0f, properties.limits.maxSamplerAnisotropy);
+    }
+    textureManager.init(device, physicalDevice, memoryAllocator, uploadManager, maxAnisotropy);
+    textureManager.initCache("cache/textures", !benchmark.isEnabled() || benchmark.getSettings().textureCache);
+
+    // Workers are needed from here on (texture rows, mip levels, later the particles)
+    jobSystem.init();
+    std::cout << "Job system: " << jobSystem.getWorkerCount() << " worker threads\n";
+
+    auto textureStart = std::chrono::high_resolution_clock::now();
+    sandTextureIndex = textureManager.generateProceduralTexture(TextureManager::ProceduralTexture::sand(SAND_TEXTURE_SIZE), &jobSystem);
+    std::cout << "Procedural textures: " << std::chrono::duration<float, std::milli>(
+        std::chrono::high_resolution_clock::now() - textureStart).count() << " ms ("
+        << textureManager.getCacheHits() << " cached, " << textureManager.getCacheMisses() << " generated)" << std::endl;
+    createMaterials();
+
+    // One vertex layout per run: the shared buffer and every pipeline reading it must agree
+    vertexFormat = benchmark.getSettings().packedVertices ? VertexFormat::Packed : VertexFormat::Full;
+    positionEncoding = benchmark.getSettings().halfPositions ? PositionEncoding::Half : PositionEncoding::Unorm16;
 
     createDescriptorSetLayout();
+    createSceneCullPipeline();
+    createMeshletPipelines();
     createGraphicsPipeline();
 	createParticlePipeline(); // Create particle rendering pipeline
-
-    loadModel();
+    createComputeParticlePipelines();
+
+    // Compile everything queued above in parallel, seeded from last run's cache
+    pipelineCache.init(device, physicalDevice, "cache/pipelines", !benchmark.isEnabled() || benchmark.getSettings().pipelineCache);
+    auto pipelineStart = Profiler::Clock::now();
+    pipelineRegistry.build(device, pipelineCache.get(), &jobSystem);
+    const char* pipelineScope = pipelineCache.isWarm() ? "Startup: pipelines (warm)" : "Startup: pipelines (cold)";
+    Profiler::instance().recordCpu(pipelineScope, pipelineStart, Profiler::Clock::now());
+    benchmark.recordStartup(pipelineCache.isWarm() ? "pipelinesWarm" : "pipelinesCold", pipelineRegistry.getLastBuildMs());
+    std::cout << "Pipelines: " << pipelineRegistry.getLastBuildCount() << " built in " << pipelineRegistry.getLastBuildMs()
+        << " ms (" << (pipelineCache.isWarm() ? "warm cache, " + std::to_string(pipelineCache.getLoadedBytes() / 1024) + " KB"
+                                              : std::string("cold cache")) << ")" << std::endl;
+
+    const Benchmark::Settings& sceneSettings = benchmark.getSettings();
+    SceneOptions sceneOptions;
+    sceneOptions.seed = sceneSettings.seed;
+    if (benchmark.isEnabled()) {
+        sceneOptions.instanceCacti = sceneSettings.cactusInstancing;
+        sceneOptions.extraCacti = sceneSettings.extraCacti;
+        sceneOptions.lodLevels = sceneSettings.lod ? MAX_LOD_LEVELS : 1;
+        sceneOptions.meshlets = sceneSettings.meshlets;
+    }
+    sceneOptions.globeMaterial = globeMaterial;
+    sceneOptions.groundMaterial = groundMaterial;
+    sceneOptions.cactusMaterial = cactusMaterial;
+    meshCache.init("cache/meshes", !benchmark.isEnabled() || sceneSettings.meshCache);
+
+    AssetStreamer::Settings streamingSettings;
+    streamingSettings.budgetBytes = STREAMING_BUDGET;
+    streamingSettings.framesInFlight = framesInFlight;
+    streamingSettings.vertexFormat = vertexFormat;
+    streamingSettings.positionEncoding = positionEncoding;
+    assetStreamer.init(device, memoryAllocator, uploadManager, textureManager, &meshCache, streamingSettings);
+    requestStreamedModels();
+    auto loadStart = std::chrono::high_resolution_clock::now();
+    loadModel(scene, cactusField, meshCache, sceneOptions);
+    std::cout << "Scene load: " << std::chrono::duration<float, std::milli>(
+        std::chrono::high_resolution_clock::now() - loadStart).count() << " ms" << std::endl;
+    initCactusInstances();
 	initParticleSystems(); //Initialize particle systems
 
     createVertexBuffer();
     createIndexBuffer();
     createUniformBuffers();
+    createMaterialBuffer();
+    createComputeParticleBuffer();
     createDescriptorPool();
     createDescriptorSets();
+    createComputeParticleDescriptorSets();
+    createSceneCullBuffers();
+    createSceneCullDescriptorSets();
+    createMeshletBuffers();
+    createMeshletDescriptorSets();
     createCommandBuffers();
     createSyncObjects();
+
+    // One pool per job system thread (workers + this one), per frame in flight
+    recordPools.init(device, queueFamilies.graphicsFamily.value(), jobSystem.getWorkerCount() + 1, framesInFlight);
+    parallelRecording = !benchmark.isEnabled() || benchmark.getSettings().parallelRecording;
+    useDepthPrepass = !benchmark.isEnabled() || benchmark.getSettings().depthPrepass;
+    std::cout << "Depth pre-pass: " << (useDepthPrepass ? "on" : "off") << std::endl;
+
+    useParticleSort = !benchmark.isEnabled() || benchmark.getSettings().particleSort;
+    std::cout << "Particle depth sort: " << (useParticleSort ? "on" : "off") << std::endl;
+    std::cout << "Command recording: " << (parallelRecording
+        ? "secondary command buffers on " + std::to_string(recordPools.getThreadCount()) + " threads"
+        : std::string("serial (primary only)")) << std::endl;
+
+    Profiler::instance().initGpu(device, physicalDevice, queueFamilies.graphicsFamily.value(), framesInFlight);
+
+    // Kick the startup uploads; the first frame waits for them GPU-side
+    uploadManager.submit();
+    std::cout << "Uploads: " << (uploadManager.hasDedicatedTransferQueue() ? "dedicated transfer queue" : "graphics queue") << std::endl;
+
+    memoryAllocator.printStats();
 }
 
 void HelloTriangleApplication::mainLoop() {
-    while (!glfwWindowShouldClose(window)) {
+    while (window == nullptr || !glfwWindowShouldClose(window)) {
+        if (benchmark.isEnabled() && benchmark.isComplete()) break;
+
+        // Frame cap: sleep until this frame's start (outside the profiled frame)
+        framePacer.waitForNextFrame();
+
         // Calculate delta time
         auto currentTime = std::chrono::high_resolution_clock::now();
         deltaTime = std::chrono::duration<float>(currentTime - lastFrameTime).count();
         lastFrameTime = currentTime;
 
-        glfwPollEvents();
-        inputHandler.processInput(window, deltaTime);
+        // Benchmark runs step exactly one simulation tick per frame so every run sees the same frames
+        if (benchmark.isEnabled()) {
+            deltaTime = benchmark.getSettings().fixedDelta;
+        }
+
+        // drawFrame samples input itself, as late as it can (see sampleInput)
+        Profiler::instance().beginFrame();
         drawFrame();
+        Profiler::instance().endFrame();
+
+        if (benchmark.isEnabled()) {
+            auto frameEnd = std::chrono::high_resolution_clock::now();
+            recordBenchmarkFrame(std::chrono::duration<float, std::milli>(frameEnd - currentTime).count());
+        }
+        if (window) {
+            updateProfilerTitle();
+        }
     }
     vkDeviceWaitIdle(device);
+
+    if (benchmark.isEnabled()) {
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+        if (!benchmark.writeReport(properties.deviceName)) {
+            throw std::runtime_error("Failed to write benchmark report!");
+        }
+    }
 }
 
 void HelloTriangleApplication::cleanup() {
@@ -469,50 +1087,97 @@ void HelloTriangleApplication::cleanup() {
 
     
     // Clean up particle resources
-    vkDestroyBuffer(device, particleVertexBuffer, nullptr);
-    vkFreeMemory(device, particleVertexBufferMemory, nullptr);
-    vkDestroyBuffer(device, particleIndexBuffer, nullptr);
-    vkFreeMemory(device, particleIndexBufferMemory, nullptr);
+    jobSystem.shutdown();
+    particleUploadRing.cleanup();
+    cactusInstanceRing.cleanup();
     vkDestroyPipeline(device, particlePipeline, nullptr);
+    vkDestroyPipeline(device, particleAlphaPipeline, nullptr);
+
+    memoryAllocator.destroyBuffer(computeParticleBuffer, computeParticleBufferAllocation);
+    memoryAllocator.destroyBuffer(particleSortBuffer, particleSortBufferAllocation);
+    vkDestroyPipeline(device, computeParticleSimPipeline, nullptr);
+    vkDestroyPipeline(device, computeParticleRenderPipeline, nullptr);
+    vkDestroyPipeline(device, particleSortPipeline, nullptr);
+    vkDestroyPipelineLayout(device, particleSortPipelineLayout, nullptr);
+    vkDestroyPipelineLayout(device, computeParticlePipelineLayout, nullptr);
+    vkDestroyDescriptorSetLayout(device, computeParticleSetLayout, nullptr);
 
 
     // Clean up textures
+    assetStreamer.shutdown();
     textureManager.cleanup();
 
+    // Clean up GPU-driven scene resources
+    for (size_t i = 0; i < sceneDrawBuffers.size(); i++) {
+        memoryAllocator.destroyBuffer(sceneDrawBuffers[i], sceneDrawBuffersAllocations[i]);
+    }
+    memoryAllocator.destroyBuffer(sceneObjectBuffer, sceneObjectBufferAllocation);
+    memoryAllocator.destroyBuffer(materialBuffer, materialBufferAllocation);
+    vkDestroyPipeline(device, indirectGraphicsPipeline, nullptr);
+    vkDestroyPipelineLayout(device, indirectPipelineLayout, nullptr);
+    vkDestroyPipeline(device, sceneCullPipeline, nullptr);
+    vkDestroyPipelineLayout(device, sceneCullPipelineLayout, nullptr);
+    vkDestroyDescriptorSetLayout(device, sceneCullSetLayout, nullptr);
+
+    // Clean up meshlet resources
+    for (size_t i = 0; i < meshletIndexBuffers.size(); i++) {
+        memoryAllocator.destroyBuffer(meshletIndexBuffers[i], meshletIndexBuffersAllocations[i]);
+        memoryAllocator.destroyBuffer(meshletDrawBuffers[i], meshletDrawBuffersAllocations[i]);
+    }
+    memoryAllocator.destroyBuffer(meshletTriangleBuffer, meshletTriangleBufferAllocation);
+    memoryAllocator.destroyBuffer(meshletVertexBuffer, meshletVertexBufferAllocation);
+    memoryAllocator.destroyBuffer(meshletBuffer, meshletBufferAllocation);
+    vkDestroyPipeline(device, meshletGraphicsPipeline, nullptr);
+    vkDestroyPipelineLayout(device, meshletPipelineLayout, nullptr);
+    vkDestroyPipeline(device, meshletCullPipeline, nullptr);
+    vkDestroyPipelineLayout(device, meshletCullPipelineLayout, nullptr);
+    vkDestroyDescriptorSetLayout(device, meshletSetLayout, nullptr);
+
+    vkDestroyPipeline(device, cactusInstancedPipeline, nullptr);
+    vkDestroyPipeline(device, gouraudPipeline, nullptr);
+    vkDestroyPipeline(device, depthPrepassPipeline, nullptr);
+    vkDestroyPipeline(device, depthPrepassIndirectPipeline, nullptr);
+    vkDestroyPipeline(device, depthPrepassCactusPipeline, nullptr);
     vkDestroyPipeline(device, graphicsPipeline, nullptr);
     vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
     vkDestroyDescriptorSetLayout(device, descriptorSetLayout, nullptr);
 
-    vkDestroyBuffer(device, indexBuffer, nullptr);
-    vkFreeMemory(device, indexBufferMemory, nullptr);
+    memoryAllocator.destroyBuffer(indexBuffer, indexBufferAllocation);
+    memoryAllocator.destroyBuffer(vertexBuffer, vertexBufferAllocation);
 
-    vkDestroyBuffer(device, vertexBuffer, nullptr);
-    vkFreeMemory(device, vertexBufferMemory, nullptr);
-
-    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
-        vkDestroyBuffer(device, uniformBuffers[i], nullptr);
-        vkFreeMemory(device, uniformBuffersMemory[i], nullptr);
+    for (size_t i = 0; i < framesInFlight; i++) {
+        memoryAllocator.destroyBuffer(uniformBuffers[i], uniformBuffersAllocations[i]);
     }
     vkDestroyDescriptorPool(device, descriptorPool, nullptr);
 
-    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+    for (size_t i = 0; i < framesInFlight; i++) {
         vkDestroySemaphore(device, renderFinishedSemaphores[i], nullptr);
         vkDestroySemaphore(device, imageAvailableSemaphores[i], nullptr);
         vkDestroyFence(device, inFlightFences[i], nullptr);
     }
 
+    recordPools.cleanup();
     vkDestroyCommandPool(device, commandPool, nullptr);
+    pipelineCache.save();
+    pipelineCache.cleanup();
+    Profiler::instance().cleanupGpu();
+    uploadManager.cleanup();
+    memoryAllocator.cleanup();
     vkDestroyDevice(device, nullptr);
 
     if (enableValidationLayers) {
         DestroyDebugUtilsMessengerEXT(instance, debugMessenger, nullptr);
     }
 
-    vkDestroySurfaceKHR(instance, surface, nullptr);
+    if (surface != VK_NULL_HANDLE) {
+        vkDestroySurfaceKHR(instance, surface, nullptr);
+    }
     vkDestroyInstance(instance, nullptr);
 
-    glfwDestroyWindow(window);
-    glfwTerminate();
+    if (window) {
+        glfwDestroyWindow(window);
+        glfwTerminate();
+    }
 }
 
 void HelloTriangleApplication::createInstance() {
@@ -563,6 +1228,7 @@ void HelloTriangleApplication::setupDebugMessenger() {
 }
 
 void HelloTriangleApplication::createSurface() {
+    if (isOffscreen()) return;
     if (glfwCreateWindowSurface(instance, window, nullptr, &surface) != VK_SUCCESS) {
         throw std::runtime_error("Failed to create window surface!");
     }
@@ -593,6 +1259,9 @@ void HelloTriangleApplication::createLogicalDevice() {
     QueueFamilyIndices indices = findQueueFamilies(physicalDevice);
     std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
     std::set<uint32_t> uniqueQueueFamilies = { indices.graphicsFamily.value(), indices.presentFamily.value() };
+    if (indices.transferFamily.has_value()) {
+        uniqueQueueFamilies.insert(indices.transferFamily.value());
+    }
 
     float queuePriority = 1.0f;
     for (uint32_t queueFamily : uniqueQueueFamilies) {
@@ -613,9 +1282,60 @@ void HelloTriangleApplication::createLogicalDevice() {
     sync2Features.synchronization2 = VK_TRUE;
     dynamicRenderingFeatures.pNext = &sync2Features;
 
+    // GPU-driven rendering is optional: enable it only where supported
+    VkPhysicalDeviceVulkan12Features supported12{};
+    supported12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    VkPhysicalDeviceFeatures2 supportedFeatures{};
+    supportedFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    supportedFeatures.pNext = &supported12;
+
+    // So are mesh shaders: the extension plus both task and mesh stages
+    uint32_t extensionCount = 0;
+    vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, nullptr);
+    std::vector<VkExtensionProperties> availableExtensions(extensionCount);
+    vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, availableExtensions.data());
+    bool meshShaderExtension = std::any_of(availableExtensions.begin(), availableExtensions.end(),
+        [](const VkExtensionProperties& extension) {
+            return strcmp(extension.extensionName, VK_EXT_MESH_SHADER_EXTENSION_NAME) == 0;
+        });
+    VkPhysicalDeviceMeshShaderFeaturesEXT supportedMeshShader{};
+    supportedMeshShader.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_FEATURES_EXT;
+    if (meshShaderExtension) {
+        supported12.pNext = &supportedMeshShader;
+    }
+
+    vkGetPhysicalDeviceFeatures2(physicalDevice, &supportedFeatures);
+    gpuDrivenSupported = supported12.drawIndirectCount && supportedFeatures.features.drawIndirectFirstInstance;
+    if (!hasBindlessSupport(supported12)) {
+        throw std::runtime_error("Failed to find descriptor indexing support for bindless textures!");
+    }
+    meshShaderSupported = meshShaderExtension && supportedMeshShader.taskShader && supportedMeshShader.meshShader;
+    samplerAnisotropySupported = supportedFeatures.features.samplerAnisotropy == VK_TRUE;
+
+    // Timeline semaphores signal upload completion (core since 1.2)
+    VkPhysicalDeviceVulkan12Features vulkan12Features{};
+    vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    vulkan12Features.timelineSemaphore = VK_TRUE;
+    vulkan12Features.drawIndirectCount = gpuDrivenSupported ? VK_TRUE : VK_FALSE;
+    vulkan12Features.runtimeDescriptorArray = VK_TRUE;
+    vulkan12Features.descriptorBindingPartiallyBound = VK_TRUE;
+    vulkan12Features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+    vulkan12Features.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+    sync2Features.pNext = &vulkan12Features;
+
+    VkPhysicalDeviceMeshShaderFeaturesEXT meshShaderFeatures{};
+    meshShaderFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_FEATURES_EXT;
+    meshShaderFeatures.taskShader = VK_TRUE;
+    meshShaderFeatures.meshShader = VK_TRUE;
+    if (meshShaderSupported) {
+        vulkan12Features.pNext = &meshShaderFeatures;
+    }
+
     VkPhysicalDeviceFeatures2 deviceFeatures2{};
     deviceFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
     deviceFeatures2.pNext = &dynamicRenderingFeatures;
+    deviceFeatures2.features.drawIndirectFirstInstance = gpuDrivenSupported ? VK_TRUE : VK_FALSE;
+    deviceFeatures2.features.samplerAnisotropy = samplerAnisotropySupported ? VK_TRUE : VK_FALSE;
 
     VkDeviceCreateInfo createInfo{};
     createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
@@ -623,8 +1343,12 @@ void HelloTriangleApplication::createLogicalDevice() {
     createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
     createInfo.pQueueCreateInfos = queueCreateInfos.data();
     createInfo.pEnabledFeatures = nullptr;
-    createInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size());
-    createInfo.ppEnabledExtensionNames = deviceExtensions.data();
+    std::vector<const char*> extensions = getDeviceExtensions();
+    if (meshShaderSupported) {
+        extensions.push_back(VK_EXT_MESH_SHADER_EXTENSION_NAME);
+    }
+    createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+    createInfo.ppEnabledExtensionNames = extensions.data();
 
     if (enableValidationLayers) {
         createInfo.enabledLayerCount = static_cast<uint32_t>(validationLayers.size());
@@ -638,11 +1362,27 @@ void HelloTriangleApplication::createLogicalDevice() {
         throw std::runtime_error("Failed to create logical device!");
     }
 
+    if (meshShaderSupported) {
+        cmdDrawMeshTasks = (PFN_vkCmdDrawMeshTasksEXT)vkGetDeviceProcAddr(device, "vkCmdDrawMeshTasksEXT");
+        meshShaderSupported = cmdDrawMeshTasks != nullptr;
+    }
+
     vkGetDeviceQueue(device, indices.graphicsFamily.value(), 0, &graphicsQueue);
     vkGetDeviceQueue(device, indices.presentFamily.value(), 0, &presentQueue);
+    if (indices.transferFamily.has_value()) {
+        vkGetDeviceQueue(device, indices.transferFamily.value(), 0, &transferQueue);
+    }
+    else {
+        transferQueue = graphicsQueue;
+    }
 }
 
 void HelloTriangleApplication::createSwapChain() {
+    if (isOffscreen()) {
+        createOffscreenTargets();
+        return;
+    }
+
     SwapChainSupportDetails swapChainSupport = querySwapChainSupport(physicalDevice);
     VkSurfaceFormatKHR surfaceFormat = chooseSwapSurfaceFormat(swapChainSupport.formats);
     VkPresentModeKHR presentMode = chooseSwapPresentMode(swapChainSupport.presentModes);
@@ -720,21 +1460,46 @@ void HelloTriangleApplication::createDescriptorSetLayout() {
     uboLayoutBinding.descriptorCount = 1;
     uboLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
     uboLayoutBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+    if (meshShaderSupported) {
+        // meshlet.task culls against the view, meshlet.mesh transforms
+        uboLayoutBinding.stageFlags |= VK_SHADER_STAGE_TASK_BIT_EXT | VK_SHADER_STAGE_MESH_BIT_EXT;
+    }
 
-    // Binding 1: Texture sampler
+    // Binding 1: Bindless texture array, indexed by material
     VkDescriptorSetLayoutBinding samplerLayoutBinding{};
     samplerLayoutBinding.binding = 1;
-    samplerLayoutBinding.descriptorCount = 1;
+    samplerLayoutBinding.descriptorCount = MAX_BINDLESS_TEXTURES;
     samplerLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
     samplerLayoutBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
     samplerLayoutBinding.pImmutableSamplers = nullptr;
 
-    std::array<VkDescriptorSetLayoutBinding, 2> bindings = {
-        uboLayoutBinding, samplerLayoutBinding
+    // Binding 2: Material buffer (gouraud.vert reads the specular terms per vertex)
+    VkDescriptorSetLayoutBinding materialLayoutBinding{};
+    materialLayoutBinding.binding = 2;
+    materialLayoutBinding.descriptorCount = 1;
+    materialLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    materialLayoutBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+
+    std::array<VkDescriptorSetLayoutBinding, 3> bindings = {
+        uboLayoutBinding, samplerLayoutBinding, materialLayoutBinding
+    };
+
+    // Unused texture slots stay empty, and new textures can be written
+    // while earlier frames that bound the set are still in flight
+    std::array<VkDescriptorBindingFlags, 3> bindingFlags = {
+        0u,
+        static_cast<VkDescriptorBindingFlags>(VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT),
+        0u
     };
+    VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo{};
+    bindingFlagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+    bindingFlagsInfo.bindingCount = static_cast<uint32_t>(bindingFlags.size());
+    bindingFlagsInfo.pBindingFlags = bindingFlags.data();
 
     VkDescriptorSetLayoutCreateInfo layoutInfo{};
     layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.pNext = &bindingFlagsInfo;
+    layoutInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
     layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
     layoutInfo.pBindings = bindings.data();
 
@@ -744,129 +1509,110 @@ void HelloTriangleApplication::createDescriptorSetLayout() {
 }
 
 void HelloTriangleApplication::createGraphicsPipeline() {
-    auto vertShaderCode = readFile("shaders/vert.spv");
-    auto fragShaderCode = readFile("shaders/frag.spv");
-
-    VkShaderModule vertShaderModule = createShaderModule(vertShaderCode);
-    VkShaderModule fragShaderModule = createShaderModule(fragShaderCode);
-
-    VkPipelineShaderStageCreateInfo vertShaderStageInfo{};
-    vertShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-    vertShaderStageInfo.stage = VK_SHADER_STAGE_VERTEX_BIT;
-    vertShaderStageInfo.module = vertShaderModule;
-    vertShaderStageInfo.pName = "main";
-
-    VkPipelineShaderStageCreateInfo fragShaderStageInfo{};
-    fragShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-    fragShaderStageInfo.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
-    fragShaderStageInfo.module = fragShaderModule;
-    fragShaderStageInfo.pName = "main";
-
-    VkPipelineShaderStageCreateInfo shaderStages[] = { vertShaderStageInfo, fragShaderStageInfo };
-
-    auto bindingDescription = Vertex::getBindingDescription();
-    auto attributeDescriptions = Vertex::getAttributeDescriptions();
-
-    VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
-    vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-    vertexInputInfo.vertexBindingDescriptionCount = 1;
-    vertexInputInfo.pVertexBindingDescriptions = &bindingDescription;
-    vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
-    vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
-
-    VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
-    inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
-    inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
-    inputAssembly.primitiveRestartEnable = VK_FALSE; 
-
-    //VkProvokingVertexModeEXT provokingVertexMode = VK_PROVOKING_VERTEX_MODE_FIRST_VERTEX_EXT;
-
-    VkPipelineViewportStateCreateInfo viewportState{};
-    viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
-    viewportState.viewportCount = 1;
-    viewportState.scissorCount = 1;
-
-    VkPipelineRasterizationStateCreateInfo rasterizer{};
-    rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
-    rasterizer.depthClampEnable = VK_FALSE;
-    rasterizer.rasterizerDiscardEnable = VK_FALSE;
-    rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
-    rasterizer.lineWidth = 1.0f;
-    rasterizer.cullMode = VK_CULL_MODE_BACK_BIT;
-    rasterizer.frontFace =  VK_FRONT_FACE_COUNTER_CLOCKWISE;
-    rasterizer.depthBiasEnable = VK_FALSE;
-
-    VkPipelineMultisampleStateCreateInfo multisampling{};
-    multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
-    multisampling.sampleShadingEnable = VK_FALSE;
-    multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
-
-	// Depth and Stencil State
-    VkPipelineDepthStencilStateCreateInfo depthStencil{};
-    depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
-    depthStencil.depthTestEnable = VK_TRUE;
-    depthStencil.depthWriteEnable = VK_TRUE;
-    depthStencil.depthCompareOp = VK_COMPARE_OP_LESS;
-    depthStencil.depthBoundsTestEnable = VK_FALSE;
-    depthStencil.stencilTestEnable = VK_FALSE;
-
-
-    VkPipelineColorBlendAttachmentState colorBlendAttachment{};
-    colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
-    colorBlendAttachment.blendEnable = VK_FALSE;
-
-    VkPipelineColorBlendStateCreateInfo colorBlending{};
-    colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
-    colorBlending.logicOpEnable = VK_FALSE;
-    colorBlending.attachmentCount = 1;
-    colorBlending.pAttachments = &colorBlendAttachment;
-
-    std::vector<VkDynamicState> dynamicStates = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
-    VkPipelineDynamicStateCreateInfo dynamicState{};
-    dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
-    dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
-    dynamicState.pDynamicStates = dynamicStates.data();
-
     VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
     pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
     pipelineLayoutInfo.setLayoutCount = 1;
     pipelineLayoutInfo.pSetLayouts = &descriptorSetLayout;
 
+    // Per-object model and normal matrices
+    VkPushConstantRange objectPushRange{};
+    objectPushRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+    objectPushRange.offset = 0;
+    objectPushRange.size = sizeof(ObjectPushConstants);
+    pipelineLayoutInfo.pushConstantRangeCount = 1;
+    pipelineLayoutInfo.pPushConstantRanges = &objectPushRange;
+
     if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
         throw std::runtime_error("Failed to create pipeline layout!");
     }
 
-    VkFormat depthFormat = findDepthFormat();
-
-    VkPipelineRenderingCreateInfo renderingCreateInfo{};
-    renderingCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO;
-    renderingCreateInfo.colorAttachmentCount = 1;
-    renderingCreateInfo.pColorAttachmentFormats = &swapChainImageFormat;
-    renderingCreateInfo.depthAttachmentFormat = depthFormat;
-
-    VkGraphicsPipelineCreateInfo pipelineInfo{};
-    pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-    pipelineInfo.pNext = &renderingCreateInfo;
-    pipelineInfo.stageCount = 2;
-    pipelineInfo.pStages = shaderStages;
-    pipelineInfo.pVertexInputState = &vertexInputInfo;
-    pipelineInfo.pInputAssemblyState = &inputAssembly;
-    pipelineInfo.pViewportState = &viewportState;
-    pipelineInfo.pRasterizationState = &rasterizer;
-    pipelineInfo.pMultisampleState = &multisampling;
-    pipelineInfo.pColorBlendState = &colorBlending;
-    pipelineInfo.pDynamicState = &dynamicState;
-    pipelineInfo.layout = pipelineLayout;
-    pipelineInfo.renderPass = VK_NULL_HANDLE;
-    pipelineInfo.subpass = 0;
-    pipelineInfo.pDepthStencilState = &depthStencil;
-
-    if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &graphicsPipeline) != VK_SUCCESS) {
-        throw std::runtime_error("Failed to create graphics pipeline!");
+    // Packed variants: same shaders built with PACKED_VERTEX (see the pre-build step)
+    const bool packedVertices = vertexFormat == VertexFormat::Packed;
+    auto bindingDescription = packedVertices ? PackedVertex::getBindingDescription() : Vertex::getBindingDescription();
+    auto attributeDescriptions = packedVertices ? PackedVertex::getAttributeDescriptions(positionEncoding)
+                                                : Vertex::getAttributeDescriptions();
+
+    // Phong (per-pixel); the variants below only swap shaders, inputs and layout
+    PipelineRegistry::GraphicsDesc phong;
+    phong.name = "graphics";
+    phong.stages = {
+        { VK_SHADER_STAGE_VERTEX_BIT, packedVertices ? "shaders/vert_packed.spv" : "shaders/vert.spv" },
+        { VK_SHADER_STAGE_FRAGMENT_BIT, "shaders/frag.spv" } };
+    phong.bindings = { bindingDescription };
+    phong.attributes.assign(attributeDescriptions.begin(), attributeDescriptions.end());
+    phong.layout = pipelineLayout;
+    phong.colorFormat = swapChainImageFormat;
+    phong.depthFormat = depthFormat;
+    phong.dynamicDepth = true;
+    pipelineRegistry.addGraphics(phong, &graphicsPipeline);
+
+    // Depth pre-pass: vertex stage only, and the same vertex shaders as the
+    // color pass so positions match bit for bit (gl_Position is invariant)
+    PipelineRegistry::GraphicsDesc prepass = phong;
+    prepass.name = "depth pre-pass";
+    prepass.stages.resize(1);
+    prepass.depthOnly = true;
+    prepass.dynamicDepth = false;
+    pipelineRegistry.addGraphics(prepass, &depthPrepassPipeline);
+
+    // Gouraud (per-vertex), selectable at runtime for the per-object draw path
+    PipelineRegistry::GraphicsDesc gouraud = phong;
+    gouraud.name = "Gouraud";
+    gouraud.stages = {
+        { VK_SHADER_STAGE_VERTEX_BIT, packedVertices ? "shaders/gouraud_vert_packed.spv" : "shaders/gouraud_vert.spv" },
+        { VK_SHADER_STAGE_FRAGMENT_BIT, "shaders/gouraud_frag.spv" } };
+    pipelineRegistry.addGraphics(gouraud, &gouraudPipeline);
+
+    // GPU-driven variant: same state, transforms pulled from the object buffer
+    if (gpuDrivenSupported) {
+        PipelineRegistry::GraphicsDesc indirect = phong;
+        indirect.name = "indirect graphics";
+        indirect.stages[0].path = packedVertices ? "shaders/scene_indirect_vert_packed.spv" : "shaders/scene_indirect_vert.spv";
+        indirect.layout = indirectPipelineLayout;
+        pipelineRegistry.addGraphics(indirect, &indirectGraphicsPipeline);
+
+        PipelineRegistry::GraphicsDesc indirectPrepass = prepass;
+        indirectPrepass.name = "indirect depth pre-pass";
+        indirectPrepass.stages[0].path = indirect.stages[0].path;
+        indirectPrepass.layout = indirectPipelineLayout;
+        pipelineRegistry.addGraphics(indirectPrepass, &depthPrepassIndirectPipeline);
     }
 
-    vkDestroyShaderModule(device, fragShaderModule, nullptr);
-    vkDestroyShaderModule(device, vertShaderModule, nullptr);
+    // Instanced cactus variant: second vertex binding with per-instance data
+    auto instanceAttributes = CactusInstance::getAttributeDescriptions();
+    PipelineRegistry::GraphicsDesc instanced = phong;
+    instanced.name = "instanced cactus";
+    instanced.stages[0].path = packedVertices ? "shaders/cactus_instanced_vert_packed.spv" : "shaders/cactus_instanced_vert.spv";
+    instanced.bindings.push_back(CactusInstance::getBindingDescription());
+    instanced.attributes.insert(instanced.attributes.end(), instanceAttributes.begin(), instanceAttributes.end());
+    pipelineRegistry.addGraphics(instanced, &cactusInstancedPipeline);
+
+    PipelineRegistry::GraphicsDesc instancedPrepass = instanced;
+    instancedPrepass.name = "instanced cactus depth pre-pass";
+    instancedPrepass.stages.resize(1);
+    instancedPrepass.depthOnly = true;
+    instancedPrepass.dynamicDepth = false;
+    pipelineRegistry.addGraphics(instancedPrepass, &depthPrepassCactusPipeline);
+
+    // Meshlet variant: task + mesh stages replace vertex input and assembly
+    if (meshShaderSupported) {
+        // Vertex pulling decodes in the shader, so the position encoding needs its own variant
+        const char* meshShaderFile = !packedVertices ? "shaders/meshlet_mesh.spv"
+            : positionEncoding == PositionEncoding::Half ? "shaders/meshlet_mesh_packed_half.spv"
+            : "shaders/meshlet_mesh_packed.spv";
+
+        PipelineRegistry::GraphicsDesc meshlet = phong;
+        meshlet.name = "meshlet graphics";
+        meshlet.stages = {
+            { VK_SHADER_STAGE_TASK_BIT_EXT, "shaders/meshlet_task.spv" },
+            { VK_SHADER_STAGE_MESH_BIT_EXT, meshShaderFile },
+            { VK_SHADER_STAGE_FRAGMENT_BIT, "shaders/frag.spv" } };
+        meshlet.bindings.clear();
+        meshlet.attributes.clear();
+        meshlet.meshShading = true;
+        meshlet.layout = meshletPipelineLayout;
+        pipelineRegistry.addGraphics(meshlet, &meshletGraphicsPipeline);
+    }
 }
 
 void HelloTriangleApplication::createCommandPool() {
@@ -881,67 +1627,117 @@ void HelloTriangleApplication::createCommandPool() {
 }
 
 void HelloTriangleApplication::createVertexBuffer() {
-    VkDeviceSize bufferSize = sizeof(vertices[0]) * vertices.size();
-    VkBuffer stagingBuffer;
-    VkDeviceMemory stagingBufferMemory;
-    createBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer, stagingBufferMemory);
-
-    void* data;
-    vkMapMemory(device, stagingBufferMemory, 0, bufferSize, 0, &data);
-    memcpy(data, vertices.data(), (size_t)bufferSize);
-    vkUnmapMemory(device, stagingBufferMemory);
-
-    createBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, vertexBuffer, vertexBufferMemory);
-    copyBuffer(stagingBuffer, vertexBuffer, bufferSize);
-
-    vkDestroyBuffer(device, stagingBuffer, nullptr);
-    vkFreeMemory(device, stagingBufferMemory, nullptr);
+    const std::vector<Vertex>& vertices = scene.getVertices();
+
+    // The scene keeps full-precision vertices; only the GPU copy is packed
+    std::vector<PackedVertex> packedVertices;
+    const void* vertexData = vertices.data();
+    VkDeviceSize bufferSize = sizeof(Vertex) * vertices.size();
+    positionDecode = PositionDecode();
+    if (vertexFormat == VertexFormat::Packed) {
+        packedVertices = PackedVertex::packAll(vertices, positionEncoding, positionDecode);
+        vertexData = packedVertices.data();
+        bufferSize = sizeof(PackedVertex) * packedVertices.size();
+    }
+    std::cout << "Vertex buffer: " << (vertexFormat == VertexFormat::Full ? "full"
+        : positionEncoding == PositionEncoding::Half ? "packed (half positions)" : "packed (unorm16 positions)")
+        << ", " << bufferSize / 1024 << " KB" << std::endl;
+
+    // Storage too: meshlet.mesh pulls vertices instead of using vertex input
+    createBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+        DeviceMemoryAllocator::Pool::DeviceLocal, vertexBuffer, vertexBufferAllocation);
+    uploadManager.uploadBuffer(vertexBuffer, vertexData, bufferSize);
 }
 
 void HelloTriangleApplication::createIndexBuffer() {
-    VkDeviceSize bufferSize = sizeof(uint32_t) * indices.size();
-    VkBuffer stagingBuffer;
-    VkDeviceMemory stagingBufferMemory;
-    createBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer, stagingBufferMemory);
+    const std::vector<uint32_t>& indices = scene.getIndices();
 
-    void* data;
-    vkMapMemory(device, stagingBufferMemory, 0, bufferSize, 0, &data);
-    memcpy(data, indices.data(), (size_t)bufferSize);
-    vkUnmapMemory(device, stagingBufferMemory);
-
-    createBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, indexBuffer, indexBufferMemory);
-    copyBuffer(stagingBuffer, indexBuffer, bufferSize);
+    // Half the index bandwidth when no mesh needs more than 16 bits
+    std::vector<uint16_t> shortIndices;
+    const void* indexData = indices.data();
+    VkDeviceSize bufferSize = sizeof(uint32_t) * indices.size();
+    indexType = VK_INDEX_TYPE_UINT32;
+    if (scene.fitsUint16Indices()) {
+        shortIndices.reserve(indices.size());
+        for (uint32_t index : indices) shortIndices.push_back(static_cast<uint16_t>(index));
+        indexData = shortIndices.data();
+        bufferSize = sizeof(uint16_t) * shortIndices.size();
+        indexType = VK_INDEX_TYPE_UINT16;
+    }
+    std::cout << "Index buffer: " << (indexType == VK_INDEX_TYPE_UINT16 ? "16" : "32") << "-bit, "
+        << bufferSize / 1024 << " KB" << std::endl;
 
-    vkDestroyBuffer(device, stagingBuffer, nullptr);
-    vkFreeMemory(device, stagingBufferMemory, nullptr);
+    createBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, DeviceMemoryAllocator::Pool::DeviceLocal, indexBuffer, indexBufferAllocation);
+    uploadManager.uploadBuffer(indexBuffer, indexData, bufferSize);
 }
 
 void HelloTriangleApplication::createUniformBuffers() {
     VkDeviceSize bufferSize = sizeof(UniformBufferObject);
-    uniformBuffers.resize(MAX_FRAMES_IN_FLIGHT);
-    uniformBuffersMemory.resize(MAX_FRAMES_IN_FLIGHT);
-    uniformBuffersMapped.resize(MAX_FRAMES_IN_FLIGHT);
-
-    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
-        createBuffer(bufferSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, uniformBuffers[i], uniformBuffersMemory[i]);
-        vkMapMemory(device, uniformBuffersMemory[i], 0, bufferSize, 0, &uniformBuffersMapped[i]);
+    uniformBuffers.resize(framesInFlight);
+    uniformBuffersAllocations.resize(framesInFlight);
+    uniformBuffersMapped.resize(framesInFlight);
+
+    for (size_t i = 0; i < framesInFlight; i++) {
+        // HostVisible pool blocks are persistently mapped by the allocator
+        createBuffer(bufferSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, DeviceMemoryAllocator::Pool::HostVisible, uniformBuffers[i], uniformBuffersAllocations[i]);
+        uniformBuffersMapped[i] = uniformBuffersAllocations[i].mapped;
     }
 }
 
+void HelloTriangleApplication::createMaterials() {
+    materials.clear();
+
+    // Sand is matte and textured; the globe and cacti keep their vertex colors
+    GpuMaterial sand;
+    sand.albedoTexture = static_cast<uint32_t>(sandTextureIndex);
+    sand.specularStrength = 0.1f;
+    sand.shininess = 4.0f;
+    groundMaterial = materials.add("Sand", sand);
+
+    GpuMaterial glass;
+    glass.albedoTexture = MaterialLibrary::NO_TEXTURE;
+    glass.specularStrength = 0.5f;
+    glass.shininess = 32.0f;
+    globeMaterial = materials.add("Globe", glass);
+
+    GpuMaterial cactus;
+    cactus.albedoTexture = MaterialLibrary::NO_TEXTURE;
+    cactus.specularStrength = 0.5f;
+    cactus.shininess = 32.0f;
+    cactusMaterial = materials.add("Cactus", cactus);
+}
+
+void HelloTriangleApplication::createMaterialBuffer() {
+    // Static after load, like the scene object buffer
+    VkDeviceSize bufferSize = sizeof(GpuMaterial) * materials.getCount();
+    createBuffer(bufferSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        DeviceMemoryAllocator::Pool::DeviceLocal, materialBuffer, materialBufferAllocation);
+    uploadManager.uploadBuffer(materialBuffer, materials.getMaterials().data(), bufferSize);
+}
+
 void HelloTriangleApplication::createDescriptorPool() {
-    std::array<VkDescriptorPoolSize, 2> poolSizes{};
+    std::array<VkDescriptorPoolSize, 3> poolSizes{};
 
+    // Scene sets + GPU particle sets each take one UBO per frame
     poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-    poolSizes[0].descriptorCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
+    poolSizes[0].descriptorCount = static_cast<uint32_t>(framesInFlight * 2);
 
+    // Scene sets hold the whole bindless texture array
     poolSizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    poolSizes[1].descriptorCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
+    poolSizes[1].descriptorCount = static_cast<uint32_t>(framesInFlight * MAX_BINDLESS_TEXTURES);
 
+    // Scene sets take the material buffer, GPU particles two storage buffers
+    // per frame (state + sort order), scene culling two, meshlets six
+    poolSizes[2].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    poolSizes[2].descriptorCount = static_cast<uint32_t>(framesInFlight * 11);
+
+    // Required by the scene set layout; the other layouts allocate from it as usual
     VkDescriptorPoolCreateInfo poolInfo{};
     poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
     poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
     poolInfo.pPoolSizes = poolSizes.data();
-    poolInfo.maxSets = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
+    poolInfo.maxSets = static_cast<uint32_t>(framesInFlight * 4);
 
     if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS) {
         throw std::runtime_error("Failed to create descriptor pool!");
@@ -949,25 +1745,28 @@ void HelloTriangleApplication::createDescriptorPool() {
 }
 
 void HelloTriangleApplication::createDescriptorSets() {
-    std::vector<VkDescriptorSetLayout> layouts(MAX_FRAMES_IN_FLIGHT, descriptorSetLayout);
+    std::vector<VkDescriptorSetLayout> layouts(framesInFlight, descriptorSetLayout);
     VkDescriptorSetAllocateInfo allocInfo{};
     allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
     allocInfo.descriptorPool = descriptorPool;
-    allocInfo.descriptorSetCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
+    allocInfo.descriptorSetCount = static_cast<uint32_t>(framesInFlight);
     allocInfo.pSetLayouts = layouts.data();
 
-    descriptorSets.resize(MAX_FRAMES_IN_FLIGHT);
+    descriptorSets.resize(framesInFlight);
     if (vkAllocateDescriptorSets(device, &allocInfo, descriptorSets.data()) != VK_SUCCESS) {
         throw std::runtime_error("Failed to allocate descriptor sets!");
     }
 
-    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+    for (size_t i = 0; i < framesInFlight; i++) {
         VkDescriptorBufferInfo bufferInfo{};
         bufferInfo.buffer = uniformBuffers[i];
         bufferInfo.offset = 0;
         bufferInfo.range = sizeof(UniformBufferObject);
 
-        VkDescriptorImageInfo imageInfo = textureManager.getDescriptorInfo(sandTextureIndex);
+        VkDescriptorBufferInfo materialInfo{};
+        materialInfo.buffer = materialBuffer;
+        materialInfo.offset = 0;
+        materialInfo.range = VK_WHOLE_SIZE;
 
         std::array<VkWriteDescriptorSet, 2> descriptorWrites{};
 
@@ -980,18 +1779,64 @@ void HelloTriangleApplication::createDescriptorSets() {
 
         descriptorWrites[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
         descriptorWrites[1].dstSet = descriptorSets[i];
-        descriptorWrites[1].dstBinding = 1;
-        descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        descriptorWrites[1].dstBinding = 2;
+        descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
         descriptorWrites[1].descriptorCount = 1;
-        descriptorWrites[1].pImageInfo = &imageInfo;
+        descriptorWrites[1].pBufferInfo = &materialInfo;
 
         vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptorWrites.size()),
             descriptorWrites.data(), 0, nullptr);
     }
+
+    bindlessSlotVersions.assign(framesInFlight, {});
+    for (uint32_t i = 0; i < framesInFlight; i++) {
+        updateBindlessTextures(i);
+    }
+}
+
+void HelloTriangleApplication::updateBindlessTextures(uint32_t frame) {
+    // Textures come and go while streaming and released slots get reused, so
+    // each set is brought up to date on its own frame: only that set is idle
+    uint32_t textureCount = static_cast<uint32_t>(textureManager.getTextureCount());
+    if (textureCount > STREAMED_TEXTURE_SLOT_BASE) {
+        throw std::runtime_error("Failed to fit textures in the bindless array!");
+    }
+
+    std::vector<uint32_t>& written = bindlessSlotVersions[frame];
+    written.resize(textureCount, 0);
+    std::vector<VkDescriptorImageInfo> imageInfos;
+    std::vector<uint32_t> slots;
+    for (uint32_t slot = 0; slot < textureCount; slot++) {
+        uint32_t version = textureManager.getSlotVersion(static_cast<int32_t>(slot));
+        if (version == written[slot]) continue;
+        written[slot] = version;
+
+        // Released slots get the placeholder: no set keeps a destroyed view
+        VkDescriptorImageInfo imageInfo = textureManager.getDescriptorInfo(static_cast<int32_t>(slot));
+        if (imageInfo.imageView == VK_NULL_HANDLE) {
+            imageInfo = assetStreamer.getPlaceholderDescriptor();
+        }
+        imageInfos.push_back(imageInfo);
+        slots.push_back(slot);
+    }
+    if (slots.empty()) return;
+
+    std::vector<VkWriteDescriptorSet> descriptorWrites(slots.size());
+    for (size_t t = 0; t < slots.size(); t++) {
+        VkWriteDescriptorSet& write = descriptorWrites[t];
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = descriptorSets[frame];
+        write.dstBinding = 1;
+        write.dstArrayElement = slots[t];
+        write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        write.descriptorCount = 1;
+        write.pImageInfo = &imageInfos[t];
+    }
+    vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
 }
 
 void HelloTriangleApplication::createCommandBuffers() {
-    commandBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+    commandBuffers.resize(framesInFlight);
     VkCommandBufferAllocateInfo allocInfo{};
     allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
     allocInfo.commandPool = commandPool;
@@ -1003,9 +1848,9 @@ void HelloTriangleApplication::createCommandBuffers() {
 }
 
 void HelloTriangleApplication::createSyncObjects() {
-    imageAvailableSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
-    renderFinishedSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
-    inFlightFences.resize(MAX_FRAMES_IN_FLIGHT);
+    imageAvailableSemaphores.resize(framesInFlight);
+    renderFinishedSemaphores.resize(framesInFlight);
+    inFlightFences.resize(framesInFlight);
 
     VkSemaphoreCreateInfo semaphoreInfo{};
     semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
@@ -1014,7 +1859,7 @@ void HelloTriangleApplication::createSyncObjects() {
     fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
     fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
 
-    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+    for (size_t i = 0; i < framesInFlight; i++) {
         if (vkCreateSemaphore(device, &semaphoreInfo, nullptr, &imageAvailableSemaphores[i]) != VK_SUCCESS ||
             vkCreateSemaphore(device, &semaphoreInfo, nullptr, &renderFinishedSemaphores[i]) != VK_SUCCESS ||
             vkCreateFence(device, &fenceInfo, nullptr, &inFlightFences[i]) != VK_SUCCESS) {
@@ -1025,10 +1870,18 @@ void HelloTriangleApplication::createSyncObjects() {
 
 
 void HelloTriangleApplication::drawFrame() {
-    vkWaitForFences(device, 1, &inFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
+    {
+        PROFILE_SCOPE("WaitForFences");
+        vkWaitForFences(device, 1, &inFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
+    }
+    framePacer.markGpuComplete(currentFrame);
 
-    uint32_t imageIndex;
-    VkResult result = vkAcquireNextImageKHR(device, swapChain, UINT64_MAX, imageAvailableSemaphores[currentFrame], VK_NULL_HANDLE, &imageIndex);
+    uint32_t imageIndex = currentFrame;   // Offscreen: one target per frame in flight
+    VkResult result = VK_SUCCESS;
+    if (!isOffscreen()) {
+        PROFILE_SCOPE("AcquireImage");
+        result = vkAcquireNextImageKHR(device, swapChain, UINT64_MAX, imageAvailableSemaphores[currentFrame], VK_NULL_HANDLE, &imageIndex);
+    }
 
     if (result == VK_ERROR_OUT_OF_DATE_KHR) {
         recreateSwapChain();
@@ -1038,21 +1891,73 @@ void HelloTriangleApplication::drawFrame() {
         throw std::runtime_error("Failed to acquire swap chain image!");
     }
 
-    updateUniformBuffer(currentFrame);
-    updateParticles();
+    // Everything that could block (fence, acquire) is behind us: read input now
+    {
+        PROFILE_SCOPE("SampleInput");
+        sampleInput();
+    }
+    {
+        PROFILE_SCOPE("StepSimulation");
+        stepSimulation();
+    }
+    {
+        PROFILE_SCOPE("UpdateUniformBuffer");
+        updateUniformBuffer(currentFrame);
+    }
+    if (!useGpuCulling) {
+        PROFILE_SCOPE("CullScene");
+        scene.selectLods(lodCameraPosition, lodProjectionScaleFactor, lodSettings);
+        scene.cull(viewFrustum, visibleObjects);
+        scene.sortFrontToBack(visibleObjects, lodCameraPosition);
+    }
+    {
+        PROFILE_SCOPE("CullCacti");
+        updateCactusInstances();
+    }
+    {
+        PROFILE_SCOPE("UpdateParticles");
+        updateParticles();
+    }
+
+    // Start streamed uploads that fit the budget and promote finished ones,
+    // then submit everything recorded since the last frame
+    assetStreamer.update();
+    uploadManager.update();
+    {
+        PROFILE_SCOPE("Streaming");
+        updateBindlessTextures(currentFrame);
+        updateStreamedModels();
+    }
 
     vkResetFences(device, 1, &inFlightFences[currentFrame]);
     vkResetCommandBuffer(commandBuffers[currentFrame], 0);
-    recordCommandBuffer(commandBuffers[currentFrame], imageIndex);
+    recordPools.beginFrame(currentFrame);
+    {
+        PROFILE_SCOPE("RecordCommandBuffer");
+        recordCommandBuffer(commandBuffers[currentFrame], imageIndex);
+    }
+
+    // This frame's instances are already in the upload ring, so the CPU
+    // emitters can run this frame's ticks on worker threads while we submit and present
+    kickParticleSimulation(simulationSteps, simulationClock.getTick());
 
     VkCommandBufferSubmitInfo commandBufferInfo{};
     commandBufferInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
     commandBufferInfo.commandBuffer = commandBuffers[currentFrame];
 
-    VkSemaphoreSubmitInfo waitSemaphoreInfo{};
-    waitSemaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
-    waitSemaphoreInfo.semaphore = imageAvailableSemaphores[currentFrame];
-    waitSemaphoreInfo.stageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+    std::array<VkSemaphoreSubmitInfo, 2> waitSemaphoreInfos{};
+    uint32_t waitSemaphoreCount = 0;
+    if (!isOffscreen()) {
+        waitSemaphoreInfos[0].sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+        waitSemaphoreInfos[0].semaphore = imageAvailableSemaphores[currentFrame];
+        waitSemaphoreInfos[0].stageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+        waitSemaphoreCount++;
+    }
+
+    // GPU-side wait on in-flight uploads instead of idling a queue on the CPU
+    if (uploadManager.getPendingWait(waitSemaphoreInfos[waitSemaphoreCount])) {
+        waitSemaphoreCount++;
+    }
 
     VkSemaphoreSubmitInfo signalSemaphoreInfo{};
     signalSemaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
@@ -1061,15 +1966,25 @@ void HelloTriangleApplication::drawFrame() {
 
     VkSubmitInfo2 submitInfo{};
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
-    submitInfo.waitSemaphoreInfoCount = 1;
-    submitInfo.pWaitSemaphoreInfos = &waitSemaphoreInfo;
+    submitInfo.waitSemaphoreInfoCount = waitSemaphoreCount;
+    submitInfo.pWaitSemaphoreInfos = waitSemaphoreInfos.data();
     submitInfo.commandBufferInfoCount = 1;
     submitInfo.pCommandBufferInfos = &commandBufferInfo;
-    submitInfo.signalSemaphoreInfoCount = 1;
+    submitInfo.signalSemaphoreInfoCount = isOffscreen() ? 0 : 1;   // Nothing presents offscreen
     submitInfo.pSignalSemaphoreInfos = &signalSemaphoreInfo;
 
-    if (vkQueueSubmit2(graphicsQueue, 1, &submitInfo, inFlightFences[currentFrame]) != VK_SUCCESS) {
-        throw std::runtime_error("Failed to submit draw command buffer!");
+    {
+        PROFILE_SCOPE("QueueSubmit");
+        if (vkQueueSubmit2(graphicsQueue, 1, &submitInfo, inFlightFences[currentFrame]) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to submit draw command buffer!");
+        }
+    }
+    framePacer.markSubmitted(currentFrame);
+
+    // Offscreen frames end at submit; the slot's fence paces the CPU
+    if (isOffscreen()) {
+        currentFrame = (currentFrame + 1) % framesInFlight;
+        return;
     }
 
     VkPresentInfoKHR presentInfo{};
@@ -1081,17 +1996,69 @@ void HelloTriangleApplication::drawFrame() {
     presentInfo.pSwapchains = swapChains;
     presentInfo.pImageIndices = &imageIndex;
 
-    result = vkQueuePresentKHR(presentQueue, &presentInfo);
+    {
+        PROFILE_SCOPE("Present");
+        result = vkQueuePresentKHR(presentQueue, &presentInfo);
+    }
 
-    if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || framebufferResized) {
+    if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || framebufferResized || presentModeChanged) {
         framebufferResized = false;
         recreateSwapChain();
+        presentModeChanged = false;
     }
     else if (result != VK_SUCCESS) {
         throw std::runtime_error("Failed to present swap chain image!");
     }
 
-    currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+    currentFrame = (currentFrame + 1) % framesInFlight;
+}
+
+void HelloTriangleApplication::sampleInput() {
+    // Late sampling: events and held keys are read after the fence wait and
+    // image acquire, so the camera reflects input from just before recording
+    pollGpuLatency();
+    if (window) {
+        glfwPollEvents();
+    }
+    if (benchmark.isEnabled()) {
+        updateBenchmarkCamera();
+    }
+    else {
+        // Held keys step the camera a fixed amount per input tick, so its
+        // speed no longer follows the frame rate
+        uint32_t inputSteps = inputClock.advance(deltaTime);
+        for (uint32_t i = 0; i < inputSteps; i++) {
+            const Camera& camera = cameras[activeCameraIndex];
+            previousCamera = { activeCameraIndex, camera.getPosition(), camera.getTarget() };
+            inputHandler.processInput(window, inputClock.getTick());
+        }
+    }
+    framePacer.markInputSampled(currentFrame);
+}
+
+void HelloTriangleApplication::stepSimulation() {
+    // Time-scaled seconds become fixed ticks; what is left over is the
+    // alpha rendering interpolates by. CPU particles run the same ticks
+    // after recording (kickParticleSimulation), GPU particles on the queue.
+    simulationSteps = simulationClock.advance(deltaTime * timeScale);
+
+    // Held at a fixed time of day when benchmarking
+    if (!benchmark.isEnabled()) {
+        for (uint32_t i = 0; i < simulationSteps; i++) {
+            dayNightCycle.update(simulationClock.getTick());
+        }
+    }
+    renderLightState = dayNightCycle.getLightState(simulationClock.getAlpha());
+}
+
+void HelloTriangleApplication::pollGpuLatency() {
+    // Catch frames that finished while the CPU was busy elsewhere, so their
+    // "input to GPU done" isn't stretched to the next wait on their fence
+    for (uint32_t frame = 0; frame < framesInFlight; frame++) {
+        if (framePacer.isAwaitingGpu(frame) && vkGetFenceStatus(device, inFlightFences[frame]) == VK_SUCCESS) {
+            framePacer.markGpuComplete(frame);
+        }
+    }
 }
 
 void HelloTriangleApplication::recreateSwapChain() {
@@ -1110,12 +2077,19 @@ void HelloTriangleApplication::recreateSwapChain() {
 
 void HelloTriangleApplication::cleanupSwapChain() {
     vkDestroyImageView(device, depthImageView, nullptr);
-    vkDestroyImage(device, depthImage, nullptr);
-    vkFreeMemory(device, depthImageMemory, nullptr);
+    memoryAllocator.destroyImage(depthImage, depthImageAllocation);
 
     for (auto imageView : swapChainImageViews) {
         vkDestroyImageView(device, imageView, nullptr);
     }
+
+    if (isOffscreen()) {
+        for (size_t i = 0; i < swapChainImages.size(); i++) {
+            memoryAllocator.destroyImage(swapChainImages[i], offscreenImageAllocations[i]);
+        }
+        swapChainImages.clear();
+        return;
+    }
     vkDestroySwapchainKHR(device, swapChain, nullptr);
 }
 
@@ -1126,6 +2100,36 @@ void HelloTriangleApplication::recordCommandBuffer(VkCommandBuffer commandBuffer
         throw std::runtime_error("Failed to begin recording command buffer!");
     }
 
+    // Read back this slot's timestamps from its previous use and reset them
+    Profiler::instance().beginGpuFrame(commandBuffer, currentFrame);
+
+    // Draw passes record on the workers while this thread records compute and barriers
+    collectDrawPasses();
+    if (parallelRecording) {
+        kickDrawPassRecording();
+    }
+
+    // GPU particle simulation must run outside the rendering scope
+    {
+        PROFILE_GPU_SCOPE(commandBuffer, "ComputeParticles");
+        dispatchComputeParticles(commandBuffer);
+    }
+    {
+        PROFILE_GPU_SCOPE(commandBuffer, "SortComputeParticles");
+        dispatchParticleSort(commandBuffer);
+    }
+
+    if (useGpuCulling) {
+        PROFILE_GPU_SCOPE(commandBuffer, "SceneCulling");
+        dispatchSceneCulling(commandBuffer);
+    }
+
+    // The task shader culls meshlets itself; the fallback culls them here
+    if (!clusterObjects.empty() && !useMeshShaders) {
+        PROFILE_GPU_SCOPE(commandBuffer, "MeshletCulling");
+        dispatchMeshletCulling(commandBuffer);
+    }
+
     // Transition color image
     VkImageMemoryBarrier2 imageBarrierToAttachment{};
     imageBarrierToAttachment.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
@@ -1165,7 +2169,7 @@ void HelloTriangleApplication::recordCommandBuffer(VkCommandBuffer commandBuffer
     colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
 
     // Dynamic sky color from day/night cycle
-    DayNightCycle::LightState lightState = dayNightCycle.getLightState();
+    const DayNightCycle::LightState& lightState = renderLightState;
     colorAttachment.clearValue.color = { {lightState.skyColor.r, lightState.skyColor.g, lightState.skyColor.b, 1.0f} };
 
 
@@ -1186,29 +2190,20 @@ void HelloTriangleApplication::recordCommandBuffer(VkCommandBuffer commandBuffer
     renderingInfo.pColorAttachments = &colorAttachment;
     renderingInfo.pDepthAttachment = &depthAttachment;  // ADD DEPTH
 
-    vkCmdBeginRendering(commandBuffer, &renderingInfo);
-
-    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipeline);
-
-    VkViewport viewport{};
-    viewport.width = static_cast<float>(swapChainExtent.width);
-    viewport.height = static_cast<float>(swapChainExtent.height);
-    viewport.maxDepth = 1.0f;
-    vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
-
-    VkRect2D scissor{};
-    scissor.extent = swapChainExtent;
-    vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
-
-    VkBuffer vertexBuffers[] = { vertexBuffer };
-    VkDeviceSize offsets[] = { 0 };
-    vkCmdBindVertexBuffers(commandBuffer, 0, 1, vertexBuffers, offsets);
-    vkCmdBindIndexBuffer(commandBuffer, indexBuffer, 0, VK_INDEX_TYPE_UINT32);
-    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &descriptorSets[currentFrame], 0, nullptr);
-    vkCmdDrawIndexed(commandBuffer, static_cast<uint32_t>(indices.size()), 1, 0, 0, 0);
-
-    // Render particles (after main scene, before vkCmdEndRendering)
-    renderParticles(commandBuffer);
+    if (parallelRecording) {
+        waitDrawPassRecording();
+        renderingInfo.flags = VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT;
+        vkCmdBeginRendering(commandBuffer, &renderingInfo);
+        vkCmdExecuteCommands(commandBuffer, static_cast<uint32_t>(drawPassBuffers.size()), drawPassBuffers.data());
+    }
+    else {
+        vkCmdBeginRendering(commandBuffer, &renderingInfo);
+        for (const DrawPass& pass : drawPasses) {
+            PROFILE_GPU_SCOPE(commandBuffer, pass.name);
+            bindDrawState(commandBuffer, pass);
+            pass.record(commandBuffer);
+        }
+    }
 
     vkCmdEndRendering(commandBuffer);
 
@@ -1219,7 +2214,7 @@ void HelloTriangleApplication::recordCommandBuffer(VkCommandBuffer commandBuffer
     imageBarrierToPresent.srcAccessMask = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT;
     imageBarrierToPresent.dstStageMask = VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT;
     imageBarrierToPresent.oldLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-    imageBarrierToPresent.newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    imageBarrierToPresent.newLayout = finalColorLayout;
     imageBarrierToPresent.image = swapChainImages[imageIndex];
     imageBarrierToPresent.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
 
@@ -1234,45 +2229,212 @@ void HelloTriangleApplication::recordCommandBuffer(VkCommandBuffer commandBuffer
     }
 }
 
-void HelloTriangleApplication::updateUniformBuffer(uint32_t currentImage) {
-    // Update day/night cycle
-    dayNightCycle.update(deltaTime, timeScale);
-    DayNightCycle::LightState lightState = dayNightCycle.getLightState();
+void HelloTriangleApplication::collectDrawPasses() {
+    drawPasses.clear();
 
-    UniformBufferObject ubo{};
-    ubo.model = glm::mat4(1.0f);
+    // CPU-culled draws scale with the scene, so split them across the threads;
+    // the GPU-driven path is a single indirect draw
+    const uint32_t visibleCount = static_cast<uint32_t>(visibleObjects.size());
+    uint32_t chunks = 1;
+    if (!useGpuCulling && parallelRecording) {
+        chunks = std::clamp((visibleCount + SCENE_DRAWS_PER_RECORD_JOB - 1) / SCENE_DRAWS_PER_RECORD_JOB,
+                            1u, recordPools.getThreadCount());
+    }
+    auto addScenePasses = [&](const char* name, bool depthOnly, bool depthEqual) {
+        for (uint32_t chunk = 0; chunk < chunks; chunk++) {
+            uint32_t first = visibleCount * chunk / chunks;
+            uint32_t last = visibleCount * (chunk + 1) / chunks;
+            drawPasses.push_back({ name, depthEqual, [this, first, last, depthOnly](VkCommandBuffer commandBuffer) {
+                renderScene(commandBuffer, first, last, depthOnly);
+            } });
+        }
+    };
 
-    // Use active camera's view matrix
-    ubo.view = cameras[activeCameraIndex].getViewMatrix();
+    // Pre-pass lays down the nearest depth, the color pass then shades only fragments that match
+    if (useDepthPrepass) {
+        addScenePasses("Depth pre-pass", true, false);
+        drawPasses.push_back({ "Depth pre-pass", false, [this](VkCommandBuffer commandBuffer) {
+            renderCactusInstances(commandBuffer, true);
+        } });
+        if (!streamedDraws.empty()) {
+            drawPasses.push_back({ "Depth pre-pass", false, [this](VkCommandBuffer commandBuffer) {
+                renderStreamedModels(commandBuffer, true);
+            } });
+        }
+    }
+    addScenePasses("Scene", false, useDepthPrepass);
+    drawPasses.push_back({ "Cacti", useDepthPrepass, [this](VkCommandBuffer commandBuffer) {
+        renderCactusInstances(commandBuffer, false);
+    } });
+    if (!streamedDraws.empty()) {
+        drawPasses.push_back({ "Streamed models", useDepthPrepass, [this](VkCommandBuffer commandBuffer) {
+            renderStreamedModels(commandBuffer, false);
+        } });
+    }
+    // Meshlets are culled per cluster and skip the pre-pass; drawn after the
+    // pre-passed geometry, early-z still rejects whatever it already covers
+    drawPasses.push_back({ "Meshlets", false, [this](VkCommandBuffer commandBuffer) { renderMeshlets(commandBuffer); } });
+    // Particles last: blended over the opaque scene
+    drawPasses.push_back({ "Particles", false, [this](VkCommandBuffer commandBuffer) { renderParticles(commandBuffer); } });
+}
 
-    ubo.proj = glm::perspective(glm::radians(45.0f),
-        swapChainExtent.width / static_cast<float>(swapChainExtent.height),
-        0.1f, 1000.0f);
-    ubo.proj[1][1] *= -1;  // Flip Y for Vulkan
+void HelloTriangleApplication::kickDrawPassRecording() {
+    drawPassBuffers.assign(drawPasses.size(), VK_NULL_HANDLE);
+    jobSystem.parallelFor(drawPassJobs, static_cast<uint32_t>(drawPasses.size()), 1, [this](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; i++) {
+            drawPassBuffers[i] = recordDrawPass(drawPasses[i]);
+        }
+    });
+}
 
-    // Camera position for specular calculations
-    ubo.viewPos = cameras[activeCameraIndex].getPosition();
+void HelloTriangleApplication::waitDrawPassRecording() {
+    // This thread records passes too while it waits
+    jobSystem.wait(drawPassJobs);
+    for (VkCommandBuffer secondary : drawPassBuffers) {
+        if (secondary == VK_NULL_HANDLE) {
+            throw std::runtime_error("Failed to record secondary command buffer!");
+        }
+    }
+}
 
-    // Time for shader animations
-    static auto startTime = std::chrono::high_resolution_clock::now();
-    auto currentTime = std::chrono::high_resolution_clock::now();
-    ubo.time = std::chrono::duration<float>(currentTime - startTime).count();
+VkCommandBuffer HelloTriangleApplication::recordDrawPass(const DrawPass& pass) {
+    // Runs on any job system thread: only touches that thread's pool
+    VkCommandBuffer commandBuffer = recordPools.acquireSecondary(JobSystem::getThreadIndex());
+    if (commandBuffer == VK_NULL_HANDLE) return VK_NULL_HANDLE;
 
-    // Dynamic lighting from day/night cycle
-    ubo.lightPos = lightState.position;
-    ubo.lightIntensity = lightState.intensity;
-    ubo.lightColor = lightState.color;
-    ubo.ambientStrength = lightState.ambientStrength;
+    // Must match the attachments of the primary's vkCmdBeginRendering
+    VkCommandBufferInheritanceRenderingInfo renderingInheritance{};
+    renderingInheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO;
+    renderingInheritance.colorAttachmentCount = 1;
+    renderingInheritance.pColorAttachmentFormats = &swapChainImageFormat;
+    renderingInheritance.depthAttachmentFormat = depthFormat;
+    renderingInheritance.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
 
-    memcpy(uniformBuffersMapped[currentImage], &ubo, sizeof(ubo));
-}
+    VkCommandBufferInheritanceInfo inheritanceInfo{};
+    inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritanceInfo.pNext = &renderingInheritance;
 
-// --- Helper Implementations ---
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    beginInfo.pInheritanceInfo = &inheritanceInfo;
+    if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) return VK_NULL_HANDLE;
+
+    // Secondaries inherit no state from the primary or from each other
+    bindDrawState(commandBuffer, pass);
+    {
+        PROFILE_GPU_SCOPE(commandBuffer, pass.name);
+        pass.record(commandBuffer);
+    }
 
-void HelloTriangleApplication::populateDebugMessengerCreateInfo(VkDebugUtilsMessengerCreateInfoEXT& createInfo) {
-    createInfo = {};
-    createInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT;
-    createInfo.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+    return vkEndCommandBuffer(commandBuffer) == VK_SUCCESS ? commandBuffer : VK_NULL_HANDLE;
+}
+
+void HelloTriangleApplication::bindDrawState(VkCommandBuffer commandBuffer, const DrawPass& pass) {
+    VkViewport viewport{};
+    viewport.width = static_cast<float>(swapChainExtent.width);
+    viewport.height = static_cast<float>(swapChainExtent.height);
+    viewport.maxDepth = 1.0f;
+    vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+
+    VkRect2D scissor{};
+    scissor.extent = swapChainExtent;
+    vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+    VkBuffer vertexBuffers[] = { vertexBuffer };
+    VkDeviceSize offsets[] = { 0 };
+    vkCmdBindVertexBuffers(commandBuffer, 0, 1, vertexBuffers, offsets);
+    vkCmdBindIndexBuffer(commandBuffer, indexBuffer, 0, indexType);
+
+    // Picked up by the opaque pipelines; ones with static depth state override it
+    vkCmdSetDepthCompareOp(commandBuffer, pass.depthEqual ? VK_COMPARE_OP_EQUAL : VK_COMPARE_OP_LESS);
+    vkCmdSetDepthWriteEnable(commandBuffer, pass.depthEqual ? VK_FALSE : VK_TRUE);
+}
+
+void HelloTriangleApplication::renderScene(VkCommandBuffer commandBuffer, uint32_t firstVisible, uint32_t lastVisible,
+                                           bool depthOnly) {
+    if (useGpuCulling) {
+        // Draw list and count were written by dispatchSceneCulling
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+            depthOnly ? depthPrepassIndirectPipeline : indirectGraphicsPipeline);
+        std::array<VkDescriptorSet, 2> sets = { descriptorSets[currentFrame], sceneCullDescriptorSets[currentFrame] };
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, indirectPipelineLayout,
+            0, static_cast<uint32_t>(sets.size()), sets.data(), 0, nullptr);
+        vkCmdDrawIndexedIndirectCount(commandBuffer,
+            sceneDrawBuffers[currentFrame], SCENE_DRAW_COMMANDS_OFFSET,
+            sceneDrawBuffers[currentFrame], 0,
+            scene.getObjectCount(), sizeof(VkDrawIndexedIndirectCommand));
+        return;
+    }
+
+    if (firstVisible == lastVisible) return;
+
+    VkPipeline pipeline = depthOnly ? depthPrepassPipeline : useGouraud ? gouraudPipeline : graphicsPipeline;
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &descriptorSets[currentFrame], 0, nullptr);
+    for (uint32_t i = firstVisible; i < lastVisible; i++) {
+        const SceneObject& object = scene.getObject(visibleObjects[i]);
+        ObjectPushConstants push = ObjectPushConstants::forObject(object);
+        vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(push), &push);
+        vkCmdDrawIndexed(commandBuffer, object.indexCount, 1, object.firstIndex, object.vertexOffset, 0);
+    }
+}
+
+void HelloTriangleApplication::updateUniformBuffer(uint32_t currentImage) {
+    // Day/night cycle interpolated between its last two ticks (stepSimulation)
+    const DayNightCycle::LightState& lightState = renderLightState;
+
+    UniformBufferObject ubo{};
+    ubo.model = glm::mat4(1.0f);
+
+    // Active camera, blended from its pose before the latest input tick.
+    // Benchmark paths and camera switches place the camera directly.
+    const Camera& camera = cameras[activeCameraIndex];
+    renderCameraPosition = camera.getPosition();
+    renderView = camera.getViewMatrix();
+    if (!benchmark.isEnabled() && previousCamera.cameraIndex == activeCameraIndex) {
+        float alpha = inputClock.getAlpha();
+        renderCameraPosition = glm::mix(previousCamera.position, camera.getPosition(), alpha);
+        renderView = glm::lookAt(renderCameraPosition,
+            glm::mix(previousCamera.target, camera.getTarget(), alpha), camera.getUp());
+    }
+    ubo.view = renderView;
+
+    ubo.proj = glm::perspective(glm::radians(45.0f),
+        swapChainExtent.width / static_cast<float>(swapChainExtent.height),
+        0.1f, 1000.0f);
+    ubo.proj[1][1] *= -1;  // Flip Y for Vulkan
+
+    // Culling uses the exact matrices the shaders will see
+    viewFrustum.update(ubo.proj * ubo.view);
+    lodCameraPosition = renderCameraPosition;
+    lodProjectionScaleFactor = lodProjectionScale(ubo.proj, static_cast<float>(swapChainExtent.height));
+
+    // Camera position for specular calculations
+    ubo.viewPos = renderCameraPosition;
+
+    // Time for shader animations (simulated, so benchmark frames repeat exactly)
+    elapsedTime += deltaTime;
+    ubo.time = elapsedTime;
+
+    // Dynamic lighting from day/night cycle
+    ubo.lightPos = lightState.position;
+    ubo.lightIntensity = lightState.intensity;
+    ubo.lightColor = lightState.color;
+    ubo.ambientStrength = lightState.ambientStrength;
+
+    ubo.positionScale = glm::vec4(positionDecode.scale, 0.0f);
+    ubo.positionBias = glm::vec4(positionDecode.bias, 0.0f);
+
+    memcpy(uniformBuffersMapped[currentImage], &ubo, sizeof(ubo));
+}
+
+// --- Helper Implementations ---
+
+void HelloTriangleApplication::populateDebugMessengerCreateInfo(VkDebugUtilsMessengerCreateInfoEXT& createInfo) {
+    createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT;
+    createInfo.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
     createInfo.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
     createInfo.pfnUserCallback = debugCallback;
 }
@@ -1280,20 +2442,30 @@ void HelloTriangleApplication::populateDebugMessengerCreateInfo(VkDebugUtilsMess
 bool HelloTriangleApplication::isDeviceSuitable(VkPhysicalDevice device) {
     QueueFamilyIndices indices = findQueueFamilies(device);
     bool extensionsSupported = checkDeviceExtensionSupport(device);
-    bool swapChainAdequate = false;
-    if (extensionsSupported) {
+    bool swapChainAdequate = isOffscreen();   // Offscreen targets need no surface
+    if (extensionsSupported && !isOffscreen()) {
         SwapChainSupportDetails swapChainSupport = querySwapChainSupport(device);
         swapChainAdequate = !swapChainSupport.formats.empty() && !swapChainSupport.presentModes.empty();
     }
 
+    VkPhysicalDeviceVulkan12Features features12{};
+    features12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
     VkPhysicalDeviceDynamicRenderingFeatures dynamicRenderingFeatures{};
     dynamicRenderingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES;
+    dynamicRenderingFeatures.pNext = &features12;
     VkPhysicalDeviceFeatures2 features2{};
     features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
     features2.pNext = &dynamicRenderingFeatures;
     vkGetPhysicalDeviceFeatures2(device, &features2);
 
-    return indices.isComplete() && extensionsSupported && swapChainAdequate && dynamicRenderingFeatures.dynamicRendering;
+    return indices.isComplete() && extensionsSupported && swapChainAdequate && dynamicRenderingFeatures.dynamicRendering &&
+           hasBindlessSupport(features12);
+}
+
+bool HelloTriangleApplication::hasBindlessSupport(const VkPhysicalDeviceVulkan12Features& features) {
+    // The subset shader.frag and the scene descriptor set layout rely on
+    return features.runtimeDescriptorArray && features.descriptorBindingPartiallyBound &&
+           features.descriptorBindingSampledImageUpdateAfterBind && features.shaderSampledImageArrayNonUniformIndexing;
 }
 
 bool HelloTriangleApplication::checkDeviceExtensionSupport(VkPhysicalDevice device) {
@@ -1301,7 +2473,8 @@ bool HelloTriangleApplication::checkDeviceExtensionSupport(VkPhysicalDevice devi
     vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, nullptr);
     std::vector<VkExtensionProperties> availableExtensions(extensionCount);
     vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, availableExtensions.data());
-    std::set<std::string> requiredExtensions(deviceExtensions.begin(), deviceExtensions.end());
+    std::vector<const char*> extensions = getDeviceExtensions();
+    std::set<std::string> requiredExtensions(extensions.begin(), extensions.end());
     for (const auto& extension : availableExtensions) {
         requiredExtensions.erase(extension.extensionName);
     }
@@ -1320,7 +2493,13 @@ QueueFamilyIndices HelloTriangleApplication::findQueueFamilies(VkPhysicalDevice
             indices.graphicsFamily = i;
         }
         VkBool32 presentSupport = false;
-        vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);
+        if (surface != VK_NULL_HANDLE) {
+            vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);
+        }
+        else {
+            // Offscreen: "present" is just the graphics queue
+            presentSupport = (queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) != 0;
+        }
         if (presentSupport) {
             indices.presentFamily = i;
         }
@@ -1329,6 +2508,19 @@ QueueFamilyIndices HelloTriangleApplication::findQueueFamilies(VkPhysicalDevice
         }
         i++;
     }
+
+    // Prefer a pure transfer (DMA) family, then any non-graphics one with transfer
+    for (int pass = 0; pass < 2 && !indices.transferFamily.has_value(); pass++) {
+        for (uint32_t family = 0; family < queueFamilyCount; family++) {
+            VkQueueFlags flags = queueFamilies[family].queueFlags;
+            bool transferOnly = !(flags & VK_QUEUE_COMPUTE_BIT);
+            if ((flags & VK_QUEUE_TRANSFER_BIT) && !(flags & VK_QUEUE_GRAPHICS_BIT) &&
+                (pass == 1 || transferOnly)) {
+                indices.transferFamily = family;
+                break;
+            }
+        }
+    }
     return indices;
 }
 
@@ -1360,12 +2552,14 @@ VkSurfaceFormatKHR HelloTriangleApplication::chooseSwapSurfaceFormat(const std::
 }
 
 VkPresentModeKHR HelloTriangleApplication::chooseSwapPresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes) {
-    for (const auto& availablePresentMode : availablePresentModes) {
-        if (availablePresentMode == VK_PRESENT_MODE_MAILBOX_KHR) {
-            return availablePresentMode;
-        }
+    VkPresentModeKHR mode = FramePacer::choosePresentMode(requestedPresentMode, availablePresentModes);
+    if (mode != activePresentMode || swapChain == VK_NULL_HANDLE || presentModeChanged) {
+        std::cout << "Present mode: " << FramePacer::getName(requestedPresentMode)
+            << (mode == VK_PRESENT_MODE_FIFO_KHR && requestedPresentMode != FramePacer::PresentMode::Fifo
+                ? " not supported, using fifo" : "") << std::endl;
     }
-    return VK_PRESENT_MODE_FIFO_KHR;
+    activePresentMode = mode;
+    return mode;
 }
 
 VkExtent2D HelloTriangleApplication::chooseSwapExtent(const VkSurfaceCapabilitiesKHR& capabilities) {
@@ -1386,10 +2580,13 @@ VkExtent2D HelloTriangleApplication::chooseSwapExtent(const VkSurfaceCapabilitie
 }
 
 std::vector<const char*> HelloTriangleApplication::getRequiredExtensions() {
-    uint32_t glfwExtensionCount = 0;
-    const char** glfwExtensions;
-    glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
-    std::vector<const char*> extensions(glfwExtensions, glfwExtensions + glfwExtensionCount);
+    std::vector<const char*> extensions;
+    if (!isOffscreen()) {
+        uint32_t glfwExtensionCount = 0;
+        const char** glfwExtensions;
+        glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+        extensions.assign(glfwExtensions, glfwExtensions + glfwExtensionCount);
+    }
     if (enableValidationLayers) {
         extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
     }
@@ -1416,99 +2613,10 @@ bool HelloTriangleApplication::checkValidationLayerSupport() {
     return true;
 }
 
-std::vector<char> HelloTriangleApplication::readFile(const std::string& filename) {
-    std::ifstream file(filename, std::ios::ate | std::ios::binary);
-    if (!file.is_open()) {
-        throw std::runtime_error("failed to open file!");
-    }
-    size_t fileSize = (size_t)file.tellg();
-    std::vector<char> buffer(fileSize);
-    file.seekg(0);
-    file.read(buffer.data(), fileSize);
-    file.close();
-    return buffer;
-}
-
-VkShaderModule HelloTriangleApplication::createShaderModule(const std::vector<char>& code) {
-    VkShaderModuleCreateInfo createInfo{};
-    createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-    createInfo.codeSize = code.size();
-    createInfo.pCode = reinterpret_cast<const uint32_t*>(code.data());
-    VkShaderModule shaderModule;
-    if (vkCreateShaderModule(device, &createInfo, nullptr, &shaderModule) != VK_SUCCESS) {
-        throw std::runtime_error("failed to create shader module!");
-    }
-    return shaderModule;
-}
-
-void HelloTriangleApplication::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& bufferMemory) {
-    VkBufferCreateInfo bufferInfo{};
-    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    bufferInfo.size = size;
-    bufferInfo.usage = usage;
-    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-
-    if (vkCreateBuffer(device, &bufferInfo, nullptr, &buffer) != VK_SUCCESS) {
-        throw std::runtime_error("failed to create buffer!");
-    }
-
-    VkMemoryRequirements memRequirements;
-    vkGetBufferMemoryRequirements(device, buffer, &memRequirements);
-
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, properties);
-
-    if (vkAllocateMemory(device, &allocInfo, nullptr, &bufferMemory) != VK_SUCCESS) {
-        throw std::runtime_error("failed to allocate buffer memory!");
-    }
-
-    vkBindBufferMemory(device, buffer, bufferMemory, 0);
-}
-
-void HelloTriangleApplication::copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size) {
-    VkCommandBufferAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    allocInfo.commandPool = commandPool;
-    allocInfo.commandBufferCount = 1;
-
-    VkCommandBuffer commandBuffer;
-    vkAllocateCommandBuffers(device, &allocInfo, &commandBuffer);
-
-    VkCommandBufferBeginInfo beginInfo{};
-    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-
-    vkBeginCommandBuffer(commandBuffer, &beginInfo);
-    VkBufferCopy copyRegion{};
-    copyRegion.size = size;
-    vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
-    vkEndCommandBuffer(commandBuffer);
-
-    VkSubmitInfo submitInfo{};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &commandBuffer;
-
-    vkQueueSubmit(graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
-    vkQueueWaitIdle(graphicsQueue);
-    vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
-}
-
-uint32_t HelloTriangleApplication::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) {
-    VkPhysicalDeviceMemoryProperties memProperties;
-    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
-    for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
-        if ((typeFilter & (1 << i)) && (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
-            return i;
-        }
-    }
-    throw std::runtime_error("failed to find suitable memory type!");
+void HelloTriangleApplication::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, DeviceMemoryAllocator::Pool pool, VkBuffer& buffer, DeviceMemoryAllocator::Allocation& allocation) {
+    memoryAllocator.createBuffer(size, usage, pool, buffer, allocation);
 }
 
-
 // --- Callback Implementations ---
 
 void HelloTriangleApplication::framebufferResizeCallback(GLFWwindow* window, int width, int height) {
@@ -1567,26 +2675,30 @@ void HelloTriangleApplication::setupInputCallbacks()
     // Reset
     inputHandler.onReset([this]() {
         cameras[activeCameraIndex].reset();
+        previousCamera.cameraIndex = -1;   // Jump, don't blend from the old pose
         timeScale = 1.0f;
         dayNightCycle.reset();
         });
 
     // Camera switching (F1-F3)
-    inputHandler.onCameraSwitch(1, [this]() { activeCameraIndex = 0; });
-    inputHandler.onCameraSwitch(2, [this]() { activeCameraIndex = 1; });
-    inputHandler.onCameraSwitch(3, [this]() { activeCameraIndex = 2; });
+    inputHandler.onCameraSwitch(1, [this]() { activeCameraIndex = 0; previousCamera.cameraIndex = -1; });
+    inputHandler.onCameraSwitch(2, [this]() { activeCameraIndex = 1; previousCamera.cameraIndex = -1; });
+    inputHandler.onCameraSwitch(3, [this]() { activeCameraIndex = 2; previousCamera.cameraIndex = -1; });
 
     // Particle fire effect (F4)
     inputHandler.onParticleEffect([this]() {
+        waitParticleSimulation();  // Emitters may be mid-update on workers
         fireActive = !fireActive;
         if (fireActive) {
-            fireParticles.start();
+            particleEmitters[fireEmitterIndex].start();
+            particleEmitters[smokeEmitterIndex].start();
             std::cout << "F4: Fire effect STARTED on cactus\n";
             // Switch to camera 3 to see the effect
             activeCameraIndex = 2;
         }
         else {
-            fireParticles.stop();
+            particleEmitters[fireEmitterIndex].stop();
+            particleEmitters[smokeEmitterIndex].stop();
             std::cout << "F4: Fire effect STOPPED\n";
         }
         });
@@ -1601,6 +2713,63 @@ void HelloTriangleApplication::setupInputCallbacks()
         std::cout << "Time scale: " << timeScale << "\n";
         });
 
+    // Scene culling path (F7): GPU-driven indirect vs CPU per-object draws
+    inputHandler.onToggleGpuCulling([this]() {
+        if (!gpuDrivenSupported) {
+            std::cout << "F7: GPU-driven rendering not supported on this device\n";
+            return;
+        }
+        useGpuCulling = !useGpuCulling;
+        std::cout << "F7: Scene culling on " << (useGpuCulling ? "GPU (indirect)" : "CPU") << "\n";
+        });
+
+    // Meshlet path (F8): task/mesh shaders vs compute culling + indirect draws
+    inputHandler.onToggleMeshShaders([this]() {
+        if (!meshShaderSupported) {
+            std::cout << "F8: Mesh shaders not supported on this device (meshlets culled in compute)\n";
+            return;
+        }
+        useMeshShaders = !useMeshShaders;
+        std::cout << "F8: Meshlets " << (useMeshShaders ? "on task/mesh shaders" : "culled in compute (indirect)") << "\n";
+        });
+
+    // Shading model (F9): Phong vs Gouraud on the per-object draw paths
+    inputHandler.onToggleShading([this]() {
+        useGouraud = !useGouraud;
+        std::cout << "F9: " << (useGouraud ? "Gouraud (per-vertex)" : "Phong (per-pixel)") << " shading"
+            << (useGpuCulling || useMeshShaders ? " (GPU-driven and mesh shader draws stay Phong)" : "") << "\n";
+        });
+
+    // Depth pre-pass (F10): compare the "Depth pre-pass" + "Scene" GPU scopes with it off
+    inputHandler.onToggleDepthPrepass([this]() {
+        useDepthPrepass = !useDepthPrepass;
+        std::cout << "F10: Depth pre-pass " << (useDepthPrepass ? "on (color pass shades with EQUAL)" : "off") << "\n";
+        });
+
+    // Particle depth sort (F11): alpha-blended smoke and sand composite in pool order when off
+    inputHandler.onToggleParticleSort([this]() {
+        useParticleSort = !useParticleSort;
+        std::cout << "F11: Particle depth sort " << (useParticleSort ? "on (back to front)" : "off (pool order)") << "\n";
+        });
+
+    // Present mode (F12): fifo -> fifo-relaxed -> mailbox -> immediate, applied after the next present
+    inputHandler.onCyclePresentMode([this]() {
+        if (isOffscreen()) return;
+        requestedPresentMode = FramePacer::next(requestedPresentMode);
+        presentModeChanged = true;
+        std::cout << "F12: Present mode " << FramePacer::getName(requestedPresentMode) << " requested\n";
+        });
+
+    // Profiler report (F5) and Chrome trace capture (F6)
+    inputHandler.onProfilerReport([]() {
+        Profiler::instance().printReport();
+        });
+    inputHandler.onProfilerCapture([]() {
+        if (!Profiler::instance().isCapturing()) {
+            Profiler::instance().startCapture(300, "profile_trace.json");
+        }
+        });
+
     // Rotation controls
     inputHandler.onRotateLeft([this]() {
         cameras[activeCameraIndex].rotateYaw(-1.0f);  // Negative = camera orbits left
@@ -1639,11 +2808,11 @@ void HelloTriangleApplication::setupInputCallbacks()
 
 // --- DEPTH BUFFERING ---
 void HelloTriangleApplication::createDepthResources() {
-    VkFormat depthFormat = findDepthFormat();
+    depthFormat = findDepthFormat();
 
     createImage(swapChainExtent.width, swapChainExtent.height, depthFormat,
         VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
-        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, depthImage, depthImageMemory);
+        DeviceMemoryAllocator::Pool::DeviceLocal, depthImage, depthImageAllocation);
 
     // Create image view
     VkImageViewCreateInfo viewInfo{};
@@ -1689,8 +2858,8 @@ VkFormat HelloTriangleApplication::findSupportedFormat(const std::vector<VkForma
 
 void HelloTriangleApplication::createImage(uint32_t width, uint32_t height, VkFormat format,
     VkImageTiling tiling, VkImageUsageFlags usage,
-    VkMemoryPropertyFlags properties, VkImage& image,
-    VkDeviceMemory& imageMemory) {
+    DeviceMemoryAllocator::Pool pool, VkImage& image,
+    DeviceMemoryAllocator::Allocation& imageAllocation) {
     VkImageCreateInfo imageInfo{};
     imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
     imageInfo.imageType = VK_IMAGE_TYPE_2D;
@@ -1706,244 +2875,1440 @@ void HelloTriangleApplication::createImage(uint32_t width, uint32_t height, VkFo
     imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
     imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
-    if (vkCreateImage(device, &imageInfo, nullptr, &image) != VK_SUCCESS) {
-        throw std::runtime_error("Failed to create image!");
+    memoryAllocator.createImage(imageInfo, pool, image, imageAllocation);
+}
+// --- DEPTH BUFFERING END ---
+
+// --- PARTICLE SYSTEM ---
+void HelloTriangleApplication::createParticlePipeline()
+{
+    // Particle instance input (one record per particle, quad built in the shader)
+    auto attributeDescriptions = ParticleInstance::getAttributeDescriptions();
+
+    PipelineRegistry::GraphicsDesc desc;
+    desc.name = "particle";
+    desc.stages = {
+        { VK_SHADER_STAGE_VERTEX_BIT, "shaders/particle_vert.spv" },
+        { VK_SHADER_STAGE_FRAGMENT_BIT, "shaders/particle_frag.spv" } };
+    desc.bindings = { ParticleInstance::getBindingDescription() };
+    desc.attributes.assign(attributeDescriptions.begin(), attributeDescriptions.end());
+    desc.cullMode = VK_CULL_MODE_NONE;     // No culling for billboards
+    desc.depthWrite = false;               // Depth test only: particles don't occlude each other
+    desc.additiveBlend = true;             // Fire/glow effects
+    desc.layout = pipelineLayout;          // Reuse existing layout (same UBO)
+    desc.colorFormat = swapChainImageFormat;
+    desc.depthFormat = depthFormat;
+    pipelineRegistry.addGraphics(desc, &particlePipeline);
+
+    // Smoke and dust: "over" blending, correct only when drawn back to front
+    desc.name = "particle alpha";
+    desc.additiveBlend = false;
+    desc.alphaBlend = true;
+    pipelineRegistry.addGraphics(desc, &particleAlphaPipeline);
+}
+
+void HelloTriangleApplication::initParticleSystems() {
+    // Emitter table - add rows to populate the scene
+    struct EmitterDesc {
+        ParticleSystem::EffectType type;
+        glm::vec3 position;
+        bool gpuSimulated;
+        bool startActive;
+    };
+    const EmitterDesc emitterTable[] = {
+        { ParticleSystem::EffectType::Fire, glm::vec3(20.0f, 6.0f, 15.0f), false, false },  // Cactus fire (F4)
+        { ParticleSystem::EffectType::Smoke, glm::vec3(20.0f, 8.0f, 15.0f), false, false }, // Smoke above the fire
+        { ParticleSystem::EffectType::Sand, glm::vec3(0.0f, 2.0f, 0.0f),   true,  true  },  // Ambient desert sand
+    };
+
+    particleEmitters.clear();
+    particleEmitters.reserve(std::size(emitterTable));
+
+    VkDeviceSize instanceBytesPerFrame = 0;
+    for (const EmitterDesc& desc : emitterTable) {
+        ParticleSystem::EmitterConfig config = ParticleSystem::getPreset(desc.type);
+        config.position = desc.position;
+
+        ParticleSystem& emitter = particleEmitters.emplace_back();
+        if (benchmark.isEnabled()) {
+            emitter.setSeed(benchmark.getSettings().seed + static_cast<uint32_t>(particleEmitters.size()));
+        }
+        if (desc.gpuSimulated) {
+            // Emission rate is scaled so the GPU ring never recycles a live
+            // particle: capacity / maxLife particles per second
+            config.maxParticles = static_cast<int>(GPU_SAND_PARTICLES);
+            config.emissionRate = static_cast<float>(GPU_SAND_PARTICLES) / config.maxLife;
+            emitter.initGpu(config);
+            sandEmitterIndex = particleEmitters.size() - 1;
+        }
+        else {
+            emitter.init(config);
+            instanceBytesPerFrame += sizeof(ParticleInstance) * config.maxParticles;
+            if (desc.type == ParticleSystem::EffectType::Fire) {
+                fireEmitterIndex = particleEmitters.size() - 1;
+            }
+            else if (desc.type == ParticleSystem::EffectType::Smoke) {
+                smokeEmitterIndex = particleEmitters.size() - 1;
+            }
+        }
+
+        // Benchmarks run every emitter so both simulation paths are measured
+        if (desc.startActive || benchmark.isEnabled()) emitter.start();
+        else emitter.stop();
     }
+    fireActive = particleEmitters[fireEmitterIndex].isActive();
+
+    // Per-frame instance ring (rewritten every frame, mapped once).
+    // Each region holds one record per particle of every CPU emitter's pool,
+    // so the CPU never writes a region the GPU may still be reading.
+
+    particleUploadRing.init(memoryAllocator, instanceBytesPerFrame,
+        framesInFlight, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+}
+
+void HelloTriangleApplication::initCactusInstances() {
+    if (cactusField.getInstanceCount() == 0) return;
+
+    // Each region holds every instance, so a fully visible field always fits
+    cactusInstanceRing.init(memoryAllocator, sizeof(CactusInstance) * cactusField.getInstanceCount(),
+        framesInFlight, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+}
+
+void HelloTriangleApplication::updateCactusInstances() {
+    visibleCactusCount = 0;
+    cactusDraws.clear();
+    if (cactusField.getInstanceCount() == 0) return;
+
+    // The frame's fence has been waited on, so its region is free to overwrite
+    cactusInstanceRing.beginFrame(currentFrame);
+    DynamicUploadRing::Allocation alloc = cactusInstanceRing.allocate(
+        sizeof(CactusInstance) * cactusField.getInstanceCount(), alignof(CactusInstance));
+    if (!alloc.data) return;
 
-    VkMemoryRequirements memRequirements;
-    vkGetImageMemoryRequirements(device, image, &memRequirements);
+    visibleCactusCount = cactusField.cull(viewFrustum, lodCameraPosition, lodProjectionScaleFactor,
+        lodSettings, static_cast<CactusInstance*>(alloc.data), cactusDraws);
+    cactusInstanceOffset = alloc.offset;
 
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, properties);
+    // Coarser levels are further away: finest first is roughly front-to-back
+    std::stable_sort(cactusDraws.begin(), cactusDraws.end(),
+        [](const CactusField::Draw& a, const CactusField::Draw& b) { return a.lod < b.lod; });
+}
+
+void HelloTriangleApplication::renderCactusInstances(VkCommandBuffer commandBuffer, bool depthOnly) {
+    if (visibleCactusCount == 0) return;
 
-    if (vkAllocateMemory(device, &allocInfo, nullptr, &imageMemory) != VK_SUCCESS) {
-        throw std::runtime_error("Failed to allocate image memory!");
+    // Shared geometry at binding 0 (index buffer is still bound), instances at binding 1
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+        depthOnly ? depthPrepassCactusPipeline : cactusInstancedPipeline);
+    VkBuffer vertexBuffers[] = { vertexBuffer, cactusInstanceRing.getBuffer() };
+    VkDeviceSize offsets[] = { 0, cactusInstanceOffset };
+    vkCmdBindVertexBuffers(commandBuffer, 0, 2, vertexBuffers, offsets);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+        pipelineLayout, 0, 1, &descriptorSets[currentFrame], 0, nullptr);
+
+    // Transforms are per instance; only the material comes from ObjectPushConstants
+    vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT,
+        offsetof(ObjectPushConstants, material), sizeof(uint32_t), &cactusMaterial);
+
+    // One draw per shared mesh and LOD level that has visible instances
+    const std::vector<CactusField::Batch>& batches = cactusField.getBatches();
+    for (const CactusField::Draw& draw : cactusDraws) {
+        const SceneMesh& mesh = batches[draw.batch].lods[draw.lod];
+        vkCmdDrawIndexed(commandBuffer, mesh.indexCount, draw.instanceCount,
+            mesh.firstIndex, mesh.vertexOffset, draw.firstInstance);
     }
+}
 
-    vkBindImageMemory(device, image, imageMemory, 0);
+void HelloTriangleApplication::requestStreamedModels() {
+    const std::vector<Benchmark::ModelFile>& files = benchmark.getSettings().models;
+    if (files.size() > MAX_STREAMED_MODELS) {
+        std::cerr << "Streaming: only the first " << MAX_STREAMED_MODELS << " of " << files.size()
+            << " models are loaded" << std::endl;
+    }
+    const uint32_t count = std::min(static_cast<uint32_t>(files.size()), MAX_STREAMED_MODELS);
+
+    // Materials are still being collected: the buffer is created after this
+    streamedModels.clear();
+    for (uint32_t i = 0; i < count; i++) {
+        const Benchmark::ModelFile& file = files[i];
+        StreamedModel model;
+        model.mesh = assetStreamer.requestMesh(file.meshPath);
+        model.textureSlot = STREAMED_TEXTURE_SLOT_BASE + i;
+
+        // Evenly spaced on a ring around the hand-placed cacti
+        float angle = glm::two_pi<float>() * static_cast<float>(i) / static_cast<float>(count);
+        model.position = glm::vec3(std::cos(angle), 0.0f, std::sin(angle)) * STREAMED_MODEL_RING_RADIUS;
+
+        GpuMaterial material;
+        material.albedoTexture = MaterialLibrary::NO_TEXTURE;
+        material.specularStrength = 0.3f;
+        material.shininess = 16.0f;
+        if (!file.texturePath.empty()) {
+            model.texture = assetStreamer.requestTexture(file.texturePath);
+            material.albedoTexture = model.textureSlot;
+        }
+        model.material = materials.add(file.meshPath, material);
+        streamedModels.push_back(model);
+    }
+
+    if (!streamedModels.empty()) {
+        std::cout << "Streaming: " << streamedModels.size() << " models requested" << std::endl;
+    }
 }
-// --- DEPTH BUFFERING END ---
 
-// --- PARTICLE SYSTEM ---
-void HelloTriangleApplication::createParticlePipeline()
-{
-    auto vertShaderCode = readFile("shaders/particle_vert.spv");
-    auto fragShaderCode = readFile("shaders/particle_frag.spv");
-
-    VkShaderModule vertShaderModule = createShaderModule(vertShaderCode);
-    VkShaderModule fragShaderModule = createShaderModule(fragShaderCode);
-
-    VkPipelineShaderStageCreateInfo vertShaderStageInfo{};
-    vertShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-    vertShaderStageInfo.stage = VK_SHADER_STAGE_VERTEX_BIT;
-    vertShaderStageInfo.module = vertShaderModule;
-    vertShaderStageInfo.pName = "main";
-
-    VkPipelineShaderStageCreateInfo fragShaderStageInfo{};
-    fragShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-    fragShaderStageInfo.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
-    fragShaderStageInfo.module = fragShaderModule;
-    fragShaderStageInfo.pName = "main";
-
-    VkPipelineShaderStageCreateInfo shaderStages[] = { vertShaderStageInfo, fragShaderStageInfo };
-
-    // Particle vertex input
-    auto bindingDescription = ParticleVertex::getBindingDescription();
-    auto attributeDescriptions = ParticleVertex::getAttributeDescriptions();
-
-    VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
-    vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-    vertexInputInfo.vertexBindingDescriptionCount = 1;
-    vertexInputInfo.pVertexBindingDescriptions = &bindingDescription;
-    vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
-    vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
-
-    VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
-    inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
-    inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
-    inputAssembly.primitiveRestartEnable = VK_FALSE;
-
-    VkPipelineViewportStateCreateInfo viewportState{};
-    viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
-    viewportState.viewportCount = 1;
-    viewportState.scissorCount = 1;
-
-    VkPipelineRasterizationStateCreateInfo rasterizer{};
-    rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
-    rasterizer.depthClampEnable = VK_FALSE;
-    rasterizer.rasterizerDiscardEnable = VK_FALSE;
-    rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
-    rasterizer.lineWidth = 1.0f;
-    rasterizer.cullMode = VK_CULL_MODE_NONE;  // No culling for billboards
-    rasterizer.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
-    rasterizer.depthBiasEnable = VK_FALSE;
-
-    VkPipelineMultisampleStateCreateInfo multisampling{};
-    multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
-    multisampling.sampleShadingEnable = VK_FALSE;
-    multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
-
-    // Depth test but no depth write (particles don't occlude each other)
-    VkPipelineDepthStencilStateCreateInfo depthStencil{};
-    depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
-    depthStencil.depthTestEnable = VK_TRUE;
-    depthStencil.depthWriteEnable = VK_FALSE;  // KEY: Don't write depth
-    depthStencil.depthCompareOp = VK_COMPARE_OP_LESS;
-    depthStencil.depthBoundsTestEnable = VK_FALSE;
-    depthStencil.stencilTestEnable = VK_FALSE;
-
-    // Additive blending for fire/glow effects
-    VkPipelineColorBlendAttachmentState colorBlendAttachment{};
-    colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
-        VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
-    colorBlendAttachment.blendEnable = VK_TRUE;
-    colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
-    colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE;  // Additive
-    colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
-    colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
-    colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
-    colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
-
-    VkPipelineColorBlendStateCreateInfo colorBlending{};
-    colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
-    colorBlending.logicOpEnable = VK_FALSE;
-    colorBlending.attachmentCount = 1;
-    colorBlending.pAttachments = &colorBlendAttachment;
-
-    std::vector<VkDynamicState> dynamicStates = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
-    VkPipelineDynamicStateCreateInfo dynamicState{};
-    dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
-    dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
-    dynamicState.pDynamicStates = dynamicStates.data();
-
-    // Reuse existing pipeline layout (same UBO)
-    VkFormat depthFormat = findDepthFormat();
-
-    VkPipelineRenderingCreateInfo renderingCreateInfo{};
-    renderingCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO;
-    renderingCreateInfo.colorAttachmentCount = 1;
-    renderingCreateInfo.pColorAttachmentFormats = &swapChainImageFormat;
-    renderingCreateInfo.depthAttachmentFormat = depthFormat;
-
-    VkGraphicsPipelineCreateInfo pipelineInfo{};
-    pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-    pipelineInfo.pNext = &renderingCreateInfo;
-    pipelineInfo.stageCount = 2;
-    pipelineInfo.pStages = shaderStages;
-    pipelineInfo.pVertexInputState = &vertexInputInfo;
-    pipelineInfo.pInputAssemblyState = &inputAssembly;
-    pipelineInfo.pViewportState = &viewportState;
-    pipelineInfo.pRasterizationState = &rasterizer;
-    pipelineInfo.pMultisampleState = &multisampling;
-    pipelineInfo.pColorBlendState = &colorBlending;
-    pipelineInfo.pDynamicState = &dynamicState;
-    pipelineInfo.pDepthStencilState = &depthStencil;
-    pipelineInfo.layout = pipelineLayout;  // Reuse existing layout
-    pipelineInfo.renderPass = VK_NULL_HANDLE;
-    pipelineInfo.subpass = 0;
-
-    if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &particlePipeline) != VK_SUCCESS) {
-        throw std::runtime_error("Failed to create particle pipeline!");
-    }
-
-    vkDestroyShaderModule(device, fragShaderModule, nullptr);
-    vkDestroyShaderModule(device, vertShaderModule, nullptr);
+void HelloTriangleApplication::placeStreamedModel(StreamedModel& model, const AssetStreamer::StreamedMesh& mesh) {
+    // Largest extent scaled to STREAMED_MODEL_SIZE, base center on the floor
+    glm::vec3 extent = mesh.maxBounds - mesh.minBounds;
+    float largest = std::max({ extent.x, extent.y, extent.z });
+    float scale = largest > 0.0f ? STREAMED_MODEL_SIZE / largest : 1.0f;
+    glm::vec3 base((mesh.minBounds.x + mesh.maxBounds.x) * 0.5f, mesh.minBounds.y,
+                   (mesh.minBounds.z + mesh.maxBounds.z) * 0.5f);
+    model.transform = glm::translate(glm::mat4(1.0f), model.position) *
+        glm::scale(glm::mat4(1.0f), glm::vec3(scale)) * glm::translate(glm::mat4(1.0f), -base);
+    model.normalMatrix = glm::transpose(glm::inverse(model.transform));
+
+    // Uniform scale, no rotation: the bounds corners stay the corners
+    model.worldMin = glm::vec3(model.transform * glm::vec4(mesh.minBounds, 1.0f));
+    model.worldMax = glm::vec3(model.transform * glm::vec4(mesh.maxBounds, 1.0f));
+    model.placed = true;
 }
 
-void HelloTriangleApplication::initParticleSystems() {
-    // Fire effect at first cactus position (triggered by F4)
-    fireParticles.init(ParticleSystem::EffectType::Fire, glm::vec3(20.0f, 6.0f, 15.0f));
-    fireParticles.stop();  // Start inactive
+void HelloTriangleApplication::updateStreamedModels() {
+    streamedDraws.clear();
+    if (streamedModels.empty()) return;
+
+    // Lookups mark assets used, so off-screen models are skipped and age out first
+    std::vector<VkDescriptorImageInfo> imageInfos(streamedModels.size(), assetStreamer.getPlaceholderDescriptor());
+    for (size_t i = 0; i < streamedModels.size(); i++) {
+        StreamedModel& model = streamedModels[i];
+        if (model.placed && !viewFrustum.intersects(model.worldMin, model.worldMax)) continue;
+
+        const AssetStreamer::StreamedMesh* mesh = assetStreamer.getMesh(model.mesh);
+        if (!mesh) continue;    // Still streaming, or failed
+        if (!model.placed) {
+            placeStreamedModel(model, *mesh);
+            if (!viewFrustum.intersects(model.worldMin, model.worldMax)) continue;
+        }
+        if (model.texture != AssetStreamer::INVALID_HANDLE) {
+            imageInfos[i] = assetStreamer.getTextureDescriptor(model.texture);
+        }
 
-    // Ambient sand particles across the desert
-    sandParticles.init(ParticleSystem::EffectType::Sand, glm::vec3(0.0f, 2.0f, 0.0f));
-    sandParticles.start();  // Always active
+        // Packed meshes are quantized against their own bounds but the shaders
+        // decode with the scene's: map the scene's decode onto this mesh's first
+        glm::mat4 modelMatrix = model.transform;
+        if (vertexFormat == VertexFormat::Packed) {
+            glm::vec3 ratio = mesh->decode.scale / positionDecode.scale;
+            modelMatrix = modelMatrix * glm::translate(glm::mat4(1.0f), mesh->decode.bias - positionDecode.bias * ratio) *
+                glm::scale(glm::mat4(1.0f), ratio);
+        }
 
-    // Create particle buffers (dynamic - will be updated each frame)
-    VkDeviceSize vertexBufferSize = sizeof(ParticleVertex) * 4000;  // Max vertices
-    VkDeviceSize indexBufferSize = sizeof(uint32_t) * 6000;         // Max indices
+        StreamedDraw draw;
+        draw.vertexBuffer = mesh->vertexBuffer;
+        draw.indexBuffer = mesh->indexBuffer;
+        draw.indexType = mesh->indexType;
+        draw.indexCount = mesh->indexCount;
+        draw.push.model = modelMatrix;
+        for (int column = 0; column < 3; column++) {
+            draw.push.normalMatrix[column] = glm::vec4(glm::vec3(model.normalMatrix[column]), 0.0f);
+        }
+        draw.push.material = model.material;
+        streamedDraws.push_back(draw);
+    }
 
-    createBuffer(vertexBufferSize,
-        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-        particleVertexBuffer, particleVertexBufferMemory);
+    // Only this frame's set: its fence was waited on, the others get theirs on their turn
+    std::vector<VkWriteDescriptorSet> descriptorWrites;
+    for (size_t i = 0; i < streamedModels.size(); i++) {
+        if (streamedModels[i].texture == AssetStreamer::INVALID_HANDLE) continue;
+        VkWriteDescriptorSet write{};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = descriptorSets[currentFrame];
+        write.dstBinding = 1;
+        write.dstArrayElement = streamedModels[i].textureSlot;
+        write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        write.descriptorCount = 1;
+        write.pImageInfo = &imageInfos[i];
+        descriptorWrites.push_back(write);
+    }
+    if (!descriptorWrites.empty()) {
+        vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
+    }
+}
 
-    createBuffer(indexBufferSize,
-        VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-        particleIndexBuffer, particleIndexBufferMemory);
+void HelloTriangleApplication::renderStreamedModels(VkCommandBuffer commandBuffer, bool depthOnly) {
+    // The per-object scene pipelines; every mesh brings its own buffers
+    VkPipeline pipeline = depthOnly ? depthPrepassPipeline : useGouraud ? gouraudPipeline : graphicsPipeline;
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &descriptorSets[currentFrame], 0, nullptr);
+    for (const StreamedDraw& draw : streamedDraws) {
+        VkDeviceSize offset = 0;
+        vkCmdBindVertexBuffers(commandBuffer, 0, 1, &draw.vertexBuffer, &offset);
+        vkCmdBindIndexBuffer(commandBuffer, draw.indexBuffer, 0, draw.indexType);
+        vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(draw.push), &draw.push);
+        vkCmdDrawIndexed(commandBuffer, draw.indexCount, 1, 0, 0, 0);
+    }
 }
 
 void HelloTriangleApplication::updateParticles() {
-    // Update particle physics
-    fireParticles.update(deltaTime * timeScale);
-    sandParticles.update(deltaTime * timeScale);
+    // CPU emitters were advanced on the job system while the previous
+    // frame was being submitted (see kickParticleSimulation)
+    waitParticleSimulation();
+
+    // GPU emitter: only pace emission here, the compute shader does the rest.
+    // Every simulation tick is one dispatch, emitting that tick's share.
+    ParticleSystem& sandEmitter = particleEmitters[sandEmitterIndex];
+    const ParticleSystem::EmitterConfig& sand = sandEmitter.getConfig();
+    float tick = simulationClock.getTick();
+
+    ParticleComputePush push{};
+    push.positionDelta = glm::vec4(sand.position, tick);
+    push.positionVariance = glm::vec4(sand.positionVariance, sand.drag);
+    push.velocity = glm::vec4(sand.velocity, sand.minLife);
+    push.velocityVariance = glm::vec4(sand.velocityVariance, sand.maxLife);
+    push.gravity = glm::vec4(sand.gravity, sand.startSize);
+    push.startColor = sand.startColor;
+    push.endColor = sand.endColor;
+    push.endSize = sand.endSize;
+    push.maxParticles = GPU_SAND_PARTICLES;
+
+    computeParticleTicks.clear();
+    for (uint32_t i = 0; i < simulationSteps; i++) {
+        push.emitBase = computeParticleEmitted;
+        push.emitCount = std::min(sandEmitter.stepEmitter(tick), GPU_SAND_PARTICLES);
+        computeParticleEmitted += push.emitCount;
+        computeParticleTicks.push_back(push);
+    }
 
-    // Get camera vectors for billboarding
-    glm::mat4 view = cameras[activeCameraIndex].getViewMatrix();
-    glm::vec3 cameraRight = glm::vec3(view[0][0], view[1][0], view[2][0]);
-    glm::vec3 cameraUp = glm::vec3(view[0][1], view[1][1], view[2][1]);
+    // The draw pulls each particle back along its velocity from the latest
+    // tick to this frame's point between the last two ticks
+    computeParticlePush = push;
+    computeParticlePush.positionDelta.w = -(1.0f - simulationClock.getAlpha()) * tick;
 
-    // Generate billboard vertices
-    fireParticles.generateVertices(cameraRight, cameraUp);
-    sandParticles.generateVertices(cameraRight, cameraUp);
+    // Generate one instance per live particle directly into this frame's
+    // ring region (billboarding happens in particle.vert). The frame's fence
+    // has already been waited on, so the region is free to overwrite.
+    particleUploadRing.beginFrame(currentFrame);
+    particleInstanceCount = 0;
 
-    // Combine all particle vertices
-    std::vector<ParticleVertex> allVertices;
-    std::vector<uint32_t> allIndices;
+    size_t liveCount = 0;
+    for (const ParticleSystem& emitter : particleEmitters) {
+        liveCount += static_cast<size_t>(emitter.getAliveCount());
+    }
+    if (liveCount == 0) return;
+
+    DynamicUploadRing::Allocation alloc = particleUploadRing.allocate(
+        sizeof(ParticleInstance) * liveCount, alignof(ParticleInstance));
+    if (!alloc.data) return;
+
+    // Every emitter owns a disjoint slice of the allocation, generated in parallel chunks.
+    // Alpha-blended emitters fill the front (drawn first, back to front), additive ones follow.
+    ParticleInstance* instances = static_cast<ParticleInstance*>(alloc.data);
+    JobSystem::Counter instanceJobs;
+    uint32_t instanceBase = 0;
+
+    auto generateInPoolOrder = [&](bool alphaBlended) {
+        for (const ParticleSystem& emitter : particleEmitters) {
+            uint32_t alive = static_cast<uint32_t>(emitter.getAliveCount());
+            if (emitter.isGpuSimulated() || alive == 0 || emitter.needsSorting() != alphaBlended) continue;
+
+            const ParticleSystem* source = &emitter;
+            ParticleInstance* slice = instances + instanceBase;
+            float rewind = particleRewind;
+            jobSystem.parallelFor(instanceJobs, alive, PARTICLE_JOB_CHUNK,
+                [source, slice, rewind](uint32_t begin, uint32_t end) {
+                    source->generateInstanceRange(slice + begin, begin, end, rewind);
+                });
+            instanceBase += alive;
+        }
+    };
 
-    // Add fire particles
-    const auto& fireVerts = fireParticles.getVertices();
-    const auto& fireInds = fireParticles.getIndices();
-    allVertices.insert(allVertices.end(), fireVerts.begin(), fireVerts.end());
-    allIndices.insert(allIndices.end(), fireInds.begin(), fireInds.end());
+    if (useParticleSort) {
+        instanceBase = generateSortedParticleInstances(instances);
+    }
+    else {
+        generateInPoolOrder(true);
+    }
+    particleAlphaInstanceCount = instanceBase;
+    generateInPoolOrder(false);
+    jobSystem.wait(instanceJobs);
+
+    particleInstanceCount = instanceBase;
+    particleInstanceOffset = alloc.offset;
+}
 
-    // Add sand particles (offset indices)
-    uint32_t indexOffset = static_cast<uint32_t>(fireVerts.size());
-    const auto& sandVerts = sandParticles.getVertices();
-    const auto& sandInds = sandParticles.getIndices();
-    allVertices.insert(allVertices.end(), sandVerts.begin(), sandVerts.end());
-    for (uint32_t idx : sandInds) {
-        allIndices.push_back(idx + indexOffset);
+uint32_t HelloTriangleApplication::generateSortedParticleInstances(ParticleInstance* dst) {
+    PROFILE_SCOPE("SortParticles");
+
+    // One sort across every alpha-blended CPU emitter, so their particles interleave correctly
+    particleSortEmitters.clear();
+    size_t sortCount = 0;
+    for (const ParticleSystem& emitter : particleEmitters) {
+        if (emitter.isGpuSimulated() || !emitter.needsSorting() || emitter.getAliveCount() == 0) continue;
+        particleSortEmitters.push_back(&emitter);
+        sortCount += static_cast<size_t>(emitter.getAliveCount());
     }
+    if (sortCount == 0) return 0;
 
-    // Upload to GPU
-    if (!allVertices.empty()) {
-        void* data;
-        vkMapMemory(device, particleVertexBufferMemory, 0,
-            sizeof(ParticleVertex) * allVertices.size(), 0, &data);
-        memcpy(data, allVertices.data(), sizeof(ParticleVertex) * allVertices.size());
-        vkUnmapMemory(device, particleVertexBufferMemory);
+    if (particleSortKeys.size() < sortCount) {
+        particleSortKeys.resize(sortCount);
+        particleSortValues.resize(sortCount);
+    }
 
-        vkMapMemory(device, particleIndexBufferMemory, 0,
-            sizeof(uint32_t) * allIndices.size(), 0, &data);
-        memcpy(data, allIndices.data(), sizeof(uint32_t) * allIndices.size());
-        vkUnmapMemory(device, particleIndexBufferMemory);
+    // Same camera as this frame's UBO (updateUniformBuffer has already run)
+    const glm::mat4& view = renderView;
+    glm::vec3 forward = -glm::vec3(view[0][2], view[1][2], view[2][2]);
+    glm::vec3 eye = renderCameraPosition;
+
+    // Quantized depth keys of the rewound (drawn) positions, chunked like instance generation
+    JobSystem::Counter keyJobs;
+    size_t keyBase = 0;
+    const float rewind = particleRewind;
+    for (uint32_t slot = 0; slot < particleSortEmitters.size(); slot++) {
+        const ParticleSystem* source = particleSortEmitters[slot];
+        uint32_t alive = static_cast<uint32_t>(source->getAliveCount());
+        uint32_t* keys = particleSortKeys.data() + keyBase;
+        uint32_t* values = particleSortValues.data() + keyBase;
+        uint32_t tag = slot << PARTICLE_SORT_INDEX_BITS;
+        jobSystem.parallelFor(keyJobs, alive, PARTICLE_JOB_CHUNK,
+            [source, keys, values, eye, forward, tag, rewind](uint32_t begin, uint32_t end) {
+                source->writeSortKeys(keys + begin, values + begin, begin, end,
+                    eye, forward, PARTICLE_SORT_MAX_DEPTH, tag, rewind);
+            });
+        keyBase += alive;
+    }
+    jobSystem.wait(keyJobs);
+
+    particleSorter.sort(particleSortKeys.data(), particleSortValues.data(), sortCount, 16, &jobSystem);
+
+    // Instances in sorted order; each record is gathered from its emitter's pool
+    const uint32_t indexMask = (1u << PARTICLE_SORT_INDEX_BITS) - 1;
+    JobSystem::Counter instanceJobs;
+    jobSystem.parallelFor(instanceJobs, static_cast<uint32_t>(sortCount), PARTICLE_JOB_CHUNK,
+        [this, dst, indexMask](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; i++) {
+                uint32_t value = particleSortValues[i];
+                particleSortEmitters[value >> PARTICLE_SORT_INDEX_BITS]->generateInstance(dst[i], value & indexMask, particleRewind);
+            }
+        });
+    jobSystem.wait(instanceJobs);
+
+    return static_cast<uint32_t>(sortCount);
+}
+
+void HelloTriangleApplication::kickParticleSimulation(uint32_t steps, float tick) {
+    // The next frame draws the state after these ticks, at this frame's alpha
+    particleRewind = (1.0f - simulationClock.getAlpha()) * tick;
+    if (steps == 0) return;
+
+    // One job per CPU emitter, running every tick in order. Emission and
+    // compaction are serial per emitter; large emitters fan their
+    // integration out into chunks and the emitter job helps run them
+    // while it waits.
+    for (ParticleSystem& emitter : particleEmitters) {
+        if (emitter.isGpuSimulated()) continue;
+
+        ParticleSystem* target = &emitter;
+        jobSystem.submit(particleSimJobs, [this, target, steps, tick]() {
+            PROFILE_SCOPE("SimulateEmitter");
+            for (uint32_t step = 0; step < steps; step++) {
+                uint32_t liveCount = static_cast<uint32_t>(target->beginUpdate(tick));
+
+                if (liveCount > PARTICLE_JOB_CHUNK) {
+                    JobSystem::Counter chunkJobs;
+                    jobSystem.parallelFor(chunkJobs, liveCount, PARTICLE_JOB_CHUNK,
+                        [target, tick](uint32_t begin, uint32_t end) {
+                            target->integrateRange(begin, end, tick);
+                        });
+                    jobSystem.wait(chunkJobs);
+                }
+                else {
+                    target->integrateRange(0, liveCount, tick);
+                }
+
+                target->endUpdate();
+            }
+        });
     }
 }
 
+void HelloTriangleApplication::waitParticleSimulation() {
+    jobSystem.wait(particleSimJobs);
+}
+
 void HelloTriangleApplication::renderParticles(VkCommandBuffer commandBuffer) {
-    size_t totalIndices = fireParticles.getIndexCount() + sandParticles.getIndexCount();
-    if (totalIndices == 0) return;
+    // GPU particles: vertex pulling in sort-buffer order, 6 vertices each
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, computeParticleRenderPipeline);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+        computeParticlePipelineLayout, 0, 1, &computeParticleDescriptorSets[currentFrame], 0, nullptr);
+    vkCmdPushConstants(commandBuffer, computeParticlePipelineLayout,
+        VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(ParticleComputePush), &computeParticlePush);
+    vkCmdDraw(commandBuffer, GPU_SAND_PARTICLES * 6, 1, 0, 0);
 
-    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, particlePipeline);
+    // CPU particles: instanced quads, 6 vertices per instance, no index buffer
+    if (particleInstanceCount == 0) return;
 
-    VkBuffer vertexBuffers[] = { particleVertexBuffer };
-    VkDeviceSize offsets[] = { 0 };
+    VkBuffer vertexBuffers[] = { particleUploadRing.getBuffer() };
+    VkDeviceSize offsets[] = { particleInstanceOffset };
     vkCmdBindVertexBuffers(commandBuffer, 0, 1, vertexBuffers, offsets);
-    vkCmdBindIndexBuffer(commandBuffer, particleIndexBuffer, 0, VK_INDEX_TYPE_UINT32);
     vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
         pipelineLayout, 0, 1, &descriptorSets[currentFrame], 0, nullptr);
 
-    vkCmdDrawIndexed(commandBuffer, static_cast<uint32_t>(totalIndices), 1, 0, 0, 0);
+    // Sorted alpha-blended instances first, additive ones (order-independent) on top
+    if (particleAlphaInstanceCount > 0) {
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, particleAlphaPipeline);
+        vkCmdDraw(commandBuffer, 6, particleAlphaInstanceCount, 0, 0);
+    }
+    if (particleInstanceCount > particleAlphaInstanceCount) {
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, particlePipeline);
+        vkCmdDraw(commandBuffer, 6, particleInstanceCount - particleAlphaInstanceCount, 0, particleAlphaInstanceCount);
+    }
+}
+
+void HelloTriangleApplication::createComputeParticlePipelines() {
+    // Set 0: binding 0 = UBO (camera), binding 1 = particle storage buffer,
+    // binding 2 = sort entries (the sort reads the camera to build depth keys)
+    VkDescriptorSetLayoutBinding uboBinding{};
+    uboBinding.binding = 0;
+    uboBinding.descriptorCount = 1;
+    uboBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    uboBinding.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_VERTEX_BIT;
+
+    VkDescriptorSetLayoutBinding storageBinding{};
+    storageBinding.binding = 1;
+    storageBinding.descriptorCount = 1;
+    storageBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    storageBinding.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_VERTEX_BIT;
+
+    VkDescriptorSetLayoutBinding sortBinding = storageBinding;
+    sortBinding.binding = 2;
+
+    std::array<VkDescriptorSetLayoutBinding, 3> bindings = { uboBinding, storageBinding, sortBinding };
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+    layoutInfo.pBindings = bindings.data();
+
+    if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &computeParticleSetLayout) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create compute particle descriptor set layout!");
+    }
+
+    // Emitter parameters are shared by the simulation and the billboard shader
+    VkPushConstantRange pushRange{};
+    pushRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_VERTEX_BIT;
+    pushRange.offset = 0;
+    pushRange.size = sizeof(ParticleComputePush);
+
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+    pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutInfo.setLayoutCount = 1;
+    pipelineLayoutInfo.pSetLayouts = &computeParticleSetLayout;
+    pipelineLayoutInfo.pushConstantRangeCount = 1;
+    pipelineLayoutInfo.pPushConstantRanges = &pushRange;
+
+    if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &computeParticlePipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create compute particle pipeline layout!");
+    }
+
+    // --- Simulation (compute) ---
+    pipelineRegistry.addCompute({ "particle compute", "shaders/particle_sim_comp.spv", computeParticlePipelineLayout },
+                                &computeParticleSimPipeline);
+
+    // --- Depth sort (compute): same set, its own step parameters ---
+    VkPushConstantRange sortPushRange{};
+    sortPushRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    sortPushRange.offset = 0;
+    sortPushRange.size = sizeof(ParticleSortPush);
+
+    pipelineLayoutInfo.pPushConstantRanges = &sortPushRange;
+    if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &particleSortPipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create particle sort pipeline layout!");
+    }
+    pipelineRegistry.addCompute({ "particle sort", "shaders/particle_sort_comp.spv", particleSortPipelineLayout },
+                                &particleSortPipeline);
+
+    // --- Rendering (vertex pulling, no vertex input; same state as CPU particles) ---
+    PipelineRegistry::GraphicsDesc desc;
+    desc.name = "GPU particle render";
+    desc.stages = {
+        { VK_SHADER_STAGE_VERTEX_BIT, "shaders/particle_gpu_vert.spv" },
+        { VK_SHADER_STAGE_FRAGMENT_BIT, "shaders/particle_frag.spv" } };
+    desc.cullMode = VK_CULL_MODE_NONE;
+    desc.depthWrite = false;
+    desc.alphaBlend = true;                // Sand is alpha-blended, drawn in sorted order
+    desc.layout = computeParticlePipelineLayout;
+    desc.colorFormat = swapChainImageFormat;
+    desc.depthFormat = depthFormat;
+    pipelineRegistry.addGraphics(desc, &computeParticleRenderPipeline);
+}
+
+void HelloTriangleApplication::createComputeParticleBuffer() {
+    // Device-local: only ever touched by the GPU (cleared with vkCmdFillBuffer)
+    VkDeviceSize bufferSize = sizeof(GpuParticle) * GPU_SAND_PARTICLES;
+    createBuffer(bufferSize,
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        DeviceMemoryAllocator::Pool::DeviceLocal,
+        computeParticleBuffer, computeParticleBufferAllocation);
+
+    computeParticlesNeedClear = true;
+    std::cout << "GPU particles: " << GPU_SAND_PARTICLES << " capacity ("
+        << bufferSize / (1024 * 1024) << " MB)" << std::endl;
+
+    // One (key, index) pair per slot, rewritten by dispatchParticleSort every frame
+    createBuffer(sizeof(uint32_t) * 2 * GPU_SAND_PARTICLES,
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+        DeviceMemoryAllocator::Pool::DeviceLocal,
+        particleSortBuffer, particleSortBufferAllocation);
+}
+
+void HelloTriangleApplication::createComputeParticleDescriptorSets() {
+    std::vector<VkDescriptorSetLayout> layouts(framesInFlight, computeParticleSetLayout);
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = descriptorPool;
+    allocInfo.descriptorSetCount = static_cast<uint32_t>(framesInFlight);
+    allocInfo.pSetLayouts = layouts.data();
+
+    computeParticleDescriptorSets.resize(framesInFlight);
+    if (vkAllocateDescriptorSets(device, &allocInfo, computeParticleDescriptorSets.data()) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to allocate compute particle descriptor sets!");
+    }
+
+    for (size_t i = 0; i < framesInFlight; i++) {
+        VkDescriptorBufferInfo uboInfo{};
+        uboInfo.buffer = uniformBuffers[i];
+        uboInfo.offset = 0;
+        uboInfo.range = sizeof(UniformBufferObject);
+
+        VkDescriptorBufferInfo storageInfo{};
+        storageInfo.buffer = computeParticleBuffer;
+        storageInfo.offset = 0;
+        storageInfo.range = VK_WHOLE_SIZE;
+
+        VkDescriptorBufferInfo sortInfo{};
+        sortInfo.buffer = particleSortBuffer;
+        sortInfo.offset = 0;
+        sortInfo.range = VK_WHOLE_SIZE;
+
+        std::array<VkWriteDescriptorSet, 3> descriptorWrites{};
+
+        descriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptorWrites[0].dstSet = computeParticleDescriptorSets[i];
+        descriptorWrites[0].dstBinding = 0;
+        descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        descriptorWrites[0].descriptorCount = 1;
+        descriptorWrites[0].pBufferInfo = &uboInfo;
+
+        descriptorWrites[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptorWrites[1].dstSet = computeParticleDescriptorSets[i];
+        descriptorWrites[1].dstBinding = 1;
+        descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        descriptorWrites[1].descriptorCount = 1;
+        descriptorWrites[1].pBufferInfo = &storageInfo;
+
+        descriptorWrites[2].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptorWrites[2].dstSet = computeParticleDescriptorSets[i];
+        descriptorWrites[2].dstBinding = 2;
+        descriptorWrites[2].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        descriptorWrites[2].descriptorCount = 1;
+        descriptorWrites[2].pBufferInfo = &sortInfo;
+
+        vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptorWrites.size()),
+            descriptorWrites.data(), 0, nullptr);
+    }
+}
+
+void HelloTriangleApplication::dispatchComputeParticles(VkCommandBuffer commandBuffer) {
+    // A single buffer is shared across frames in flight; queue-order barriers
+    // serialize this frame's simulation against last frame's vertex reads.
+    VkBufferMemoryBarrier2 toCompute{};
+    toCompute.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+    toCompute.srcStageMask = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    toCompute.srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+    toCompute.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    toCompute.dstAccessMask = VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+    toCompute.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toCompute.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toCompute.buffer = computeParticleBuffer;
+    toCompute.offset = 0;
+    toCompute.size = VK_WHOLE_SIZE;
+
+    if (computeParticlesNeedClear) {
+        // life = 0 marks every slot dead
+        vkCmdFillBuffer(commandBuffer, computeParticleBuffer, 0, VK_WHOLE_SIZE, 0);
+        toCompute.srcStageMask |= VK_PIPELINE_STAGE_2_CLEAR_BIT;
+        toCompute.srcAccessMask |= VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        computeParticlesNeedClear = false;
+    }
+
+    VkDependencyInfo dependencyToCompute{};
+    dependencyToCompute.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyToCompute.bufferMemoryBarrierCount = 1;
+    dependencyToCompute.pBufferMemoryBarriers = &toCompute;
+    vkCmdPipelineBarrier2(commandBuffer, &dependencyToCompute);
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computeParticleSimPipeline);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE,
+        computeParticlePipelineLayout, 0, 1, &computeParticleDescriptorSets[currentFrame], 0, nullptr);
+
+    // One dispatch per simulation tick (none on frames between ticks),
+    // each reading the previous tick's results
+    VkBufferMemoryBarrier2 betweenTicks = toCompute;
+    betweenTicks.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    betweenTicks.srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+
+    VkDependencyInfo dependencyBetweenTicks{};
+    dependencyBetweenTicks.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyBetweenTicks.bufferMemoryBarrierCount = 1;
+    dependencyBetweenTicks.pBufferMemoryBarriers = &betweenTicks;
+
+    const uint32_t workgroupSize = 256;  // Matches local_size_x in particle_sim.comp
+    for (size_t i = 0; i < computeParticleTicks.size(); i++) {
+        if (i > 0) {
+            vkCmdPipelineBarrier2(commandBuffer, &dependencyBetweenTicks);
+        }
+        vkCmdPushConstants(commandBuffer, computeParticlePipelineLayout,
+            VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(ParticleComputePush), &computeParticleTicks[i]);
+        vkCmdDispatch(commandBuffer, (GPU_SAND_PARTICLES + workgroupSize - 1) / workgroupSize, 1, 1);
+    }
+
+    // Simulation results must be visible to the depth sort and the billboard vertex shader
+    VkBufferMemoryBarrier2 toVertex{};
+    toVertex.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+    toVertex.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    toVertex.srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+    toVertex.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT;
+    toVertex.dstAccessMask = VK_ACCESS_2_SHADER_STORAGE_READ_BIT;
+    toVertex.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toVertex.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toVertex.buffer = computeParticleBuffer;
+    toVertex.offset = 0;
+    toVertex.size = VK_WHOLE_SIZE;
+
+    VkDependencyInfo dependencyToVertex{};
+    dependencyToVertex.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyToVertex.bufferMemoryBarrierCount = 1;
+    dependencyToVertex.pBufferMemoryBarriers = &toVertex;
+    vkCmdPipelineBarrier2(commandBuffer, &dependencyToVertex);
+}
+
+void HelloTriangleApplication::dispatchParticleSort(VkCommandBuffer commandBuffer) {
+    // Last frame's draw may still be reading the order this frame rewrites
+    VkBufferMemoryBarrier2 toCompute{};
+    toCompute.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+    toCompute.srcStageMask = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT;
+    toCompute.srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_READ_BIT;
+    toCompute.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    toCompute.dstAccessMask = VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+    toCompute.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toCompute.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toCompute.buffer = particleSortBuffer;
+    toCompute.offset = 0;
+    toCompute.size = VK_WHOLE_SIZE;
+
+    VkDependencyInfo dependency{};
+    dependency.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependency.bufferMemoryBarrierCount = 1;
+    dependency.pBufferMemoryBarriers = &toCompute;
+    vkCmdPipelineBarrier2(commandBuffer, &dependency);
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, particleSortPipeline);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE,
+        particleSortPipelineLayout, 0, 1, &computeParticleDescriptorSets[currentFrame], 0, nullptr);
+
+    // Every stage runs one invocation per pair of entries
+    const uint32_t groupCount = GPU_SAND_PARTICLES / PARTICLE_SORT_BLOCK;
+    auto dispatchStage = [&](uint32_t stage, uint32_t blockSize, uint32_t stride) {
+        ParticleSortPush push{ stage, blockSize, stride, 0 };
+        vkCmdPushConstants(commandBuffer, particleSortPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT,
+            0, sizeof(ParticleSortPush), &push);
+        vkCmdDispatch(commandBuffer, groupCount, 1, 1);
+    };
+
+    // Each bitonic step reads what the previous one wrote
+    VkBufferMemoryBarrier2 step = toCompute;
+    step.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    step.srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+    dependency.pBufferMemoryBarriers = &step;
+
+    if (!useParticleSort) {
+        // The vertex shader always draws through the sort buffer
+        dispatchStage(ParticleSortPush::POOL_ORDER, 0, 0);
+    }
+    else {
+        // Blocks are built and fully sorted in shared memory; merging two
+        // sorted runs only goes through global memory while the compare
+        // stride spans blocks, the rest finishes in shared memory again.
+        // 2^18 entries: 1 + 36 global + 8 local dispatches.
+        dispatchStage(ParticleSortPush::SORT_BLOCKS, PARTICLE_SORT_BLOCK, 0);
+        for (uint32_t blockSize = PARTICLE_SORT_BLOCK * 2; blockSize <= GPU_SAND_PARTICLES; blockSize *= 2) {
+            for (uint32_t stride = blockSize / 2; stride >= PARTICLE_SORT_BLOCK; stride /= 2) {
+                vkCmdPipelineBarrier2(commandBuffer, &dependency);
+                dispatchStage(ParticleSortPush::MERGE_GLOBAL, blockSize, stride);
+            }
+            vkCmdPipelineBarrier2(commandBuffer, &dependency);
+            dispatchStage(ParticleSortPush::MERGE_LOCAL, blockSize, 0);
+        }
+    }
+
+    // The billboard vertex shader reads the final order
+    VkBufferMemoryBarrier2 toVertex = step;
+    toVertex.dstStageMask = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT;
+    toVertex.dstAccessMask = VK_ACCESS_2_SHADER_STORAGE_READ_BIT;
+    dependency.pBufferMemoryBarriers = &toVertex;
+    vkCmdPipelineBarrier2(commandBuffer, &dependency);
 }
 
 // --- PARTICLE SYSTEM END ---
 
-int main() {
+// --- GPU-DRIVEN SCENE RENDERING ---
+
+void HelloTriangleApplication::createSceneCullPipeline() {
+    if (!gpuDrivenSupported) {
+        std::cout << "Scene culling: CPU (drawIndirectCount not supported)" << std::endl;
+        return;
+    }
+
+    // Set layout: binding 0 = scene objects, binding 1 = per-frame draw buffer.
+    // The indirect vertex shader reuses the same set to read transforms.
+    VkDescriptorSetLayoutBinding objectBinding{};
+    objectBinding.binding = 0;
+    objectBinding.descriptorCount = 1;
+    objectBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    objectBinding.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_VERTEX_BIT;
+
+    VkDescriptorSetLayoutBinding drawBinding{};
+    drawBinding.binding = 1;
+    drawBinding.descriptorCount = 1;
+    drawBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    drawBinding.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+    std::array<VkDescriptorSetLayoutBinding, 2> bindings = { objectBinding, drawBinding };
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+    layoutInfo.pBindings = bindings.data();
+
+    if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &sceneCullSetLayout) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create scene cull descriptor set layout!");
+    }
+
+    VkPushConstantRange pushRange{};
+    pushRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    pushRange.offset = 0;
+    pushRange.size = sizeof(SceneCullPush);
+
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+    pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutInfo.setLayoutCount = 1;
+    pipelineLayoutInfo.pSetLayouts = &sceneCullSetLayout;
+    pipelineLayoutInfo.pushConstantRangeCount = 1;
+    pipelineLayoutInfo.pPushConstantRanges = &pushRange;
+
+    if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &sceneCullPipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create scene cull pipeline layout!");
+    }
+
+    // Indirect scene pipeline: set 0 = scene UBO/texture, set 1 = scene objects
+    std::array<VkDescriptorSetLayout, 2> indirectSetLayouts = { descriptorSetLayout, sceneCullSetLayout };
+    VkPipelineLayoutCreateInfo indirectLayoutInfo{};
+    indirectLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    indirectLayoutInfo.setLayoutCount = static_cast<uint32_t>(indirectSetLayouts.size());
+    indirectLayoutInfo.pSetLayouts = indirectSetLayouts.data();
+
+    if (vkCreatePipelineLayout(device, &indirectLayoutInfo, nullptr, &indirectPipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create indirect pipeline layout!");
+    }
+
+    pipelineRegistry.addCompute({ "scene cull compute", "shaders/scene_cull_comp.spv", sceneCullPipelineLayout }, &sceneCullPipeline);
+
+    // Benchmarks can force the CPU path for comparison
+    useGpuCulling = !benchmark.isEnabled() || benchmark.getSettings().gpuCulling;
+    std::cout << "Scene culling: " << (useGpuCulling ? "GPU (indirect)" : "CPU") << std::endl;
+}
+
+void HelloTriangleApplication::createSceneCullBuffers() {
+    if (!gpuDrivenSupported) return;
+
+    // Static scene: bounds, transforms and LOD ranges are uploaded once
+    std::vector<GpuSceneObject> gpuObjects;
+    gpuObjects.reserve(scene.getObjectCount());
+    for (const SceneObject& object : scene.getObjects()) {
+        GpuSceneObject gpuObject{};
+        gpuObject.model = object.transform;
+        gpuObject.normalMatrix = object.normalMatrix;
+        gpuObject.boundsMin = glm::vec4(object.worldMin, 0.0f);
+        gpuObject.boundsMax = glm::vec4(object.worldMax, 0.0f);
+        for (uint32_t level = 0; level < object.lodCount; level++) {
+            gpuObject.lodFirstIndex[level] = object.lods[level].firstIndex;
+            gpuObject.lodIndexCount[level] = object.lods[level].indexCount;
+            gpuObject.lodVertexOffset[level] = object.lods[level].vertexOffset;
+        }
+        gpuObject.lodCount = object.lodCount;
+        gpuObject.clustered = object.clustered ? 1 : 0;
+        gpuObject.material = object.material;
+        gpuObjects.push_back(gpuObject);
+    }
+
+    VkDeviceSize objectBufferSize = sizeof(GpuSceneObject) * gpuObjects.size();
+    createBuffer(objectBufferSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        DeviceMemoryAllocator::Pool::DeviceLocal, sceneObjectBuffer, sceneObjectBufferAllocation);
+    uploadManager.uploadBuffer(sceneObjectBuffer, gpuObjects.data(), objectBufferSize);
+
+    // One draw buffer per frame in flight, so culling never overwrites
+    // commands a previous frame is still drawing from
+    VkDeviceSize drawBufferSize = SCENE_DRAW_COMMANDS_OFFSET +
+        sizeof(VkDrawIndexedIndirectCommand) * scene.getObjectCount();
+    sceneDrawBuffers.resize(framesInFlight);
+    sceneDrawBuffersAllocations.resize(framesInFlight);
+    for (size_t i = 0; i < framesInFlight; i++) {
+        createBuffer(drawBufferSize,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            DeviceMemoryAllocator::Pool::DeviceLocal, sceneDrawBuffers[i], sceneDrawBuffersAllocations[i]);
+    }
+}
+
+void HelloTriangleApplication::createSceneCullDescriptorSets() {
+    if (!gpuDrivenSupported) return;
+
+    std::vector<VkDescriptorSetLayout> layouts(framesInFlight, sceneCullSetLayout);
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = descriptorPool;
+    allocInfo.descriptorSetCount = static_cast<uint32_t>(framesInFlight);
+    allocInfo.pSetLayouts = layouts.data();
+
+    sceneCullDescriptorSets.resize(framesInFlight);
+    if (vkAllocateDescriptorSets(device, &allocInfo, sceneCullDescriptorSets.data()) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to allocate scene cull descriptor sets!");
+    }
+
+    for (size_t i = 0; i < framesInFlight; i++) {
+        VkDescriptorBufferInfo objectInfo{};
+        objectInfo.buffer = sceneObjectBuffer;
+        objectInfo.offset = 0;
+        objectInfo.range = VK_WHOLE_SIZE;
+
+        VkDescriptorBufferInfo drawInfo{};
+        drawInfo.buffer = sceneDrawBuffers[i];
+        drawInfo.offset = 0;
+        drawInfo.range = VK_WHOLE_SIZE;
+
+        std::array<VkWriteDescriptorSet, 2> descriptorWrites{};
+
+        descriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptorWrites[0].dstSet = sceneCullDescriptorSets[i];
+        descriptorWrites[0].dstBinding = 0;
+        descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        descriptorWrites[0].descriptorCount = 1;
+        descriptorWrites[0].pBufferInfo = &objectInfo;
+
+        descriptorWrites[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptorWrites[1].dstSet = sceneCullDescriptorSets[i];
+        descriptorWrites[1].dstBinding = 1;
+        descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        descriptorWrites[1].descriptorCount = 1;
+        descriptorWrites[1].pBufferInfo = &drawInfo;
+
+        vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptorWrites.size()),
+            descriptorWrites.data(), 0, nullptr);
+    }
+}
+
+void HelloTriangleApplication::dispatchSceneCulling(VkCommandBuffer commandBuffer) {
+    VkBuffer drawBuffer = sceneDrawBuffers[currentFrame];
+
+    // Reset the draw count; the commands themselves are overwritten in place
+    vkCmdFillBuffer(commandBuffer, drawBuffer, 0, sizeof(uint32_t), 0);
+
+    // The previous dispatch wrote each object's LOD back (hysteresis state)
+    VkBufferMemoryBarrier2 lodState{};
+    lodState.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+    lodState.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    lodState.srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+    lodState.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    lodState.dstAccessMask = VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+    lodState.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    lodState.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    lodState.buffer = sceneObjectBuffer;
+    lodState.offset = 0;
+    lodState.size = VK_WHOLE_SIZE;
+
+    VkBufferMemoryBarrier2 toCompute{};
+    toCompute.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+    toCompute.srcStageMask = VK_PIPELINE_STAGE_2_CLEAR_BIT;
+    toCompute.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    toCompute.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    toCompute.dstAccessMask = VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+    toCompute.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toCompute.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toCompute.buffer = drawBuffer;
+    toCompute.offset = 0;
+    toCompute.size = VK_WHOLE_SIZE;
+
+    std::array<VkBufferMemoryBarrier2, 2> computeBarriers = { toCompute, lodState };
+    VkDependencyInfo dependencyToCompute{};
+    dependencyToCompute.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyToCompute.bufferMemoryBarrierCount = static_cast<uint32_t>(computeBarriers.size());
+    dependencyToCompute.pBufferMemoryBarriers = computeBarriers.data();
+    vkCmdPipelineBarrier2(commandBuffer, &dependencyToCompute);
+
+    SceneCullPush push{};
+    const glm::vec4* planes = viewFrustum.getPlanes();
+    std::copy(planes, planes + 6, push.planes);
+    push.cameraPosition = glm::vec4(lodCameraPosition, lodProjectionScaleFactor);
+    push.objectCount = scene.getObjectCount();
+    push.lodBaseRadius = lodSettings.baseScreenRadius;
+    push.lodHysteresis = lodSettings.hysteresis;
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, sceneCullPipeline);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE,
+        sceneCullPipelineLayout, 0, 1, &sceneCullDescriptorSets[currentFrame], 0, nullptr);
+    vkCmdPushConstants(commandBuffer, sceneCullPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push), &push);
+
+    const uint32_t workgroupSize = 64;  // Matches local_size_x in scene_cull.comp
+    vkCmdDispatch(commandBuffer, (push.objectCount + workgroupSize - 1) / workgroupSize, 1, 1);
+
+    // Commands and count are consumed by the indirect draw
+    VkBufferMemoryBarrier2 toIndirect{};
+    toIndirect.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+    toIndirect.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    toIndirect.srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+    toIndirect.dstStageMask = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT;
+    toIndirect.dstAccessMask = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT;
+    toIndirect.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toIndirect.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toIndirect.buffer = drawBuffer;
+    toIndirect.offset = 0;
+    toIndirect.size = VK_WHOLE_SIZE;
+
+    VkDependencyInfo dependencyToIndirect{};
+    dependencyToIndirect.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyToIndirect.bufferMemoryBarrierCount = 1;
+    dependencyToIndirect.pBufferMemoryBarriers = &toIndirect;
+    vkCmdPipelineBarrier2(commandBuffer, &dependencyToIndirect);
+}
+
+// --- MESHLET RENDERING ---
+
+void HelloTriangleApplication::createMeshletPipelines() {
+    // One set for both paths: 0 = meshlets, 1 = meshlet vertices, 2 = triangles,
+    // 3 = scene vertices (mesh shader), 4 = output indices, 5 = draw commands (compute)
+    VkShaderStageFlags meshletStages = VK_SHADER_STAGE_COMPUTE_BIT;
+    if (meshShaderSupported) {
+        meshletStages |= VK_SHADER_STAGE_TASK_BIT_EXT | VK_SHADER_STAGE_MESH_BIT_EXT;
+    }
+
+    std::array<VkDescriptorSetLayoutBinding, 6> bindings{};
+    for (uint32_t i = 0; i < static_cast<uint32_t>(bindings.size()); i++) {
+        bindings[i].binding = i;
+        bindings[i].descriptorCount = 1;
+        bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        bindings[i].stageFlags = meshletStages;
+    }
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+    layoutInfo.pBindings = bindings.data();
+
+    if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &meshletSetLayout) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create meshlet descriptor set layout!");
+    }
+
+    VkPushConstantRange cullPushRange{};
+    cullPushRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    cullPushRange.offset = 0;
+    cullPushRange.size = sizeof(MeshletCullPush);
+
+    VkPipelineLayoutCreateInfo cullLayoutInfo{};
+    cullLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    cullLayoutInfo.setLayoutCount = 1;
+    cullLayoutInfo.pSetLayouts = &meshletSetLayout;
+    cullLayoutInfo.pushConstantRangeCount = 1;
+    cullLayoutInfo.pPushConstantRanges = &cullPushRange;
+
+    if (vkCreatePipelineLayout(device, &cullLayoutInfo, nullptr, &meshletCullPipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create meshlet cull pipeline layout!");
+    }
+
+    pipelineRegistry.addCompute({ "meshlet cull compute", "shaders/meshlet_cull_comp.spv", meshletCullPipelineLayout }, &meshletCullPipeline);
+
+    // Mesh shader pipeline: set 0 = scene UBO/texture, set 1 = meshlet data
+    if (meshShaderSupported) {
+        VkPushConstantRange drawPushRange{};
+        drawPushRange.stageFlags = VK_SHADER_STAGE_TASK_BIT_EXT | VK_SHADER_STAGE_MESH_BIT_EXT;
+        drawPushRange.offset = 0;
+        drawPushRange.size = sizeof(MeshletDrawPush);
+
+        std::array<VkDescriptorSetLayout, 2> setLayouts = { descriptorSetLayout, meshletSetLayout };
+        VkPipelineLayoutCreateInfo drawLayoutInfo{};
+        drawLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        drawLayoutInfo.setLayoutCount = static_cast<uint32_t>(setLayouts.size());
+        drawLayoutInfo.pSetLayouts = setLayouts.data();
+        drawLayoutInfo.pushConstantRangeCount = 1;
+        drawLayoutInfo.pPushConstantRanges = &drawPushRange;
+
+        if (vkCreatePipelineLayout(device, &drawLayoutInfo, nullptr, &meshletPipelineLayout) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create meshlet pipeline layout!");
+        }
+    }
+
+    // Benchmarks can force the compute path for comparison
+    useMeshShaders = meshShaderSupported && (!benchmark.isEnabled() || benchmark.getSettings().meshShaders);
+    std::cout << "Meshlet culling: " << (useMeshShaders ? "task/mesh shaders" : "compute (indirect)")
+        << (meshShaderSupported ? "" : ", VK_EXT_mesh_shader not supported") << std::endl;
+}
+
+void HelloTriangleApplication::createMeshletBuffers() {
+    clusterObjects.clear();
+    meshletDrawTemplate.clear();
+
+    std::vector<GpuMeshlet> gpuMeshlets;
+    std::vector<uint32_t> meshletVertices;
+    std::vector<uint32_t> meshletTriangles;
+    uint32_t indexCapacity = 0;
+    const std::vector<Vertex>& vertices = scene.getVertices();
+    const std::vector<uint32_t>& indices = scene.getIndices();
+
+    for (uint32_t objectIndex = 0; objectIndex < scene.getObjectCount(); objectIndex++) {
+        const SceneObject& object = scene.getObject(objectIndex);
+        if (!object.clustered) continue;
+
+        // Clustered objects always draw their full-detail mesh
+        const SceneMesh& geometry = object.lods[0];
+        // Keyed by content: any change to the mesh or the builder limits is a new entry
+        const Vertex* meshVertices = &vertices[geometry.vertexOffset];
+        const uint32_t* meshIndices = &indices[geometry.firstIndex];
+        uint64_t key = MeshCache::Key("meshlets")
+            .add(CacheFile::hashBytes(meshVertices, sizeof(Vertex) * geometry.vertexCount))
+            .add(CacheFile::hashBytes(meshIndices, sizeof(uint32_t) * geometry.indexCount))
+            .add(MeshletBuilder::DEFAULT_MAX_VERTICES).add(MeshletBuilder::DEFAULT_MAX_TRIANGLES).get();
+        MeshletMesh meshlets = meshCache.getOrCreateMeshlets(key, [&]() {
+            return MeshletBuilder::build(meshVertices, geometry.vertexCount, meshIndices, geometry.indexCount);
+        });
+
+        ClusterObject cluster;
+        cluster.objectIndex = objectIndex;
+        cluster.firstMeshlet = static_cast<uint32_t>(gpuMeshlets.size());
+        cluster.meshletCount = static_cast<uint32_t>(meshlets.meshlets.size());
+        cluster.firstIndex = indexCapacity;
+        cluster.triangleCount = static_cast<uint32_t>(meshlets.getTriangleCount());
+        indexCapacity += cluster.triangleCount * 3;
+
+        // Static object: bake bounds into world space once. A non-uniform
+        // scale would bend the normal cone, so it disables cone culling.
+        glm::vec3 axisScale(glm::length(glm::vec3(object.transform[0])),
+                            glm::length(glm::vec3(object.transform[1])),
+                            glm::length(glm::vec3(object.transform[2])));
+        float maxScale = std::max(axisScale.x, std::max(axisScale.y, axisScale.z));
+        bool uniformScale = maxScale - std::min(axisScale.x, std::min(axisScale.y, axisScale.z)) <= 1e-4f * maxScale;
+
+        uint32_t vertexBase = static_cast<uint32_t>(meshletVertices.size());
+        uint32_t triangleBase = static_cast<uint32_t>(meshletTriangles.size());
+        for (const Meshlet& meshlet : meshlets.meshlets) {
+            GpuMeshlet gpuMeshlet{};
+            gpuMeshlet.sphere = glm::vec4(glm::vec3(object.transform * glm::vec4(meshlet.center, 1.0f)),
+                meshlet.radius * maxScale);
+            glm::vec3 axis = glm::vec3(object.normalMatrix * glm::vec4(meshlet.coneAxis, 0.0f));
+            float axisLength = glm::length(axis);
+            gpuMeshlet.cone = glm::vec4(axisLength > 0.0f ? axis / axisLength : meshlet.coneAxis,
+                uniformScale ? meshlet.coneCutoff : 1.0f);
+            gpuMeshlet.vertexOffset = vertexBase + meshlet.vertexOffset;
+            gpuMeshlet.vertexCount = meshlet.vertexCount;
+            gpuMeshlet.triangleOffset = triangleBase + meshlet.triangleOffset;
+            gpuMeshlet.triangleCount = meshlet.triangleCount;
+            gpuMeshlet.clusterObject = static_cast<uint32_t>(clusterObjects.size());
+            gpuMeshlets.push_back(gpuMeshlet);
+        }
+
+        // Global vertex indices: neither path needs the object's vertexOffset
+        for (uint32_t vertex : meshlets.vertices) {
+            meshletVertices.push_back(vertex + static_cast<uint32_t>(geometry.vertexOffset));
+        }
+        meshletTriangles.insert(meshletTriangles.end(), meshlets.triangles.begin(), meshlets.triangles.end());
+
+        meshletDrawTemplate.push_back({ 0, 1, cluster.firstIndex, 0, 0 });
+        clusterObjects.push_back(cluster);
+    }
+
+    meshletCount = static_cast<uint32_t>(gpuMeshlets.size());
+    if (clusterObjects.empty()) return;
+
+    std::cout << "Meshlets: " << meshletCount << " clusters over " << clusterObjects.size() << " objects, "
+        << indexCapacity / 3 / meshletCount << " triangles per cluster on average" << std::endl;
+
+    VkDeviceSize meshletBufferSize = sizeof(GpuMeshlet) * gpuMeshlets.size();
+    createBuffer(meshletBufferSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        DeviceMemoryAllocator::Pool::DeviceLocal, meshletBuffer, meshletBufferAllocation);
+    uploadManager.uploadBuffer(meshletBuffer, gpuMeshlets.data(), meshletBufferSize);
+
+    VkDeviceSize vertexBufferSize = sizeof(uint32_t) * meshletVertices.size();
+    createBuffer(vertexBufferSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        DeviceMemoryAllocator::Pool::DeviceLocal, meshletVertexBuffer, meshletVertexBufferAllocation);
+    uploadManager.uploadBuffer(meshletVertexBuffer, meshletVertices.data(), vertexBufferSize);
+
+    VkDeviceSize triangleBufferSize = sizeof(uint32_t) * meshletTriangles.size();
+    createBuffer(triangleBufferSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        DeviceMemoryAllocator::Pool::DeviceLocal, meshletTriangleBuffer, meshletTriangleBufferAllocation);
+    uploadManager.uploadBuffer(meshletTriangleBuffer, meshletTriangles.data(), triangleBufferSize);
+
+    // Compute path outputs, per frame like the scene draw buffers
+    VkDeviceSize indexBufferSize = sizeof(uint32_t) * indexCapacity;
+    VkDeviceSize drawBufferSize = sizeof(VkDrawIndexedIndirectCommand) * clusterObjects.size();
+    meshletIndexBuffers.resize(framesInFlight);
+    meshletIndexBuffersAllocations.resize(framesInFlight);
+    meshletDrawBuffers.resize(framesInFlight);
+    meshletDrawBuffersAllocations.resize(framesInFlight);
+    for (size_t i = 0; i < framesInFlight; i++) {
+        createBuffer(indexBufferSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+            DeviceMemoryAllocator::Pool::DeviceLocal, meshletIndexBuffers[i], meshletIndexBuffersAllocations[i]);
+        createBuffer(drawBufferSize,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            DeviceMemoryAllocator::Pool::DeviceLocal, meshletDrawBuffers[i], meshletDrawBuffersAllocations[i]);
+    }
+}
+
+void HelloTriangleApplication::createMeshletDescriptorSets() {
+    if (clusterObjects.empty()) return;
+
+    std::vector<VkDescriptorSetLayout> layouts(framesInFlight, meshletSetLayout);
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = descriptorPool;
+    allocInfo.descriptorSetCount = static_cast<uint32_t>(framesInFlight);
+    allocInfo.pSetLayouts = layouts.data();
+
+    meshletDescriptorSets.resize(framesInFlight);
+    if (vkAllocateDescriptorSets(device, &allocInfo, meshletDescriptorSets.data()) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to allocate meshlet descriptor sets!");
+    }
+
+    for (size_t i = 0; i < framesInFlight; i++) {
+        // Same order as the bindings in createMeshletPipelines
+        std::array<VkBuffer, 6> buffers = {
+            meshletBuffer, meshletVertexBuffer, meshletTriangleBuffer,
+            vertexBuffer, meshletIndexBuffers[i], meshletDrawBuffers[i]
+        };
+
+        std::array<VkDescriptorBufferInfo, 6> bufferInfos{};
+        std::array<VkWriteDescriptorSet, 6> descriptorWrites{};
+        for (uint32_t b = 0; b < static_cast<uint32_t>(buffers.size()); b++) {
+            bufferInfos[b].buffer = buffers[b];
+            bufferInfos[b].offset = 0;
+            bufferInfos[b].range = VK_WHOLE_SIZE;
+
+            descriptorWrites[b].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            descriptorWrites[b].dstSet = meshletDescriptorSets[i];
+            descriptorWrites[b].dstBinding = b;
+            descriptorWrites[b].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            descriptorWrites[b].descriptorCount = 1;
+            descriptorWrites[b].pBufferInfo = &bufferInfos[b];
+        }
+
+        vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptorWrites.size()),
+            descriptorWrites.data(), 0, nullptr);
+    }
+}
+
+void HelloTriangleApplication::dispatchMeshletCulling(VkCommandBuffer commandBuffer) {
+    VkBuffer drawBuffer = meshletDrawBuffers[currentFrame];
+    VkBuffer indexOutput = meshletIndexBuffers[currentFrame];
+
+    // Restart every command at indexCount 0; the dispatch appends to it
+    vkCmdUpdateBuffer(commandBuffer, drawBuffer, 0,
+        sizeof(VkDrawIndexedIndirectCommand) * meshletDrawTemplate.size(), meshletDrawTemplate.data());
+
+    VkBufferMemoryBarrier2 toCompute{};
+    toCompute.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+    toCompute.srcStageMask = VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT;
+    toCompute.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    toCompute.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    toCompute.dstAccessMask = VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+    toCompute.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toCompute.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toCompute.buffer = drawBuffer;
+    toCompute.offset = 0;
+    toCompute.size = VK_WHOLE_SIZE;
+
+    VkDependencyInfo dependencyToCompute{};
+    dependencyToCompute.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyToCompute.bufferMemoryBarrierCount = 1;
+    dependencyToCompute.pBufferMemoryBarriers = &toCompute;
+    vkCmdPipelineBarrier2(commandBuffer, &dependencyToCompute);
+
+    MeshletCullPush push{};
+    const glm::vec4* planes = viewFrustum.getPlanes();
+    std::copy(planes, planes + 6, push.planes);
+    push.cameraPosition = glm::vec4(lodCameraPosition, 0.0f);
+    push.meshletCount = meshletCount;
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, meshletCullPipeline);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE,
+        meshletCullPipelineLayout, 0, 1, &meshletDescriptorSets[currentFrame], 0, nullptr);
+    vkCmdPushConstants(commandBuffer, meshletCullPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push), &push);
+
+    const uint32_t workgroupSize = 64;  // Matches local_size_x in meshlet_cull.comp
+    vkCmdDispatch(commandBuffer, (meshletCount + workgroupSize - 1) / workgroupSize, 1, 1);
+
+    // Commands feed the indirect draw, the expanded triangles the index fetch
+    std::array<VkBufferMemoryBarrier2, 2> drawBarriers{};
+    for (VkBufferMemoryBarrier2& barrier : drawBarriers) {
+        barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+        barrier.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+        barrier.srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.offset = 0;
+        barrier.size = VK_WHOLE_SIZE;
+    }
+    drawBarriers[0].dstStageMask = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT;
+    drawBarriers[0].dstAccessMask = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT;
+    drawBarriers[0].buffer = drawBuffer;
+    drawBarriers[1].dstStageMask = VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT;
+    drawBarriers[1].dstAccessMask = VK_ACCESS_2_INDEX_READ_BIT;
+    drawBarriers[1].buffer = indexOutput;
+
+    VkDependencyInfo dependencyToDraw{};
+    dependencyToDraw.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyToDraw.bufferMemoryBarrierCount = static_cast<uint32_t>(drawBarriers.size());
+    dependencyToDraw.pBufferMemoryBarriers = drawBarriers.data();
+    vkCmdPipelineBarrier2(commandBuffer, &dependencyToDraw);
+}
+
+void HelloTriangleApplication::renderMeshlets(VkCommandBuffer commandBuffer) {
+    if (clusterObjects.empty()) return;
+
+    if (useMeshShaders) {
+        // The task shader culls; one task workgroup per MESHLETS_PER_TASK meshlets
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, meshletGraphicsPipeline);
+        std::array<VkDescriptorSet, 2> sets = { descriptorSets[currentFrame], meshletDescriptorSets[currentFrame] };
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, meshletPipelineLayout,
+            0, static_cast<uint32_t>(sets.size()), sets.data(), 0, nullptr);
+
+        for (const ClusterObject& cluster : clusterObjects) {
+            const SceneObject& object = scene.getObject(cluster.objectIndex);
+            MeshletDrawPush push{ object.transform, cluster.firstMeshlet, cluster.meshletCount, object.material };
+            vkCmdPushConstants(commandBuffer, meshletPipelineLayout,
+                VK_SHADER_STAGE_TASK_BIT_EXT | VK_SHADER_STAGE_MESH_BIT_EXT, 0, sizeof(push), &push);
+            cmdDrawMeshTasks(commandBuffer, (cluster.meshletCount + MESHLETS_PER_TASK - 1) / MESHLETS_PER_TASK, 1, 1);
+        }
+        return;
+    }
+
+    // Compute path: regular pipeline, surviving triangles from dispatchMeshletCulling
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, useGouraud ? gouraudPipeline : graphicsPipeline);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &descriptorSets[currentFrame], 0, nullptr);
+    vkCmdBindIndexBuffer(commandBuffer, meshletIndexBuffers[currentFrame], 0, VK_INDEX_TYPE_UINT32);
+
+    for (uint32_t i = 0; i < static_cast<uint32_t>(clusterObjects.size()); i++) {
+        const SceneObject& object = scene.getObject(clusterObjects[i].objectIndex);
+        ObjectPushConstants push = ObjectPushConstants::forObject(object);
+        vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(push), &push);
+        vkCmdDrawIndexedIndirect(commandBuffer, meshletDrawBuffers[currentFrame],
+            sizeof(VkDrawIndexedIndirectCommand) * i, 1, sizeof(VkDrawIndexedIndirectCommand));
+    }
+}
+
+// --- PROFILING ---
+
+void HelloTriangleApplication::updateProfilerTitle() {
+    // Two refreshes a second keep the numbers readable without title spam
+    auto now = std::chrono::steady_clock::now();
+    if (now - lastTitleUpdate < std::chrono::milliseconds(500)) return;
+    lastTitleUpdate = now;
+
+    std::string title = "Vulkan 1.3 - Refactored | " + Profiler::instance().getSummary();
+    glfwSetWindowTitle(window, title.c_str());
+}
+
+// --- BENCHMARK MODE ---
+
+std::vector<const char*> HelloTriangleApplication::getDeviceExtensions() const {
+    // Offscreen runs never present, so they also work on devices without a swapchain
+    if (isOffscreen()) return {};
+    return deviceExtensions;
+}
+
+void HelloTriangleApplication::initBenchmark() {
+    const Benchmark::Settings& settings = benchmark.getSettings();
+
+    if (settings.cameraPathFile.empty() || !benchmarkPath.loadFromFile(settings.cameraPathFile)) {
+        if (!settings.cameraPathFile.empty()) {
+            std::cerr << "Benchmark: could not read " << settings.cameraPathFile << ", using built-in path\n";
+        }
+        benchmarkPath = CameraPath::createDefault();
+    }
+
+    dayNightCycle.setTimeOfDay(settings.timeOfDay);
+    timeScale = 1.0f;
+    activeCameraIndex = 1;   // Navigation camera flies the path
+
+    std::cout << "Benchmark: " << settings.warmupFrames << " warm-up + " << settings.frameCount
+        << " frames" << (settings.offscreen ? " (offscreen)" : "")
+        << ", seed " << settings.seed << ", path " << benchmarkPath.getDuration() << " s\n";
+}
+
+void HelloTriangleApplication::createOffscreenTargets() {
+    const Benchmark::Settings& settings = benchmark.getSettings();
+
+    // Same format the swapchain usually picks, so pipelines are identical
+    swapChainImageFormat = VK_FORMAT_B8G8R8A8_SRGB;
+    swapChainExtent = { settings.width, settings.height };
+    finalColorLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+
+    swapChainImages.resize(framesInFlight);
+    offscreenImageAllocations.resize(framesInFlight);
+    for (size_t i = 0; i < framesInFlight; i++) {
+        createImage(swapChainExtent.width, swapChainExtent.height, swapChainImageFormat,
+            VK_IMAGE_TILING_OPTIMAL,
+            VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+            DeviceMemoryAllocator::Pool::DeviceLocal, swapChainImages[i], offscreenImageAllocations[i]);
+    }
+}
+
+void HelloTriangleApplication::updateBenchmarkCamera() {
+    // Path time comes from the frame index, never the wall clock
+    float pathTime = static_cast<float>(benchmark.getFrameIndex()) * benchmark.getSettings().fixedDelta;
+
+    glm::vec3 position, target;
+    benchmarkPath.evaluate(pathTime, position, target);
+    cameras[activeCameraIndex].setPosition(position);
+    cameras[activeCameraIndex].setTarget(target);
+}
+
+void HelloTriangleApplication::recordBenchmarkFrame(float frameMilliseconds) {
+    // Per-subsystem CPU scopes and GPU passes, as totalled by the profiler
+    Profiler& profiler = Profiler::instance();
+    for (const std::string& name : profiler.getScopeNames()) {
+        if (name == "Frame" || name.rfind("Startup:", 0) == 0) continue;
+        benchmark.recordMetric(name + " ms", profiler.getLastFrame(name));
+    }
+
+    if (!useGpuCulling) {
+        benchmark.recordMetric("Visible objects", static_cast<float>(visibleObjects.size()));
+    }
+    benchmark.recordMetric("Visible cacti", static_cast<float>(visibleCactusCount));
+    benchmark.recordMetric("Cactus draws", static_cast<float>(cactusDraws.size()));
+    benchmark.recordMetric("CPU particles", static_cast<float>(particleInstanceCount));
+    benchmark.recordMetric("CPU particles sorted", static_cast<float>(useParticleSort ? particleAlphaInstanceCount : 0));
+    uint32_t gpuParticlesEmitted = 0;
+    for (const ParticleComputePush& tick : computeParticleTicks) {
+        gpuParticlesEmitted += tick.emitCount;
+    }
+    benchmark.recordMetric("GPU particles emitted", static_cast<float>(gpuParticlesEmitted));
+    benchmark.recordMetric("Simulation ticks", static_cast<float>(simulationSteps));
+    benchmark.endFrame(frameMilliseconds);
+}
+
+int main(int argc, char** argv) {
+    Benchmark::Settings benchmarkSettings;
+    if (!Benchmark::parseCommandLine(argc, argv, benchmarkSettings)) {
+        return EXIT_FAILURE;
+    }
+
     HelloTriangleApplication app;
+    app.configureBenchmark(benchmarkSettings);
     try {
         app.run();
     }
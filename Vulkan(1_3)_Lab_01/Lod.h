@@ -0,0 +1,57 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+// ============================================================
+// LEVEL OF DETAIL SELECTION
+// ============================================================
+// Meshes are generated as chains of up to MAX_LOD_LEVELS levels,
+// each with roughly half the segments of the previous one.
+// A level is picked from the object's projected size: the bounding
+// sphere radius in pixels. Boundary k (between level k and k+1)
+// sits at baseScreenRadius / 2^k, so every halving of on-screen
+// size drops one level.
+//
+// Key concepts for defense:
+// - Screen size, not raw distance: narrowing the FOV raises detail
+// - Hysteresis: a level only changes once the size is clearly past a
+//   boundary (+/- hysteresis fraction), so objects hovering at a
+//   boundary do not pop back and forth every frame
+// - scene_cull.comp runs the same rule on the GPU-driven path
+// ============================================================
+
+constexpr uint32_t MAX_LOD_LEVELS = 4;
+
+struct LodSettings {
+    float baseScreenRadius = 160.0f;   // Pixels; below this, leave LOD 0 (0 = always LOD 0)
+    float hysteresis = 0.15f;          // Fraction of a boundary to overshoot before switching
+};
+
+// Pixels per world unit of radius at distance 1: proj[1][1] * height / 2
+inline float lodProjectionScale(const glm::mat4& projection, float viewportHeight) {
+    return std::abs(projection[1][1]) * 0.5f * viewportHeight;
+}
+
+// Projected radius in pixels of a bounding sphere
+inline float lodScreenRadius(const glm::vec3& center, float radius,
+                             const glm::vec3& cameraPosition, float projectionScale) {
+    float distance = std::max(glm::length(center - cameraPosition), 1e-3f);
+    return radius * projectionScale / distance;
+}
+
+// Level for a projected size, keeping currentLod unless a boundary is clearly crossed
+inline uint32_t selectLod(float screenRadius, uint32_t currentLod, uint32_t lodCount,
+                          const LodSettings& settings) {
+    uint32_t minLevel = 0;   // Clearly past these boundaries: at least this coarse
+    uint32_t maxLevel = 0;   // Within hysteresis of these: at most this coarse
+    float boundary = settings.baseScreenRadius;
+    for (uint32_t k = 0; k + 1 < lodCount; k++) {
+        if (screenRadius < boundary * (1.0f - settings.hysteresis)) minLevel = k + 1;
+        if (screenRadius < boundary * (1.0f + settings.hysteresis)) maxLevel = k + 1;
+        boundary *= 0.5f;
+    }
+    return std::clamp(currentLod, minLevel, maxLevel);
+}
@@ -0,0 +1,115 @@
+#include "MappedFile.h"
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+        std::swap(m_open, other.m_open);
+        std::swap(m_file, other.m_file);
+#ifdef _WIN32
+        std::swap(m_mapping, other.m_mapping);
+#endif
+    }
+    return *this;
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string& filepath) {
+    close();
+
+    HANDLE file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        return false;
+    }
+    m_file = file;
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+    m_open = true;
+    if (m_size == 0) return true;   // Zero-length files can't be mapped
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        close();
+        return false;
+    }
+    m_mapping = mapping;
+
+    m_data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (m_data == nullptr) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void MappedFile::close() {
+    if (m_data) UnmapViewOfFile(m_data);
+    if (m_mapping) CloseHandle(static_cast<HANDLE>(m_mapping));
+    if (m_file) CloseHandle(static_cast<HANDLE>(m_file));
+    m_data = nullptr;
+    m_mapping = nullptr;
+    m_file = nullptr;
+    m_size = 0;
+    m_open = false;
+}
+
+#else
+
+bool MappedFile::open(const std::string& filepath) {
+    close();
+
+    int file = ::open(filepath.c_str(), O_RDONLY);
+    if (file < 0) return false;
+
+    struct stat fileStat {};
+    if (fstat(file, &fileStat) != 0) {
+        ::close(file);
+        return false;
+    }
+    m_file = file;
+    m_size = static_cast<size_t>(fileStat.st_size);
+    m_open = true;
+    if (m_size == 0) return true;   // Zero-length files can't be mapped
+
+    void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0);
+    if (data == MAP_FAILED) {
+        close();
+        return false;
+    }
+    madvise(data, m_size, MADV_SEQUENTIAL);
+    m_data = static_cast<const char*>(data);
+    return true;
+}
+
+void MappedFile::close() {
+    if (m_data) munmap(const_cast<char*>(m_data), m_size);
+    if (m_file >= 0) ::close(m_file);
+    m_data = nullptr;
+    m_file = -1;
+    m_size = 0;
+    m_open = false;
+}
+
+#endif
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Read-only memory mapping of a whole file
+ * 
+ * Role: Let loaders parse large asset files in place
+ * Responsibilities:
+ * - Map a file into the address space (Win32 file mapping or POSIX mmap)
+ * - Unmap and close it on destruction
+ * 
+ * Design Notes:
+ * - No copy into a std::string or stream buffer: pages are faulted in
+ *   on first touch, and threads can parse disjoint ranges concurrently
+ * - Empty files open successfully with size 0 and a null data pointer
+ * - Move-only (owns OS handles)
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    // Non-copyable
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Map filepath read-only (closes any previous mapping)
+     * @return false if the file can't be opened or mapped
+     */
+    bool open(const std::string& filepath);
+    void close();
+
+    bool isOpen() const { return m_open; }
+    const char* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+private:
+    const char* m_data = nullptr;
+    size_t m_size = 0;
+    bool m_open = false;
+
+#ifdef _WIN32
+    void* m_file = nullptr;       // HANDLE
+    void* m_mapping = nullptr;    // HANDLE
+#else
+    int m_file = -1;
+#endif
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief One surface material (std430, matches Material in shader.frag)
+ */
+struct GpuMaterial {
+    glm::vec4 baseColor{ 1.0f };            // Multiplies the albedo texture or vertex color
+    uint32_t albedoTexture = 0xFFFFFFFFu;   // Bindless slot (TextureManager index or reserved), or NO_TEXTURE
+    float specularStrength = 0.5f;
+    float shininess = 32.0f;
+    uint32_t padding = 0;
+};
+static_assert(sizeof(GpuMaterial) == 32, "GpuMaterial must match the std430 Material struct");
+
+/**
+ * @brief Table of materials uploaded as one storage buffer
+ *
+ * Role: Give every draw path the same way to look up surface properties
+ * Responsibilities:
+ * - Hold the GpuMaterial records in upload order, with a name per entry
+ * - Hand out stable indices that draws pass to the shaders
+ *
+ * Design Notes:
+ * - Textures are referenced by bindless slot, which is simply the
+ *   TextureManager index: the texture array in descriptor set 0 is
+ *   written at those slots, so adding a textured material never adds a
+ *   descriptor set or a rebind. Slots above the TextureManager's range
+ *   may be reserved by the application and rewritten per frame (streamed
+ *   textures, whose TextureManager index changes as they come and go)
+ * - The table is built once at load and is read-only afterwards; the
+ *   GPU copy lives in a device-local buffer owned by the application
+ */
+class MaterialLibrary {
+public:
+    static constexpr uint32_t NO_TEXTURE = 0xFFFFFFFFu;   // Use the vertex color instead
+
+    MaterialLibrary() = default;
+
+    /**
+     * @brief Append a material
+     * @return Index to pass to the shaders
+     */
+    uint32_t add(const std::string& name, const GpuMaterial& material) {
+        m_names.push_back(name);
+        m_materials.push_back(material);
+        return static_cast<uint32_t>(m_materials.size() - 1);
+    }
+
+    void clear() {
+        m_names.clear();
+        m_materials.clear();
+    }
+
+    // Accessors
+    const std::vector<GpuMaterial>& getMaterials() const { return m_materials; }
+    const std::string& getName(uint32_t index) const { return m_names.at(index); }
+    uint32_t getCount() const { return static_cast<uint32_t>(m_materials.size()); }
+
+private:
+    std::vector<std::string> m_names;
+    std::vector<GpuMaterial> m_materials;
+};
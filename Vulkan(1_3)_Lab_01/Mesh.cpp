@@ -9,6 +9,15 @@ Mesh::Mesh(std::vector<Vertex> vertices, std::vector<uint32_t> indices)
     recalculateBounds();
 }
 
+Mesh::Mesh(std::vector<Vertex> vertices, std::vector<uint32_t> indices,
+           const glm::vec3& minBounds, const glm::vec3& maxBounds)
+    : m_vertices(std::move(vertices))
+    , m_indices(std::move(indices))
+    , m_minBounds(minBounds)
+    , m_maxBounds(maxBounds)
+{
+}
+
 void Mesh::setVertices(std::vector<Vertex> vertices) {
     m_vertices = std::move(vertices);
     recalculateBounds();
@@ -22,6 +22,9 @@ class Mesh {
 public:
     Mesh() = default;
     Mesh(std::vector<Vertex> vertices, std::vector<uint32_t> indices);
+    // Trusts the given bounds (e.g. from a cache) instead of rescanning the vertices
+    Mesh(std::vector<Vertex> vertices, std::vector<uint32_t> indices,
+         const glm::vec3& minBounds, const glm::vec3& maxBounds);
 
     // Accessors
     const std::vector<Vertex>& getVertices() const { return m_vertices; }
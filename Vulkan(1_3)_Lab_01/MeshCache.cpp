@@ -0,0 +1,177 @@
+#include "MeshCache.h"
+#include "MappedFile.h"
+#include <cstring>
+#include <filesystem>
+
+namespace {
+    const char MAGIC[4] = { 'S', 'M', 'S', 'H' };
+
+    // File layout: FileHeader, LodRecord[lodCount], per level the vertex
+    // then index blob, then Meshlet[meshletCount], meshlet vertices and
+    // meshlet triangles. Everything is 4-byte aligned.
+    struct FileHeader {
+        char magic[4];
+        uint32_t version;
+        uint64_t key;
+        uint64_t contentHash;       // CacheFile::hashBytes over everything after the header
+        uint32_t vertexStride;      // sizeof(Vertex) when written
+        uint32_t lodCount;
+        uint32_t meshletCount;
+        uint32_t meshletVertexCount;
+        uint32_t meshletTriangleCount;
+        uint32_t padding;
+    };
+    static_assert(sizeof(FileHeader) == 48, "FileHeader layout is part of the file format");
+
+    struct LodRecord {
+        uint32_t vertexCount;
+        uint32_t indexCount;
+        float boundsMin[3];
+        float boundsMax[3];
+    };
+
+    template<typename T>
+    void appendBytes(std::vector<char>& blob, const T* data, size_t count) {
+        const char* bytes = reinterpret_cast<const char*>(data);
+        blob.insert(blob.end(), bytes, bytes + sizeof(T) * count);
+    }
+
+    // Bounds-checked read cursor over the mapped file
+    struct Reader {
+        const char* cursor;
+        const char* end;
+
+        template<typename T>
+        bool read(std::vector<T>& out, size_t count) {
+            size_t bytes = sizeof(T) * count;
+            if (static_cast<size_t>(end - cursor) < bytes) return false;
+            out.resize(count);
+            if (bytes > 0) std::memcpy(out.data(), cursor, bytes);
+            cursor += bytes;
+            return true;
+        }
+    };
+}
+
+void MeshCache::init(const std::string& directory, bool enabled) {
+    m_directory = directory;
+    m_enabled = enabled;
+    m_hits = 0;
+    m_misses = 0;
+}
+
+std::vector<Mesh> MeshCache::getOrCreateLods(uint64_t key, const std::function<std::vector<Mesh>()>& generate) {
+    Entry entry;
+    if (load(key, entry) && !entry.lods.empty()) {
+        return std::move(entry.lods);
+    }
+    entry = Entry();
+    entry.lods = generate();
+    if (!entry.lods.empty()) store(key, entry);   // Failed generation: retry next run
+    return std::move(entry.lods);
+}
+
+MeshletMesh MeshCache::getOrCreateMeshlets(uint64_t key, const std::function<MeshletMesh()>& build) {
+    Entry entry;
+    if (load(key, entry) && !entry.meshlets.meshlets.empty()) {
+        return std::move(entry.meshlets);
+    }
+    entry = Entry();
+    entry.meshlets = build();
+    if (!entry.meshlets.meshlets.empty()) store(key, entry);
+    return std::move(entry.meshlets);
+}
+
+bool MeshCache::load(uint64_t key, Entry& entry) {
+    if (!m_enabled) return false;
+
+    MappedFile file;
+    FileHeader header{};
+    bool valid = file.open(CacheFile::pathFor(m_directory, key, ".smesh")) && file.size() >= sizeof(FileHeader);
+    if (valid) {
+        std::memcpy(&header, file.data(), sizeof(header));
+        valid = std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 &&
+                header.version == FORMAT_VERSION &&
+                header.key == key &&
+                header.vertexStride == sizeof(Vertex) &&
+                header.contentHash == CacheFile::hashBytes(file.data() + sizeof(header), file.size() - sizeof(header));
+    }
+
+    Reader reader{ file.data() + sizeof(header), file.data() + file.size() };
+    std::vector<LodRecord> records;
+    valid = valid && reader.read(records, header.lodCount);
+
+    entry = Entry();
+    for (size_t level = 0; valid && level < records.size(); level++) {
+        const LodRecord& record = records[level];
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+        valid = reader.read(vertices, record.vertexCount) && reader.read(indices, record.indexCount);
+        if (valid) {
+            entry.lods.emplace_back(std::move(vertices), std::move(indices),
+                glm::vec3(record.boundsMin[0], record.boundsMin[1], record.boundsMin[2]),
+                glm::vec3(record.boundsMax[0], record.boundsMax[1], record.boundsMax[2]));
+        }
+    }
+    valid = valid &&
+        reader.read(entry.meshlets.meshlets, header.meshletCount) &&
+        reader.read(entry.meshlets.vertices, header.meshletVertexCount) &&
+        reader.read(entry.meshlets.triangles, header.meshletTriangleCount);
+
+    if (!valid) {
+        entry = Entry();
+        m_misses++;
+        return false;
+    }
+    m_hits++;
+    return true;
+}
+
+bool MeshCache::store(uint64_t key, const Entry& entry) const {
+    if (!m_enabled) return false;
+
+    std::vector<char> body;
+    for (const Mesh& mesh : entry.lods) {
+        LodRecord record{};
+        record.vertexCount = static_cast<uint32_t>(mesh.getVertexCount());
+        record.indexCount = static_cast<uint32_t>(mesh.getIndexCount());
+        glm::vec3 boundsMin = mesh.getMinBounds();
+        glm::vec3 boundsMax = mesh.getMaxBounds();
+        std::memcpy(record.boundsMin, &boundsMin, sizeof(record.boundsMin));
+        std::memcpy(record.boundsMax, &boundsMax, sizeof(record.boundsMax));
+        appendBytes(body, &record, 1);
+    }
+    for (const Mesh& mesh : entry.lods) {
+        appendBytes(body, mesh.getVertices().data(), mesh.getVertexCount());
+        appendBytes(body, mesh.getIndices().data(), mesh.getIndexCount());
+    }
+    appendBytes(body, entry.meshlets.meshlets.data(), entry.meshlets.meshlets.size());
+    appendBytes(body, entry.meshlets.vertices.data(), entry.meshlets.vertices.size());
+    appendBytes(body, entry.meshlets.triangles.data(), entry.meshlets.triangles.size());
+
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = FORMAT_VERSION;
+    header.key = key;
+    header.contentHash = CacheFile::hashBytes(body.data(), body.size());
+    header.vertexStride = sizeof(Vertex);
+    header.lodCount = static_cast<uint32_t>(entry.lods.size());
+    header.meshletCount = static_cast<uint32_t>(entry.meshlets.meshlets.size());
+    header.meshletVertexCount = static_cast<uint32_t>(entry.meshlets.vertices.size());
+    header.meshletTriangleCount = static_cast<uint32_t>(entry.meshlets.triangles.size());
+
+    return CacheFile::writeFileAtomically(CacheFile::pathFor(m_directory, key, ".smesh"), header, body.data(), body.size());
+}
+
+uint64_t MeshCache::keyForFile(const std::string& filepath) {
+    std::error_code error;
+    auto size = std::filesystem::file_size(filepath, error);
+    if (error) return 0;
+    auto modified = std::filesystem::last_write_time(filepath, error);
+    if (error) return 0;
+
+    return Key("file").add(filepath)
+        .add(static_cast<uint64_t>(size))
+        .add(static_cast<int64_t>(modified.time_since_epoch().count()))
+        .get();
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "CacheFile.h"
+#include "Mesh.h"
+#include "Meshlet.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief On-disk cache of generated and loaded meshes
+ * 
+ * Role: Skip OBJ parsing, procedural generation and meshlet building on
+ *       every launch after the first
+ * Responsibilities:
+ * - Store LOD chains and meshlets in a binary container (one file per key)
+ * - Memory-map entries back and copy the blobs out with no parsing
+ * - Build keys from generator parameters or from a source file's
+ *   path, size and modification time
+ * 
+ * Design Notes:
+ * - Vertex blobs are raw Vertex arrays, i.e. exactly the layout of
+ *   Vertex::getAttributeDescriptions(); indices are uint32_t
+ * - Every entry carries its key, format version, vertex stride and a
+ *   content hash; any mismatch counts as a miss and the entry is rebuilt,
+ *   so stale or truncated files are never used
+ * - Writes go through CacheFile::writeFileAtomically, so a crash never
+ *   leaves a half-written entry behind
+ * - Bump GENERATOR_REVISION whenever procedural output changes
+ * - load()/store() may run on several threads at once (AssetStreamer
+ *   loaders) as long as they use different keys
+ */
+class MeshCache {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 1;
+    static constexpr uint32_t GENERATOR_REVISION = 2;    // 2: MeshOptimizer ordering
+
+    /**
+     * @brief What one cache file holds (either part may be empty)
+     */
+    struct Entry {
+        std::vector<Mesh> lods;     // Level 0 first
+        MeshletMesh meshlets;
+    };
+
+    /**
+     * @brief Mesh key: CacheFile::Key seeded with GENERATOR_REVISION
+     */
+    class Key : public CacheFile::Key {
+    public:
+        explicit Key(const std::string& kind) : CacheFile::Key(kind, GENERATOR_REVISION) {}
+    };
+
+    MeshCache() = default;
+
+    /**
+     * @brief Set the cache directory (created on first store)
+     * @param enabled False = always generate, never read or write
+     */
+    void init(const std::string& directory, bool enabled = true);
+
+    /**
+     * @brief Cached LOD chain for key, or generate() stored under key
+     */
+    std::vector<Mesh> getOrCreateLods(uint64_t key, const std::function<std::vector<Mesh>()>& generate);
+
+    /**
+     * @brief Cached meshlets for key, or build() stored under key
+     */
+    MeshletMesh getOrCreateMeshlets(uint64_t key, const std::function<MeshletMesh()>& build);
+
+    bool load(uint64_t key, Entry& entry);
+    bool store(uint64_t key, const Entry& entry) const;
+
+    /**
+     * @brief Key for a source file: path, size and modification time
+     * @return 0 if the file does not exist
+     */
+    static uint64_t keyForFile(const std::string& filepath);
+
+    bool isEnabled() const { return m_enabled; }
+    uint32_t getHits() const { return m_hits; }
+    uint32_t getMisses() const { return m_misses; }
+
+private:
+    std::string m_directory;
+    bool m_enabled = false;
+    std::atomic<uint32_t> m_hits{ 0 };
+    std::atomic<uint32_t> m_misses{ 0 };
+};
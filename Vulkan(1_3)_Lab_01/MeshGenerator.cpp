@@ -1,5 +1,6 @@
 #include "MeshGenerator.h"
 #include <glm/gtc/constants.hpp>
+#include <algorithm>
 #include <cmath>
 
 Mesh MeshGenerator::createSphere(float radius, uint32_t segments, uint32_t rings, 
@@ -54,6 +55,25 @@ Mesh MeshGenerator::createSphere(float radius, uint32_t segments, uint32_t rings
     return Mesh(std::move(vertices), std::move(indices));
 }
 
+uint32_t MeshGenerator::lodSegments(uint32_t baseSegments, uint32_t level, uint32_t minimum) {
+    return std::max(baseSegments >> level, std::min(minimum, baseSegments));
+}
+
+std::vector<Mesh> MeshGenerator::createSphereLods(float radius, uint32_t segments, uint32_t rings,
+                                                  uint32_t levels, const glm::vec3& color) {
+    std::vector<Mesh> chain;
+    uint32_t previousSegments = 0;
+    for (uint32_t level = 0; level < levels; ++level) {
+        uint32_t levelSegments = lodSegments(segments, level, 8);
+        uint32_t levelRings = lodSegments(rings, level, 4);
+        if (levelSegments == previousSegments) break;   // Already at the floor
+
+        chain.push_back(createSphere(radius, levelSegments, levelRings, color));
+        previousSegments = levelSegments;
+    }
+    return chain;
+}
+
 Mesh MeshGenerator::createPlane(float width, float depth, 
                                  uint32_t subdivisionsX, uint32_t subdivisionsZ,
                                  const glm::vec3& color) {
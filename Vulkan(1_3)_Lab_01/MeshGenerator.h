@@ -2,6 +2,7 @@
 
 #include "Mesh.h"
 #include <glm/glm.hpp>
+#include <vector>
 
 /**
  * @brief Procedural mesh generation utility
@@ -15,7 +16,8 @@
  * Design Notes:
  * - Static utility class (stateless)
  * - All meshes have proper normals and UVs
- * - Configurable resolution for LOD support
+ * - Configurable resolution for LOD support (see createSphereLods,
+ *   Cactus::generateLocalMeshLods)
  */
 class MeshGenerator {
 public:
@@ -75,4 +77,19 @@ public:
      */
     static Mesh createCone(float baseRadius, float topRadius, float height, 
                            uint32_t segments, const glm::vec3& color = glm::vec3(1.0f));
+
+    /**
+     * @brief Segment count for an LOD level: base halved per level, never below minimum
+     */
+    static uint32_t lodSegments(uint32_t baseSegments, uint32_t level, uint32_t minimum);
+
+    /**
+     * @brief Generate a sphere LOD chain (level 0 = full resolution)
+     * @param levels Maximum number of levels; stops early once the
+     *        resolution cannot shrink any further
+     * 
+     * Used for: Globe
+     */
+    static std::vector<Mesh> createSphereLods(float radius, uint32_t segments, uint32_t rings,
+                                              uint32_t levels, const glm::vec3& color = glm::vec3(1.0f));
 };
\ No newline at end of file
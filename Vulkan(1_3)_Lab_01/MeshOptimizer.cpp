@@ -0,0 +1,293 @@
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+
+MeshOptimizer::Stats MeshOptimizer::optimize(Mesh& mesh, const Options& options) {
+    std::vector<Vertex> vertices = mesh.getVertices();
+    std::vector<uint32_t> indices = mesh.getIndices();
+
+    Stats stats;
+    stats.before = analyzeVertexCache(indices.data(), indices.size(), vertices.size());
+
+    optimizeVertexCache(indices.data(), indices.size(), vertices.size());
+    if (options.overdraw) {
+        // Never spend more than the cache pass gained
+        CacheStats ordered = analyzeVertexCache(indices.data(), indices.size(), vertices.size());
+        float threshold = options.overdrawThreshold;
+        if (ordered.acmr > 0.0f) threshold = std::min(threshold, std::max(1.0f, stats.before.acmr / ordered.acmr));
+        optimizeOverdraw(indices.data(), indices.size(), vertices.data(), vertices.size(), threshold);
+    }
+    optimizeVertexFetch(vertices, indices);
+
+    stats.after = analyzeVertexCache(indices.data(), indices.size(), vertices.size());
+    mesh.setVertices(std::move(vertices));
+    mesh.setIndices(std::move(indices));
+    return stats;
+}
+
+void MeshOptimizer::optimizeLods(std::vector<Mesh>& lods, const std::string& name, const Options& options) {
+    for (size_t level = 0; level < lods.size(); level++) {
+        if (lods[level].isEmpty()) continue;
+        Stats stats = optimize(lods[level], options);
+        std::cout << "Optimized " << name << " LOD " << level << std::fixed << std::setprecision(3)
+            << ": ACMR " << stats.before.acmr << " -> " << stats.after.acmr
+            << ", ATVR " << stats.before.atvr << " -> " << stats.after.atvr
+            << std::defaultfloat << std::endl;
+    }
+}
+
+void MeshOptimizer::optimizeVertexCache(uint32_t* indices, size_t indexCount, size_t vertexCount) {
+    const uint32_t triangleCount = static_cast<uint32_t>(indexCount / 3);
+    if (triangleCount == 0) return;
+
+    // Vertex -> triangle adjacency; each vertex's live triangles stay at
+    // the front of its range, so removal is a swap
+    std::vector<uint32_t> remaining(vertexCount, 0);
+    for (size_t i = 0; i < triangleCount * 3; i++) remaining[indices[i]]++;
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; v++) offsets[v + 1] = offsets[v] + remaining[v];
+    std::vector<uint32_t> adjacency(offsets[vertexCount]);
+    {
+        std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (uint32_t t = 0; t < triangleCount; t++) {
+            for (int c = 0; c < 3; c++) adjacency[cursor[indices[t * 3 + c]]++] = t;
+        }
+    }
+
+    std::vector<int32_t> cachePosition(vertexCount, -1);
+    std::vector<float> scores(vertexCount);
+    for (size_t v = 0; v < vertexCount; v++) scores[v] = vertexScore(-1, remaining[v]);
+
+    std::vector<float> triangleScores(triangleCount);
+    std::vector<bool> emitted(triangleCount, false);
+    uint32_t best = 0;
+    for (uint32_t t = 0; t < triangleCount; t++) {
+        const uint32_t* corners = indices + t * 3;
+        triangleScores[t] = scores[corners[0]] + scores[corners[1]] + scores[corners[2]];
+        if (triangleScores[t] > triangleScores[best]) best = t;
+    }
+
+    std::vector<uint32_t> output;
+    output.reserve(triangleCount * 3);
+    std::vector<uint32_t> cache;        // Most recent first
+    std::vector<uint32_t> nextCache;
+    cache.reserve(FORSYTH_CACHE_SIZE + 3);
+    nextCache.reserve(FORSYTH_CACHE_SIZE + 3);
+    uint32_t seedCursor = 0;
+
+    while (best != UINT32_MAX) {
+        const uint32_t corners[3] = { indices[best * 3], indices[best * 3 + 1], indices[best * 3 + 2] };
+        output.insert(output.end(), corners, corners + 3);
+        emitted[best] = true;
+
+        for (uint32_t v : corners) {
+            uint32_t* begin = &adjacency[offsets[v]];
+            uint32_t* end = begin + remaining[v];
+            uint32_t* found = std::find(begin, end, best);
+            if (found != end) {
+                std::swap(*found, *(end - 1));
+                remaining[v]--;
+            }
+        }
+
+        // The triangle's corners move to the front; entries past the
+        // cache size fall out
+        nextCache.assign(corners, corners + 3);
+        if (corners[0] == corners[1] || corners[1] == corners[2] || corners[0] == corners[2]) {
+            nextCache.erase(std::unique(nextCache.begin(), nextCache.end()), nextCache.end());
+        }
+        for (uint32_t v : cache) {
+            if (std::find(nextCache.begin(), nextCache.end(), v) == nextCache.end()) nextCache.push_back(v);
+        }
+        for (size_t i = FORSYTH_CACHE_SIZE; i < nextCache.size(); i++) cachePosition[nextCache[i]] = -1;
+        if (nextCache.size() > FORSYTH_CACHE_SIZE) nextCache.resize(FORSYTH_CACHE_SIZE);
+        for (size_t i = 0; i < nextCache.size(); i++) cachePosition[nextCache[i]] = static_cast<int32_t>(i);
+
+        // Rescore every vertex whose position or valence changed (old and
+        // new cache contents) and push the difference into its triangles
+        auto rescore = [&](uint32_t v) {
+            float score = vertexScore(cachePosition[v], remaining[v]);
+            float delta = score - scores[v];
+            if (delta == 0.0f) return;
+            scores[v] = score;
+            for (uint32_t a = offsets[v]; a < offsets[v] + remaining[v]; a++) triangleScores[adjacency[a]] += delta;
+        };
+        for (uint32_t v : cache) if (cachePosition[v] < 0) rescore(v);
+        for (uint32_t v : nextCache) rescore(v);
+        std::swap(cache, nextCache);
+
+        // Next: the best live triangle touching the cache
+        best = UINT32_MAX;
+        float bestScore = -1.0f;
+        for (uint32_t v : cache) {
+            for (uint32_t a = offsets[v]; a < offsets[v] + remaining[v]; a++) {
+                uint32_t t = adjacency[a];
+                if (triangleScores[t] > bestScore) {
+                    best = t;
+                    bestScore = triangleScores[t];
+                }
+            }
+        }
+        if (best == UINT32_MAX) {
+            // Cache holds nothing useful: continue with the next unused triangle
+            while (seedCursor < triangleCount && emitted[seedCursor]) seedCursor++;
+            if (seedCursor < triangleCount) best = seedCursor;
+        }
+    }
+
+    std::copy(output.begin(), output.end(), indices);
+}
+
+void MeshOptimizer::optimizeOverdraw(uint32_t* indices, size_t indexCount,
+                                     const Vertex* vertices, size_t vertexCount, float threshold) {
+    const uint32_t triangleCount = static_cast<uint32_t>(indexCount / 3);
+    if (triangleCount < 2) return;
+
+    const CacheStats original = analyzeVertexCache(indices, indexCount, vertexCount);
+
+    // Split into clusters that stay cheap on their own: each cluster is
+    // simulated from a cold cache (which is how it starts once moved) and
+    // ends as soon as its ACMR is within the threshold of the original
+    std::vector<uint32_t> clusterStarts = { 0 };
+    {
+        std::vector<uint32_t> stamps(vertexCount, 0);
+        uint32_t time = FIFO_CACHE_SIZE + 1;
+        uint32_t clusterMisses = 0;
+        const float targetAcmr = original.acmr * threshold;
+        for (uint32_t t = 0; t < triangleCount; t++) {
+            for (int c = 0; c < 3; c++) {
+                uint32_t v = indices[t * 3 + c];
+                if (time - stamps[v] > FIFO_CACHE_SIZE) {
+                    stamps[v] = time++;
+                    clusterMisses++;
+                }
+            }
+            uint32_t clusterTriangles = t + 1 - clusterStarts.back();
+            if (t + 1 < triangleCount && static_cast<float>(clusterMisses) <= targetAcmr * clusterTriangles) {
+                clusterStarts.push_back(t + 1);
+                clusterMisses = 0;
+                time += FIFO_CACHE_SIZE + 1;    // Flush: the next cluster starts cold
+            }
+        }
+    }
+    if (clusterStarts.size() < 2) return;
+
+    // Outward-facing clusters (relative to the mesh center) first: they
+    // are the likeliest to hide the rest of the mesh
+    glm::vec3 meshCenter(0.0f);
+    float meshArea = 0.0f;
+    const size_t clusterCount = clusterStarts.size();
+    std::vector<float> sortKeys(clusterCount);
+    std::vector<glm::vec3> clusterCenters(clusterCount, glm::vec3(0.0f));
+    std::vector<glm::vec3> clusterNormals(clusterCount, glm::vec3(0.0f));
+    for (size_t c = 0; c < clusterCount; c++) {
+        uint32_t end = c + 1 < clusterCount ? clusterStarts[c + 1] : triangleCount;
+        float area = 0.0f;
+        for (uint32_t t = clusterStarts[c]; t < end; t++) {
+            const glm::vec3& p0 = vertices[indices[t * 3]].position;
+            const glm::vec3& p1 = vertices[indices[t * 3 + 1]].position;
+            const glm::vec3& p2 = vertices[indices[t * 3 + 2]].position;
+            glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);   // Length = 2 * area
+            float weight = glm::length(normal);
+            clusterCenters[c] += (p0 + p1 + p2) * (weight / 3.0f);
+            clusterNormals[c] += normal;
+            area += weight;
+        }
+        meshCenter += clusterCenters[c];
+        meshArea += area;
+        clusterCenters[c] = area > 0.0f ? clusterCenters[c] / area : vertices[indices[clusterStarts[c] * 3]].position;
+    }
+    if (meshArea > 0.0f) meshCenter /= meshArea;
+    for (size_t c = 0; c < clusterCount; c++) {
+        float length = glm::length(clusterNormals[c]);
+        sortKeys[c] = length > 0.0f ? glm::dot(clusterCenters[c] - meshCenter, clusterNormals[c] / length) : 0.0f;
+    }
+
+    std::vector<uint32_t> order(clusterCount);
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return sortKeys[a] > sortKeys[b]; });
+
+    std::vector<uint32_t> reordered;
+    reordered.reserve(triangleCount * 3);
+    for (uint32_t c : order) {
+        uint32_t end = c + 1 < clusterCount ? clusterStarts[c + 1] : triangleCount;
+        reordered.insert(reordered.end(), indices + clusterStarts[c] * 3, indices + end * 3);
+    }
+
+    // Keep the new order only if the cache pays no more than the threshold for it
+    CacheStats result = analyzeVertexCache(reordered.data(), reordered.size(), vertexCount);
+    if (result.acmr <= original.acmr * threshold) {
+        std::copy(reordered.begin(), reordered.end(), indices);
+    }
+}
+
+size_t MeshOptimizer::optimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+    std::vector<uint32_t> remap(vertices.size(), UINT32_MAX);
+    std::vector<Vertex> reordered;
+    reordered.reserve(vertices.size());
+    for (uint32_t& index : indices) {
+        if (remap[index] == UINT32_MAX) {
+            remap[index] = static_cast<uint32_t>(reordered.size());
+            reordered.push_back(vertices[index]);
+        }
+        index = remap[index];
+    }
+    vertices = std::move(reordered);
+    return vertices.size();
+}
+
+MeshOptimizer::CacheStats MeshOptimizer::analyzeVertexCache(const uint32_t* indices, size_t indexCount,
+                                                            size_t vertexCount, uint32_t cacheSize) {
+    CacheStats stats;
+    if (indexCount < 3 || vertexCount == 0) return stats;
+
+    // FIFO: a vertex is cached while fewer than cacheSize misses happened since its own
+    std::vector<uint32_t> stamps(vertexCount, 0);
+    uint32_t time = cacheSize + 1;
+    uint32_t misses = 0;
+    for (size_t i = 0; i < indexCount; i++) {
+        uint32_t v = indices[i];
+        if (time - stamps[v] > cacheSize) {
+            stamps[v] = time++;
+            misses++;
+        }
+    }
+
+    std::vector<bool> used(vertexCount, false);
+    size_t usedCount = 0;
+    for (size_t i = 0; i < indexCount; i++) {
+        if (!used[indices[i]]) {
+            used[indices[i]] = true;
+            usedCount++;
+        }
+    }
+
+    stats.acmr = static_cast<float>(misses) / static_cast<float>(indexCount / 3);
+    stats.atvr = static_cast<float>(misses) / static_cast<float>(usedCount);
+    return stats;
+}
+
+// Private helper implementations
+
+float MeshOptimizer::vertexScore(int32_t cachePosition, uint32_t remainingTriangles) {
+    // Forsyth, "Linear-Speed Vertex Cache Optimisation"
+    if (remainingTriangles == 0) return -1.0f;     // Nothing left to draw with it
+
+    float score = 0.0f;
+    if (cachePosition >= 0) {
+        if (cachePosition < 3) {
+            score = 0.75f;     // Used by the last triangle: fixed so it isn't simply repeated
+        }
+        else {
+            float scale = 1.0f / static_cast<float>(FORSYTH_CACHE_SIZE - 3);
+            score = std::pow(1.0f - static_cast<float>(cachePosition - 3) * scale, 1.5f);
+        }
+    }
+
+    // Valence boost: finish off vertices with few triangles left
+    score += 2.0f / std::sqrt(static_cast<float>(remainingTriangles));
+    return score;
+}
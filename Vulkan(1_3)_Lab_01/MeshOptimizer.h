@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Mesh.h"
+#include "Vertex.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Reorders mesh data for the GPU's vertex cache and fetch
+ *
+ * Role: Optimization step between mesh generation/loading and the cache
+ * Responsibilities:
+ * - Reorder triangles for post-transform cache reuse (Forsyth)
+ * - Optionally reorder clusters of triangles to reduce overdraw
+ * - Renumber vertices in first-use order for fetch locality
+ * - Measure ACMR/ATVR before and after
+ *
+ * Design Notes:
+ * - Static utility class, like MeshletBuilder
+ * - Generated meshes are optimized before they are stored in MeshCache,
+ *   so the cost is paid once per asset, not once per launch
+ * - ACMR = transformed vertices per triangle (0.5 is the ideal for
+ *   regular grids, 3 is the worst), ATVR = transformed vertices per
+ *   vertex (1 is the ideal). Both come from a FIFO cache simulation,
+ *   which is closer to real hardware than the LRU model Forsyth scores
+ * - The overdraw pass cuts the cache-ordered list into clusters whose
+ *   cold-cache ACMR is within overdrawThreshold, then draws outward-facing
+ *   clusters first; the new order is dropped if the final ACMR exceeds
+ *   the threshold anyway
+ */
+class MeshOptimizer {
+public:
+    MeshOptimizer() = delete;  // Prevent instantiation
+
+    static constexpr uint32_t FORSYTH_CACHE_SIZE = 32;  // LRU model used for scoring
+    static constexpr uint32_t FIFO_CACHE_SIZE = 16;     // Model used for ACMR reporting
+
+    struct Options {
+        bool overdraw = true;
+        float overdrawThreshold = 1.05f;    // Allowed ACMR growth for better draw order
+    };
+
+    struct CacheStats {
+        float acmr = 0.0f;
+        float atvr = 0.0f;
+    };
+
+    struct Stats {
+        CacheStats before;
+        CacheStats after;
+    };
+
+    /**
+     * @brief Run all passes on a mesh (indices relative to its own vertices)
+     */
+    static Stats optimize(Mesh& mesh, const Options& options);
+    static Stats optimize(Mesh& mesh) { return optimize(mesh, Options()); }
+
+    /**
+     * @brief optimize() every level and print one ACMR line per level
+     */
+    static void optimizeLods(std::vector<Mesh>& lods, const std::string& name, const Options& options);
+    static void optimizeLods(std::vector<Mesh>& lods, const std::string& name) { optimizeLods(lods, name, Options()); }
+
+    static void optimizeVertexCache(uint32_t* indices, size_t indexCount, size_t vertexCount);
+
+    static void optimizeOverdraw(uint32_t* indices, size_t indexCount,
+                                 const Vertex* vertices, size_t vertexCount, float threshold);
+
+    /**
+     * @brief Renumber vertices in first-use order, dropping unused ones
+     * @return New vertex count
+     */
+    static size_t optimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+
+    static CacheStats analyzeVertexCache(const uint32_t* indices, size_t indexCount, size_t vertexCount,
+                                         uint32_t cacheSize = FIFO_CACHE_SIZE);
+
+private:
+    static float vertexScore(int32_t cachePosition, uint32_t remainingTriangles);
+};
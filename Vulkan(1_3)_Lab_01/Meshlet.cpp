@@ -0,0 +1,190 @@
+#include "Meshlet.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+MeshletMesh MeshletBuilder::build(const Vertex* vertices, size_t vertexCount,
+                                  const uint32_t* indices, size_t indexCount,
+                                  uint32_t maxVertices, uint32_t maxTriangles) {
+    MeshletMesh result;
+    maxVertices = std::min(maxVertices, 256u);      // Local indices are 8-bit
+    const uint32_t triangleCount = static_cast<uint32_t>(indexCount / 3);
+
+    // Face normals (for cone-friendly growth) and vertex -> triangle adjacency
+    std::vector<glm::vec3> faceNormals(triangleCount, glm::vec3(0.0f));
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+    for (uint32_t t = 0; t < triangleCount; t++) {
+        const uint32_t* corners = indices + t * 3;
+        if (corners[0] == corners[1] || corners[1] == corners[2] || corners[0] == corners[2]) {
+            emitted[t] = true;      // Degenerate: rasterizes nothing, drop it
+            continue;
+        }
+        glm::vec3 normal = glm::cross(vertices[corners[1]].position - vertices[corners[0]].position,
+                                      vertices[corners[2]].position - vertices[corners[0]].position);
+        float length = glm::length(normal);
+        faceNormals[t] = length > 0.0f ? normal / length : glm::vec3(0.0f);
+        for (int c = 0; c < 3; c++) adjacencyOffsets[corners[c] + 1]++;
+    }
+    for (size_t v = 0; v < vertexCount; v++) adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+    std::vector<uint32_t> adjacency(adjacencyOffsets[vertexCount]);
+    {
+        std::vector<uint32_t> cursor(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (uint32_t t = 0; t < triangleCount; t++) {
+            if (emitted[t]) continue;
+            for (int c = 0; c < 3; c++) adjacency[cursor[indices[t * 3 + c]]++] = t;
+        }
+    }
+
+    // Mesh vertex -> local index in the open meshlet (-1 = not in it)
+    std::vector<int32_t> localIndex(vertexCount, -1);
+    std::vector<uint32_t> candidates;   // Unemitted triangles touching the open meshlet
+    Meshlet current;
+    glm::vec3 currentAxis(0.0f);
+    uint32_t seedCursor = 0;
+
+    auto flush = [&]() {
+        if (current.triangleCount == 0) return;
+        computeBounds(current, result, vertices);
+        for (uint32_t v = 0; v < current.vertexCount; v++) {
+            localIndex[result.vertices[current.vertexOffset + v]] = -1;
+        }
+        result.meshlets.push_back(current);
+
+        current = Meshlet();
+        current.vertexOffset = static_cast<uint32_t>(result.vertices.size());
+        current.triangleOffset = static_cast<uint32_t>(result.triangles.size());
+        currentAxis = glm::vec3(0.0f);
+        candidates.clear();
+    };
+
+    auto newVertexCount = [&](uint32_t t) {
+        uint32_t count = 0;
+        for (int c = 0; c < 3; c++) {
+            if (localIndex[indices[t * 3 + c]] < 0) count++;
+        }
+        return count;
+    };
+
+    while (true) {
+        // Grow by adjacency: fewest new vertices first, then the face best
+        // aligned with the meshlet so far (keeps normal cones tight)
+        uint32_t best = UINT32_MAX;
+        uint32_t bestNew = 4;
+        float bestAlignment = -2.0f;
+        for (size_t i = 0; i < candidates.size();) {
+            uint32_t t = candidates[i];
+            if (emitted[t]) {
+                candidates[i] = candidates.back();
+                candidates.pop_back();
+                continue;
+            }
+            uint32_t added = newVertexCount(t);
+            float alignment = glm::dot(faceNormals[t], currentAxis);
+            if (added < bestNew || (added == bestNew && alignment > bestAlignment)) {
+                best = t;
+                bestNew = added;
+                bestAlignment = alignment;
+            }
+            i++;
+        }
+
+        if (best == UINT32_MAX) {
+            // Nothing adjacent left: start a new meshlet at the next unused triangle
+            flush();
+            while (seedCursor < triangleCount && emitted[seedCursor]) seedCursor++;
+            if (seedCursor == triangleCount) break;
+            best = seedCursor;
+            bestNew = newVertexCount(best);
+        }
+        else if (current.vertexCount + bestNew > maxVertices || current.triangleCount + 1 > maxTriangles) {
+            // Full: the triangle that did not fit seeds the next meshlet
+            flush();
+            bestNew = 3;
+        }
+
+        uint32_t packed = 0;
+        for (int c = 0; c < 3; c++) {
+            uint32_t corner = indices[best * 3 + c];
+            if (localIndex[corner] < 0) {
+                localIndex[corner] = static_cast<int32_t>(current.vertexCount++);
+                result.vertices.push_back(corner);
+                for (uint32_t a = adjacencyOffsets[corner]; a < adjacencyOffsets[corner + 1]; a++) {
+                    if (!emitted[adjacency[a]]) candidates.push_back(adjacency[a]);
+                }
+            }
+            packed |= static_cast<uint32_t>(localIndex[corner]) << (8 * c);
+        }
+        result.triangles.push_back(packed);
+        current.triangleCount++;
+        currentAxis += faceNormals[best];
+        emitted[best] = true;
+    }
+
+    return result;
+}
+
+MeshletMesh MeshletBuilder::build(const Mesh& mesh, uint32_t maxVertices, uint32_t maxTriangles) {
+    const auto& vertices = mesh.getVertices();
+    const auto& indices = mesh.getIndices();
+    return build(vertices.data(), vertices.size(), indices.data(), indices.size(), maxVertices, maxTriangles);
+}
+
+bool MeshletBuilder::isBackFacing(const Meshlet& meshlet, const glm::vec3& cameraPosition) {
+    glm::vec3 toCenter = meshlet.center - cameraPosition;
+    return glm::dot(toCenter, meshlet.coneAxis) >= meshlet.coneCutoff * glm::length(toCenter) + meshlet.radius;
+}
+
+// Private helper implementations
+
+void MeshletBuilder::computeBounds(Meshlet& meshlet, const MeshletMesh& result, const Vertex* vertices) {
+    // Sphere: box center, radius to the furthest vertex
+    glm::vec3 boundsMin(std::numeric_limits<float>::max());
+    glm::vec3 boundsMax(std::numeric_limits<float>::lowest());
+    for (uint32_t v = 0; v < meshlet.vertexCount; v++) {
+        const glm::vec3& position = vertices[result.vertices[meshlet.vertexOffset + v]].position;
+        boundsMin = glm::min(boundsMin, position);
+        boundsMax = glm::max(boundsMax, position);
+    }
+    meshlet.center = (boundsMin + boundsMax) * 0.5f;
+
+    float radiusSquared = 0.0f;
+    for (uint32_t v = 0; v < meshlet.vertexCount; v++) {
+        glm::vec3 offset = vertices[result.vertices[meshlet.vertexOffset + v]].position - meshlet.center;
+        radiusSquared = std::max(radiusSquared, glm::dot(offset, offset));
+    }
+    meshlet.radius = std::sqrt(radiusSquared);
+
+    // Cone: average face normal, half-angle from the least aligned face
+    std::vector<glm::vec3> normals;
+    normals.reserve(meshlet.triangleCount);
+    glm::vec3 axis(0.0f);
+    for (uint32_t t = 0; t < meshlet.triangleCount; t++) {
+        uint32_t packed = result.triangles[meshlet.triangleOffset + t];
+        const glm::vec3& p0 = vertices[result.vertices[meshlet.vertexOffset + (packed & 0xFF)]].position;
+        const glm::vec3& p1 = vertices[result.vertices[meshlet.vertexOffset + ((packed >> 8) & 0xFF)]].position;
+        const glm::vec3& p2 = vertices[result.vertices[meshlet.vertexOffset + ((packed >> 16) & 0xFF)]].position;
+
+        glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+        float length = glm::length(normal);
+        if (length <= 0.0f) continue;   // Zero-area: no orientation to cull by
+        normal /= length;
+        normals.push_back(normal);
+        axis += normal;
+    }
+
+    float axisLength = glm::length(axis);
+    if (normals.empty() || axisLength <= 0.0f) {
+        meshlet.coneCutoff = 1.0f;
+        return;
+    }
+    meshlet.coneAxis = axis / axisLength;
+
+    float minDot = 1.0f;
+    for (const glm::vec3& normal : normals) {
+        minDot = std::min(minDot, glm::dot(normal, meshlet.coneAxis));
+    }
+
+    // Cones close to a hemisphere (or wider) can't be culled from anywhere
+    meshlet.coneCutoff = (minDot <= 0.1f) ? 1.0f : std::sqrt(1.0f - minDot * minDot);
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Mesh.h"
+#include "Vertex.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief One cluster of a mesh: a small vertex list plus triangles indexing into it
+ */
+struct Meshlet {
+    uint32_t vertexOffset = 0;      // Into MeshletMesh::vertices
+    uint32_t vertexCount = 0;
+    uint32_t triangleOffset = 0;    // Into MeshletMesh::triangles
+    uint32_t triangleCount = 0;
+    glm::vec3 center{ 0.0f };       // Bounding sphere (mesh space)
+    float radius = 0.0f;
+    glm::vec3 coneAxis{ 0.0f, 0.0f, 1.0f };   // Normal cone (mesh space)
+    float coneCutoff = 1.0f;        // 1 = cone too wide, never back-face culled
+};
+
+/**
+ * @brief A mesh split into meshlets
+ */
+struct MeshletMesh {
+    std::vector<Meshlet> meshlets;
+    std::vector<uint32_t> vertices;     // Mesh vertex index per meshlet-local vertex
+    std::vector<uint32_t> triangles;    // Packed local indices: i0 | i1 << 8 | i2 << 16
+
+    size_t getTriangleCount() const { return triangles.size(); }
+};
+
+/**
+ * @brief Splits meshes into meshlets for cluster culling
+ *
+ * Role: Packing step between mesh generation/loading and upload
+ * Responsibilities:
+ * - Greedily grow meshlets across shared edges, up to maxVertices unique
+ *   vertices and maxTriangles triangles each
+ * - Compute each meshlet's bounding sphere and normal cone
+ *
+ * Design Notes:
+ * - Static utility class, like MeshGenerator
+ * - Defaults (64 / 124) match common mesh shader output limits and keep
+ *   local indices within 8 bits
+ * - The cone uses geometric (winding) normals, so it agrees with the
+ *   rasterizer's back-face test. A cluster is back-facing for a camera at
+ *   C when dot(center - C, axis) >= cutoff * |center - C| + radius
+ * - Growth prefers triangles adding the fewest new vertices, then the
+ *   one best aligned with the meshlet so far, which keeps cones tight;
+ *   index order only picks the seed of each new meshlet
+ */
+class MeshletBuilder {
+public:
+    MeshletBuilder() = delete;  // Prevent instantiation
+
+    static constexpr uint32_t DEFAULT_MAX_VERTICES = 64;
+    static constexpr uint32_t DEFAULT_MAX_TRIANGLES = 124;
+
+    /**
+     * @brief Build meshlets from raw arrays (indices are relative to vertices)
+     */
+    static MeshletMesh build(const Vertex* vertices, size_t vertexCount,
+                             const uint32_t* indices, size_t indexCount,
+                             uint32_t maxVertices = DEFAULT_MAX_VERTICES,
+                             uint32_t maxTriangles = DEFAULT_MAX_TRIANGLES);
+
+    static MeshletMesh build(const Mesh& mesh,
+                             uint32_t maxVertices = DEFAULT_MAX_VERTICES,
+                             uint32_t maxTriangles = DEFAULT_MAX_TRIANGLES);
+
+    /**
+     * @brief CPU version of the cluster back-face test the shaders run
+     */
+    static bool isBackFacing(const Meshlet& meshlet, const glm::vec3& cameraPosition);
+
+private:
+    static void computeBounds(Meshlet& meshlet, const MeshletMesh& result, const Vertex* vertices);
+};
@@ -1,112 +1,198 @@
 #include "OBJLoader.h"
+#include "JobSystem.h"
+#include "MappedFile.h"
+#include "MeshCache.h"
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstring>
 #include <fstream>
-#include <sstream>
 #include <iostream>
-#include <unordered_map>
 
-Mesh OBJLoader::load(const std::string& filepath) {
-    std::ifstream file(filepath);
-    if (!file.is_open()) {
-        std::cerr << "OBJLoader: Failed to open file: " << filepath << std::endl;
-        return Mesh();
+namespace {
+    // Chunks below this size cost more to schedule than to parse
+    constexpr size_t MIN_CHUNK_BYTES = 1 << 20;
+
+    // Vertices gathered per job once the chunks are merged
+    constexpr uint32_t VERTEX_JOB_SIZE = 1 << 16;
+
+    inline bool isSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
     }
 
-    std::vector<glm::vec3> positions;
-    std::vector<glm::vec3> normals;
-    std::vector<glm::vec2> texCoords;
-    std::vector<Vertex> vertices;
-    std::vector<uint32_t> indices;
-
-    // Map for vertex deduplication
-    std::unordered_map<Vertex, uint32_t> uniqueVertices;
-
-    std::string line;
-    while (std::getline(file, line)) {
-        line = trim(line);
-        
-        // Skip empty lines and comments
-        if (line.empty() || line[0] == '#') {
-            continue;
+    inline const char* skipSpaces(const char* cursor, const char* end) {
+        while (cursor < end && isSpace(*cursor)) ++cursor;
+        return cursor;
+    }
+
+    // Parse up to count floats; missing or malformed values stay 0
+    inline const char* parseFloats(const char* cursor, const char* end, float* values, int count) {
+        for (int i = 0; i < count; i++) {
+            cursor = skipSpaces(cursor, end);
+            if (cursor < end && *cursor == '+') ++cursor;   // from_chars rejects a leading '+'
+            auto [next, error] = std::from_chars(cursor, end, values[i]);
+            if (error != std::errc()) break;
+            cursor = next;
         }
+        return cursor;
+    }
 
-        std::istringstream iss(line);
-        std::string prefix;
-        iss >> prefix;
+    // splitmix64 finalizer: every input bit affects every output bit
+    inline uint64_t mix64(uint64_t h) {
+        h ^= h >> 30;
+        h *= 0xBF58476D1CE4E5B9ull;
+        h ^= h >> 27;
+        h *= 0x94D049BB133111EBull;
+        h ^= h >> 31;
+        return h;
+    }
 
-        if (prefix == "v") {
-            // Vertex position
-            glm::vec3 pos;
-            iss >> pos.x >> pos.y >> pos.z;
-            positions.push_back(pos);
-        }
-        else if (prefix == "vt") {
-            // Texture coordinate
-            glm::vec2 tex;
-            iss >> tex.x >> tex.y;
-            // Flip V coordinate for Vulkan (OBJ uses bottom-left origin)
-            tex.y = 1.0f - tex.y;
-            texCoords.push_back(tex);
-        }
-        else if (prefix == "vn") {
-            // Vertex normal
-            glm::vec3 norm;
-            iss >> norm.x >> norm.y >> norm.z;
-            normals.push_back(norm);
+    // Open-addressing set of (v, vt, vn) triples, sized for maxKeys up front
+    // so it never rehashes (load factor <= 2/3, usually far lower)
+    class KeyTable {
+    public:
+        KeyTable(size_t maxKeys, std::vector<glm::ivec3>& keys) : m_keys(keys) {
+            size_t capacity = 16;
+            while (capacity < maxKeys + maxKeys / 2) capacity <<= 1;
+            m_mask = capacity - 1;
+            m_slots.assign(capacity, EMPTY);
         }
-        else if (prefix == "f") {
-            // Face - can be triangle or polygon
-            std::vector<FaceVertex> faceVertices;
-            std::string token;
-            
-            while (iss >> token) {
-                faceVertices.push_back(parseFaceVertex(token));
-            }
 
-            // Triangulate polygon (fan triangulation)
-            for (size_t i = 1; i + 1 < faceVertices.size(); ++i) {
-                std::array<FaceVertex, 3> triangle = {
-                    faceVertices[0],
-                    faceVertices[i],
-                    faceVertices[i + 1]
-                };
-
-                for (const auto& fv : triangle) {
-                    Vertex vertex{};
-
-                    // Position (required)
-                    if (fv.positionIndex >= 0 && 
-                        fv.positionIndex < static_cast<int>(positions.size())) {
-                        vertex.position = positions[fv.positionIndex];
-                    }
-
-                    // Normal (optional)
-                    if (fv.normalIndex >= 0 && 
-                        fv.normalIndex < static_cast<int>(normals.size())) {
-                        vertex.normal = normals[fv.normalIndex];
-                    }
-
-                    // Texture coordinate (optional)
-                    if (fv.texCoordIndex >= 0 && 
-                        fv.texCoordIndex < static_cast<int>(texCoords.size())) {
-                        vertex.texCoord = texCoords[fv.texCoordIndex];
-                    }
-
-                    // Default color (white)
-                    vertex.color = glm::vec3(1.0f);
-
-                    // Deduplicate vertices
-                    if (uniqueVertices.count(vertex) == 0) {
-                        uniqueVertices[vertex] = static_cast<uint32_t>(vertices.size());
-                        vertices.push_back(vertex);
-                    }
-                    indices.push_back(uniqueVertices[vertex]);
+        // Index of key in the key list, appended if it is new
+        uint32_t insert(const glm::ivec3& key) {
+            uint64_t h = static_cast<uint32_t>(key.x) | (static_cast<uint64_t>(static_cast<uint32_t>(key.y)) << 32);
+            h = mix64(h ^ mix64(static_cast<uint32_t>(key.z)));
+
+            size_t slot = static_cast<size_t>(h) & m_mask;
+            while (true) {
+                uint32_t index = m_slots[slot];
+                if (index == EMPTY) {
+                    index = static_cast<uint32_t>(m_keys.size());
+                    m_slots[slot] = index;
+                    m_keys.push_back(key);
+                    return index;
                 }
+                if (m_keys[index] == key) return index;
+                slot = (slot + 1) & m_mask;
             }
         }
-        // Ignore: mtllib, usemtl, o, g, s (not needed for basic loading)
+
+    private:
+        static constexpr uint32_t EMPTY = UINT32_MAX;
+        std::vector<uint32_t> m_slots;      // Key index per slot
+        std::vector<glm::ivec3>& m_keys;
+        size_t m_mask = 0;
+    };
+}
+
+Mesh OBJLoader::load(const std::string& filepath, JobSystem* jobSystem) {
+    auto startTime = std::chrono::steady_clock::now();
+
+    MappedFile file;
+    if (!file.open(filepath)) {
+        std::cerr << "OBJLoader: Failed to open file: " << filepath << std::endl;
+        return Mesh();
+    }
+
+    // Split into line-aligned chunks: a few per thread for load balancing.
+    // One thread gets one chunk; splitting would only add the merge
+    uint32_t threadCount = jobSystem ? jobSystem->getWorkerCount() + 1 : 1;
+    size_t maxChunks = threadCount > 1 ? threadCount * 4 : 1;
+    size_t chunkCount = std::clamp<size_t>(file.size() / MIN_CHUNK_BYTES, 1, maxChunks);
+    std::vector<Chunk> chunks(chunkCount);
+    const char* fileEnd = file.data() + file.size();
+    const char* chunkBegin = file.data();
+    for (size_t i = 0; i < chunkCount; i++) {
+        const char* chunkEnd = (i + 1 == chunkCount) ? fileEnd : file.data() + file.size() / chunkCount * (i + 1);
+        chunkEnd = std::max(chunkEnd, chunkBegin);
+        if (chunkEnd < fileEnd) {
+            const char* newline = static_cast<const char*>(std::memchr(chunkEnd, '\n', fileEnd - chunkEnd));
+            chunkEnd = newline ? newline + 1 : fileEnd;
+        }
+        chunks[i].begin = chunkBegin;
+        chunks[i].end = chunkEnd;
+        chunkBegin = chunkEnd;
+    }
+
+    auto forEachChunk = [&](auto&& job) {
+        if (jobSystem && chunkCount > 1) {
+            JobSystem::Counter counter;
+            jobSystem->parallelFor(counter, static_cast<uint32_t>(chunkCount), 1,
+                [&](uint32_t begin, uint32_t end) {
+                    for (uint32_t i = begin; i < end; i++) job(i);
+                });
+            jobSystem->wait(counter);
+        }
+        else {
+            for (uint32_t i = 0; i < static_cast<uint32_t>(chunkCount); i++) job(i);
+        }
+    };
+
+    // Pass 1 (parallel): parse each chunk into its own arrays
+    forEachChunk([&](uint32_t i) { parseChunk(chunks[i]); });
+
+    // Stitch attribute arrays in file order; bases turn chunk-local
+    // (relative) indices into global ones
+    std::vector<glm::ivec3> bases(chunkCount);
+    glm::ivec3 totals(0);
+    for (size_t i = 0; i < chunkCount; i++) {
+        bases[i] = totals;
+        totals += glm::ivec3(static_cast<int32_t>(chunks[i].positions.size()),
+                             static_cast<int32_t>(chunks[i].texCoords.size()),
+                             static_cast<int32_t>(chunks[i].normals.size()));
+    }
+
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec2> texCoords;
+    std::vector<glm::vec3> normals;
+    positions.reserve(totals.x);
+    texCoords.reserve(totals.y);
+    normals.reserve(totals.z);
+    for (const Chunk& chunk : chunks) {
+        positions.insert(positions.end(), chunk.positions.begin(), chunk.positions.end());
+        texCoords.insert(texCoords.end(), chunk.texCoords.begin(), chunk.texCoords.end());
+        normals.insert(normals.end(), chunk.normals.begin(), chunk.normals.end());
+    }
+
+    // Pass 2 (parallel): resolve and bounds-check face indices
+    forEachChunk([&](uint32_t i) { resolveIndices(chunks[i], bases[i], totals); });
+
+    // Pass 3 (parallel): deduplicate corners within each chunk
+    forEachChunk([&](uint32_t i) { dedupChunk(chunks[i]); });
+
+    // Pass 4: merge the chunks' distinct triples into mesh vertices
+    std::vector<glm::ivec3> keys = mergeChunks(chunks);
+    std::vector<Vertex> vertices(keys.size());
+    uint32_t vertexCount = static_cast<uint32_t>(keys.size());
+    if (jobSystem && vertexCount > VERTEX_JOB_SIZE) {
+        JobSystem::Counter counter;
+        jobSystem->parallelFor(counter, vertexCount, VERTEX_JOB_SIZE, [&](uint32_t begin, uint32_t end) {
+            buildVertices(keys, begin, end, positions, texCoords, normals, vertices);
+        });
+        jobSystem->wait(counter);
+    }
+    else {
+        buildVertices(keys, 0, vertexCount, positions, texCoords, normals, vertices);
     }
 
-    file.close();
+    // Pass 5 (parallel): write each chunk's slice of the index buffer
+    size_t indexCount = 0;
+    for (Chunk& chunk : chunks) {
+        chunk.firstIndex = indexCount;
+        indexCount += chunk.localIndices.size();
+    }
+    std::vector<uint32_t> indices(indexCount);
+    forEachChunk([&](uint32_t i) {
+        const Chunk& chunk = chunks[i];
+        uint32_t* out = indices.data() + chunk.firstIndex;
+        if (chunk.remap.empty()) {
+            std::copy(chunk.localIndices.begin(), chunk.localIndices.end(), out);
+        }
+        else {
+            for (uint32_t local : chunk.localIndices) *out++ = chunk.remap[local];
+        }
+    });
 
     Mesh mesh(std::move(vertices), std::move(indices));
 
@@ -116,52 +202,195 @@ Mesh OBJLoader::load(const std::string& filepath) {
         mesh.recalculateNormals();
     }
 
+    if (!s_logLoads.load(std::memory_order_relaxed)) return mesh;
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
     std::cout << "OBJLoader: Loaded " << filepath 
               << " (" << mesh.getVertexCount() << " vertices, "
-              << mesh.getIndexCount() / 3 << " triangles)" << std::endl;
+              << mesh.getIndexCount() / 3 << " triangles, "
+              << seconds * 1000.0 << " ms, "
+              << (seconds > 0.0 ? file.size() / (1024.0 * 1024.0) / seconds : 0.0) << " MB/s, "
+              << chunkCount << " chunks)" << std::endl;
 
     return mesh;
 }
 
+Mesh OBJLoader::loadCached(const std::string& filepath, MeshCache& cache, JobSystem* jobSystem) {
+    uint64_t key = MeshCache::keyForFile(filepath);
+    if (key == 0) {
+        return load(filepath, jobSystem);   // Missing file: load() reports it
+    }
+
+    std::vector<Mesh> lods = cache.getOrCreateLods(key, [&]() {
+        Mesh mesh = load(filepath, jobSystem);
+        if (mesh.isEmpty()) return std::vector<Mesh>();
+        std::vector<Mesh> lods{ std::move(mesh) };
+        MeshOptimizer::optimizeLods(lods, filepath);
+        return lods;
+    });
+    return lods.empty() ? Mesh() : std::move(lods.front());
+}
+
 bool OBJLoader::fileExists(const std::string& filepath) {
     std::ifstream file(filepath);
     return file.good();
 }
 
-OBJLoader::FaceVertex OBJLoader::parseFaceVertex(const std::string& token) {
-    FaceVertex fv;
-    std::vector<std::string> parts = split(token, '/');
+// Private helper implementations
+
+void OBJLoader::parseChunk(Chunk& chunk) {
+    std::vector<FaceVertex> face;   // Corners of the current polygon
+    const char* cursor = chunk.begin;
+    const char* end = chunk.end;
+
+    while (cursor < end) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(cursor, '\n', end - cursor));
+        if (!lineEnd) lineEnd = end;
+        cursor = skipSpaces(cursor, lineEnd);
+
+        // Comments, empty lines and mtllib/usemtl/o/g/s fall through
+        if (lineEnd - cursor >= 2 && cursor[0] == 'v') {
+            if (isSpace(cursor[1])) {
+                // Vertex position
+                glm::vec3 pos(0.0f);
+                parseFloats(cursor + 2, lineEnd, &pos.x, 3);
+                chunk.positions.push_back(pos);
+            }
+            else if (lineEnd - cursor >= 3 && cursor[1] == 't' && isSpace(cursor[2])) {
+                // Texture coordinate
+                glm::vec2 tex(0.0f);
+                parseFloats(cursor + 3, lineEnd, &tex.x, 2);
+                // Flip V coordinate for Vulkan (OBJ uses bottom-left origin)
+                tex.y = 1.0f - tex.y;
+                chunk.texCoords.push_back(tex);
+            }
+            else if (lineEnd - cursor >= 3 && cursor[1] == 'n' && isSpace(cursor[2])) {
+                // Vertex normal
+                glm::vec3 norm(0.0f);
+                parseFloats(cursor + 3, lineEnd, &norm.x, 3);
+                chunk.normals.push_back(norm);
+            }
+        }
+        else if (lineEnd - cursor >= 2 && cursor[0] == 'f' && isSpace(cursor[1])) {
+            // Face - can be triangle or polygon
+            face.clear();
+            const char* token = cursor + 2;
+            while (true) {
+                token = skipSpaces(token, lineEnd);
+                if (token >= lineEnd || *token == '#') break;
+                FaceVertex fv;
+                const char* next = parseFaceVertex(token, lineEnd, chunk, fv);
+                if (next == token) break;
+                face.push_back(fv);
+                token = next;
+            }
+
+            // Triangulate polygon (fan triangulation)
+            for (size_t i = 1; i + 1 < face.size(); ++i) {
+                chunk.corners.push_back(face[0]);
+                chunk.corners.push_back(face[i]);
+                chunk.corners.push_back(face[i + 1]);
+            }
+        }
+
+        cursor = (lineEnd < end) ? lineEnd + 1 : end;
+    }
+}
+
+const char* OBJLoader::parseFaceVertex(const char* cursor, const char* end, const Chunk& chunk, FaceVertex& fv) {
+    // OBJ is 1-indexed; negative indices count back from the latest element
+    auto parseIndex = [&](const char* p, int32_t& index, uint32_t relativeBit, size_t count) {
+        int32_t value = 0;
+        auto [next, error] = std::from_chars(p, end, value);
+        if (error != std::errc()) return p;
+        if (value > 0) {
+            index = value - 1;
+        }
+        else if (value < 0) {
+            index = static_cast<int32_t>(count) + value;
+            fv.relativeMask |= relativeBit;
+        }
+        return next;
+    };
 
     // Format: v, v/vt, v/vt/vn, v//vn
-    if (!parts.empty() && !parts[0].empty()) {
-        fv.positionIndex = std::stoi(parts[0]) - 1;  // OBJ is 1-indexed
+    const char* p = parseIndex(cursor, fv.positionIndex, 1, chunk.positions.size());
+    if (p == cursor) return cursor;     // Not a face vertex
+    if (p < end && *p == '/') {
+        ++p;
+        if (p < end && *p != '/') {
+            p = parseIndex(p, fv.texCoordIndex, 2, chunk.texCoords.size());
+        }
+        if (p < end && *p == '/') {
+            p = parseIndex(p + 1, fv.normalIndex, 4, chunk.normals.size());
+        }
     }
-    if (parts.size() > 1 && !parts[1].empty()) {
-        fv.texCoordIndex = std::stoi(parts[1]) - 1;
+
+    // Skip whatever is left of a malformed token
+    while (p < end && !isSpace(*p)) ++p;
+    return p;
+}
+
+void OBJLoader::resolveIndices(Chunk& chunk, const glm::ivec3& base, const glm::ivec3& totals) {
+    auto resolve = [](int32_t& index, bool relative, int32_t offset, int32_t total) {
+        if (index == NO_INDEX) return;
+        if (relative) index += offset;
+        if (index < 0 || index >= total) index = NO_INDEX;   // Out of range: attribute left at default
+    };
+
+    for (FaceVertex& fv : chunk.corners) {
+        resolve(fv.positionIndex, (fv.relativeMask & 1) != 0, base.x, totals.x);
+        resolve(fv.texCoordIndex, (fv.relativeMask & 2) != 0, base.y, totals.y);
+        resolve(fv.normalIndex, (fv.relativeMask & 4) != 0, base.z, totals.z);
+        fv.relativeMask = 0;
     }
-    if (parts.size() > 2 && !parts[2].empty()) {
-        fv.normalIndex = std::stoi(parts[2]) - 1;
+}
+
+void OBJLoader::dedupChunk(Chunk& chunk) {
+    chunk.localIndices.resize(chunk.corners.size());
+    KeyTable table(chunk.corners.size(), chunk.uniqueKeys);
+    for (size_t i = 0; i < chunk.corners.size(); i++) {
+        const FaceVertex& fv = chunk.corners[i];
+        chunk.localIndices[i] = table.insert(glm::ivec3(fv.positionIndex, fv.texCoordIndex, fv.normalIndex));
     }
 
-    return fv;
+    // Corners are fully described by localIndices from here on
+    std::vector<FaceVertex>().swap(chunk.corners);
 }
 
-std::vector<std::string> OBJLoader::split(const std::string& str, char delimiter) {
-    std::vector<std::string> tokens;
-    std::string token;
-    std::istringstream tokenStream(str);
-    while (std::getline(tokenStream, token, delimiter)) {
-        tokens.push_back(token);
+std::vector<glm::ivec3> OBJLoader::mergeChunks(std::vector<Chunk>& chunks) {
+    if (chunks.size() == 1) {
+        return std::move(chunks.front().uniqueKeys);    // Already global, remap stays identity
     }
-    return tokens;
+
+    // Triples shared between chunks (along chunk borders, or re-used
+    // attribute sets) collapse here; chunk order keeps first occurrences first
+    size_t keyCount = 0;
+    for (const Chunk& chunk : chunks) keyCount += chunk.uniqueKeys.size();
+    std::vector<glm::ivec3> keys;
+    keys.reserve(keyCount);
+    KeyTable table(keyCount, keys);
+    for (Chunk& chunk : chunks) {
+        chunk.remap.resize(chunk.uniqueKeys.size());
+        for (size_t i = 0; i < chunk.uniqueKeys.size(); i++) {
+            chunk.remap[i] = table.insert(chunk.uniqueKeys[i]);
+        }
+        std::vector<glm::ivec3>().swap(chunk.uniqueKeys);
+    }
+    return keys;
 }
 
-std::string OBJLoader::trim(const std::string& str) {
-    const char* whitespace = " \t\r\n";
-    size_t start = str.find_first_not_of(whitespace);
-    if (start == std::string::npos) {
-        return "";
+void OBJLoader::buildVertices(const std::vector<glm::ivec3>& keys, uint32_t begin, uint32_t end,
+                              const std::vector<glm::vec3>& positions,
+                              const std::vector<glm::vec2>& texCoords,
+                              const std::vector<glm::vec3>& normals,
+                              std::vector<Vertex>& vertices) {
+    for (uint32_t i = begin; i < end; i++) {
+        const glm::ivec3& key = keys[i];
+        Vertex& vertex = vertices[i];
+        if (key.x != NO_INDEX) vertex.position = positions[key.x];
+        if (key.z != NO_INDEX) vertex.normal = normals[key.z];
+        if (key.y != NO_INDEX) vertex.texCoord = texCoords[key.y];
+        vertex.color = glm::vec3(1.0f);     // Default color (white)
     }
-    size_t end = str.find_last_not_of(whitespace);
-    return str.substr(start, end - start + 1);
-}
\ No newline at end of file
+}
@@ -1,8 +1,16 @@
 #pragma once
 
 #include "Mesh.h"
+#include <glm/glm.hpp>
+#include <atomic>
+#include <cstdint>
+#include <limits>
 #include <string>
 #include <memory>
+#include <vector>
+
+class JobSystem;
+class MeshCache;
 
 /**
  * @brief Wavefront OBJ file loader
@@ -17,9 +25,18 @@
  * - Static utility class (no state needed)
  * - Returns Mesh by value for simplicity
  * - Handles missing normals by calculating them
+ * - The file is memory-mapped and split into line-aligned chunks that
+ *   are parsed in parallel (std::from_chars, no streams or per-line
+ *   strings); chunks are stitched in file order, so the result does not
+ *   depend on the thread count
+ * - Corners are deduplicated on their (v, vt, vn) index triple through
+ *   open-addressing tables sized up front (no rehashing, no per-vertex
+ *   allocation): each chunk in parallel first, then a serial merge over
+ *   the chunks' distinct triples only. Merging in file order keeps the
+ *   first-occurrence vertex order of a single-threaded load
  * 
  * OBJ Format Reference: http://www.fileformat.info/format/wavefrontobj/
- * Supported elements: v, vt, vn, f
+ * Supported elements: v, vt, vn, f (including negative/relative indices)
  */
 class OBJLoader {
 public:
@@ -29,9 +46,18 @@ public:
     /**
      * @brief Load a mesh from an OBJ file
      * @param filepath Path to the OBJ file
+     * @param jobSystem Parses chunks on its workers; nullptr = calling thread only
      * @return Loaded mesh, empty mesh if loading fails
      */
-    static Mesh load(const std::string& filepath);
+    static Mesh load(const std::string& filepath, JobSystem* jobSystem = nullptr);
+
+    /**
+     * @brief load() through the mesh cache, keyed by path, size and modification time
+     * 
+     * Editing the OBJ changes its key, so the stale entry is simply never read again.
+     * Cached meshes are run through MeshOptimizer first; load() keeps file order.
+     */
+    static Mesh loadCached(const std::string& filepath, MeshCache& cache, JobSystem* jobSystem = nullptr);
 
     /**
      * @brief Check if a file exists and is readable
@@ -40,14 +66,48 @@ public:
      */
     static bool fileExists(const std::string& filepath);
 
+    /**
+     * @brief Print a summary line (size, time, MB/s) for every successful load
+     * On by default; tools that load the same file repeatedly turn it off.
+     * Failures are always reported.
+     */
+    static void setLogLoads(bool enabled) { s_logLoads.store(enabled, std::memory_order_relaxed); }
+
 private:
+    static inline std::atomic<bool> s_logLoads{ true };
+
+    static constexpr int32_t NO_INDEX = std::numeric_limits<int32_t>::min();
+
+    // One triangle corner, 0-based indices
     struct FaceVertex {
-        int positionIndex = -1;
-        int texCoordIndex = -1;
-        int normalIndex = -1;
+        int32_t positionIndex = NO_INDEX;
+        int32_t texCoordIndex = NO_INDEX;
+        int32_t normalIndex = NO_INDEX;
+        uint32_t relativeMask = 0;      // Bit per index: negative in the file, chunk-local until resolved
+    };
+
+    // Everything parsed from one line-aligned slice of the file
+    struct Chunk {
+        const char* begin = nullptr;
+        const char* end = nullptr;
+        std::vector<glm::vec3> positions;
+        std::vector<glm::vec2> texCoords;
+        std::vector<glm::vec3> normals;
+        std::vector<FaceVertex> corners;    // 3 per triangle (polygons are fan-triangulated)
+        std::vector<glm::ivec3> uniqueKeys; // Distinct (v, vt, vn) triples, first occurrence first
+        std::vector<uint32_t> localIndices; // Per corner, into uniqueKeys
+        std::vector<uint32_t> remap;        // uniqueKeys -> mesh vertex (empty = identity)
+        size_t firstIndex = 0;              // Offset of this chunk's corners in the index buffer
     };
 
-    static FaceVertex parseFaceVertex(const std::string& token);
-    static std::vector<std::string> split(const std::string& str, char delimiter);
-    static std::string trim(const std::string& str);
-};
\ No newline at end of file
+    static void parseChunk(Chunk& chunk);
+    static const char* parseFaceVertex(const char* cursor, const char* end, const Chunk& chunk, FaceVertex& fv);
+    static void resolveIndices(Chunk& chunk, const glm::ivec3& base, const glm::ivec3& totals);
+    static void dedupChunk(Chunk& chunk);
+    static std::vector<glm::ivec3> mergeChunks(std::vector<Chunk>& chunks);
+    static void buildVertices(const std::vector<glm::ivec3>& keys, uint32_t begin, uint32_t end,
+                              const std::vector<glm::vec3>& positions,
+                              const std::vector<glm::vec2>& texCoords,
+                              const std::vector<glm::vec3>& normals,
+                              std::vector<Vertex>& vertices);
+};
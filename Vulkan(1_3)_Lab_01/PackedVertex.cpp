@@ -0,0 +1,178 @@
+#include "PackedVertex.h"
+#include "Particle.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace {
+    int16_t toSnorm16(float value) {
+        return static_cast<int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+    }
+
+    float fromSnorm16(int16_t value) {
+        return std::max(static_cast<float>(value) / 32767.0f, -1.0f);
+    }
+
+    // Unit sphere -> [-1,1]^2: project onto the octahedron |x|+|y|+|z| = 1,
+    // then fold the lower half over the diagonals
+    glm::vec2 octEncode(const glm::vec3& normal) {
+        float sum = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+        if (sum <= 0.0f) return glm::vec2(0.0f);    // Degenerate normal: decodes to +Z
+        glm::vec2 p = glm::vec2(normal.x, normal.y) / sum;
+        if (normal.z < 0.0f) {
+            glm::vec2 folded(1.0f - std::abs(p.y), 1.0f - std::abs(p.x));
+            p.x = p.x >= 0.0f ? folded.x : -folded.x;
+            p.y = p.y >= 0.0f ? folded.y : -folded.y;
+        }
+        return p;
+    }
+
+    // Inverse of octEncode; SHADERS/packed_vertex.glsl runs the same code
+    glm::vec3 octDecode(const glm::vec2& encoded) {
+        glm::vec3 n(encoded.x, encoded.y, 1.0f - std::abs(encoded.x) - std::abs(encoded.y));
+        float t = std::max(-n.z, 0.0f);
+        n.x += n.x >= 0.0f ? -t : t;
+        n.y += n.y >= 0.0f ? -t : t;
+        return glm::normalize(n);
+    }
+}
+
+PositionDecode PackedVertex::makeDecode(PositionEncoding encoding, const glm::vec3& minBounds, const glm::vec3& maxBounds) {
+    PositionDecode decode;
+    if (encoding == PositionEncoding::Half) {
+        // Centering keeps the values small, where half floats are most precise
+        decode.scale = glm::vec3(1.0f);
+        decode.bias = (minBounds + maxBounds) * 0.5f;
+    }
+    else {
+        decode.scale = glm::max(maxBounds - minBounds, glm::vec3(0.0f));
+        decode.bias = minBounds;
+    }
+    return decode;
+}
+
+PackedVertex PackedVertex::pack(const Vertex& vertex, PositionEncoding encoding, const PositionDecode& decode) {
+    PackedVertex packed{};
+
+    glm::vec3 position = vertex.position - decode.bias;
+    for (int axis = 0; axis < 3; axis++) {
+        if (encoding == PositionEncoding::Half) {
+            packed.position[axis] = floatToHalf(position[axis] / decode.scale[axis]);
+        }
+        else {
+            float normalized = decode.scale[axis] > 0.0f ? position[axis] / decode.scale[axis] : 0.0f;
+            packed.position[axis] = static_cast<uint16_t>(std::lround(std::clamp(normalized, 0.0f, 1.0f) * 65535.0f));
+        }
+    }
+    packed.position[3] = encoding == PositionEncoding::Half ? floatToHalf(1.0f) : 65535;
+
+    glm::vec2 octahedral = octEncode(vertex.normal);
+    packed.normal[0] = toSnorm16(octahedral.x);
+    packed.normal[1] = toSnorm16(octahedral.y);
+
+    packed.texCoord[0] = floatToHalf(vertex.texCoord.x);
+    packed.texCoord[1] = floatToHalf(vertex.texCoord.y);
+
+    packed.color = packColorRGBA8(glm::vec4(vertex.color, 1.0f));
+    return packed;
+}
+
+Vertex PackedVertex::unpack(const PackedVertex& vertex, PositionEncoding encoding, const PositionDecode& decode) {
+    Vertex unpacked{};
+    for (int axis = 0; axis < 3; axis++) {
+        float stored = encoding == PositionEncoding::Half
+            ? halfToFloat(vertex.position[axis])
+            : static_cast<float>(vertex.position[axis]) / 65535.0f;
+        unpacked.position[axis] = stored * decode.scale[axis] + decode.bias[axis];
+    }
+    unpacked.normal = octDecode(glm::vec2(fromSnorm16(vertex.normal[0]), fromSnorm16(vertex.normal[1])));
+    unpacked.texCoord = glm::vec2(halfToFloat(vertex.texCoord[0]), halfToFloat(vertex.texCoord[1]));
+    for (int channel = 0; channel < 3; channel++) {
+        unpacked.color[channel] = static_cast<float>((vertex.color >> (8 * channel)) & 0xFF) / 255.0f;
+    }
+    return unpacked;
+}
+
+std::vector<PackedVertex> PackedVertex::packAll(const std::vector<Vertex>& vertices, PositionEncoding encoding,
+                                                PositionDecode& decode) {
+    glm::vec3 minBounds(std::numeric_limits<float>::max());
+    glm::vec3 maxBounds(std::numeric_limits<float>::lowest());
+    for (const Vertex& vertex : vertices) {
+        minBounds = glm::min(minBounds, vertex.position);
+        maxBounds = glm::max(maxBounds, vertex.position);
+    }
+    if (vertices.empty()) {
+        minBounds = maxBounds = glm::vec3(0.0f);
+    }
+    decode = makeDecode(encoding, minBounds, maxBounds);
+
+    std::vector<PackedVertex> packed(vertices.size());
+    for (size_t i = 0; i < vertices.size(); i++) {
+        packed[i] = pack(vertices[i], encoding, decode);
+    }
+    return packed;
+}
+
+uint16_t PackedVertex::floatToHalf(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    uint32_t sign = (bits >> 16) & 0x8000;
+    uint32_t magnitude = bits & 0x7FFFFFFF;
+
+    if (magnitude >= 0x7F800000) {
+        // Inf stays inf, NaN stays a (quiet) NaN
+        return static_cast<uint16_t>(sign | 0x7C00 | (magnitude > 0x7F800000 ? 0x200 : 0));
+    }
+    if (magnitude >= 0x477FF000) {
+        return static_cast<uint16_t>(sign | 0x7BFF);    // Would round past 65504: clamp instead of inf
+    }
+    if (magnitude < 0x38800000) {
+        // Subnormal half (or zero): shift the mantissa, with its implicit bit, into place
+        if (magnitude < 0x33000000) return static_cast<uint16_t>(sign);
+        uint32_t exponent = magnitude >> 23;
+        uint32_t mantissa = (magnitude & 0x7FFFFF) | 0x800000;
+        uint32_t shift = 126 - exponent;    // Half subnormals count in units of 2^-24
+        uint32_t half = mantissa >> shift;
+        uint32_t remainder = mantissa & ((1u << shift) - 1);
+        uint32_t halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (half & 1))) half++;
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    // Normal: rebias the exponent, round the mantissa to nearest even
+    uint32_t half = (magnitude - 0x38000000) >> 13;
+    uint32_t remainder = magnitude & 0x1FFF;
+    if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1))) half++;
+    return static_cast<uint16_t>(sign | half);
+}
+
+float PackedVertex::halfToFloat(uint16_t half) {
+    uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+    uint32_t exponent = (half >> 10) & 0x1F;
+    uint32_t mantissa = half & 0x3FF;
+
+    uint32_t bits;
+    if (exponent == 0x1F) {
+        bits = sign | 0x7F800000 | (mantissa << 13);
+    }
+    else if (exponent != 0) {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    }
+    else if (mantissa == 0) {
+        bits = sign;
+    }
+    else {
+        // Subnormal: normalize into a float exponent
+        exponent = 113;
+        while ((mantissa & 0x400) == 0) {
+            mantissa <<= 1;
+            exponent--;
+        }
+        bits = sign | (exponent << 23) | ((mantissa & 0x3FF) << 13);
+    }
+
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
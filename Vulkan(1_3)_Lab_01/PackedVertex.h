@@ -0,0 +1,113 @@
+#pragma once
+
+#include "Vertex.h"
+#include <glm/glm.hpp>
+#include <vulkan/vulkan.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Which vertex layout a pipeline (and the vertex buffer it reads) uses
+enum class VertexFormat {
+    Full,       // Vertex: 32-bit floats, 44 bytes
+    Packed      // PackedVertex: quantized, 20 bytes
+};
+
+// How PackedVertex stores positions
+enum class PositionEncoding {
+    Half,       // Half floats, relative to the bounds center
+    Unorm16     // 16-bit normalized across the bounds (uniform precision)
+};
+
+// Reconstructs positions: position = stored * scale + bias.
+// Shaders get it through the UBO (positionScale / positionBias).
+struct PositionDecode {
+    glm::vec3 scale{ 1.0f };
+    glm::vec3 bias{ 0.0f };
+};
+
+/**
+ * @brief Quantized vertex layout (20 bytes instead of 44)
+ * 
+ * Layout (all decoded by the input assembler except the normal):
+ * - position: 4x16 bits, half or unorm16 (w unused), then * scale + bias
+ * - normal:   octahedral encoding in 2x snorm16, unfolded in the shader
+ * - texCoord: 2x half float
+ * - color:    RGBA8 unorm
+ * 
+ * Design Notes:
+ * - Lossy: about 1/65535 of the bounds extent for unorm16 positions,
+ *   11 significant bits for half, under 0.05 degrees for normals and
+ *   1/255 for color, which the lit sand and vertex colors never show
+ * - The CPU side (Scene, MeshCache, loaders, meshlet building) keeps
+ *   full Vertex data; packing happens once when the buffer is uploaded
+ * - meshlet.mesh pulls the same 5 words from a storage buffer and
+ *   decodes them with the GLSL unpack* built-ins
+ */
+struct PackedVertex {
+    uint16_t position[4];
+    int16_t normal[2];
+    uint16_t texCoord[2];
+    uint32_t color;
+
+    static VkVertexInputBindingDescription getBindingDescription() {
+        VkVertexInputBindingDescription bindingDescription{};
+        bindingDescription.binding = 0;
+        bindingDescription.stride = sizeof(PackedVertex);
+        bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+        return bindingDescription;
+    }
+
+    // Same locations as Vertex, so shaders only differ in how they decode
+    static std::array<VkVertexInputAttributeDescription, 4> getAttributeDescriptions(PositionEncoding encoding) {
+        std::array<VkVertexInputAttributeDescription, 4> attributeDescriptions{};
+
+        // Position at location 0
+        attributeDescriptions[0].binding = 0;
+        attributeDescriptions[0].location = 0;
+        attributeDescriptions[0].format = encoding == PositionEncoding::Half
+            ? VK_FORMAT_R16G16B16A16_SFLOAT : VK_FORMAT_R16G16B16A16_UNORM;
+        attributeDescriptions[0].offset = offsetof(PackedVertex, position);
+
+        // Octahedral normal at location 1
+        attributeDescriptions[1].binding = 0;
+        attributeDescriptions[1].location = 1;
+        attributeDescriptions[1].format = VK_FORMAT_R16G16_SNORM;
+        attributeDescriptions[1].offset = offsetof(PackedVertex, normal);
+
+        // Texture coordinate at location 2
+        attributeDescriptions[2].binding = 0;
+        attributeDescriptions[2].location = 2;
+        attributeDescriptions[2].format = VK_FORMAT_R16G16_SFLOAT;
+        attributeDescriptions[2].offset = offsetof(PackedVertex, texCoord);
+
+        // Color at location 3
+        attributeDescriptions[3].binding = 0;
+        attributeDescriptions[3].location = 3;
+        attributeDescriptions[3].format = VK_FORMAT_R8G8B8A8_UNORM;
+        attributeDescriptions[3].offset = offsetof(PackedVertex, color);
+
+        return attributeDescriptions;
+    }
+
+    /**
+     * @brief Decode parameters for positions inside [minBounds, maxBounds]
+     */
+    static PositionDecode makeDecode(PositionEncoding encoding, const glm::vec3& minBounds, const glm::vec3& maxBounds);
+
+    static PackedVertex pack(const Vertex& vertex, PositionEncoding encoding, const PositionDecode& decode);
+    static Vertex unpack(const PackedVertex& vertex, PositionEncoding encoding, const PositionDecode& decode);
+
+    /**
+     * @brief Pack a whole vertex array against its own bounds
+     * @param decode Receives the parameters the shaders need
+     */
+    static std::vector<PackedVertex> packAll(const std::vector<Vertex>& vertices, PositionEncoding encoding,
+                                             PositionDecode& decode);
+
+    // Scalar conversions (also used by tests and tools)
+    static uint16_t floatToHalf(float value);
+    static float halfToFloat(uint16_t half);
+};
+static_assert(sizeof(PackedVertex) == 20, "PackedVertex must stay tightly packed (meshlet.mesh reads 5 words)");
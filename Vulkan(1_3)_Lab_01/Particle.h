@@ -1,73 +1,269 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <vulkan/vulkan.h>
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// SIMD backend for the integrate kernel (scalar fallback otherwise)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PARTICLE_SIMD_SSE 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define PARTICLE_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
 
 // ============================================================
 // PARTICLE DATA STRUCTURE
 // ============================================================
-// Lightweight structure for individual particle state.
-// Designed for cache-friendly iteration in particle systems.
+// Structure-of-arrays particle pool. Each attribute is its own
+// contiguous float stream so the update kernel can process 4
+// particles per instruction (SSE / NEON) with no gather.
+//
+// Key concepts for defense:
+// - SoA layout: px/py/pz, vx/vy/vz, life, invMaxLife streams
+// - Compacted live range: live particles are always [0, size()),
+//   dead ones are removed by swap-with-last, so the kernel never
+//   touches dead slots and never branches per particle
+// - Color and size are not stored: they are derived from age
+//   when instances are generated
 // ============================================================
 
-struct Particle {
-    glm::vec3 position;     // World position
-    glm::vec3 velocity;     // Movement per second
-    glm::vec4 color;        // RGBA with alpha for fade
-    float life;             // Remaining life (seconds)
-    float maxLife;          // Initial life for interpolation
-    float size;             // Billboard size
-    
-    // Returns true if particle is still alive
-    bool isAlive() const { return life > 0.0f; }
-    
-    // Get normalized age (0.0 = just born, 1.0 = about to die)
-    float getAge() const { 
-        return maxLife > 0.0f ? 1.0f - (life / maxLife) : 1.0f; 
+class ParticlePool {
+public:
+    std::vector<float> posX, posY, posZ;   // World position
+    std::vector<float> velX, velY, velZ;   // Movement per second
+    std::vector<float> life;               // Remaining life (seconds)
+    std::vector<float> invMaxLife;         // 1 / initial life, for age
+
+    // Allocate streams for a fixed capacity; all particles start dead
+    void resize(size_t newCapacity) {
+        forEachStream([newCapacity](std::vector<float>& stream) {
+            stream.assign(newCapacity, 0.0f);
+        });
+        capacityCount = newCapacity;
+        aliveCount = 0;
+    }
+
+    void clear() { aliveCount = 0; }
+
+    size_t size() const { return aliveCount; }          // Live particles
+    size_t capacity() const { return capacityCount; }
+    size_t available() const { return capacityCount - aliveCount; }
+    bool full() const { return aliveCount >= capacityCount; }
+
+    // Append a particle to the end of the live range. Caller checks full().
+    void push(const glm::vec3& position, const glm::vec3& velocity, float lifetime) {
+        size_t i = aliveCount++;
+        posX[i] = position.x; posY[i] = position.y; posZ[i] = position.z;
+        velX[i] = velocity.x; velY[i] = velocity.y; velZ[i] = velocity.z;
+        life[i] = lifetime;
+        invMaxLife[i] = lifetime > 0.0f ? 1.0f / lifetime : 0.0f;
+    }
+
+    // Normalized age (0.0 = just born, 1.0 = about to die)
+    float getAge(size_t i) const {
+        return 1.0f - life[i] * invMaxLife[i];
+    }
+
+    // Physics + aging for every live particle:
+    //   v = (v + g*dt) * (1 - drag*dt);  p += v*dt;  life -= dt
+    void integrate(float dt, const glm::vec3& gravity, float drag) {
+        integrateRange(0, aliveCount, dt, gravity, drag);
+    }
+
+    // Same kernel over [begin, end) of the live range. Disjoint ranges
+    // touch disjoint memory, so chunks can run on different threads.
+    void integrateRange(size_t begin, size_t end, float dt, const glm::vec3& gravity, float drag) {
+        end = end < aliveCount ? end : aliveCount;
+        if (begin >= end) return;
+
+        const size_t n = end - begin;
+        const float damping = 1.0f - drag * dt;
+        integrateAxis(posX.data() + begin, velX.data() + begin, n, gravity.x * dt, damping, dt);
+        integrateAxis(posY.data() + begin, velY.data() + begin, n, gravity.y * dt, damping, dt);
+        integrateAxis(posZ.data() + begin, velZ.data() + begin, n, gravity.z * dt, damping, dt);
+        age(life.data() + begin, n, dt);
+    }
+
+    // Remove expired particles, keeping the live range compacted.
+    // Order is not preserved (fine for additive blending).
+    void removeDead() {
+        size_t i = 0;
+        while (i < aliveCount) {
+            if (life[i] > 0.0f) {
+                i++;
+                continue;
+            }
+            size_t last = --aliveCount;
+            forEachStream([i, last](std::vector<float>& stream) {
+                stream[i] = stream[last];
+            });
+        }
+    }
+
+private:
+    size_t aliveCount = 0;
+    size_t capacityCount = 0;
+
+    template <typename Fn>
+    void forEachStream(Fn&& fn) {
+        fn(posX); fn(posY); fn(posZ);
+        fn(velX); fn(velY); fn(velZ);
+        fn(life); fn(invMaxLife);
+    }
+
+    // One position/velocity stream pair, 4 lanes at a time + scalar tail
+    static void integrateAxis(float* pos, float* vel, size_t n, float accelDt, float damping, float dt) {
+        size_t i = 0;
+#if defined(PARTICLE_SIMD_SSE)
+        const __m128 vAccel = _mm_set1_ps(accelDt);
+        const __m128 vDamp = _mm_set1_ps(damping);
+        const __m128 vDt = _mm_set1_ps(dt);
+        for (; i + 4 <= n; i += 4) {
+            __m128 v = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(vel + i), vAccel), vDamp);
+            __m128 p = _mm_add_ps(_mm_loadu_ps(pos + i), _mm_mul_ps(v, vDt));
+            _mm_storeu_ps(vel + i, v);
+            _mm_storeu_ps(pos + i, p);
+        }
+#elif defined(PARTICLE_SIMD_NEON)
+        const float32x4_t vAccel = vdupq_n_f32(accelDt);
+        const float32x4_t vDamp = vdupq_n_f32(damping);
+        const float32x4_t vDt = vdupq_n_f32(dt);
+        for (; i + 4 <= n; i += 4) {
+            float32x4_t v = vmulq_f32(vaddq_f32(vld1q_f32(vel + i), vAccel), vDamp);
+            float32x4_t p = vmlaq_f32(vld1q_f32(pos + i), v, vDt);
+            vst1q_f32(vel + i, v);
+            vst1q_f32(pos + i, p);
+        }
+#endif
+        for (; i < n; i++) {
+            vel[i] = (vel[i] + accelDt) * damping;
+            pos[i] += vel[i] * dt;
+        }
+    }
+
+    static void age(float* lifeStream, size_t n, float dt) {
+        size_t i = 0;
+#if defined(PARTICLE_SIMD_SSE)
+        const __m128 vDt = _mm_set1_ps(dt);
+        for (; i + 4 <= n; i += 4) {
+            _mm_storeu_ps(lifeStream + i, _mm_sub_ps(_mm_loadu_ps(lifeStream + i), vDt));
+        }
+#elif defined(PARTICLE_SIMD_NEON)
+        const float32x4_t vDt = vdupq_n_f32(dt);
+        for (; i + 4 <= n; i += 4) {
+            vst1q_f32(lifeStream + i, vsubq_f32(vld1q_f32(lifeStream + i), vDt));
+        }
+#endif
+        for (; i < n; i++) {
+            lifeStream[i] -= dt;
+        }
     }
 };
 
-// GPU-friendly vertex for particle rendering (billboard quad)
-struct ParticleVertex {
+// Pack a [0,1] RGBA color into RGBA8 (read back as R8G8B8A8_UNORM)
+inline uint32_t packColorRGBA8(const glm::vec4& color) {
+    glm::vec4 c = glm::clamp(color, 0.0f, 1.0f) * 255.0f + 0.5f;
+    return (static_cast<uint32_t>(c.r)) |
+           (static_cast<uint32_t>(c.g) << 8) |
+           (static_cast<uint32_t>(c.b) << 16) |
+           (static_cast<uint32_t>(c.a) << 24);
+}
+
+// Per-instance record for particle rendering (20 bytes).
+// particle.vert expands it into a camera-facing quad from gl_VertexIndex,
+// so no per-corner vertices or index buffer are needed.
+struct ParticleInstance {
     glm::vec3 position;     // Center position
-    glm::vec4 color;        // Color with alpha
-    glm::vec2 texCoord;     // UV for texture/procedural
-    float size;             // Particle size
+    float size;             // Billboard half-extent
+    uint32_t color;         // RGBA8 (see packColorRGBA8)
     
     static VkVertexInputBindingDescription getBindingDescription() {
         VkVertexInputBindingDescription binding{};
         binding.binding = 0;
-        binding.stride = sizeof(ParticleVertex);
-        binding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+        binding.stride = sizeof(ParticleInstance);
+        binding.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
         return binding;
     }
     
-    static std::array<VkVertexInputAttributeDescription, 4> getAttributeDescriptions() {
-        std::array<VkVertexInputAttributeDescription, 4> attributes{};
+    static std::array<VkVertexInputAttributeDescription, 3> getAttributeDescriptions() {
+        std::array<VkVertexInputAttributeDescription, 3> attributes{};
         
         // Position
         attributes[0].binding = 0;
         attributes[0].location = 0;
         attributes[0].format = VK_FORMAT_R32G32B32_SFLOAT;
-        attributes[0].offset = offsetof(ParticleVertex, position);
+        attributes[0].offset = offsetof(ParticleInstance, position);
         
-        // Color
+        // Size
         attributes[1].binding = 0;
         attributes[1].location = 1;
-        attributes[1].format = VK_FORMAT_R32G32B32A32_SFLOAT;
-        attributes[1].offset = offsetof(ParticleVertex, color);
+        attributes[1].format = VK_FORMAT_R32_SFLOAT;
+        attributes[1].offset = offsetof(ParticleInstance, size);
         
-        // TexCoord
+        // Color (normalized to vec4 by the input assembler)
         attributes[2].binding = 0;
         attributes[2].location = 2;
-        attributes[2].format = VK_FORMAT_R32G32_SFLOAT;
-        attributes[2].offset = offsetof(ParticleVertex, texCoord);
-        
-        // Size
-        attributes[3].binding = 0;
-        attributes[3].location = 3;
-        attributes[3].format = VK_FORMAT_R32_SFLOAT;
-        attributes[3].offset = offsetof(ParticleVertex, size);
+        attributes[2].format = VK_FORMAT_R8G8B8A8_UNORM;
+        attributes[2].offset = offsetof(ParticleInstance, color);
         
         return attributes;
     }
-};
\ No newline at end of file
+};
+static_assert(sizeof(ParticleInstance) == 20, "ParticleInstance must stay tightly packed");
+
+
+// ============================================================
+// GPU-SIMULATED PARTICLES
+// ============================================================
+// Layouts shared with particle_sim.comp and particle_gpu.vert.
+// Particle state never leaves device memory: the compute shader
+// emits and integrates in place, the vertex shader expands each
+// particle into a camera-facing quad (6 vertices, no vertex buffer).
+// Color and size are derived from age in the vertex shader, so
+// they are not stored per particle.
+// ============================================================
+
+// One particle in the storage buffer (std430, 32 bytes)
+struct GpuParticle {
+    glm::vec4 positionLife;     // xyz = position, w = remaining life
+    glm::vec4 velocityMaxLife;  // xyz = velocity, w = initial life
+};
+
+// Emitter parameters for one simulation tick, pushed to both the compute
+// and vertex stages (the draw's w is the interpolation offset instead).
+// Scalars are packed into vec4 .w slots to stay within the 128-byte
+// push constant minimum guaranteed by the spec.
+struct ParticleComputePush {
+    glm::vec4 positionDelta;     // xyz = emitter position, w = delta time (sim) / -rewind seconds (draw)
+    glm::vec4 positionVariance;  // xyz = spawn half extents, w = drag
+    glm::vec4 velocity;          // xyz = base velocity, w = min life
+    glm::vec4 velocityVariance;  // xyz = velocity jitter, w = max life
+    glm::vec4 gravity;           // xyz = acceleration, w = start size
+    glm::vec4 startColor;
+    glm::vec4 endColor;
+    float endSize;
+    uint32_t emitBase;           // Serial number of first particle spawned this tick
+    uint32_t emitCount;          // Particles to spawn this tick
+    uint32_t maxParticles;       // Capacity, must be a power of two (ring indexing)
+};
+static_assert(sizeof(ParticleComputePush) == 128, "Push constants must fit the 128-byte minimum");
+
+// One bitonic sort dispatch of particle_sort.comp. The sort buffer holds
+// uvec2(depth key, particle index) per slot; particle_gpu.vert draws the
+// particles in that order, so farthest-first keys give back-to-front blending.
+struct ParticleSortPush {
+    static constexpr uint32_t POOL_ORDER = 0;     // Identity order (sorting off)
+    static constexpr uint32_t SORT_BLOCKS = 1;    // Build keys, sort each block in shared memory
+    static constexpr uint32_t MERGE_GLOBAL = 2;   // One compare step whose stride spans blocks
+    static constexpr uint32_t MERGE_LOCAL = 3;    // Remaining steps of a merge, in shared memory
+
+    uint32_t stage;
+    uint32_t blockSize;          // Length of the bitonic runs being merged (k)
+    uint32_t stride;             // Compare distance, MERGE_GLOBAL only (j)
+    uint32_t padding;
+};
@@ -4,19 +4,25 @@
 #include <glm/gtc/constants.hpp>
 #include <vector>
 #include <random>
+#include <algorithm>
 #include <functional>
 #include "Particle.h"
 
 // ============================================================
 // PARTICLE SYSTEM
 // ============================================================
-// Manages emission, physics simulation, and vertex generation
+// Manages emission, physics simulation, and instance generation
 // for GPU rendering. Supports multiple effect types.
 //
 // Key concepts for defense:
 // - Object pooling: Pre-allocated particles, recycled when dead
-// - Billboard quads: 4 vertices per particle, always face camera
+// - Instanced billboards: 1 compact record per particle, the
+//   vertex shader expands it into a camera-facing quad
 // - Procedural emission: Random within configurable bounds
+// - Split update (beginUpdate / integrateRange / endUpdate) so a
+//   job system can integrate large emitters in parallel chunks
+// - Blend modes: alpha-blended emitters are drawn back to front by
+//   sorting depth keys and indices; additive emitters skip the sort
 // ============================================================
 
 class ParticleSystem {
@@ -30,6 +36,12 @@ public:
         Sparks
     };
     
+    // How an emitter's quads combine with the frame
+    enum class BlendMode {
+        Additive,   // src alpha + dst: order-independent, never sorted
+        Alpha       // src alpha over dst: drawn back to front after a depth sort
+    };
+    
     // Configuration for particle behavior
     struct EmitterConfig {
         glm::vec3 position = glm::vec3(0.0f);
@@ -55,15 +67,16 @@ public:
         
         bool looping = true;
         float duration = 0.0f;       // 0 = infinite (if looping)
+        
+        BlendMode blendMode = BlendMode::Additive;
     };
 
 private:
-    std::vector<Particle> particles;
-    std::vector<ParticleVertex> vertices;  // 4 per particle (quad)
-    std::vector<uint32_t> indices;         // 6 per particle (2 triangles)
+    ParticlePool particles;                   // SoA, live range compacted
     
     EmitterConfig config;
     bool active = false;
+    bool gpuSimulated = false;
     float emissionAccumulator = 0.0f;
     float systemTime = 0.0f;
     
@@ -77,17 +90,11 @@ public:
     void init(EffectType type, const glm::vec3& position) {
         config = getPreset(type);
         config.position = position;
-        particles.resize(config.maxParticles);
         
-        // Pre-allocate vertex/index buffers
-        vertices.reserve(config.maxParticles * 4);
-        indices.reserve(config.maxParticles * 6);
-        
-        // Initialize all particles as dead
-        for (auto& p : particles) {
-            p.life = 0.0f;
-        }
+        // Pre-allocate particle streams (all dead)
+        particles.resize(config.maxParticles);
         
+        gpuSimulated = false;
         active = true;
         systemTime = 0.0f;
     }
@@ -96,13 +103,8 @@ public:
     void init(const EmitterConfig& cfg) {
         config = cfg;
         particles.resize(config.maxParticles);
-        vertices.reserve(config.maxParticles * 4);
-        indices.reserve(config.maxParticles * 6);
-        
-        for (auto& p : particles) {
-            p.life = 0.0f;
-        }
         
+        gpuSimulated = false;
         active = true;
         systemTime = 0.0f;
     }
@@ -111,14 +113,36 @@ public:
         config.position = pos;
     }
     
+    // Fixed seed for reproducible runs (benchmark mode)
+    void setSeed(uint32_t seed) {
+        rng.seed(seed);
+    }
+    
+    // Initialize as a GPU-simulated emitter (see particle_sim.comp).
+    // Only the config and emission pacing live on the CPU; particle
+    // state lives in a device-local storage buffer, so no pool is allocated.
+    void initGpu(const EmitterConfig& cfg) {
+        config = cfg;
+        particles.resize(0);
+        
+        gpuSimulated = true;
+        active = true;
+        systemTime = 0.0f;
+        emissionAccumulator = 0.0f;
+    }
+    
     void start() { active = true; }
     void stop() { active = false; }
     bool isActive() const { return active; }
+    bool isGpuSimulated() const { return gpuSimulated; }
     
-    // Update particle simulation
-    void update(float deltaTime) {
-        if (!active && getAliveCount() == 0) return;
-        
+    const EmitterConfig& getConfig() const { return config; }
+    bool needsSorting() const { return config.blendMode == BlendMode::Alpha; }
+    
+    // Advance emitter time and return how many particles to spawn this step.
+    // Shared by the CPU path (update) and the GPU path, which forwards the
+    // count to the compute shader.
+    uint32_t stepEmitter(float deltaTime) {
         systemTime += deltaTime;
         
         // Check duration for non-looping effects
@@ -126,136 +150,142 @@ public:
             active = false;
         }
         
-        // Emit new particles
-        if (active) {
-            emissionAccumulator += config.emissionRate * deltaTime;
-            while (emissionAccumulator >= 1.0f) {
-                emitParticle();
-                emissionAccumulator -= 1.0f;
-            }
-        }
+        if (!active) return 0;
         
-        // Update existing particles
-        for (auto& p : particles) {
-            if (!p.isAlive()) continue;
-            
-            // Physics
-            p.velocity += config.gravity * deltaTime;
-            p.velocity *= (1.0f - config.drag * deltaTime);
-            p.position += p.velocity * deltaTime;
-            
-            // Life
-            p.life -= deltaTime;
-            
-            // Interpolate color and size based on age
-            float age = p.getAge();
-            p.color = glm::mix(config.startColor, config.endColor, age);
-            p.size = glm::mix(config.startSize, config.endSize, age);
-        }
+        emissionAccumulator += config.emissionRate * deltaTime;
+        uint32_t count = static_cast<uint32_t>(emissionAccumulator);
+        emissionAccumulator -= static_cast<float>(count);
+        return count;
+    }
+    
+    // Update particle simulation (single-threaded)
+    void update(float deltaTime) {
+        size_t liveCount = beginUpdate(deltaTime);
+        integrateRange(0, liveCount, deltaTime);
+        endUpdate();
     }
     
-    // Generate billboard vertices for rendering
-    void generateVertices(const glm::vec3& cameraRight, const glm::vec3& cameraUp) {
-        vertices.clear();
-        indices.clear();
+    // Split update for the job system:
+    //   beginUpdate   - emission, serial per emitter; returns live count
+    //   integrateRange - physics + life for a slice of the live range,
+    //                    disjoint slices may run concurrently
+    //   endUpdate     - compact out dead particles, serial per emitter
+    size_t beginUpdate(float deltaTime) {
+        if (!active && getAliveCount() == 0) return 0;
         
-        uint32_t vertexIndex = 0;
+        emitParticles(stepEmitter(deltaTime));
+        return particles.size();
+    }
+    
+    void integrateRange(size_t begin, size_t end, float deltaTime) {
+        particles.integrateRange(begin, end, deltaTime, config.gravity, config.drag);
+    }
+    
+    void endUpdate() {
+        particles.removeDead();
+    }
+    
+    // Write one instance record per live particle straight into dst
+    // (typically persistently mapped GPU memory). Returns records written.
+    size_t generateInstances(ParticleInstance* dst, size_t maxCount) const {
+        return generateInstanceRange(dst, 0, std::min(particles.size(), maxCount));
+    }
+    
+    // Instance records for live particles [begin, end) into dst[0, end - begin).
+    // Const and range-based so chunks can be generated in parallel.
+    // rewind steps each position back along its velocity by that many seconds;
+    // integration moves positions by velocity * dt, so rewinding a fraction
+    // of the last step interpolates between the last two fixed ticks exactly.
+    size_t generateInstanceRange(ParticleInstance* dst, size_t begin, size_t end, float rewind = 0.0f) const {
+        end = std::min(end, particles.size());
+        if (begin >= end) return 0;
         
-        for (const auto& p : particles) {
-            if (!p.isAlive()) continue;
-            
-            // Billboard corners (camera-facing quad)
-            glm::vec3 right = cameraRight * p.size;
-            glm::vec3 up = cameraUp * p.size;
-            
-            // 4 corners of quad
-            ParticleVertex v0, v1, v2, v3;
-            
-            v0.position = p.position - right - up;  // Bottom-left
-            v0.color = p.color;
-            v0.texCoord = glm::vec2(0.0f, 0.0f);
-            v0.size = p.size;
-            
-            v1.position = p.position + right - up;  // Bottom-right
-            v1.color = p.color;
-            v1.texCoord = glm::vec2(1.0f, 0.0f);
-            v1.size = p.size;
-            
-            v2.position = p.position + right + up;  // Top-right
-            v2.color = p.color;
-            v2.texCoord = glm::vec2(1.0f, 1.0f);
-            v2.size = p.size;
-            
-            v3.position = p.position - right + up;  // Top-left
-            v3.color = p.color;
-            v3.texCoord = glm::vec2(0.0f, 1.0f);
-            v3.size = p.size;
-            
-            vertices.push_back(v0);
-            vertices.push_back(v1);
-            vertices.push_back(v2);
-            vertices.push_back(v3);
-            
-            // Two triangles per quad
-            indices.push_back(vertexIndex + 0);
-            indices.push_back(vertexIndex + 1);
-            indices.push_back(vertexIndex + 2);
-            
-            indices.push_back(vertexIndex + 0);
-            indices.push_back(vertexIndex + 2);
-            indices.push_back(vertexIndex + 3);
-            
-            vertexIndex += 4;
+        for (size_t i = begin; i < end; i++) {
+            generateInstance(dst[i - begin], i, rewind);
         }
+        return end - begin;
     }
     
-    // Accessors for rendering
-    const std::vector<ParticleVertex>& getVertices() const { return vertices; }
-    const std::vector<uint32_t>& getIndices() const { return indices; }
-    size_t getVertexCount() const { return vertices.size(); }
-    size_t getIndexCount() const { return indices.size(); }
+    // Instance record of live particle i (i < getAliveCount()), for
+    // writing particles in an order other than the pool's (depth sorting)
+    void generateInstance(ParticleInstance& instance, size_t i, float rewind = 0.0f) const {
+        // Interpolate color and size based on age
+        float age = particles.getAge(i);
+        
+        instance.position = glm::vec3(particles.posX[i] - particles.velX[i] * rewind,
+                                      particles.posY[i] - particles.velY[i] * rewind,
+                                      particles.posZ[i] - particles.velZ[i] * rewind);
+        instance.size = glm::mix(config.startSize, config.endSize, age);
+        instance.color = packColorRGBA8(glm::mix(config.startColor, config.endColor, age));
+    }
     
-    int getAliveCount() const {
-        int count = 0;
-        for (const auto& p : particles) {
-            if (p.isAlive()) count++;
+    // Back-to-front sort keys for live particles [begin, end): view depth
+    // along forward, quantized to 16 bits over [0, maxDepth] and inverted so
+    // an ascending sort puts the farthest first. values[] gets tag | index,
+    // so particles from several emitters can share one sort. Pass the
+    // rewind given to generateInstance so keys match the drawn positions.
+    void writeSortKeys(uint32_t* keys, uint32_t* values, size_t begin, size_t end,
+                       const glm::vec3& eye, const glm::vec3& forward, float maxDepth, uint32_t tag,
+                       float rewind = 0.0f) const {
+        end = std::min(end, particles.size());
+        float scale = 65535.0f / maxDepth;
+        for (size_t i = begin; i < end; i++) {
+            float depth = (particles.posX[i] - particles.velX[i] * rewind - eye.x) * forward.x +
+                          (particles.posY[i] - particles.velY[i] * rewind - eye.y) * forward.y +
+                          (particles.posZ[i] - particles.velZ[i] * rewind - eye.z) * forward.z;
+            float quantized = std::clamp(depth * scale, 0.0f, 65535.0f);
+            keys[i - begin] = 0xFFFFu - static_cast<uint32_t>(quantized);
+            values[i - begin] = tag | static_cast<uint32_t>(i);
         }
-        return count;
+    }
+    
+    // O(1): live particles are always the front of the pool
+    int getAliveCount() const {
+        return static_cast<int>(particles.size());
+    }
+    
+    // Spawn up to count particles immediately (explosions, impacts).
+    // Cost is O(count) and independent of maxParticles; requests beyond
+    // the free capacity are dropped. Returns how many were spawned.
+    uint32_t emitBurst(uint32_t count) {
+        return emitParticles(count);
     }
 
 private:
-    void emitParticle() {
-        // Find dead particle to recycle
-        for (auto& p : particles) {
-            if (p.isAlive()) continue;
-            
-            // Random position within variance
-            p.position = config.position + glm::vec3(
-                randomRange(-config.positionVariance.x, config.positionVariance.x),
-                randomRange(-config.positionVariance.y, config.positionVariance.y),
-                randomRange(-config.positionVariance.z, config.positionVariance.z)
-            );
-            
-            // Random velocity
-            p.velocity = config.velocity + glm::vec3(
-                randomRange(-config.velocityVariance.x, config.velocityVariance.x),
-                randomRange(-config.velocityVariance.y, config.velocityVariance.y),
-                randomRange(-config.velocityVariance.z, config.velocityVariance.z)
-            );
-            
-            p.life = randomRange(config.minLife, config.maxLife);
-            p.maxLife = p.life;
-            p.color = config.startColor;
-            p.size = config.startSize;
-            
-            return;
+    // Batched emission: clamp once to free capacity, then append
+    uint32_t emitParticles(uint32_t count) {
+        uint32_t spawn = static_cast<uint32_t>(std::min<size_t>(count, particles.available()));
+        for (uint32_t i = 0; i < spawn; i++) {
+            emitParticle();
         }
+        return spawn;
+    }
+    
+    // Live range is compacted: new particles append at the end.
+    // Caller guarantees free capacity (see emitParticles).
+    void emitParticle() {
+        // Random position within variance
+        glm::vec3 position = config.position + glm::vec3(
+            randomRange(-config.positionVariance.x, config.positionVariance.x),
+            randomRange(-config.positionVariance.y, config.positionVariance.y),
+            randomRange(-config.positionVariance.z, config.positionVariance.z)
+        );
+        
+        // Random velocity
+        glm::vec3 velocity = config.velocity + glm::vec3(
+            randomRange(-config.velocityVariance.x, config.velocityVariance.x),
+            randomRange(-config.velocityVariance.y, config.velocityVariance.y),
+            randomRange(-config.velocityVariance.z, config.velocityVariance.z)
+        );
+        
+        particles.push(position, velocity, randomRange(config.minLife, config.maxLife));
     }
     
     float randomRange(float min, float max) {
         return min + dist(rng) * (max - min);
     }
-    
+
+public:
     // Effect presets
     static EmitterConfig getPreset(EffectType type) {
         EmitterConfig cfg;
@@ -291,6 +321,7 @@ private:
                 cfg.drag = 0.2f;
                 cfg.emissionRate = 20.0f;
                 cfg.maxParticles = 200;
+                cfg.blendMode = BlendMode::Alpha;
                 break;
                 
             case EffectType::Sand:
@@ -307,6 +338,7 @@ private:
                 cfg.drag = 0.1f;
                 cfg.emissionRate = 100.0f;
                 cfg.maxParticles = 1000;
+                cfg.blendMode = BlendMode::Alpha;
                 break;
                 
             case EffectType::Snow:
@@ -323,6 +355,7 @@ private:
                 cfg.drag = 0.3f;
                 cfg.emissionRate = 50.0f;
                 cfg.maxParticles = 800;
+                cfg.blendMode = BlendMode::Alpha;
                 break;
                 
             case EffectType::Sparks:
@@ -0,0 +1,121 @@
+#include "PipelineCache.h"
+#include "CacheFile.h"
+#include "MappedFile.h"
+#include <stdexcept>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+namespace {
+    // File layout: PipelineCacheFileHeader, then the driver's cache data
+    const char PIPELINE_CACHE_MAGIC[4] = { 'S', 'P', 'L', 'C' };
+    constexpr uint32_t PIPELINE_CACHE_VERSION = 1;
+
+    struct PipelineCacheFileHeader {
+        char magic[4];
+        uint32_t version;
+        uint64_t dataSize;
+        uint64_t contentHash;       // CacheFile::hashBytes over the driver data
+    };
+    static_assert(sizeof(PipelineCacheFileHeader) == 24, "PipelineCacheFileHeader layout is part of the file format");
+}
+
+void PipelineCache::init(VkDevice device, VkPhysicalDevice physicalDevice, const std::string& directory, bool enabled) {
+    m_device = device;
+    m_enabled = enabled;
+    m_warm = false;
+    m_loadedBytes = 0;
+    vkGetPhysicalDeviceProperties(physicalDevice, &m_properties);
+
+    std::ostringstream name;
+    name << directory << '/' << std::hex << std::setfill('0')
+         << std::setw(8) << m_properties.vendorID << '_' << std::setw(8) << m_properties.deviceID << ".plc";
+    m_path = name.str();
+
+    // Seed only from a file that is intact and was written for this device and driver
+    MappedFile file;
+    const char* initialData = nullptr;
+    size_t initialSize = 0;
+    if (m_enabled && file.open(m_path) && file.size() >= sizeof(PipelineCacheFileHeader)) {
+        PipelineCacheFileHeader header{};
+        std::memcpy(&header, file.data(), sizeof(header));
+        const char* data = file.data() + sizeof(header);
+        bool valid = std::memcmp(header.magic, PIPELINE_CACHE_MAGIC, sizeof(PIPELINE_CACHE_MAGIC)) == 0 &&
+                     header.version == PIPELINE_CACHE_VERSION &&
+                     header.dataSize == file.size() - sizeof(header) &&
+                     header.contentHash == CacheFile::hashBytes(data, static_cast<size_t>(header.dataSize)) &&
+                     isCompatible(data, static_cast<size_t>(header.dataSize));
+        if (valid) {
+            initialData = data;
+            initialSize = static_cast<size_t>(header.dataSize);
+        }
+        else {
+            std::cout << "Pipeline cache: " << m_path << " is stale or from another device, starting cold" << std::endl;
+        }
+    }
+
+    VkPipelineCacheCreateInfo createInfo{};
+    createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    createInfo.initialDataSize = initialSize;
+    createInfo.pInitialData = initialData;
+
+    if (vkCreatePipelineCache(m_device, &createInfo, nullptr, &m_cache) != VK_SUCCESS) {
+        // Drivers may still refuse data that passed the header check
+        createInfo.initialDataSize = 0;
+        createInfo.pInitialData = nullptr;
+        initialSize = 0;
+        if (vkCreatePipelineCache(m_device, &createInfo, nullptr, &m_cache) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create pipeline cache!");
+        }
+    }
+
+    m_warm = initialSize > 0;
+    m_loadedBytes = initialSize;
+}
+
+bool PipelineCache::save() const {
+    if (!m_enabled || m_cache == VK_NULL_HANDLE) return false;
+
+    size_t size = 0;
+    if (vkGetPipelineCacheData(m_device, m_cache, &size, nullptr) != VK_SUCCESS || size == 0) {
+        return false;
+    }
+    std::vector<char> data(size);
+    if (vkGetPipelineCacheData(m_device, m_cache, &size, data.data()) != VK_SUCCESS) {
+        return false;
+    }
+    data.resize(size);
+
+    PipelineCacheFileHeader header{};
+    std::memcpy(header.magic, PIPELINE_CACHE_MAGIC, sizeof(PIPELINE_CACHE_MAGIC));
+    header.version = PIPELINE_CACHE_VERSION;
+    header.dataSize = data.size();
+    header.contentHash = CacheFile::hashBytes(data.data(), data.size());
+
+    return CacheFile::writeFileAtomically(m_path, header, data.data(), data.size());
+}
+
+void PipelineCache::cleanup() {
+    if (m_cache != VK_NULL_HANDLE) {
+        vkDestroyPipelineCache(m_device, m_cache, nullptr);
+        m_cache = VK_NULL_HANDLE;
+    }
+}
+
+// Private helper implementations
+
+bool PipelineCache::isCompatible(const char* data, size_t size) const {
+    if (size < sizeof(VkPipelineCacheHeaderVersionOne)) return false;
+
+    VkPipelineCacheHeaderVersionOne header{};
+    std::memcpy(&header, data, sizeof(header));
+    return header.headerSize >= sizeof(VkPipelineCacheHeaderVersionOne) &&
+           header.headerSize <= size &&
+           header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+           header.vendorID == m_properties.vendorID &&
+           header.deviceID == m_properties.deviceID &&
+           std::memcmp(header.pipelineCacheUUID, m_properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
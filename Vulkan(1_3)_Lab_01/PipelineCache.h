@@ -0,0 +1,68 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief VkPipelineCache that persists between runs
+ *
+ * Role: Let the driver skip shader compilation for pipelines it built last run
+ * Responsibilities:
+ * - Load the cache file for the current device and seed the VkPipelineCache
+ * - Reject data written by another GPU or driver (header vendor/device IDs
+ *   and pipelineCacheUUID) and files that fail their content hash
+ * - Write the driver's cache data back on shutdown
+ *
+ * Design Notes:
+ * - One file per vendor/device ID pair, so machines with several GPUs keep
+ *   a cache for each; a driver update changes the UUID and starts cold
+ * - The file is a small header (magic, version, size, CacheFile::hashBytes)
+ *   followed by the vkGetPipelineCacheData blob. The hash catches truncated
+ *   or corrupted files before the blob reaches the driver
+ * - Writes go through CacheFile::writeFileAtomically, like MeshCache and
+ *   the procedural texture cache
+ * - The cache object is internally synchronized, so worker threads may
+ *   create pipelines against it concurrently (see PipelineRegistry)
+ */
+class PipelineCache {
+public:
+    PipelineCache() = default;
+
+    // Non-copyable
+    PipelineCache(const PipelineCache&) = delete;
+    PipelineCache& operator=(const PipelineCache&) = delete;
+
+    /**
+     * @brief Create the cache, seeded from directory if a valid file exists
+     * @param enabled False to start empty and never write (cold-start timing)
+     */
+    void init(VkDevice device, VkPhysicalDevice physicalDevice, const std::string& directory, bool enabled = true);
+
+    /**
+     * @brief Write the current cache data to disk (no-op when disabled)
+     * @return True if the file was written
+     */
+    bool save() const;
+
+    void cleanup();
+
+    VkPipelineCache get() const { return m_cache; }
+
+    /**
+     * @brief True if the cache was seeded from a valid file (warm start)
+     */
+    bool isWarm() const { return m_warm; }
+    size_t getLoadedBytes() const { return m_loadedBytes; }
+
+private:
+    VkDevice m_device = VK_NULL_HANDLE;
+    VkPhysicalDeviceProperties m_properties{};
+    VkPipelineCache m_cache = VK_NULL_HANDLE;
+    std::string m_path;
+    bool m_enabled = true;
+    bool m_warm = false;
+    size_t m_loadedBytes = 0;
+
+    bool isCompatible(const char* data, size_t size) const;
+};
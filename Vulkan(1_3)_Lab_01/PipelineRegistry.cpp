@@ -0,0 +1,246 @@
+#include "PipelineRegistry.h"
+#include "JobSystem.h"
+#include <stdexcept>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+void PipelineRegistry::addGraphics(const GraphicsDesc& desc, VkPipeline* target) {
+    m_graphics.push_back({ desc, target });
+}
+
+void PipelineRegistry::addCompute(const ComputeDesc& desc, VkPipeline* target) {
+    m_compute.push_back({ desc, target });
+}
+
+void PipelineRegistry::build(VkDevice device, VkPipelineCache cache, JobSystem* jobSystem) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    // Distinct SPIR-V files, in first-use order (fragment shaders are shared a lot)
+    std::vector<ShaderModule> modules;
+    auto addModule = [&modules](const std::string& path) {
+        auto it = std::find_if(modules.begin(), modules.end(),
+            [&path](const ShaderModule& module) { return module.path == path; });
+        if (it == modules.end()) {
+            modules.push_back({ path });
+        }
+    };
+    for (const GraphicsEntry& entry : m_graphics) {
+        for (const ShaderStage& stage : entry.desc.stages) addModule(stage.path);
+    }
+    for (const ComputeEntry& entry : m_compute) addModule(entry.desc.path);
+
+    auto runAll = [jobSystem](uint32_t count, const JobSystem::RangeJob& job) {
+        if (jobSystem && count > 1) {
+            JobSystem::Counter counter;
+            jobSystem->parallelFor(counter, count, 1, job);
+            jobSystem->wait(counter);
+        }
+        else {
+            job(0, count);
+        }
+    };
+
+    // Pass 1: file reads and module creation
+    runAll(static_cast<uint32_t>(modules.size()), [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; i++) {
+            std::vector<uint32_t> code;
+            if (!readSpirv(modules[i].path, code)) continue;
+
+            VkShaderModuleCreateInfo createInfo{};
+            createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+            createInfo.codeSize = code.size() * sizeof(uint32_t);
+            createInfo.pCode = code.data();
+            modules[i].loaded = vkCreateShaderModule(device, &createInfo, nullptr, &modules[i].module) == VK_SUCCESS;
+        }
+    });
+
+    // Pass 2: one pipeline per job, graphics first (usually the slowest to compile)
+    const uint32_t graphicsCount = static_cast<uint32_t>(m_graphics.size());
+    const uint32_t totalCount = graphicsCount + static_cast<uint32_t>(m_compute.size());
+    std::vector<VkResult> results(totalCount, VK_ERROR_INITIALIZATION_FAILED);
+    runAll(totalCount, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; i++) {
+            if (i < graphicsCount) {
+                const GraphicsEntry& entry = m_graphics[i];
+                results[i] = createGraphics(device, cache, entry.desc, modules, entry.target);
+                continue;
+            }
+
+            const ComputeEntry& entry = m_compute[i - graphicsCount];
+            VkShaderModule module = findModule(modules, entry.desc.path);
+            if (module == VK_NULL_HANDLE) continue;
+
+            VkComputePipelineCreateInfo computeInfo{};
+            computeInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+            computeInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+            computeInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+            computeInfo.stage.module = module;
+            computeInfo.stage.pName = "main";
+            computeInfo.layout = entry.desc.layout;
+            results[i] = vkCreateComputePipelines(device, cache, 1, &computeInfo, nullptr, entry.target);
+        }
+    });
+
+    // Report the first failure once everything has settled
+    std::string error;
+    for (const ShaderModule& module : modules) {
+        if (!module.loaded && error.empty()) {
+            error = "Failed to load shader " + module.path + "!";
+        }
+        if (module.module != VK_NULL_HANDLE) {
+            vkDestroyShaderModule(device, module.module, nullptr);
+        }
+    }
+    for (uint32_t i = 0; i < totalCount && error.empty(); i++) {
+        if (results[i] != VK_SUCCESS) {
+            const std::string& name = i < graphicsCount ? m_graphics[i].desc.name : m_compute[i - graphicsCount].desc.name;
+            error = "Failed to create " + name + " pipeline!";
+        }
+    }
+
+    m_graphics.clear();
+    m_compute.clear();
+    m_lastBuildCount = totalCount;
+    m_lastBuildMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+    if (!error.empty()) {
+        throw std::runtime_error(error);
+    }
+}
+
+// Private helper implementations
+
+bool PipelineRegistry::readSpirv(const std::string& path, std::vector<uint32_t>& code) {
+    std::ifstream file(path, std::ios::ate | std::ios::binary);
+    if (!file.is_open()) return false;
+
+    // SPIR-V is a stream of 32-bit words; reading into uint32_t keeps pCode aligned
+    size_t fileSize = static_cast<size_t>(file.tellg());
+    if (fileSize == 0 || fileSize % sizeof(uint32_t) != 0) return false;
+    code.resize(fileSize / sizeof(uint32_t));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(code.data()), static_cast<std::streamsize>(fileSize));
+    return static_cast<bool>(file);
+}
+
+VkShaderModule PipelineRegistry::findModule(const std::vector<ShaderModule>& modules, const std::string& path) {
+    for (const ShaderModule& module : modules) {
+        if (module.path == path) return module.module;
+    }
+    return VK_NULL_HANDLE;
+}
+
+VkResult PipelineRegistry::createGraphics(VkDevice device, VkPipelineCache cache, const GraphicsDesc& desc,
+                                          const std::vector<ShaderModule>& modules, VkPipeline* pipeline) {
+    std::vector<VkPipelineShaderStageCreateInfo> stages;
+    for (const ShaderStage& stage : desc.stages) {
+        VkPipelineShaderStageCreateInfo stageInfo{};
+        stageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        stageInfo.stage = stage.stage;
+        stageInfo.module = findModule(modules, stage.path);
+        stageInfo.pName = "main";
+        if (stageInfo.module == VK_NULL_HANDLE) return VK_ERROR_INITIALIZATION_FAILED;
+        stages.push_back(stageInfo);
+    }
+
+    VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
+    vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+    vertexInputInfo.vertexBindingDescriptionCount = static_cast<uint32_t>(desc.bindings.size());
+    vertexInputInfo.pVertexBindingDescriptions = desc.bindings.data();
+    vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(desc.attributes.size());
+    vertexInputInfo.pVertexAttributeDescriptions = desc.attributes.data();
+
+    VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+    inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    inputAssembly.primitiveRestartEnable = VK_FALSE;
+
+    VkPipelineViewportStateCreateInfo viewportState{};
+    viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    viewportState.viewportCount = 1;
+    viewportState.scissorCount = 1;
+
+    VkPipelineRasterizationStateCreateInfo rasterizer{};
+    rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    rasterizer.depthClampEnable = VK_FALSE;
+    rasterizer.rasterizerDiscardEnable = VK_FALSE;
+    rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
+    rasterizer.lineWidth = 1.0f;
+    rasterizer.cullMode = desc.cullMode;
+    rasterizer.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+    rasterizer.depthBiasEnable = VK_FALSE;
+
+    VkPipelineMultisampleStateCreateInfo multisampling{};
+    multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    multisampling.sampleShadingEnable = VK_FALSE;
+    multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+    VkPipelineDepthStencilStateCreateInfo depthStencil{};
+    depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+    depthStencil.depthTestEnable = VK_TRUE;
+    depthStencil.depthWriteEnable = desc.depthWrite ? VK_TRUE : VK_FALSE;
+    depthStencil.depthCompareOp = VK_COMPARE_OP_LESS;
+    depthStencil.depthBoundsTestEnable = VK_FALSE;
+    depthStencil.stencilTestEnable = VK_FALSE;
+
+    VkPipelineColorBlendAttachmentState colorBlendAttachment{};
+    colorBlendAttachment.colorWriteMask = desc.depthOnly ? 0 : VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
+        VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+    colorBlendAttachment.blendEnable = desc.additiveBlend || desc.alphaBlend ? VK_TRUE : VK_FALSE;
+    if (desc.alphaBlend) {
+        colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+        colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+        colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
+        colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+        colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+        colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
+    }
+    else if (desc.additiveBlend) {
+        colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+        colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE;
+        colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
+        colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+        colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
+        colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
+    }
+
+    VkPipelineColorBlendStateCreateInfo colorBlending{};
+    colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    colorBlending.logicOpEnable = VK_FALSE;
+    colorBlending.attachmentCount = 1;
+    colorBlending.pAttachments = &colorBlendAttachment;
+
+    // Depth compare/write as dynamic state is core in Vulkan 1.3 (no feature bit)
+    const VkDynamicState dynamicStates[] = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR,
+        VK_DYNAMIC_STATE_DEPTH_COMPARE_OP, VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE };
+    VkPipelineDynamicStateCreateInfo dynamicState{};
+    dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamicState.dynamicStateCount = desc.dynamicDepth ? 4 : 2;
+    dynamicState.pDynamicStates = dynamicStates;
+
+    VkPipelineRenderingCreateInfo renderingCreateInfo{};
+    renderingCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO;
+    renderingCreateInfo.colorAttachmentCount = 1;
+    renderingCreateInfo.pColorAttachmentFormats = &desc.colorFormat;
+    renderingCreateInfo.depthAttachmentFormat = desc.depthFormat;
+
+    VkGraphicsPipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    pipelineInfo.pNext = &renderingCreateInfo;
+    pipelineInfo.stageCount = static_cast<uint32_t>(stages.size());
+    pipelineInfo.pStages = stages.data();
+    pipelineInfo.pVertexInputState = desc.meshShading ? nullptr : &vertexInputInfo;
+    pipelineInfo.pInputAssemblyState = desc.meshShading ? nullptr : &inputAssembly;
+    pipelineInfo.pViewportState = &viewportState;
+    pipelineInfo.pRasterizationState = &rasterizer;
+    pipelineInfo.pMultisampleState = &multisampling;
+    pipelineInfo.pDepthStencilState = &depthStencil;
+    pipelineInfo.pColorBlendState = &colorBlending;
+    pipelineInfo.pDynamicState = &dynamicState;
+    pipelineInfo.layout = desc.layout;
+    pipelineInfo.renderPass = VK_NULL_HANDLE;
+    pipelineInfo.subpass = 0;
+
+    return vkCreateGraphicsPipelines(device, cache, 1, &pipelineInfo, nullptr, pipeline);
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class JobSystem;
+
+/**
+ * @brief Collects pipeline descriptions and builds them all at once in parallel
+ *
+ * Role: Move SPIR-V loading and pipeline compilation off the startup's serial path
+ * Responsibilities:
+ * - Hold graphics and compute pipeline descriptions by value until build()
+ * - Load each distinct SPIR-V file once and create its shader module
+ * - Create every pipeline on the job system against a shared VkPipelineCache
+ * - Destroy the shader modules and report failures by pipeline name
+ *
+ * Design Notes:
+ * - Pipeline layouts stay with their owners and must exist before build();
+ *   the registry only writes the finished VkPipeline to the target handle
+ * - Every graphics pipeline here uses dynamic rendering, dynamic viewport
+ *   and scissor, one color attachment and no multisampling; only the state
+ *   the scene actually varies is exposed in GraphicsDesc
+ * - vkCreateShaderModule and vkCreate*Pipelines are safe to call from
+ *   several threads on one device and cache, so each job is independent.
+ *   Jobs never throw: errors are collected and thrown by build() on the
+ *   calling thread once every job has finished
+ * - Optional variants (mesh shaders, GPU-driven) are queued only when the
+ *   device supports them, so a build never compiles unused pipelines
+ */
+class PipelineRegistry {
+public:
+    struct ShaderStage {
+        VkShaderStageFlagBits stage = VK_SHADER_STAGE_VERTEX_BIT;
+        std::string path;
+    };
+
+    struct GraphicsDesc {
+        std::string name;                   // Used in error messages
+        std::vector<ShaderStage> stages;
+        std::vector<VkVertexInputBindingDescription> bindings;
+        std::vector<VkVertexInputAttributeDescription> attributes;
+        bool meshShading = false;           // Task/mesh stages: no vertex input or assembly state
+        VkCullModeFlags cullMode = VK_CULL_MODE_BACK_BIT;
+        bool depthWrite = true;
+        bool additiveBlend = false;        // src alpha + dst color
+        bool alphaBlend = false;            // src alpha over dst (draw back to front)
+        bool depthOnly = false;             // Color writes masked off (depth pre-pass, no fragment stage)
+        bool dynamicDepth = false;          // Depth compare op and write enable set per draw pass
+        VkPipelineLayout layout = VK_NULL_HANDLE;
+        VkFormat colorFormat = VK_FORMAT_UNDEFINED;
+        VkFormat depthFormat = VK_FORMAT_UNDEFINED;
+    };
+
+    struct ComputeDesc {
+        std::string name;
+        std::string path;
+        VkPipelineLayout layout = VK_NULL_HANDLE;
+    };
+
+    PipelineRegistry() = default;
+
+    // Non-copyable
+    PipelineRegistry(const PipelineRegistry&) = delete;
+    PipelineRegistry& operator=(const PipelineRegistry&) = delete;
+
+    /**
+     * @brief Queue a pipeline; *target receives it during build()
+     */
+    void addGraphics(const GraphicsDesc& desc, VkPipeline* target);
+    void addCompute(const ComputeDesc& desc, VkPipeline* target);
+
+    /**
+     * @brief Create every queued pipeline and clear the queue
+     * @param jobSystem Runs the work on its workers (nullptr = calling thread only)
+     * Throws std::runtime_error naming the first shader or pipeline that failed;
+     * pipelines that did succeed are still written to their targets.
+     */
+    void build(VkDevice device, VkPipelineCache cache, JobSystem* jobSystem);
+
+    size_t getPendingCount() const { return m_graphics.size() + m_compute.size(); }
+    uint32_t getLastBuildCount() const { return m_lastBuildCount; }
+    float getLastBuildMs() const { return m_lastBuildMs; }
+
+private:
+    struct GraphicsEntry {
+        GraphicsDesc desc;
+        VkPipeline* target = nullptr;
+    };
+
+    struct ComputeEntry {
+        ComputeDesc desc;
+        VkPipeline* target = nullptr;
+    };
+
+    struct ShaderModule {
+        std::string path;
+        VkShaderModule module = VK_NULL_HANDLE;
+        bool loaded = false;            // File found and non-empty
+    };
+
+    std::vector<GraphicsEntry> m_graphics;
+    std::vector<ComputeEntry> m_compute;
+    uint32_t m_lastBuildCount = 0;
+    float m_lastBuildMs = 0.0f;
+
+    static bool readSpirv(const std::string& path, std::vector<uint32_t>& code);
+    static VkShaderModule findModule(const std::vector<ShaderModule>& modules, const std::string& path);
+    static VkResult createGraphics(VkDevice device, VkPipelineCache cache, const GraphicsDesc& desc,
+                                   const std::vector<ShaderModule>& modules, VkPipeline* pipeline);
+};
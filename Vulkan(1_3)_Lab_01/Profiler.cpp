@@ -0,0 +1,332 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+void Profiler::beginFrame() {
+    Clock::time_point now = Clock::now();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // Frame time is start-to-start, so it includes everything outside drawFrame
+    if (m_hasFrame) {
+        float frameMs = std::chrono::duration<float, std::milli>(now - m_frameStart).count();
+        addSample("Frame", frameMs);
+    }
+    m_frameStart = now;
+    m_hasFrame = true;
+}
+
+void Profiler::endFrame() {
+    std::string exportPath;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        // Push this frame's per-scope totals into the rolling windows
+        for (auto& [name, series] : m_series) {
+            series.lastFrame = series.touched ? series.frameTotal : 0.0f;
+            if (!series.touched) continue;
+            series.samples[series.head] = series.frameTotal;
+            series.head = (series.head + 1) % HISTORY_SIZE;
+            series.frameTotal = 0.0f;
+            series.touched = false;
+        }
+
+        if (m_captureFramesLeft > 0 && --m_captureFramesLeft == 0) {
+            exportPath = m_capturePath;
+        }
+    }
+
+    if (!exportPath.empty()) {
+        if (exportChromeTrace(exportPath)) {
+            std::cout << "Profiler: trace written to " << exportPath << std::endl;
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_trace.clear();
+    }
+}
+
+void Profiler::recordCpu(const char* name, Clock::time_point start, Clock::time_point end) {
+    float milliseconds = std::chrono::duration<float, std::milli>(end - start).count();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    addSample(name, milliseconds);
+
+    if (m_captureFramesLeft > 0) {
+        m_trace.push_back({ name, threadIndex(), toMicroseconds(start), milliseconds * 1000.0 });
+    }
+}
+
+void Profiler::recordLatency(const char* name, Clock::time_point start, Clock::time_point end) {
+    float milliseconds = std::chrono::duration<float, std::milli>(end - start).count();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    addSample(name, milliseconds);
+
+    if (m_captureFramesLeft > 0) {
+        m_trace.push_back({ name, LATENCY_TRACK, toMicroseconds(start), milliseconds * 1000.0 });
+    }
+}
+
+void Profiler::initGpu(VkDevice device, VkPhysicalDevice physicalDevice,
+                       uint32_t queueFamily, uint32_t framesInFlight) {
+    uint32_t familyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> families(familyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount, families.data());
+
+    uint32_t validBits = queueFamily < familyCount ? families[queueFamily].timestampValidBits : 0;
+    if (validBits == 0) {
+        std::cout << "Profiler: queue has no timestamp support, GPU timing disabled" << std::endl;
+        return;
+    }
+
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+    m_timestampPeriodNs = properties.limits.timestampPeriod;
+    m_timestampMask = validBits >= 64 ? ~0ull : ((1ull << validBits) - 1);
+    m_device = device;
+
+    VkQueryPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    poolInfo.queryCount = MAX_GPU_SCOPES * 2;
+
+    m_gpuFrames.resize(framesInFlight);
+    for (GpuFrame& frame : m_gpuFrames) {
+        if (vkCreateQueryPool(m_device, &poolInfo, nullptr, &frame.queryPool) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create timestamp query pool!");
+        }
+        frame.scopeNames.reserve(MAX_GPU_SCOPES);
+    }
+}
+
+void Profiler::cleanupGpu() {
+    for (GpuFrame& frame : m_gpuFrames) {
+        if (frame.queryPool != VK_NULL_HANDLE) {
+            vkDestroyQueryPool(m_device, frame.queryPool, nullptr);
+        }
+    }
+    m_gpuFrames.clear();
+}
+
+void Profiler::beginGpuFrame(VkCommandBuffer commandBuffer, uint32_t frameIndex) {
+    if (m_gpuFrames.empty()) return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_gpuFrameIndex = frameIndex % static_cast<uint32_t>(m_gpuFrames.size());
+    GpuFrame& frame = m_gpuFrames[m_gpuFrameIndex];
+
+    // The slot's fence was waited on before recording: results are ready
+    if (frame.pending) {
+        collectGpuResults(frame);
+    }
+
+    vkCmdResetQueryPool(commandBuffer, frame.queryPool, 0, MAX_GPU_SCOPES * 2);
+    frame.scopeNames.clear();
+    frame.recordTimeUs = toMicroseconds(Clock::now());
+    frame.pending = false;
+}
+
+uint32_t Profiler::beginGpuScope(VkCommandBuffer commandBuffer, const char* name) {
+    if (m_gpuFrames.empty()) return UINT32_MAX;
+
+    // Only the slot bookkeeping needs the lock; the timestamp goes into this thread's buffer
+    GpuFrame& frame = m_gpuFrames[m_gpuFrameIndex];
+    uint32_t scope = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (frame.scopeNames.size() >= MAX_GPU_SCOPES) return UINT32_MAX;
+
+        scope = static_cast<uint32_t>(frame.scopeNames.size());
+        frame.scopeNames.push_back(name);
+        frame.pending = true;
+    }
+    vkCmdWriteTimestamp2(commandBuffer, VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT, frame.queryPool, scope * 2);
+    return scope;
+}
+
+void Profiler::endGpuScope(VkCommandBuffer commandBuffer, uint32_t scope) {
+    if (scope == UINT32_MAX) return;
+
+    GpuFrame& frame = m_gpuFrames[m_gpuFrameIndex];
+    vkCmdWriteTimestamp2(commandBuffer, VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT, frame.queryPool, scope * 2 + 1);
+}
+
+Profiler::Stats Profiler::getStats(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    Stats stats;
+    auto it = m_series.find(name);
+    if (it == m_series.end()) return stats;
+
+    std::vector<float> values;
+    values.reserve(HISTORY_SIZE);
+    for (float sample : it->second.samples) {
+        if (sample >= 0.0f) values.push_back(sample);
+    }
+    if (values.empty()) return stats;
+
+    std::sort(values.begin(), values.end());
+    auto percentile = [&values](double p) {
+        size_t index = static_cast<size_t>(p * static_cast<double>(values.size() - 1) + 0.5);
+        return static_cast<double>(values[index]);
+    };
+
+    double sum = 0.0;
+    for (float value : values) sum += value;
+
+    stats.samples = static_cast<uint32_t>(values.size());
+    stats.average = sum / static_cast<double>(values.size());
+    stats.p50 = percentile(0.50);
+    stats.p95 = percentile(0.95);
+    stats.p99 = percentile(0.99);
+    stats.max = values.back();
+    return stats;
+}
+
+float Profiler::getLastFrame(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_series.find(name);
+    return it != m_series.end() ? it->second.lastFrame : 0.0f;
+}
+
+std::vector<std::string> Profiler::getScopeNames() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_order;
+}
+
+std::string Profiler::getSummary() const {
+    Stats frame = getStats("Frame");
+    Stats gpu = getStats("GPU Frame");
+
+    std::ostringstream summary;
+    summary << std::fixed << std::setprecision(2)
+        << frame.average << " ms (" << std::setprecision(0)
+        << (frame.average > 0.0 ? 1000.0 / frame.average : 0.0) << " FPS)"
+        << std::setprecision(2) << " | p99 " << frame.p99 << " ms";
+    if (gpu.samples > 0) {
+        summary << " | GPU " << gpu.average << " ms";
+    }
+    return summary.str();
+}
+
+void Profiler::printReport() const {
+    std::vector<std::string> order;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        order = m_order;
+    }
+
+    std::cout << "--- Profiler (last " << HISTORY_SIZE << " frames, ms) ---\n";
+    std::printf("%-24s %8s %8s %8s %8s %8s\n", "scope", "avg", "p50", "p95", "p99", "max");
+    for (const std::string& name : order) {
+        Stats stats = getStats(name);
+        if (stats.samples == 0) continue;
+        std::printf("%-24s %8.3f %8.3f %8.3f %8.3f %8.3f\n", name.c_str(),
+            stats.average, stats.p50, stats.p95, stats.p99, stats.max);
+    }
+    std::fflush(stdout);
+}
+
+void Profiler::startCapture(uint32_t frameCount, const std::string& path) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_trace.clear();
+    m_trace.reserve(static_cast<size_t>(frameCount) * 32);
+    m_capturePath = path;
+    m_captureFramesLeft = frameCount;
+    std::cout << "Profiler: capturing " << frameCount << " frames" << std::endl;
+}
+
+bool Profiler::exportChromeTrace(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file) return false;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Trace Event Format: complete events ("ph":"X"), microsecond units
+    file << "{\"traceEvents\":[\n";
+    file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << GPU_TRACK
+        << ",\"args\":{\"name\":\"GPU\"}}";
+    file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << LATENCY_TRACK
+        << ",\"args\":{\"name\":\"Latency\"}}";
+    file << std::fixed << std::setprecision(3);
+    for (const TraceEvent& event : m_trace) {
+        file << ",\n{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread
+            << ",\"ts\":" << event.startUs << ",\"dur\":" << event.durationUs << "}";
+    }
+    file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return static_cast<bool>(file);
+}
+
+// Private helper implementations
+
+void Profiler::addSample(const std::string& name, float milliseconds) {
+    Series& series = m_series[name];
+    if (series.samples.empty()) {
+        series.samples.assign(HISTORY_SIZE, -1.0f);   // -1 = no sample yet
+        m_order.push_back(name);
+    }
+    series.frameTotal += milliseconds;
+    series.touched = true;
+}
+
+void Profiler::collectGpuResults(GpuFrame& frame) {
+    const uint32_t queryCount = static_cast<uint32_t>(frame.scopeNames.size()) * 2;
+    if (queryCount == 0) return;
+
+    uint64_t timestamps[MAX_GPU_SCOPES * 2] = {};
+    VkResult result = vkGetQueryPoolResults(m_device, frame.queryPool, 0, queryCount,
+        sizeof(timestamps), timestamps, sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+    if (result != VK_SUCCESS) return;   // Not ready: drop rather than stall
+
+    const double nsToMs = m_timestampPeriodNs / 1.0e6;
+    uint64_t frameBegin = UINT64_MAX;
+    uint64_t frameEnd = 0;
+    for (uint32_t i = 0; i < queryCount; i++) {
+        timestamps[i] &= m_timestampMask;
+    }
+    for (uint32_t i = 0; i < queryCount / 2; i++) {
+        frameBegin = std::min(frameBegin, timestamps[i * 2]);
+        frameEnd = std::max(frameEnd, timestamps[i * 2 + 1]);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (uint32_t i = 0; i < queryCount / 2; i++) {
+        uint64_t begin = timestamps[i * 2];
+        uint64_t end = timestamps[i * 2 + 1];
+        if (end < begin) continue;
+
+        double milliseconds = static_cast<double>(end - begin) * nsToMs;
+        addSample(std::string("GPU ") + frame.scopeNames[i], static_cast<float>(milliseconds));
+
+        if (m_captureFramesLeft > 0) {
+            double offsetUs = static_cast<double>(begin - frameBegin) * nsToMs * 1000.0;
+            m_trace.push_back({ frame.scopeNames[i], GPU_TRACK,
+                frame.recordTimeUs + offsetUs, milliseconds * 1000.0 });
+        }
+    }
+    if (frameEnd > frameBegin) {
+        addSample("GPU Frame", static_cast<float>(static_cast<double>(frameEnd - frameBegin) * nsToMs));
+    }
+}
+
+double Profiler::toMicroseconds(Clock::time_point time) const {
+    return std::chrono::duration<double, std::micro>(time - m_epoch).count();
+}
+
+uint32_t Profiler::threadIndex() {
+    // Small stable ids read better in the trace viewer than hashed thread ids
+    static std::atomic<uint32_t> nextIndex{ 1 };
+    thread_local uint32_t index = nextIndex.fetch_add(1);
+    return index;
+}
@@ -0,0 +1,233 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Set to 0 to compile every PROFILE_* macro out of the build
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED 1
+#endif
+
+/**
+ * @brief CPU scope timers and GPU timestamp queries with rolling statistics
+ * 
+ * Role: Show where a frame's time goes, on both the CPU and the GPU
+ * Responsibilities:
+ * - Time named CPU scopes (any thread) via PROFILE_SCOPE
+ * - Time named GPU ranges via vkCmdWriteTimestamp2 (PROFILE_GPU_SCOPE)
+ * - Record spans that cross frames, such as input latency (recordLatency)
+ * - Keep a rolling window per scope: average, p50, p95, p99, max
+ * - Capture a number of frames and export them as a Chrome trace
+ *   (chrome://tracing or ui.perfetto.dev)
+ * 
+ * Design Notes:
+ * - One timestamp query pool per frame in flight; a slot is read back
+ *   only after that frame's fence has been waited on, so readback never
+ *   stalls (results are already available)
+ * - Scopes that run several times per frame are summed per frame
+ * - GPU scopes may be opened from several threads at once, each in its
+ *   own secondary command buffer of the current frame
+ * - GPU events in the trace are aligned to the CPU time the frame was
+ *   recorded, so their absolute position is approximate
+ * - Global instance so the macros can be dropped anywhere
+ */
+class Profiler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Rolling statistics for one scope (milliseconds)
+     */
+    struct Stats {
+        double average = 0.0;
+        double p50 = 0.0;
+        double p95 = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+        uint32_t samples = 0;
+    };
+
+    static Profiler& instance();
+
+    // Non-copyable
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    /**
+     * @brief Frame boundaries (render thread)
+     */
+    void beginFrame();
+    void endFrame();
+
+    /**
+     * @brief Record a finished CPU scope (thread-safe)
+     */
+    void recordCpu(const char* name, Clock::time_point start, Clock::time_point end);
+
+    /**
+     * @brief Record a span that is not a scope on the calling thread (thread-safe)
+     * Used for latencies that start in one frame and end in a later one;
+     * the trace shows them on their own track
+     */
+    void recordLatency(const char* name, Clock::time_point start, Clock::time_point end);
+
+    /**
+     * @brief Create timestamp query pools (no-op if the queue has no timestamps)
+     * @param queueFamily Family of the queue the timed commands are submitted to
+     */
+    void initGpu(VkDevice device, VkPhysicalDevice physicalDevice,
+                 uint32_t queueFamily, uint32_t framesInFlight);
+    void cleanupGpu();
+
+    /**
+     * @brief Read back this slot's previous results and reset its queries
+     * Record right after vkBeginCommandBuffer, after the slot's fence wait
+     */
+    void beginGpuFrame(VkCommandBuffer commandBuffer, uint32_t frameIndex);
+
+    /**
+     * @brief Open / close a timed GPU range in the current frame's command buffer
+     * Thread-safe between beginGpuFrame calls (primary or secondary buffers)
+     * @return Scope handle for endGpuScope (UINT32_MAX if out of queries)
+     */
+    uint32_t beginGpuScope(VkCommandBuffer commandBuffer, const char* name);
+    void endGpuScope(VkCommandBuffer commandBuffer, uint32_t scope);
+
+    /**
+     * @brief Rolling statistics for a scope ("Frame", CPU scope or "GPU <name>")
+     */
+    Stats getStats(const std::string& name) const;
+
+    /**
+     * @brief Total of a scope in the most recently ended frame (0 if it did not run)
+     */
+    float getLastFrame(const std::string& name) const;
+
+    /**
+     * @brief Every scope seen so far, in first-recorded order
+     */
+    std::vector<std::string> getScopeNames() const;
+
+    /**
+     * @brief Short line for the window title: frame time, FPS, GPU total
+     */
+    std::string getSummary() const;
+
+    /**
+     * @brief Print every scope's statistics to stdout
+     */
+    void printReport() const;
+
+    /**
+     * @brief Record the next frameCount frames, then write them to path
+     */
+    void startCapture(uint32_t frameCount, const std::string& path);
+    bool isCapturing() const { return m_captureFramesLeft > 0; }
+
+    /**
+     * @brief Write captured events as Chrome trace JSON
+     */
+    bool exportChromeTrace(const std::string& path) const;
+
+private:
+    static constexpr uint32_t HISTORY_SIZE = 240;
+    static constexpr uint32_t MAX_GPU_SCOPES = 64;
+    static constexpr uint32_t GPU_TRACK = 0xFFFF;   // Trace "thread" for GPU events
+    static constexpr uint32_t LATENCY_TRACK = 0xFFFE;
+
+    struct Series {
+        std::vector<float> samples;   // Ring of per-frame totals (ms)
+        uint32_t head = 0;
+        float frameTotal = 0.0f;      // Accumulated during the current frame
+        float lastFrame = 0.0f;       // Total of the last ended frame
+        bool touched = false;
+    };
+
+    struct TraceEvent {
+        std::string name;
+        uint32_t thread = 0;
+        double startUs = 0.0;
+        double durationUs = 0.0;
+    };
+
+    struct GpuFrame {
+        VkQueryPool queryPool = VK_NULL_HANDLE;
+        std::vector<const char*> scopeNames;
+        double recordTimeUs = 0.0;    // CPU time at beginGpuFrame (trace alignment)
+        bool pending = false;         // Queries written, not yet read back
+    };
+
+    Profiler() = default;
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, Series> m_series;
+    std::vector<std::string> m_order;          // Report order (first seen)
+
+    Clock::time_point m_epoch = Clock::now();
+    Clock::time_point m_frameStart{};
+    bool m_hasFrame = false;
+
+    std::vector<TraceEvent> m_trace;
+    uint32_t m_captureFramesLeft = 0;
+    std::string m_capturePath;
+
+    VkDevice m_device = VK_NULL_HANDLE;
+    std::vector<GpuFrame> m_gpuFrames;
+    uint32_t m_gpuFrameIndex = 0;
+    double m_timestampPeriodNs = 1.0;
+    uint64_t m_timestampMask = ~0ull;
+
+    void addSample(const std::string& name, float milliseconds);
+    void collectGpuResults(GpuFrame& frame);
+    double toMicroseconds(Clock::time_point time) const;
+    static uint32_t threadIndex();
+};
+
+/**
+ * @brief RAII CPU timer (use PROFILE_SCOPE)
+ */
+class ScopedCpuTimer {
+public:
+    explicit ScopedCpuTimer(const char* name) : m_name(name), m_start(Profiler::Clock::now()) {}
+    ~ScopedCpuTimer() { Profiler::instance().recordCpu(m_name, m_start, Profiler::Clock::now()); }
+
+    ScopedCpuTimer(const ScopedCpuTimer&) = delete;
+    ScopedCpuTimer& operator=(const ScopedCpuTimer&) = delete;
+
+private:
+    const char* m_name;
+    Profiler::Clock::time_point m_start;
+};
+
+/**
+ * @brief RAII GPU timestamp range (use PROFILE_GPU_SCOPE)
+ */
+class ScopedGpuTimer {
+public:
+    ScopedGpuTimer(VkCommandBuffer commandBuffer, const char* name)
+        : m_commandBuffer(commandBuffer), m_scope(Profiler::instance().beginGpuScope(commandBuffer, name)) {}
+    ~ScopedGpuTimer() { Profiler::instance().endGpuScope(m_commandBuffer, m_scope); }
+
+    ScopedGpuTimer(const ScopedGpuTimer&) = delete;
+    ScopedGpuTimer& operator=(const ScopedGpuTimer&) = delete;
+
+private:
+    VkCommandBuffer m_commandBuffer;
+    uint32_t m_scope;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#if PROFILER_ENABLED
+#define PROFILE_SCOPE(name) ScopedCpuTimer PROFILE_CONCAT(profileScope_, __LINE__)(name)
+#define PROFILE_GPU_SCOPE(commandBuffer, name) ScopedGpuTimer PROFILE_CONCAT(profileGpuScope_, __LINE__)(commandBuffer, name)
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_GPU_SCOPE(commandBuffer, name) ((void)0)
+#endif
@@ -0,0 +1,90 @@
+#include "RadixSort.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <utility>
+
+void RadixSort::sort(uint32_t* keys, uint32_t* values, size_t count, uint32_t keyBits, JobSystem* jobSystem) {
+    m_lastPassCount = 0;
+    if (count < 2 || keyBits == 0) return;
+
+    if (m_keyScratch.size() < count) {
+        m_keyScratch.resize(count);
+        m_valueScratch.resize(count);
+    }
+
+    // One chunk per thread at most, and none smaller than MIN_CHUNK
+    uint32_t threadCount = jobSystem ? jobSystem->getWorkerCount() + 1 : 1;
+    uint32_t chunkCount = static_cast<uint32_t>(std::clamp<size_t>(count / MIN_CHUNK, 1,
+        std::min(MAX_CHUNKS, threadCount)));
+    size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+    m_offsets.resize(static_cast<size_t>(chunkCount) * BUCKETS);
+
+    auto forEachChunk = [&](auto&& work) {
+        auto runChunk = [&](uint32_t chunk) {
+            size_t begin = chunk * chunkSize;
+            size_t end = std::min(count, begin + chunkSize);
+            work(&m_offsets[static_cast<size_t>(chunk) * BUCKETS], begin, end);
+        };
+        if (chunkCount == 1) {
+            runChunk(0);
+            return;
+        }
+        JobSystem::Counter chunkJobs;
+        jobSystem->parallelFor(chunkJobs, chunkCount, 1, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t chunk = begin; chunk < end; chunk++) runChunk(chunk);
+        });
+        jobSystem->wait(chunkJobs);
+    };
+
+    uint32_t* srcKeys = keys;
+    uint32_t* srcValues = values;
+    uint32_t* dstKeys = m_keyScratch.data();
+    uint32_t* dstValues = m_valueScratch.data();
+
+    uint32_t passCount = (std::min(keyBits, 32u) + RADIX_BITS - 1) / RADIX_BITS;
+    for (uint32_t pass = 0; pass < passCount; pass++) {
+        uint32_t shift = pass * RADIX_BITS;
+
+        // Digit histogram of every chunk
+        forEachChunk([&](uint32_t* histogram, size_t begin, size_t end) {
+            std::fill(histogram, histogram + BUCKETS, 0u);
+            for (size_t i = begin; i < end; i++) {
+                histogram[(srcKeys[i] >> shift) & (BUCKETS - 1)]++;
+            }
+        });
+
+        // Exclusive prefix sum, bucket-major then chunk order, turns the
+        // histograms into each chunk's first write position per bucket
+        uint32_t running = 0;
+        bool singleBucket = false;
+        for (uint32_t digit = 0; digit < BUCKETS; digit++) {
+            uint32_t bucketStart = running;
+            for (uint32_t chunk = 0; chunk < chunkCount; chunk++) {
+                uint32_t& slot = m_offsets[static_cast<size_t>(chunk) * BUCKETS + digit];
+                uint32_t chunkItems = slot;
+                slot = running;
+                running += chunkItems;
+            }
+            if (running - bucketStart == count) singleBucket = true;
+        }
+        if (singleBucket) continue;   // Every key has this digit: order is unchanged
+
+        forEachChunk([&](uint32_t* offsets, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                uint32_t position = offsets[(srcKeys[i] >> shift) & (BUCKETS - 1)]++;
+                dstKeys[position] = srcKeys[i];
+                dstValues[position] = srcValues[i];
+            }
+        });
+
+        std::swap(srcKeys, dstKeys);
+        std::swap(srcValues, dstValues);
+        m_lastPassCount++;
+    }
+
+    // An odd number of scatters leaves the result in scratch
+    if (srcKeys != keys) {
+        std::copy(srcKeys, srcKeys + count, keys);
+        std::copy(srcValues, srcValues + count, values);
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class JobSystem;
+
+/**
+ * @brief Stable LSD radix sort of 32-bit (key, value) pairs on the job system
+ *
+ * Role: Order per-frame CPU data by an integer key (particle view depth)
+ * Responsibilities:
+ * - Sort values by ascending key, 8 bits per pass, only over the key bits asked for
+ * - Split every pass into chunks that histogram and scatter in parallel
+ * - Own the scratch arrays so a per-frame sort never allocates once warm
+ *
+ * Design Notes:
+ * - Only keys and small values move: callers sort indices into their own
+ *   data, which stays where it is
+ * - Chunk c scatters to the offsets reserved for it after chunks 0..c-1
+ *   in every bucket, so the parallel scatter is still stable
+ * - A pass whose digit is the same for every key is skipped, which makes
+ *   narrow key ranges (e.g. particles in one depth band) cheaper
+ * - The result always ends in the caller's arrays, whatever the pass count
+ */
+class RadixSort {
+public:
+    RadixSort() = default;
+
+    // Non-copyable
+    RadixSort(const RadixSort&) = delete;
+    RadixSort& operator=(const RadixSort&) = delete;
+
+    /**
+     * @brief Sort values[0, count) by keys[0, count), both arrays reordered in place
+     * @param keyBits Low key bits that take part (rounded up to whole 8-bit passes)
+     * @param jobSystem Runs large sorts in parallel (nullptr = calling thread only)
+     */
+    void sort(uint32_t* keys, uint32_t* values, size_t count, uint32_t keyBits, JobSystem* jobSystem);
+
+    uint32_t getLastPassCount() const { return m_lastPassCount; }   // Scatter passes actually run
+
+private:
+    static constexpr uint32_t RADIX_BITS = 8;
+    static constexpr uint32_t BUCKETS = 1u << RADIX_BITS;
+    static constexpr uint32_t MIN_CHUNK = 16384;    // Below this a chunk isn't worth a job
+    static constexpr uint32_t MAX_CHUNKS = 64;
+
+    std::vector<uint32_t> m_keyScratch;
+    std::vector<uint32_t> m_valueScratch;
+    std::vector<uint32_t> m_offsets;                // [chunk * BUCKETS + digit]
+    uint32_t m_lastPassCount = 0;
+};
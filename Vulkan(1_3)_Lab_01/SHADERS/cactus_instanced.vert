@@ -0,0 +1,71 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+layout(binding = 0) uniform UniformBufferObject {
+    mat4 model;
+    mat4 view;
+    mat4 proj;
+    vec3 viewPos;
+    float time;
+    vec3 lightPos;
+    float lightIntensity;
+    vec3 lightColor;
+    float ambientStrength;
+    vec4 positionScale;    // PACKED_VERTEX: position = stored * scale + bias
+    vec4 positionBias;
+} ubo;
+
+// Only the material of ObjectPush is used: the transform is per instance
+layout(push_constant) uniform ObjectPush {
+    layout(offset = 112) uint material;
+} object;
+
+// Shared unit-height cactus mesh (binding 0, per vertex)
+#ifdef PACKED_VERTEX
+// PackedVertex: quantized position, octahedral normal (decoded below)
+layout(location = 0) in vec3 inPackedPosition;
+layout(location = 1) in vec2 inPackedNormal;
+#else
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inNormal;
+#endif
+layout(location = 2) in vec2 inTexCoord;
+layout(location = 3) in vec3 inColor;
+
+// Per-instance data (binding 1, see CactusInstance)
+layout(location = 4) in vec3 instancePosition;
+layout(location = 5) in float instanceGrowth;
+layout(location = 6) in vec3 instanceScale;
+layout(location = 7) in vec4 instanceTint;
+
+// Depth pre-pass and color pass must produce identical depth (EQUAL test)
+invariant gl_Position;
+
+layout(location = 0) out vec3 fragColor;
+layout(location = 1) out vec3 fragNormal;
+layout(location = 2) out vec2 fragTexCoord;
+layout(location = 3) out vec3 fragPos;       // World position for lighting
+layout(location = 4) flat out uint fragMaterial;
+
+#ifdef PACKED_VERTEX
+#include "packed_vertex.glsl"
+#endif
+
+void main() {
+#ifdef PACKED_VERTEX
+    vec3 inPosition = inPackedPosition * ubo.positionScale.xyz + ubo.positionBias.xyz;
+    vec3 inNormal = octDecode(inPackedNormal);
+#endif
+    // Scale then translate: no rotation, so no matrix is needed
+    vec3 scale = instanceScale * instanceGrowth;
+    vec4 worldPos = vec4(inPosition * scale + instancePosition, 1.0);
+    fragPos = worldPos.xyz;
+    
+    gl_Position = ubo.proj * ubo.view * worldPos;
+    fragColor = inColor * instanceTint.rgb;
+    
+    // Inverse-transpose of a diagonal scale is 1 / scale
+    fragNormal = inNormal / scale;
+    fragTexCoord = inTexCoord;
+    fragMaterial = object.material;
+}
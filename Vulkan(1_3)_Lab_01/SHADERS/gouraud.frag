@@ -1,18 +1,48 @@
 #version 450
+#extension GL_EXT_nonuniform_qualifier : require
 
 // ============================================================
 // GOURAUD SHADING - Fragment Shader
 // ============================================================
-// Simply outputs the interpolated pre-lit color from vertex shader
-// The lighting was already computed per-vertex
+// Multiplies the interpolated per-vertex lighting by the surface
+// color; no per-pixel lighting calculation. The surface color comes
+// from the material exactly as in shader.frag.
 // ============================================================
 
-layout(location = 0) in vec3 fragLitColor;
+layout(location = 0) in vec3 fragLight;
 layout(location = 1) in vec2 fragTexCoord;
+layout(location = 2) in vec3 fragColor;
+layout(location = 3) flat in uint fragMaterial;
 
 layout(location = 0) out vec4 outColor;
 
+// Indexed by TextureManager index; only slots named by a material are written
+layout(binding = 1) uniform sampler2D textures[];
+
+#define NO_TEXTURE 0xFFFFFFFFu
+
+// Matches GpuMaterial (MaterialLibrary.h)
+struct Material {
+    vec4 baseColor;
+    uint albedoTexture;    // NO_TEXTURE = vertex color
+    float specularStrength;
+    float shininess;
+    uint padding;
+};
+
+layout(std430, binding = 2) readonly buffer MaterialBuffer {
+    Material materials[];
+};
+
 void main() {
-    // Output interpolated lit color (no per-pixel lighting calculation)
-    outColor = vec4(fragLitColor, 1.0);
-}
\ No newline at end of file
+    Material material = materials[fragMaterial];
+
+    // Textured materials sample their albedo, the rest use the vertex color
+    vec3 surfaceColor = fragColor;
+    if (material.albedoTexture != NO_TEXTURE) {
+        surfaceColor = texture(textures[nonuniformEXT(material.albedoTexture)], fragTexCoord).rgb;
+    }
+    surfaceColor *= material.baseColor.rgb;
+
+    outColor = vec4(fragLight * surfaceColor, 1.0);
+}
@@ -1,4 +1,5 @@
 #version 450
+#extension GL_GOOGLE_include_directive : require
 
 // ============================================================
 // GOURAUD SHADING (Per-Vertex Lighting)
@@ -10,6 +11,9 @@
 // is calculated once per vertex rather than per fragment. However, it
 // can produce visible artifacts on low-poly geometry, especially with
 // specular highlights (Mach banding). Works well when vertices are dense.
+//
+// The material (GpuMaterial) is applied as in shader.frag: its specular
+// response here, its albedo texture and base color in gouraud.frag.
 // ============================================================
 
 layout(binding = 0) uniform UniformBufferObject {
@@ -22,28 +26,69 @@ layout(binding = 0) uniform UniformBufferObject {
     float lightIntensity;
     vec3 lightColor;
     float ambientStrength;
+    vec4 positionScale;    // PACKED_VERTEX: position = stored * scale + bias
+    vec4 positionBias;
 } ubo;
 
+// Per-draw transform and material (see ObjectPushConstants)
+layout(push_constant) uniform ObjectPush {
+    mat4 model;
+    mat3 normalMatrix;     // transpose(inverse(model)), precomputed on the CPU
+    uint material;         // Into the material buffer (see shader.frag)
+} object;
+
 // Vertex attributes
+#ifdef PACKED_VERTEX
+// PackedVertex: quantized position, octahedral normal (decoded below)
+layout(location = 0) in vec3 inPackedPosition;
+layout(location = 1) in vec2 inPackedNormal;
+#else
 layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec3 inNormal;
+#endif
 layout(location = 2) in vec2 inTexCoord;
 layout(location = 3) in vec3 inColor;
 
+// Depth pre-pass and color pass must produce identical depth (EQUAL test)
+invariant gl_Position;
+
+// Matches GpuMaterial (MaterialLibrary.h)
+struct Material {
+    vec4 baseColor;
+    uint albedoTexture;    // NO_TEXTURE = vertex color
+    float specularStrength;
+    float shininess;
+    uint padding;
+};
+
+layout(std430, binding = 2) readonly buffer MaterialBuffer {
+    Material materials[];
+};
+
 // Outputs to fragment shader
-layout(location = 0) out vec3 fragLitColor;  // Pre-computed lit color
+layout(location = 0) out vec3 fragLight;     // Pre-computed lighting, multiplied by the surface color
 layout(location = 1) out vec2 fragTexCoord;
+layout(location = 2) out vec3 fragColor;
+layout(location = 3) flat out uint fragMaterial;
+
+#ifdef PACKED_VERTEX
+#include "packed_vertex.glsl"
+#endif
 
 void main() {
+#ifdef PACKED_VERTEX
+    vec3 inPosition = inPackedPosition * ubo.positionScale.xyz + ubo.positionBias.xyz;
+    vec3 inNormal = octDecode(inPackedNormal);
+#endif
     // Transform position to world space
-    vec4 worldPos = ubo.model * vec4(inPosition, 1.0);
+    vec4 worldPos = object.model * vec4(inPosition, 1.0);
     vec3 fragPos = worldPos.xyz;
     
     // Final clip-space position
     gl_Position = ubo.proj * ubo.view * worldPos;
     
     // Transform normal to world space
-    vec3 normal = normalize(mat3(transpose(inverse(ubo.model))) * inNormal);
+    vec3 normal = normalize(object.normalMatrix * inNormal);
     
     // ===== LIGHTING CALCULATION (at vertex) =====
     
@@ -55,15 +100,18 @@ void main() {
     float diff = max(dot(normal, lightDir), 0.0);
     vec3 diffuse = diff * ubo.lightColor * ubo.lightIntensity;
     
-    // Specular (Phong)
-    float specularStrength = 0.5;
-    float shininess = 32.0;
+    // Specular (Phong) - from the material (sand is matte, globe is shiny)
+    Material material = materials[object.material];
+    float specularStrength = material.specularStrength;
+    float shininess = material.shininess;
     vec3 viewDir = normalize(ubo.viewPos - fragPos);
     vec3 reflectDir = reflect(-lightDir, normal);
     float spec = pow(max(dot(viewDir, reflectDir), 0.0), shininess);
     vec3 specular = specularStrength * spec * ubo.lightColor;
     
-    // Combine lighting with vertex color
-    fragLitColor = (ambient + diffuse + specular) * inColor;
+    // The fragment shader multiplies in the surface color (texture or vertex color)
+    fragLight = ambient + diffuse + specular;
     fragTexCoord = inTexCoord;
+    fragColor = inColor;
+    fragMaterial = object.material;
 }
\ No newline at end of file
@@ -0,0 +1,15 @@
+// Decoding shared by every shader that reads PackedVertex data.
+// Must stay the inverse of the encoding in PackedVertex.cpp.
+
+#ifndef PACKED_VERTEX_GLSL
+#define PACKED_VERTEX_GLSL
+
+// Inverse of the octahedral normal encoding (octEncode)
+vec3 octDecode(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+    return normalize(n);
+}
+
+#endif
@@ -3,8 +3,10 @@
 // ============================================================
 // PARTICLE VERTEX SHADER
 // ============================================================
-// Passes billboard vertex data to fragment shader.
-// Billboarding is computed on CPU for simplicity.
+// Instanced billboards: one ParticleInstance per particle,
+// 6 vertices per instance. The camera-facing quad is built here
+// from gl_VertexIndex and the camera right/up vectors in the view
+// matrix, so the CPU uploads 20 bytes per particle and no indices.
 // ============================================================
 
 layout(binding = 0) uniform UniformBufferObject {
@@ -19,16 +21,30 @@ layout(binding = 0) uniform UniformBufferObject {
     float ambientStrength;
 } ubo;
 
-layout(location = 0) in vec3 inPosition;
-layout(location = 1) in vec4 inColor;
-layout(location = 2) in vec2 inTexCoord;
-layout(location = 3) in float inSize;
+// Per-instance attributes
+layout(location = 0) in vec3 inPosition;   // Particle center
+layout(location = 1) in float inSize;      // Billboard half-extent
+layout(location = 2) in vec4 inColor;      // RGBA8 unorm
 
 layout(location = 0) out vec4 fragColor;
 layout(location = 1) out vec2 fragTexCoord;
 
+// Two triangles (0,1,2 / 0,2,3) of a unit quad
+const vec2 corners[6] = vec2[](
+    vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(1.0, 1.0),
+    vec2(0.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 1.0)
+);
+
 void main() {
-    gl_Position = ubo.proj * ubo.view * vec4(inPosition, 1.0);
+    vec2 corner = corners[gl_VertexIndex];
+
+    vec3 cameraRight = vec3(ubo.view[0][0], ubo.view[1][0], ubo.view[2][0]);
+    vec3 cameraUp = vec3(ubo.view[0][1], ubo.view[1][1], ubo.view[2][1]);
+
+    vec2 offset = (corner * 2.0 - 1.0) * inSize;
+    vec3 worldPos = inPosition + cameraRight * offset.x + cameraUp * offset.y;
+
+    gl_Position = ubo.proj * ubo.view * vec4(worldPos, 1.0);
     fragColor = inColor;
-    fragTexCoord = inTexCoord;
-}
\ No newline at end of file
+    fragTexCoord = corner;
+}
@@ -0,0 +1,92 @@
+#version 450
+
+// ============================================================
+// GPU PARTICLE VERTEX SHADER
+// ============================================================
+// Vertex pulling: no vertex buffer is bound. Each particle in the
+// storage buffer expands to 6 vertices (two triangles); the quad
+// is billboarded with camera right/up taken from the view matrix.
+// Quads are emitted in the order of the sort buffer (back to front
+// after particle_sort.comp), so alpha blending composites correctly.
+// Dead particles are pushed outside the clip volume.
+//
+// The buffer holds the latest fixed simulation tick. Stepping back
+// along the velocity by positionDelta.w (<= 0) places each quad at
+// the frame's point between the last two ticks: the simulation moves
+// a particle by exactly velocity * dt per tick.
+// ============================================================
+
+layout(binding = 0) uniform UniformBufferObject {
+    mat4 model;
+    mat4 view;
+    mat4 proj;
+    vec3 viewPos;
+    float time;
+    vec3 lightPos;
+    float lightIntensity;
+    vec3 lightColor;
+    float ambientStrength;
+} ubo;
+
+struct GpuParticle {
+    vec4 positionLife;     // xyz = position, w = remaining life
+    vec4 velocityMaxLife;  // xyz = velocity, w = initial life
+};
+
+layout(std430, binding = 1) readonly buffer ParticleBuffer {
+    GpuParticle particles[];
+};
+
+layout(std430, binding = 2) readonly buffer SortBuffer {
+    uvec2 entries[];       // x = depth key, y = particle index
+};
+
+layout(push_constant) uniform EmitterParams {
+    vec4 positionDelta;      // w = interpolation offset in seconds (draw push)
+    vec4 positionVariance;
+    vec4 velocity;
+    vec4 velocityVariance;
+    vec4 gravity;            // w = start size
+    vec4 startColor;
+    vec4 endColor;
+    float endSize;
+    uint emitBase;
+    uint emitCount;
+    uint maxParticles;
+} params;
+
+layout(location = 0) out vec4 fragColor;
+layout(location = 1) out vec2 fragTexCoord;
+
+// Same corner order as particle.vert (0,1,2 / 0,2,3)
+const vec2 corners[6] = vec2[](
+    vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(1.0, 1.0),
+    vec2(0.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 1.0)
+);
+
+void main() {
+    GpuParticle p = particles[entries[gl_VertexIndex / 6].y];
+    vec2 corner = corners[gl_VertexIndex % 6];
+    fragTexCoord = corner;
+
+    float life = p.positionLife.w;
+    if (life <= 0.0) {
+        gl_Position = vec4(0.0, 0.0, 2.0, 1.0);  // z > w: clipped
+        fragColor = vec4(0.0);
+        return;
+    }
+
+    // Normalized age (0 = just born, 1 = about to die)
+    float age = 1.0 - life / p.velocityMaxLife.w;
+    float size = mix(params.gravity.w, params.endSize, age);
+
+    vec3 cameraRight = vec3(ubo.view[0][0], ubo.view[1][0], ubo.view[2][0]);
+    vec3 cameraUp = vec3(ubo.view[0][1], ubo.view[1][1], ubo.view[2][1]);
+
+    vec2 offset = (corner * 2.0 - 1.0) * size;
+    vec3 center = p.positionLife.xyz + p.velocityMaxLife.xyz * params.positionDelta.w;
+    vec3 worldPos = center + cameraRight * offset.x + cameraUp * offset.y;
+
+    gl_Position = ubo.proj * ubo.view * vec4(worldPos, 1.0);
+    fragColor = mix(params.startColor, params.endColor, age);
+}
@@ -0,0 +1,80 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+layout(binding = 0) uniform UniformBufferObject {
+    mat4 model;
+    mat4 view;
+    mat4 proj;
+    vec3 viewPos;
+    float time;
+    vec3 lightPos;
+    float lightIntensity;
+    vec3 lightColor;
+    float ambientStrength;
+    vec4 positionScale;    // PACKED_VERTEX: position = stored * scale + bias
+    vec4 positionBias;
+} ubo;
+
+// GPU-driven path: transforms come from the object buffer written at load
+// time, indexed by firstInstance (= object index) of the indirect draw
+struct SceneObject {
+    mat4 model;
+    mat4 normalMatrix;     // transpose(inverse(model)), precomputed on the CPU
+    vec4 boundsMin;
+    vec4 boundsMax;
+    uvec4 lodFirstIndex;
+    uvec4 lodIndexCount;
+    ivec4 lodVertexOffset;
+    uint lodCount;
+    uint currentLod;
+    uint clustered;
+    uint material;         // Into the material buffer (see shader.frag)
+};
+
+layout(std430, set = 1, binding = 0) readonly buffer ObjectBuffer {
+    SceneObject objects[];
+};
+
+#ifdef PACKED_VERTEX
+// PackedVertex: quantized position, octahedral normal (decoded below)
+layout(location = 0) in vec3 inPackedPosition;
+layout(location = 1) in vec2 inPackedNormal;
+#else
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inNormal;
+#endif
+layout(location = 2) in vec2 inTexCoord;
+layout(location = 3) in vec3 inColor;
+
+// Depth pre-pass and color pass must produce identical depth (EQUAL test)
+invariant gl_Position;
+
+layout(location = 0) out vec3 fragColor;
+layout(location = 1) out vec3 fragNormal;
+layout(location = 2) out vec2 fragTexCoord;
+layout(location = 3) out vec3 fragPos;       // World position for lighting
+layout(location = 4) flat out uint fragMaterial;
+
+#ifdef PACKED_VERTEX
+#include "packed_vertex.glsl"
+#endif
+
+void main() {
+#ifdef PACKED_VERTEX
+    vec3 inPosition = inPackedPosition * ubo.positionScale.xyz + ubo.positionBias.xyz;
+    vec3 inNormal = octDecode(inPackedNormal);
+#endif
+    SceneObject object = objects[gl_InstanceIndex];
+
+    // Transform to world space
+    vec4 worldPos = object.model * vec4(inPosition, 1.0);
+    fragPos = worldPos.xyz;
+    
+    gl_Position = ubo.proj * ubo.view * worldPos;
+    fragColor = inColor;
+    
+    // Transform normal to world space (handles non-uniform scaling)
+    fragNormal = mat3(object.normalMatrix) * inNormal;
+    fragTexCoord = inTexCoord;
+    fragMaterial = object.material;
+}
\ No newline at end of file
@@ -1,16 +1,19 @@
 #version 450
+#extension GL_EXT_nonuniform_qualifier : require
 
 // ============================================================
-// PHONG SHADING with SELECTIVE TEXTURE MAPPING
+// PHONG SHADING with BINDLESS MATERIALS
 // ============================================================
-// Texture is only applied to the ground plane (Y near 0)
-// Globe and cacti use their vertex colors
+// Every draw path forwards a material index; the material picks
+// an albedo texture from the bindless array (or the vertex color)
+// and the specular response. No per-material descriptor sets.
 // ============================================================
 
 layout(location = 0) in vec3 fragColor;
 layout(location = 1) in vec3 fragNormal;
 layout(location = 2) in vec2 fragTexCoord;
 layout(location = 3) in vec3 fragPos;
+layout(location = 4) flat in uint fragMaterial;
 
 layout(location = 0) out vec4 outColor;
 
@@ -26,25 +29,35 @@ layout(binding = 0) uniform UniformBufferObject {
     float ambientStrength;
 } ubo;
 
-layout(binding = 1) uniform sampler2D texSampler;
+// Indexed by TextureManager index; only slots named by a material are written
+layout(binding = 1) uniform sampler2D textures[];
+
+#define NO_TEXTURE 0xFFFFFFFFu
+
+// Matches GpuMaterial (MaterialLibrary.h)
+struct Material {
+    vec4 baseColor;
+    uint albedoTexture;    // NO_TEXTURE = vertex color
+    float specularStrength;
+    float shininess;
+    uint padding;
+};
+
+layout(std430, binding = 2) readonly buffer MaterialBuffer {
+    Material materials[];
+};
 
 void main() {
     vec3 normal = normalize(fragNormal);
+    Material material = materials[fragMaterial];
     
-    // Determine if this fragment is on the ground plane
-    // Ground plane is at Y = 0, with normal pointing up (0, 1, 0)
-    // Use normal.y > 0.9 to detect horizontal surfaces facing up
-    bool isGround = (abs(fragPos.y) < 1.0) && (normal.y > 0.9);
-    
-    vec3 surfaceColor;
-    if (isGround) {
-        // Sample sand texture for ground
-        vec4 texColor = texture(texSampler, fragTexCoord);
-        surfaceColor = texColor.rgb;
-    } else {
-        // Use vertex color for globe, cacti, etc.
-        surfaceColor = fragColor;
+    // Textured materials sample their albedo, the rest use the vertex color.
+    // Draws in one indirect call may differ in material, hence nonuniformEXT
+    vec3 surfaceColor = fragColor;
+    if (material.albedoTexture != NO_TEXTURE) {
+        surfaceColor = texture(textures[nonuniformEXT(material.albedoTexture)], fragTexCoord).rgb;
     }
+    surfaceColor *= material.baseColor.rgb;
     
     // ===== LIGHTING =====
     // Ambient
@@ -55,9 +68,9 @@ void main() {
     float diff = max(dot(normal, lightDir), 0.0);
     vec3 diffuse = diff * ubo.lightColor * ubo.lightIntensity;
     
-    // Specular - adjust based on material
-    float specularStrength = isGround ? 0.1 : 0.5;  // Sand is matte, globe is shiny
-    float shininess = isGround ? 4.0 : 32.0;
+    // Specular - from the material (sand is matte, globe is shiny)
+    float specularStrength = material.specularStrength;
+    float shininess = material.shininess;
     
     vec3 viewDir = normalize(ubo.viewPos - fragPos);
     vec3 reflectDir = reflect(-lightDir, normal);
@@ -1,4 +1,5 @@
 #version 450
+#extension GL_GOOGLE_include_directive : require
 
 layout(binding = 0) uniform UniformBufferObject {
     mat4 model;
@@ -10,27 +11,55 @@ layout(binding = 0) uniform UniformBufferObject {
     float lightIntensity;
     vec3 lightColor;
     float ambientStrength;
+    vec4 positionScale;    // PACKED_VERTEX: position = stored * scale + bias
+    vec4 positionBias;
 } ubo;
 
+// Per-draw transform and material (see ObjectPushConstants)
+layout(push_constant) uniform ObjectPush {
+    mat4 model;
+    mat3 normalMatrix;     // transpose(inverse(model)), precomputed on the CPU
+    uint material;         // Into the material buffer (see shader.frag)
+} object;
+
+#ifdef PACKED_VERTEX
+// PackedVertex: quantized position, octahedral normal (decoded below)
+layout(location = 0) in vec3 inPackedPosition;
+layout(location = 1) in vec2 inPackedNormal;
+#else
 layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec3 inNormal;
+#endif
 layout(location = 2) in vec2 inTexCoord;
 layout(location = 3) in vec3 inColor;
 
+// Depth pre-pass and color pass must produce identical depth (EQUAL test)
+invariant gl_Position;
+
 layout(location = 0) out vec3 fragColor;
 layout(location = 1) out vec3 fragNormal;
 layout(location = 2) out vec2 fragTexCoord;
 layout(location = 3) out vec3 fragPos;       // World position for lighting
+layout(location = 4) flat out uint fragMaterial;
+
+#ifdef PACKED_VERTEX
+#include "packed_vertex.glsl"
+#endif
 
 void main() {
+#ifdef PACKED_VERTEX
+    vec3 inPosition = inPackedPosition * ubo.positionScale.xyz + ubo.positionBias.xyz;
+    vec3 inNormal = octDecode(inPackedNormal);
+#endif
     // Transform to world space
-    vec4 worldPos = ubo.model * vec4(inPosition, 1.0);
+    vec4 worldPos = object.model * vec4(inPosition, 1.0);
     fragPos = worldPos.xyz;
     
     gl_Position = ubo.proj * ubo.view * worldPos;
     fragColor = inColor;
     
     // Transform normal to world space (handles non-uniform scaling)
-    fragNormal = mat3(transpose(inverse(ubo.model))) * inNormal;
+    fragNormal = object.normalMatrix * inNormal;
     fragTexCoord = inTexCoord;
+    fragMaterial = object.material;
 }
\ No newline at end of file
@@ -0,0 +1,166 @@
+#include "Scene.h"
+#include <algorithm>
+#include <cmath>
+
+void Frustum::update(const glm::mat4& viewProjection) {
+    // Rows of the (column-major) matrix
+    glm::vec4 row0(viewProjection[0][0], viewProjection[1][0], viewProjection[2][0], viewProjection[3][0]);
+    glm::vec4 row1(viewProjection[0][1], viewProjection[1][1], viewProjection[2][1], viewProjection[3][1]);
+    glm::vec4 row2(viewProjection[0][2], viewProjection[1][2], viewProjection[2][2], viewProjection[3][2]);
+    glm::vec4 row3(viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3]);
+
+    m_planes[0] = row3 + row0;   // Left
+    m_planes[1] = row3 - row0;   // Right
+    m_planes[2] = row3 + row1;   // Bottom
+    m_planes[3] = row3 - row1;   // Top
+    m_planes[4] = row2;          // Near (z >= 0 in Vulkan clip space)
+    m_planes[5] = row3 - row2;   // Far
+
+    for (glm::vec4& plane : m_planes) {
+        float length = glm::length(glm::vec3(plane));
+        if (length > 0.0f) plane /= length;
+    }
+}
+
+bool Frustum::intersects(const glm::vec3& boundsMin, const glm::vec3& boundsMax) const {
+    for (const glm::vec4& plane : m_planes) {
+        // Corner of the box furthest along the plane normal
+        glm::vec3 positive(
+            plane.x >= 0.0f ? boundsMax.x : boundsMin.x,
+            plane.y >= 0.0f ? boundsMax.y : boundsMin.y,
+            plane.z >= 0.0f ? boundsMax.z : boundsMin.z);
+        if (glm::dot(glm::vec3(plane), positive) + plane.w < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32_t Scene::addObject(const std::string& name, const Mesh& mesh, const glm::mat4& transform) {
+    return addObject(name, std::vector<Mesh>{ mesh }, transform);
+}
+
+uint32_t Scene::addObject(const std::string& name, const std::vector<Mesh>& lodChain, const glm::mat4& transform) {
+    SceneObject object;
+    object.name = name;
+    object.lodCount = static_cast<uint32_t>(std::min<size_t>(lodChain.size(), MAX_LOD_LEVELS));
+    for (uint32_t level = 0; level < object.lodCount; level++) {
+        object.lods[level] = addMesh(lodChain[level]);
+    }
+
+    const SceneMesh& geometry = object.lods[0];
+    object.firstIndex = geometry.firstIndex;
+    object.indexCount = geometry.indexCount;
+    object.vertexOffset = geometry.vertexOffset;
+    object.localMin = geometry.localMin;
+    object.localMax = geometry.localMax;
+
+    m_objects.push_back(object);
+    uint32_t objectIndex = static_cast<uint32_t>(m_objects.size() - 1);
+    setTransform(objectIndex, transform);
+    return objectIndex;
+}
+
+SceneMesh Scene::addMesh(const Mesh& mesh) {
+    SceneMesh geometry;
+    geometry.firstIndex = static_cast<uint32_t>(m_indices.size());
+    geometry.indexCount = static_cast<uint32_t>(mesh.getIndexCount());
+    geometry.vertexOffset = static_cast<int32_t>(m_vertices.size());
+    geometry.vertexCount = static_cast<uint32_t>(mesh.getVertexCount());
+    geometry.localMin = mesh.getMinBounds();
+    geometry.localMax = mesh.getMaxBounds();
+    m_maxMeshVertexCount = std::max(m_maxMeshVertexCount, geometry.vertexCount);
+
+    const auto& meshVertices = mesh.getVertices();
+    const auto& meshIndices = mesh.getIndices();
+    m_vertices.insert(m_vertices.end(), meshVertices.begin(), meshVertices.end());
+    m_indices.insert(m_indices.end(), meshIndices.begin(), meshIndices.end());
+    return geometry;
+}
+
+void Scene::setTransform(uint32_t objectIndex, const glm::mat4& transform) {
+    SceneObject& object = m_objects[objectIndex];
+    object.transform = transform;
+    object.normalMatrix = glm::transpose(glm::inverse(transform));
+    transformBounds(transform, object.localMin, object.localMax, object.worldMin, object.worldMax);
+}
+
+void Scene::setClustered(uint32_t objectIndex, bool clustered) {
+    SceneObject& object = m_objects[objectIndex];
+    object.clustered = clustered;
+    if (clustered) applyLod(object, 0);
+}
+
+void Scene::setMaterial(uint32_t objectIndex, uint32_t material) {
+    m_objects[objectIndex].material = material;
+}
+
+void Scene::selectLods(const glm::vec3& cameraPosition, float projectionScale, const LodSettings& settings) {
+    for (SceneObject& object : m_objects) {
+        if (object.lodCount < 2 || object.clustered) continue;
+
+        glm::vec3 center = (object.worldMin + object.worldMax) * 0.5f;
+        float radius = glm::length(object.worldMax - object.worldMin) * 0.5f;
+        float screenRadius = lodScreenRadius(center, radius, cameraPosition, projectionScale);
+
+        applyLod(object, selectLod(screenRadius, object.lod, object.lodCount, settings));
+    }
+}
+
+void Scene::cull(const Frustum& frustum, std::vector<uint32_t>& visibleObjects) const {
+    visibleObjects.clear();
+    for (uint32_t i = 0; i < static_cast<uint32_t>(m_objects.size()); i++) {
+        if (m_objects[i].clustered) continue;
+        if (frustum.intersects(m_objects[i].worldMin, m_objects[i].worldMax)) {
+            visibleObjects.push_back(i);
+        }
+    }
+}
+
+void Scene::sortFrontToBack(std::vector<uint32_t>& objects, const glm::vec3& cameraPosition) const {
+    auto distanceSquared = [&](uint32_t index) {
+        const SceneObject& object = m_objects[index];
+        glm::vec3 offset = (object.worldMin + object.worldMax) * 0.5f - cameraPosition;
+        return glm::dot(offset, offset);
+    };
+    std::sort(objects.begin(), objects.end(), [&](uint32_t a, uint32_t b) {
+        return distanceSquared(a) < distanceSquared(b);
+    });
+}
+
+void Scene::clear() {
+    m_vertices.clear();
+    m_indices.clear();
+    m_maxMeshVertexCount = 0;
+    m_objects.clear();
+}
+
+// Private helper implementations
+
+void Scene::applyLod(SceneObject& object, uint32_t level) {
+    object.lod = level;
+    const SceneMesh& geometry = object.lods[level];
+    object.firstIndex = geometry.firstIndex;
+    object.indexCount = geometry.indexCount;
+    object.vertexOffset = geometry.vertexOffset;
+}
+
+void Scene::transformBounds(const glm::mat4& transform, const glm::vec3& localMin, const glm::vec3& localMax,
+                            glm::vec3& worldMin, glm::vec3& worldMax) {
+    // Transform center and extents (Arvo): the world extent along each axis
+    // is the local extents projected onto the absolute rotation/scale rows
+    glm::vec3 center = (localMin + localMax) * 0.5f;
+    glm::vec3 extents = (localMax - localMin) * 0.5f;
+
+    glm::vec3 worldCenter = glm::vec3(transform * glm::vec4(center, 1.0f));
+    glm::vec3 worldExtents(0.0f);
+    for (int axis = 0; axis < 3; axis++) {
+        worldExtents[axis] =
+            std::abs(transform[0][axis]) * extents.x +
+            std::abs(transform[1][axis]) * extents.y +
+            std::abs(transform[2][axis]) * extents.z;
+    }
+
+    worldMin = worldCenter - worldExtents;
+    worldMax = worldCenter + worldExtents;
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "Lod.h"
+#include "Mesh.h"
+#include "Vertex.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A mesh appended to the shared buffers: its index range and local bounds
+ */
+struct SceneMesh {
+    uint32_t firstIndex = 0;        // Into Scene::getIndices()
+    uint32_t indexCount = 0;
+    int32_t vertexOffset = 0;       // Added to every index (indices stay mesh-local)
+    uint32_t vertexCount = 0;
+    glm::vec3 localMin{ 0.0f };
+    glm::vec3 localMax{ 0.0f };
+};
+
+/**
+ * @brief One drawable object: a range of the shared index buffer plus a transform
+ */
+struct SceneObject {
+    std::string name;
+    uint32_t firstIndex = 0;        // Into Scene::getIndices() (selected LOD)
+    uint32_t indexCount = 0;
+    int32_t vertexOffset = 0;       // Added to every index (indices stay mesh-local)
+    SceneMesh lods[MAX_LOD_LEVELS]; // LOD chain, level 0 = full detail
+    uint32_t lodCount = 1;
+    uint32_t lod = 0;               // Level the draw range above points at
+    bool clustered = false;         // Drawn as meshlets (see setClustered), level 0 only
+    uint32_t material = 0;          // Into the MaterialLibrary, passed to the shaders per draw
+    glm::mat4 transform{ 1.0f };
+    glm::mat4 normalMatrix{ 1.0f }; // transpose(inverse(transform)), computed once
+    glm::vec3 localMin{ 0.0f };     // Mesh-space bounds
+    glm::vec3 localMax{ 0.0f };
+    glm::vec3 worldMin{ 0.0f };     // Bounds after transform (for culling)
+    glm::vec3 worldMax{ 0.0f };
+};
+
+/**
+ * @brief View frustum as six inward-facing planes
+ * 
+ * Design Notes:
+ * - Planes are extracted straight from the view-projection matrix
+ *   (Gribb/Hartmann), Vulkan depth range [0, 1]
+ * - AABB test checks only the corner furthest along each plane normal,
+ *   so it is conservative: boxes are never wrongly rejected
+ */
+class Frustum {
+public:
+    void update(const glm::mat4& viewProjection);
+    bool intersects(const glm::vec3& boundsMin, const glm::vec3& boundsMax) const;
+
+    const glm::vec4* getPlanes() const { return m_planes; }
+
+private:
+    glm::vec4 m_planes[6]{};   // xyz = normal, w = distance
+};
+
+/**
+ * @brief Per-object scene with shared geometry buffers
+ * 
+ * Role: Keep objects separable after their geometry is merged for upload
+ * Responsibilities:
+ * - Append meshes into one vertex/index array (one buffer pair on the GPU)
+ * - Remember each object's index range, transform and bounds
+ * - Collect the objects inside a frustum each frame
+ * 
+ * Design Notes:
+ * - Meshes are stored in local space; the transform is applied per draw
+ *   (push constant), so moving an object never touches vertex data
+ * - Indices are mesh-local and rebased with vertexOffset at draw time
+ * - An object may carry an LOD chain; selectLods() repoints its draw
+ *   range, bounds always come from level 0
+ * - The visible list is caller-owned so it can be reused every frame
+ */
+class Scene {
+public:
+    Scene() = default;
+
+    /**
+     * @brief Add a mesh as a new object
+     * @return Object index
+     */
+    uint32_t addObject(const std::string& name, const Mesh& mesh, const glm::mat4& transform = glm::mat4(1.0f));
+
+    /**
+     * @brief Add an LOD chain as a new object (level 0 first, at most MAX_LOD_LEVELS)
+     * @return Object index
+     */
+    uint32_t addObject(const std::string& name, const std::vector<Mesh>& lodChain,
+                       const glm::mat4& transform = glm::mat4(1.0f));
+
+    /**
+     * @brief Append geometry without creating an object (e.g. for instanced draws)
+     */
+    SceneMesh addMesh(const Mesh& mesh);
+
+    /**
+     * @brief Move an object (updates its normal matrix and world bounds)
+     */
+    void setTransform(uint32_t objectIndex, const glm::mat4& transform);
+
+    /**
+     * @brief Hand an object over to meshlet rendering (or take it back)
+     *
+     * Clustered objects are skipped by cull() and selectLods(): their
+     * meshlets are culled individually instead, always from level 0.
+     */
+    void setClustered(uint32_t objectIndex, bool clustered);
+
+    /**
+     * @brief Assign a material (index into the application's MaterialLibrary)
+     */
+    void setMaterial(uint32_t objectIndex, uint32_t material);
+
+    /**
+     * @brief Pick each object's LOD from its projected size (with hysteresis)
+     * @param projectionScale See lodProjectionScale()
+     */
+    void selectLods(const glm::vec3& cameraPosition, float projectionScale, const LodSettings& settings);
+
+    /**
+     * @brief Write the indices of all (non-clustered) objects intersecting the frustum
+     */
+    void cull(const Frustum& frustum, std::vector<uint32_t>& visibleObjects) const;
+
+    /**
+     * @brief Order object indices nearest first (bounds center to camera), for early-z
+     */
+    void sortFrontToBack(std::vector<uint32_t>& objects, const glm::vec3& cameraPosition) const;
+
+    void clear();
+
+    // Accessors
+    const std::vector<Vertex>& getVertices() const { return m_vertices; }
+    const std::vector<uint32_t>& getIndices() const { return m_indices; }
+    const std::vector<SceneObject>& getObjects() const { return m_objects; }
+    const SceneObject& getObject(uint32_t objectIndex) const { return m_objects[objectIndex]; }
+    uint32_t getObjectCount() const { return static_cast<uint32_t>(m_objects.size()); }
+
+    // Indices are mesh-relative (vertexOffset is added per draw), so one
+    // 16-bit buffer works whenever every mesh is small enough
+    bool fitsUint16Indices() const { return m_maxMeshVertexCount <= UINT16_MAX; }
+
+private:
+    std::vector<Vertex> m_vertices;
+    std::vector<uint32_t> m_indices;
+    uint32_t m_maxMeshVertexCount = 0;
+    std::vector<SceneObject> m_objects;
+
+    static void applyLod(SceneObject& object, uint32_t level);
+    static void transformBounds(const glm::mat4& transform, const glm::vec3& localMin, const glm::vec3& localMax,
+                                glm::vec3& worldMin, glm::vec3& worldMax);
+};
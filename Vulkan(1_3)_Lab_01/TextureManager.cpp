@@ -1,210 +1,435 @@
 #include "TextureManager.h"
+#include "JobSystem.h"
+#include "MappedFile.h"
+#include "CacheFile.h"
 #include "stb_image.h"
 #include <stdexcept>
+#include <algorithm>
+#include <array>
 #include <cstring>
-#include <random>
+#include <iostream>
 #include <cmath>
-
-void TextureManager::init(VkDevice device, VkPhysicalDevice physicalDevice,
-                          VkCommandPool commandPool, VkQueue graphicsQueue) {
-    m_device = device;
-    m_physicalDevice = physicalDevice;
-    m_commandPool = commandPool;
-    m_graphicsQueue = graphicsQueue;
-}
-
-int32_t TextureManager::loadTexture(const std::string& filepath) {
-    // Check cache first
-    auto it = m_textureCache.find(filepath);
-    if (it != m_textureCache.end()) {
-        return it->second;
+#include <numeric>
+
+// SIMD backend for the procedural shading kernel (scalar fallback otherwise)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TEXTURE_SIMD_SSE 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define TEXTURE_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace {
+    // KTX2 container (Khronos KTX 2.0 specification, section 3)
+    const uint8_t KTX2_IDENTIFIER[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+    struct Ktx2Header {
+        uint8_t identifier[12];
+        uint32_t vkFormat;
+        uint32_t typeSize;
+        uint32_t pixelWidth;
+        uint32_t pixelHeight;
+        uint32_t pixelDepth;
+        uint32_t layerCount;
+        uint32_t faceCount;
+        uint32_t levelCount;
+        uint32_t supercompressionScheme;
+        uint32_t dfdByteOffset;
+        uint32_t dfdByteLength;
+        uint32_t kvdByteOffset;
+        uint32_t kvdByteLength;
+        uint64_t sgdByteOffset;
+        uint64_t sgdByteLength;
+    };
+    static_assert(sizeof(Ktx2Header) == 80, "Ktx2Header must match the file layout");
+
+    struct Ktx2Level {
+        uint64_t byteOffset;
+        uint64_t byteLength;
+        uint64_t uncompressedByteLength;
+    };
+
+    // Formats a KTX2 file may use: block extent in texels and bytes per
+    // block (uncompressed formats are 1x1 blocks). Anything else is rejected
+    // before it reaches the device, like any other malformed file.
+    struct FormatBlock {
+        VkFormat format;
+        uint32_t width;
+        uint32_t height;
+        uint32_t bytes;
+    };
+
+    const FormatBlock KTX2_FORMATS[] = {
+        // Plain 8-bit formats
+        { VK_FORMAT_R8_UNORM, 1, 1, 1 }, { VK_FORMAT_R8G8_UNORM, 1, 1, 2 },
+        { VK_FORMAT_R8G8B8_UNORM, 1, 1, 3 }, { VK_FORMAT_R8G8B8_SRGB, 1, 1, 3 },
+        { VK_FORMAT_R8G8B8A8_UNORM, 1, 1, 4 }, { VK_FORMAT_R8G8B8A8_SRGB, 1, 1, 4 },
+        { VK_FORMAT_B8G8R8A8_UNORM, 1, 1, 4 }, { VK_FORMAT_B8G8R8A8_SRGB, 1, 1, 4 },
+        // BC1-7 (desktop)
+        { VK_FORMAT_BC1_RGB_UNORM_BLOCK, 4, 4, 8 }, { VK_FORMAT_BC1_RGB_SRGB_BLOCK, 4, 4, 8 },
+        { VK_FORMAT_BC1_RGBA_UNORM_BLOCK, 4, 4, 8 }, { VK_FORMAT_BC1_RGBA_SRGB_BLOCK, 4, 4, 8 },
+        { VK_FORMAT_BC2_UNORM_BLOCK, 4, 4, 16 }, { VK_FORMAT_BC2_SRGB_BLOCK, 4, 4, 16 },
+        { VK_FORMAT_BC3_UNORM_BLOCK, 4, 4, 16 }, { VK_FORMAT_BC3_SRGB_BLOCK, 4, 4, 16 },
+        { VK_FORMAT_BC4_UNORM_BLOCK, 4, 4, 8 }, { VK_FORMAT_BC4_SNORM_BLOCK, 4, 4, 8 },
+        { VK_FORMAT_BC5_UNORM_BLOCK, 4, 4, 16 }, { VK_FORMAT_BC5_SNORM_BLOCK, 4, 4, 16 },
+        { VK_FORMAT_BC6H_UFLOAT_BLOCK, 4, 4, 16 }, { VK_FORMAT_BC6H_SFLOAT_BLOCK, 4, 4, 16 },
+        { VK_FORMAT_BC7_UNORM_BLOCK, 4, 4, 16 }, { VK_FORMAT_BC7_SRGB_BLOCK, 4, 4, 16 },
+        // ETC2 / EAC (mobile)
+        { VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK, 4, 4, 8 }, { VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK, 4, 4, 8 },
+        { VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK, 4, 4, 8 }, { VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK, 4, 4, 8 },
+        { VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK, 4, 4, 16 }, { VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK, 4, 4, 16 },
+        { VK_FORMAT_EAC_R11_UNORM_BLOCK, 4, 4, 8 }, { VK_FORMAT_EAC_R11_SNORM_BLOCK, 4, 4, 8 },
+        { VK_FORMAT_EAC_R11G11_UNORM_BLOCK, 4, 4, 16 }, { VK_FORMAT_EAC_R11G11_SNORM_BLOCK, 4, 4, 16 },
+        // ASTC LDR (mobile)
+        { VK_FORMAT_ASTC_4x4_UNORM_BLOCK, 4, 4, 16 }, { VK_FORMAT_ASTC_4x4_SRGB_BLOCK, 4, 4, 16 },
+        { VK_FORMAT_ASTC_5x4_UNORM_BLOCK, 5, 4, 16 }, { VK_FORMAT_ASTC_5x4_SRGB_BLOCK, 5, 4, 16 },
+        { VK_FORMAT_ASTC_5x5_UNORM_BLOCK, 5, 5, 16 }, { VK_FORMAT_ASTC_5x5_SRGB_BLOCK, 5, 5, 16 },
+        { VK_FORMAT_ASTC_6x5_UNORM_BLOCK, 6, 5, 16 }, { VK_FORMAT_ASTC_6x5_SRGB_BLOCK, 6, 5, 16 },
+        { VK_FORMAT_ASTC_6x6_UNORM_BLOCK, 6, 6, 16 }, { VK_FORMAT_ASTC_6x6_SRGB_BLOCK, 6, 6, 16 },
+        { VK_FORMAT_ASTC_8x5_UNORM_BLOCK, 8, 5, 16 }, { VK_FORMAT_ASTC_8x5_SRGB_BLOCK, 8, 5, 16 },
+        { VK_FORMAT_ASTC_8x6_UNORM_BLOCK, 8, 6, 16 }, { VK_FORMAT_ASTC_8x6_SRGB_BLOCK, 8, 6, 16 },
+        { VK_FORMAT_ASTC_8x8_UNORM_BLOCK, 8, 8, 16 }, { VK_FORMAT_ASTC_8x8_SRGB_BLOCK, 8, 8, 16 },
+        { VK_FORMAT_ASTC_10x5_UNORM_BLOCK, 10, 5, 16 }, { VK_FORMAT_ASTC_10x5_SRGB_BLOCK, 10, 5, 16 },
+        { VK_FORMAT_ASTC_10x6_UNORM_BLOCK, 10, 6, 16 }, { VK_FORMAT_ASTC_10x6_SRGB_BLOCK, 10, 6, 16 },
+        { VK_FORMAT_ASTC_10x8_UNORM_BLOCK, 10, 8, 16 }, { VK_FORMAT_ASTC_10x8_SRGB_BLOCK, 10, 8, 16 },
+        { VK_FORMAT_ASTC_10x10_UNORM_BLOCK, 10, 10, 16 }, { VK_FORMAT_ASTC_10x10_SRGB_BLOCK, 10, 10, 16 },
+        { VK_FORMAT_ASTC_12x10_UNORM_BLOCK, 12, 10, 16 }, { VK_FORMAT_ASTC_12x10_SRGB_BLOCK, 12, 10, 16 },
+        { VK_FORMAT_ASTC_12x12_UNORM_BLOCK, 12, 12, 16 }, { VK_FORMAT_ASTC_12x12_SRGB_BLOCK, 12, 12, 16 },
+    };
+
+    const FormatBlock* findFormatBlock(uint32_t vkFormat) {
+        for (const FormatBlock& block : KTX2_FORMATS) {
+            if (static_cast<uint32_t>(block.format) == vkFormat) return &block;
+        }
+        return nullptr;
     }
 
-    // Load image with stb_image
-    int texWidth, texHeight, texChannels;
-    stbi_uc* pixels = stbi_load(filepath.c_str(), &texWidth, &texHeight, 
-                                 &texChannels, STBI_rgb_alpha);
-
-    if (!pixels) {
-        return -1;  // Loading failed
+    // Bytes one mip level needs: partial blocks at the edges count as whole ones
+    VkDeviceSize levelByteSize(const FormatBlock& block, uint32_t level, uint32_t width, uint32_t height) {
+        VkDeviceSize blocksX = (std::max(width >> level, 1u) + block.width - 1) / block.width;
+        VkDeviceSize blocksY = (std::max(height >> level, 1u) + block.height - 1) / block.height;
+        return blocksX * blocksY * block.bytes;
     }
 
-    VkDeviceSize imageSize = static_cast<VkDeviceSize>(texWidth) * texHeight * 4;
-
-    // Create staging buffer
-    VkBuffer stagingBuffer;
-    VkDeviceMemory stagingBufferMemory;
-
-    VkBufferCreateInfo bufferInfo{};
-    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    bufferInfo.size = imageSize;
-    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-
-    vkCreateBuffer(m_device, &bufferInfo, nullptr, &stagingBuffer);
-
-    VkMemoryRequirements memRequirements;
-    vkGetBufferMemoryRequirements(m_device, stagingBuffer, &memRequirements);
+    // Procedural texture cache: TextureCacheHeader, then the RGBA8 mip
+    // chain exactly as generateMipChain() lays it out
+    const char TEXTURE_CACHE_MAGIC[4] = { 'S', 'T', 'E', 'X' };
+    constexpr uint32_t TEXTURE_CACHE_VERSION = 1;
+
+    struct TextureCacheHeader {
+        char magic[4];
+        uint32_t version;
+        uint64_t key;
+        uint64_t contentHash;       // CacheFile::hashBytes over the chain
+        uint32_t width;
+        uint32_t height;
+        uint32_t mipLevels;
+        uint32_t padding;
+    };
+    static_assert(sizeof(TextureCacheHeader) == 40, "TextureCacheHeader layout is part of the file format");
+
+    constexpr uint32_t PROCEDURAL_ROWS_PER_JOB = 16;
+    constexpr uint32_t MIP_ROWS_PER_JOB = 32;
+
+    bool hasExtension(const std::string& path, const char* extension) {
+        size_t length = std::strlen(extension);
+        if (path.size() < length) return false;
+        return std::equal(path.end() - length, path.end(), extension, [](char a, char b) {
+            return std::tolower(static_cast<unsigned char>(a)) == b;
+        });
+    }
 
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits,
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    VkBufferImageCopy levelCopy(VkDeviceSize offset, uint32_t level, uint32_t width, uint32_t height) {
+        VkBufferImageCopy region{};
+        region.bufferOffset = offset;
+        region.bufferRowLength = 0;
+        region.bufferImageHeight = 0;
+        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.mipLevel = level;
+        region.imageSubresource.baseArrayLayer = 0;
+        region.imageSubresource.layerCount = 1;
+        region.imageOffset = { 0, 0, 0 };
+        region.imageExtent = { std::max(width >> level, 1u), std::max(height >> level, 1u), 1 };
+        return region;
+    }
 
-    vkAllocateMemory(m_device, &allocInfo, nullptr, &stagingBufferMemory);
-    vkBindBufferMemory(m_device, stagingBuffer, stagingBufferMemory, 0);
+    // Tightly packed RGBA8 levels, level 0 first; returns the chain size
+    size_t rgba8ChainLayout(uint32_t width, uint32_t height, uint32_t mipLevels,
+                            std::vector<VkBufferImageCopy>& regions) {
+        regions.clear();
+        size_t offset = 0;
+        for (uint32_t level = 0; level < mipLevels; level++) {
+            regions.push_back(levelCopy(offset, level, width, height));
+            offset += static_cast<size_t>(std::max(width >> level, 1u)) * std::max(height >> level, 1u) * 4;
+        }
+        return offset;
+    }
 
-    // Copy pixel data to staging buffer
-    void* data;
-    vkMapMemory(m_device, stagingBufferMemory, 0, imageSize, 0, &data);
-    memcpy(data, pixels, static_cast<size_t>(imageSize));
-    vkUnmapMemory(m_device, stagingBufferMemory);
+    // Stateless integer hash: noise at (x, y) needs no generator state, so
+    // rows can be produced in any order on any thread
+    inline uint32_t hashTexel(uint32_t x, uint32_t y, uint32_t seed) {
+        uint32_t h = (x * 0x8DA6B343u) ^ (y * 0xD8163841u) ^ (seed * 0xCB1AB31Fu);
+        h ^= h >> 16;
+        h *= 0x7FEB352Du;
+        h ^= h >> 15;
+        h *= 0x846CA68Bu;
+        h ^= h >> 16;
+        return h;
+    }
 
-    stbi_image_free(pixels);
+    // Top 24 bits to [0, 1)
+    inline float unitFloat(uint32_t h) {
+        return static_cast<float>(h >> 8) * (1.0f / 16777216.0f);
+    }
 
-    // Create texture
-    Texture texture;
-    texture.width = static_cast<uint32_t>(texWidth);
-    texture.height = static_cast<uint32_t>(texHeight);
-    texture.path = filepath;
+    inline float smoothstep01(float t) {
+        return t * t * (3.0f - 2.0f * t);
+    }
 
-    createImage(texture.width, texture.height, VK_FORMAT_R8G8B8A8_SRGB,
-                VK_IMAGE_TILING_OPTIMAL,
-                VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
-                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-                texture.image, texture.memory);
+    // base * (1 + dune * duneStrength) + grain * grainStrength - dark * darkColor
+    // per channel, clamped, as R8G8B8A8 with opaque alpha. 4 texels at a time + scalar tail
+    void shadeRow(const float* grain, const float* dark, const float* dune, uint32_t count,
+                  const TextureManager::ProceduralTexture& params, uint32_t* output) {
+        uint32_t i = 0;
+#if defined(TEXTURE_SIMD_SSE)
+        const __m128 vZero = _mm_setzero_ps();
+        const __m128 vOne = _mm_set1_ps(1.0f);
+        const __m128 vScale = _mm_set1_ps(255.0f);
+        const __m128 vDuneStrength = _mm_set1_ps(params.duneStrength);
+        auto channel = [&](int c, __m128 g, __m128 d, __m128 s) {
+            __m128 v = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(params.baseColor[c]), s),
+                                  _mm_mul_ps(g, _mm_set1_ps(params.grainStrength[c])));
+            v = _mm_sub_ps(v, _mm_mul_ps(d, _mm_set1_ps(params.darkGrainColor[c])));
+            v = _mm_min_ps(_mm_max_ps(v, vZero), vOne);
+            return _mm_cvttps_epi32(_mm_mul_ps(v, vScale));
+        };
+        for (; i + 4 <= count; i += 4) {
+            __m128 g = _mm_loadu_ps(grain + i);
+            __m128 d = _mm_loadu_ps(dark + i);
+            __m128 s = _mm_add_ps(vOne, _mm_mul_ps(_mm_loadu_ps(dune + i), vDuneStrength));
+            __m128i packed = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+            packed = _mm_or_si128(packed, channel(0, g, d, s));
+            packed = _mm_or_si128(packed, _mm_slli_epi32(channel(1, g, d, s), 8));
+            packed = _mm_or_si128(packed, _mm_slli_epi32(channel(2, g, d, s), 16));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), packed);
+        }
+#elif defined(TEXTURE_SIMD_NEON)
+        const float32x4_t vZero = vdupq_n_f32(0.0f);
+        const float32x4_t vOne = vdupq_n_f32(1.0f);
+        const float32x4_t vScale = vdupq_n_f32(255.0f);
+        const float32x4_t vDuneStrength = vdupq_n_f32(params.duneStrength);
+        auto channel = [&](int c, float32x4_t g, float32x4_t d, float32x4_t s) {
+            float32x4_t v = vaddq_f32(vmulq_f32(vdupq_n_f32(params.baseColor[c]), s),
+                                      vmulq_f32(g, vdupq_n_f32(params.grainStrength[c])));
+            v = vsubq_f32(v, vmulq_f32(d, vdupq_n_f32(params.darkGrainColor[c])));
+            v = vminq_f32(vmaxq_f32(v, vZero), vOne);
+            return vcvtq_u32_f32(vmulq_f32(v, vScale));
+        };
+        for (; i + 4 <= count; i += 4) {
+            float32x4_t g = vld1q_f32(grain + i);
+            float32x4_t d = vld1q_f32(dark + i);
+            float32x4_t s = vaddq_f32(vOne, vmulq_f32(vld1q_f32(dune + i), vDuneStrength));
+            uint32x4_t packed = vdupq_n_u32(0xFF000000u);
+            packed = vorrq_u32(packed, channel(0, g, d, s));
+            packed = vorrq_u32(packed, vshlq_n_u32(channel(1, g, d, s), 8));
+            packed = vorrq_u32(packed, vshlq_n_u32(channel(2, g, d, s), 16));
+            vst1q_u32(output + i, packed);
+        }
+#endif
+        for (; i < count; i++) {
+            float s = 1.0f + dune[i] * params.duneStrength;
+            uint32_t packed = 0xFF000000u;
+            for (int c = 0; c < 3; c++) {
+                float v = params.baseColor[c] * s + grain[i] * params.grainStrength[c];
+                v = std::clamp(v - dark[i] * params.darkGrainColor[c], 0.0f, 1.0f);
+                packed |= static_cast<uint32_t>(v * 255.0f) << (8 * c);
+            }
+            output[i] = packed;
+        }
+    }
 
-    // Transition and copy
-    transitionImageLayout(texture.image, VK_FORMAT_R8G8B8A8_SRGB,
-                          VK_IMAGE_LAYOUT_UNDEFINED,
-                          VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    // sRGB <-> linear, so minification averages light rather than encoded values
+    float srgbToLinear(float value) {
+        return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+    }
 
-    copyBufferToImage(stagingBuffer, texture.image, texture.width, texture.height);
+    uint8_t linearToSrgb8(float value) {
+        value = std::clamp(value, 0.0f, 1.0f);
+        float encoded = value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+        return static_cast<uint8_t>(encoded * 255.0f + 0.5f);
+    }
+}
 
-    transitionImageLayout(texture.image, VK_FORMAT_R8G8B8A8_SRGB,
-                          VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                          VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+void TextureManager::init(VkDevice device, VkPhysicalDevice physicalDevice,
+                          DeviceMemoryAllocator& allocator, UploadManager& uploadManager,
+                          float maxAnisotropy) {
+    m_device = device;
+    m_physicalDevice = physicalDevice;
+    m_allocator = &allocator;
+    m_uploadManager = &uploadManager;
+    m_maxAnisotropy = std::max(maxAnisotropy, 1.0f);
+}
 
-    // Clean up staging buffer
-    vkDestroyBuffer(m_device, stagingBuffer, nullptr);
-    vkFreeMemory(m_device, stagingBufferMemory, nullptr);
+void TextureManager::initCache(const std::string& directory, bool enabled) {
+    m_cacheDirectory = directory;
+    m_cacheEnabled = enabled;
+    m_cacheHits = 0;
+    m_cacheMisses = 0;
+}
 
-    // Create view and sampler
-    texture.view = createImageView(texture.image, VK_FORMAT_R8G8B8A8_SRGB);
-    texture.sampler = createSampler();
+int32_t TextureManager::loadTexture(const std::string& filepath) {
+    // Check cache first
+    auto it = m_textureCache.find(filepath);
+    if (it != m_textureCache.end()) {
+        return it->second;
+    }
 
-    int32_t index = static_cast<int32_t>(m_textures.size());
-    m_textures.push_back(texture);
-    m_textureCache[filepath] = index;
+    TextureData data;
+    if (!decodeFile(filepath, data)) {
+        return -1;  // Loading failed
+    }
 
+    // Pixels are copied to staging now; layout transitions and the copy
+    // run in the next upload batch
+    int32_t index = createFromData(data, filepath);
+    if (index >= 0) {
+        m_textureCache[filepath] = index;
+    }
     return index;
 }
 
 int32_t TextureManager::createTexture(uint32_t width, uint32_t height,
-                                       const std::vector<uint8_t>& data) {
-    VkDeviceSize imageSize = static_cast<VkDeviceSize>(width) * height * 4;
-
-    // Create staging buffer
-    VkBuffer stagingBuffer;
-    VkDeviceMemory stagingBufferMemory;
-
-    VkBufferCreateInfo bufferInfo{};
-    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    bufferInfo.size = imageSize;
-    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+                                       const std::vector<uint8_t>& data, bool generateMipmaps) {
+    TextureData texture;
+    texture.width = width;
+    texture.height = height;
+    texture.mipLevels = generateMipmaps ? calculateMipLevels(width, height) : 1;
+    texture.data = generateMipChain(data.data(), width, height, texture.mipLevels, texture.regions);
+    return createFromData(texture, std::string());
+}
 
-    vkCreateBuffer(m_device, &bufferInfo, nullptr, &stagingBuffer);
+bool TextureManager::decodeFile(const std::string& filepath, TextureData& out) {
+    if (hasExtension(filepath, ".ktx2")) {
+        return decodeKtx2(filepath, out);
+    }
 
-    VkMemoryRequirements memRequirements;
-    vkGetBufferMemoryRequirements(m_device, stagingBuffer, &memRequirements);
+    // Load image with stb_image
+    int texWidth, texHeight, texChannels;
+    stbi_uc* pixels = stbi_load(filepath.c_str(), &texWidth, &texHeight,
+                                 &texChannels, STBI_rgb_alpha);
 
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits,
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    if (!pixels) {
+        return false;
+    }
 
-    vkAllocateMemory(m_device, &allocInfo, nullptr, &stagingBufferMemory);
-    vkBindBufferMemory(m_device, stagingBuffer, stagingBufferMemory, 0);
+    out.width = static_cast<uint32_t>(texWidth);
+    out.height = static_cast<uint32_t>(texHeight);
+    out.mipLevels = calculateMipLevels(out.width, out.height);
+    out.format = VK_FORMAT_R8G8B8A8_SRGB;
+    out.data = generateMipChain(pixels, out.width, out.height, out.mipLevels, out.regions);
+    stbi_image_free(pixels);
+    return true;
+}
 
-    void* mappedData;
-    vkMapMemory(m_device, stagingBufferMemory, 0, imageSize, 0, &mappedData);
-    memcpy(mappedData, data.data(), static_cast<size_t>(imageSize));
-    vkUnmapMemory(m_device, stagingBufferMemory);
+int32_t TextureManager::createFromData(const TextureData& data, const std::string& path, bool streamed) {
+    // Compressed formats are optional per device (BC on desktop, ASTC/ETC2 on mobile)
+    VkFormatProperties formatProperties;
+    vkGetPhysicalDeviceFormatProperties(m_physicalDevice, data.format, &formatProperties);
+    const VkFormatFeatureFlags required = VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+    if ((formatProperties.optimalTilingFeatures & required) != required) {
+        std::cerr << "TextureManager: format " << data.format << " of " << path << " is not supported by this device" << std::endl;
+        return -1;
+    }
 
     Texture texture;
-    texture.width = width;
-    texture.height = height;
-
-    createImage(width, height, VK_FORMAT_R8G8B8A8_SRGB,
-                VK_IMAGE_TILING_OPTIMAL,
-                VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
-                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-                texture.image, texture.memory);
-
-    transitionImageLayout(texture.image, VK_FORMAT_R8G8B8A8_SRGB,
-                          VK_IMAGE_LAYOUT_UNDEFINED,
-                          VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-
-    copyBufferToImage(stagingBuffer, texture.image, width, height);
-
-    transitionImageLayout(texture.image, VK_FORMAT_R8G8B8A8_SRGB,
-                          VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                          VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    texture.width = data.width;
+    texture.height = data.height;
+    texture.mipLevels = data.mipLevels;
+    texture.format = data.format;
+    texture.path = path;
+    return uploadTexture(texture, data, streamed);
+}
 
-    vkDestroyBuffer(m_device, stagingBuffer, nullptr);
-    vkFreeMemory(m_device, stagingBufferMemory, nullptr);
+void TextureManager::releaseTexture(int32_t index) {
+    Texture& texture = m_textures.at(static_cast<size_t>(index));
+    if (texture.image == VK_NULL_HANDLE) return;
 
-    texture.view = createImageView(texture.image, VK_FORMAT_R8G8B8A8_SRGB);
-    texture.sampler = createSampler();
+    auto cached = m_textureCache.find(texture.path);
+    if (cached != m_textureCache.end() && cached->second == index) {
+        m_textureCache.erase(cached);
+    }
+    vkDestroySampler(m_device, texture.sampler, nullptr);
+    vkDestroyImageView(m_device, texture.view, nullptr);
+    m_allocator->destroyImage(texture.image, texture.allocation);
+    texture = Texture();
+    m_slotVersions[static_cast<size_t>(index)]++;
+    m_freeSlots.push_back(index);
+}
 
-    int32_t index = static_cast<int32_t>(m_textures.size());
-    m_textures.push_back(texture);
+TextureManager::ProceduralTexture TextureManager::ProceduralTexture::sand(uint32_t size, uint32_t variant) {
+    ProceduralTexture params;
+    params.width = size;
+    params.height = size;
+    params.seed = 42 + variant * 7919;
+    params.duneStrength = 0.06f;
+    return params;
+}
 
-    return index;
+TextureManager::ProceduralTexture TextureManager::ProceduralTexture::snow(uint32_t size, uint32_t variant) {
+    ProceduralTexture params;
+    params.width = size;
+    params.height = size;
+    params.seed = 1337 + variant * 7919;
+    params.baseColor[0] = 0.90f; params.baseColor[1] = 0.92f; params.baseColor[2] = 0.96f;
+    params.grainStrength[0] = 0.06f; params.grainStrength[1] = 0.06f; params.grainStrength[2] = 0.05f;
+    params.darkGrainChance = 0.03f;
+    params.darkGrainColor[0] = -0.08f; params.darkGrainColor[1] = -0.08f; params.darkGrainColor[2] = -0.06f;
+    params.duneStrength = 0.04f;
+    params.duneCells = 6;
+    return params;
 }
 
-int32_t TextureManager::generateSandTexture(uint32_t width, uint32_t height) {
-    // Procedural sand texture using noise
-    std::vector<uint8_t> pixels(width * height * 4);
-    std::mt19937 rng(42);  // Fixed seed for reproducibility
-    std::uniform_real_distribution<float> noise(-0.1f, 0.1f);
-
-    // Base sand colors
-    const float baseR = 0.76f;
-    const float baseG = 0.70f;
-    const float baseB = 0.50f;
-
-    for (uint32_t y = 0; y < height; ++y) {
-        for (uint32_t x = 0; x < width; ++x) {
-            size_t idx = (static_cast<size_t>(y) * width + x) * 4;
-
-            // Add noise for sand grain effect
-            float n = noise(rng);
-
-            // Create subtle variation
-            float r = baseR + n * 0.15f;
-            float g = baseG + n * 0.12f;
-            float b = baseB + n * 0.10f;
-
-            // Add occasional darker grains
-            if (noise(rng) > 0.08f) {
-                r -= 0.05f;
-                g -= 0.05f;
-                b -= 0.03f;
-            }
+int32_t TextureManager::generateSandTexture(uint32_t width, uint32_t height, JobSystem* jobSystem) {
+    ProceduralTexture params;
+    params.width = width;
+    params.height = height;
+    return generateProceduralTexture(params, jobSystem);
+}
 
-            // Clamp and convert to bytes
-            pixels[idx + 0] = static_cast<uint8_t>(std::clamp(r, 0.0f, 1.0f) * 255.0f);
-            pixels[idx + 1] = static_cast<uint8_t>(std::clamp(g, 0.0f, 1.0f) * 255.0f);
-            pixels[idx + 2] = static_cast<uint8_t>(std::clamp(b, 0.0f, 1.0f) * 255.0f);
-            pixels[idx + 3] = 255;  // Full alpha
+int32_t TextureManager::generateProceduralTexture(const ProceduralTexture& params, JobSystem* jobSystem) {
+    uint64_t key = CacheFile::Key("procedural-texture")
+        .add(PROCEDURAL_REVISION)
+        .add(params.width).add(params.height).add(params.seed)
+        .add(params.baseColor).add(params.grainStrength)
+        .add(params.darkGrainChance).add(params.darkGrainColor)
+        .add(params.duneStrength).add(params.duneCells)
+        .get();
+
+    TextureData texture;
+    texture.width = params.width;
+    texture.height = params.height;
+    texture.mipLevels = calculateMipLevels(params.width, params.height);
+
+    if (loadCachedChain(key, params, texture.data)) {
+        rgba8ChainLayout(texture.width, texture.height, texture.mipLevels, texture.regions);
+    }
+    else {
+        std::vector<uint8_t> pixels(static_cast<size_t>(params.width) * params.height * 4);
+        if (jobSystem && params.height > PROCEDURAL_ROWS_PER_JOB) {
+            JobSystem::Counter counter;
+            jobSystem->parallelFor(counter, params.height, PROCEDURAL_ROWS_PER_JOB,
+                [&](uint32_t begin, uint32_t end) { generateProceduralRows(params, begin, end, pixels.data()); });
+            jobSystem->wait(counter);
+        }
+        else {
+            generateProceduralRows(params, 0, params.height, pixels.data());
         }
+        texture.data = generateMipChain(pixels.data(), texture.width, texture.height, texture.mipLevels,
+                                        texture.regions, jobSystem);
+        storeCachedChain(key, params, texture.data);
     }
-
-    return createTexture(width, height, pixels);
+    return createFromData(texture, std::string());
 }
 
 const TextureManager::Texture& TextureManager::getTexture(int32_t index) const {
@@ -229,168 +454,284 @@ void TextureManager::cleanup() {
             vkDestroyImageView(m_device, tex.view, nullptr);
         }
         if (tex.image != VK_NULL_HANDLE) {
-            vkDestroyImage(m_device, tex.image, nullptr);
-        }
-        if (tex.memory != VK_NULL_HANDLE) {
-            vkFreeMemory(m_device, tex.memory, nullptr);
+            m_allocator->destroyImage(tex.image, tex.allocation);
         }
     }
     m_textures.clear();
     m_textureCache.clear();
+    m_freeSlots.clear();
+    m_slotVersions.clear();
 }
 
-// Private helper implementations
+uint32_t TextureManager::calculateMipLevels(uint32_t width, uint32_t height) {
+    uint32_t levels = 1;
+    while ((std::max(width, height) >> levels) > 0) levels++;
+    return levels;
+}
 
-void TextureManager::createImage(uint32_t width, uint32_t height, VkFormat format,
-                                  VkImageTiling tiling, VkImageUsageFlags usage,
-                                  VkMemoryPropertyFlags properties, VkImage& image,
-                                  VkDeviceMemory& memory) {
-    VkImageCreateInfo imageInfo{};
-    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-    imageInfo.imageType = VK_IMAGE_TYPE_2D;
-    imageInfo.extent.width = width;
-    imageInfo.extent.height = height;
-    imageInfo.extent.depth = 1;
-    imageInfo.mipLevels = 1;
-    imageInfo.arrayLayers = 1;
-    imageInfo.format = format;
-    imageInfo.tiling = tiling;
-    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    imageInfo.usage = usage;
-    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
-    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+// Private helper implementations
 
-    if (vkCreateImage(m_device, &imageInfo, nullptr, &image) != VK_SUCCESS) {
-        throw std::runtime_error("Failed to create image!");
+bool TextureManager::decodeKtx2(const std::string& filepath, TextureData& out) {
+    MappedFile file;
+    if (!file.open(filepath) || file.size() < sizeof(Ktx2Header)) {
+        return false;
     }
 
-    VkMemoryRequirements memRequirements;
-    vkGetImageMemoryRequirements(m_device, image, &memRequirements);
-
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, properties);
+    Ktx2Header header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.identifier, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) != 0) {
+        std::cerr << "KTX2: " << filepath << " is not a KTX2 file" << std::endl;
+        return false;
+    }
+    if (header.supercompressionScheme != 0 || header.pixelDepth > 1 || header.layerCount > 1 ||
+        header.faceCount != 1 || header.pixelWidth == 0 || header.pixelHeight == 0) {
+        std::cerr << "KTX2: " << filepath << " is supercompressed or not 2D" << std::endl;
+        return false;
+    }
+    const FormatBlock* block = findFormatBlock(header.vkFormat);
+    if (!block) {
+        std::cerr << "KTX2: " << filepath << " has unsupported format " << header.vkFormat << std::endl;
+        return false;
+    }
 
-    if (vkAllocateMemory(m_device, &allocInfo, nullptr, &memory) != VK_SUCCESS) {
-        throw std::runtime_error("Failed to allocate image memory!");
+    uint32_t levelCount = std::max(header.levelCount, 1u);     // 0 = "generate", impossible for block formats
+    if (levelCount > calculateMipLevels(header.pixelWidth, header.pixelHeight)) {
+        std::cerr << "KTX2: " << filepath << " has more levels than its mip chain" << std::endl;
+        return false;
+    }
+    size_t indexEnd = sizeof(Ktx2Header) + sizeof(Ktx2Level) * levelCount;
+    if (file.size() < indexEnd) {
+        std::cerr << "KTX2: " << filepath << " is truncated" << std::endl;
+        return false;
+    }
+    std::vector<Ktx2Level> levels(levelCount);
+    std::memcpy(levels.data(), file.data() + sizeof(Ktx2Header), sizeof(Ktx2Level) * levelCount);
+
+    // Repack level 0 first. Copy offsets must be multiples of the block size and of 4
+    const VkDeviceSize alignment = std::lcm(static_cast<VkDeviceSize>(block->bytes), VkDeviceSize(4));
+    std::vector<uint8_t>& data = out.data;
+    std::vector<VkBufferImageCopy>& regions = out.regions;
+    data.clear();
+    regions.clear();
+    for (uint32_t level = 0; level < levelCount; level++) {
+        const Ktx2Level& entry = levels[level];
+        // Written so a huge offset or length can't wrap around the check
+        if (entry.byteLength == 0 || entry.byteOffset < indexEnd || entry.byteOffset > file.size() ||
+            entry.byteLength > file.size() - entry.byteOffset) {
+            std::cerr << "KTX2: " << filepath << " is truncated" << std::endl;
+            return false;
+        }
+        // The copy reads the whole level for its extent: a short one would overrun the staging data
+        if (entry.byteLength < levelByteSize(*block, level, header.pixelWidth, header.pixelHeight)) {
+            std::cerr << "KTX2: " << filepath << " level " << level << " is smaller than its format needs" << std::endl;
+            return false;
+        }
+        VkDeviceSize offset = (data.size() + alignment - 1) / alignment * alignment;
+        data.resize(static_cast<size_t>(offset + entry.byteLength));
+        std::memcpy(data.data() + offset, file.data() + entry.byteOffset, static_cast<size_t>(entry.byteLength));
+        regions.push_back(levelCopy(offset, level, header.pixelWidth, header.pixelHeight));
     }
 
-    vkBindImageMemory(m_device, image, memory, 0);
+    out.width = header.pixelWidth;
+    out.height = header.pixelHeight;
+    out.mipLevels = levelCount;
+    out.format = static_cast<VkFormat>(header.vkFormat);
+    return true;
 }
 
-void TextureManager::transitionImageLayout(VkImage image, VkFormat format,
-                                            VkImageLayout oldLayout,
-                                            VkImageLayout newLayout) {
-    VkCommandBuffer commandBuffer = beginSingleTimeCommands();
-
-    VkImageMemoryBarrier barrier{};
-    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-    barrier.oldLayout = oldLayout;
-    barrier.newLayout = newLayout;
-    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier.image = image;
-    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    barrier.subresourceRange.baseMipLevel = 0;
-    barrier.subresourceRange.levelCount = 1;
-    barrier.subresourceRange.baseArrayLayer = 0;
-    barrier.subresourceRange.layerCount = 1;
-
-    VkPipelineStageFlags sourceStage;
-    VkPipelineStageFlags destinationStage;
-
-    if (oldLayout == VK_IMAGE_LAYOUT_UNDEFINED &&
-        newLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL) {
-        barrier.srcAccessMask = 0;
-        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-        sourceStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-        destinationStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-    } else if (oldLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL &&
-               newLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL) {
-        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-        sourceStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-        destinationStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-    } else {
-        throw std::runtime_error("Unsupported layout transition!");
-    }
-
-    vkCmdPipelineBarrier(commandBuffer, sourceStage, destinationStage,
-                         0, 0, nullptr, 0, nullptr, 1, &barrier);
-
-    endSingleTimeCommands(commandBuffer);
+int32_t TextureManager::uploadTexture(Texture& texture, const TextureData& data, bool streamed) {
+    createImage(texture.width, texture.height, texture.mipLevels, texture.format,
+                VK_IMAGE_TILING_OPTIMAL,
+                VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                DeviceMemoryAllocator::Pool::DeviceLocal,
+                texture.image, texture.allocation);
+
+    m_uploadManager->uploadImageLevels(texture.image, data.data.data(), data.data.size(),
+                                       data.regions, texture.mipLevels, streamed);
+
+    texture.view = createImageView(texture.image, texture.format, texture.mipLevels);
+    texture.sampler = createSampler(texture.mipLevels);
+
+    // Reuse slots freed by releaseTexture() so streaming churn doesn't grow the table
+    if (!m_freeSlots.empty()) {
+        int32_t index = m_freeSlots.back();
+        m_freeSlots.pop_back();
+        m_textures[static_cast<size_t>(index)] = texture;
+        m_slotVersions[static_cast<size_t>(index)]++;
+        return index;
+    }
+    int32_t index = static_cast<int32_t>(m_textures.size());
+    m_textures.push_back(texture);
+    m_slotVersions.push_back(1);
+    return index;
 }
 
-void TextureManager::copyBufferToImage(VkBuffer buffer, VkImage image,
-                                        uint32_t width, uint32_t height) {
-    VkCommandBuffer commandBuffer = beginSingleTimeCommands();
-
-    VkBufferImageCopy region{};
-    region.bufferOffset = 0;
-    region.bufferRowLength = 0;
-    region.bufferImageHeight = 0;
-    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    region.imageSubresource.mipLevel = 0;
-    region.imageSubresource.baseArrayLayer = 0;
-    region.imageSubresource.layerCount = 1;
-    region.imageOffset = {0, 0, 0};
-    region.imageExtent = {width, height, 1};
-
-    vkCmdCopyBufferToImage(commandBuffer, buffer, image,
-                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-
-    endSingleTimeCommands(commandBuffer);
-}
+std::vector<uint8_t> TextureManager::generateMipChain(const uint8_t* pixels, uint32_t width, uint32_t height,
+                                                      uint32_t mipLevels, std::vector<VkBufferImageCopy>& regions,
+                                                      JobSystem* jobSystem) {
+    std::array<float, 256> toLinear;
+    for (int i = 0; i < 256; i++) toLinear[i] = srgbToLinear(static_cast<float>(i) / 255.0f);
+
+    // Every level is RGBA8: offsets stay 4-byte aligned without padding
+    std::vector<uint8_t> chain(rgba8ChainLayout(width, height, mipLevels, regions));
+    std::memcpy(chain.data(), pixels, static_cast<size_t>(width) * height * 4);
+
+    for (uint32_t level = 1; level < mipLevels; level++) {
+        uint32_t sourceWidth = std::max(width >> (level - 1), 1u);
+        uint32_t sourceHeight = std::max(height >> (level - 1), 1u);
+        uint32_t levelWidth = std::max(width >> level, 1u);
+        uint32_t levelHeight = std::max(height >> level, 1u);
+        const uint8_t* source = chain.data() + regions[level - 1].bufferOffset;
+        uint8_t* destination = chain.data() + regions[level].bufferOffset;
+
+        // 2x2 box; odd edges (and 1-pixel dimensions) reuse the last row/column
+        auto filterRows = [&](uint32_t rowBegin, uint32_t rowEnd) {
+            for (uint32_t y = rowBegin; y < rowEnd; y++) {
+                uint32_t y0 = std::min(y * 2, sourceHeight - 1);
+                uint32_t y1 = std::min(y * 2 + 1, sourceHeight - 1);
+                for (uint32_t x = 0; x < levelWidth; x++) {
+                    uint32_t x0 = std::min(x * 2, sourceWidth - 1);
+                    uint32_t x1 = std::min(x * 2 + 1, sourceWidth - 1);
+                    const uint8_t* texels[4] = {
+                        source + (static_cast<size_t>(y0) * sourceWidth + x0) * 4,
+                        source + (static_cast<size_t>(y0) * sourceWidth + x1) * 4,
+                        source + (static_cast<size_t>(y1) * sourceWidth + x0) * 4,
+                        source + (static_cast<size_t>(y1) * sourceWidth + x1) * 4
+                    };
+                    uint8_t* out = destination + (static_cast<size_t>(y) * levelWidth + x) * 4;
+                    for (int c = 0; c < 3; c++) {
+                        float sum = toLinear[texels[0][c]] + toLinear[texels[1][c]] + toLinear[texels[2][c]] + toLinear[texels[3][c]];
+                        out[c] = linearToSrgb8(sum * 0.25f);
+                    }
+                    out[3] = static_cast<uint8_t>((texels[0][3] + texels[1][3] + texels[2][3] + texels[3][3] + 2) / 4);
+                }
+            }
+        };
 
-VkCommandBuffer TextureManager::beginSingleTimeCommands() {
-    VkCommandBufferAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    allocInfo.commandPool = m_commandPool;
-    allocInfo.commandBufferCount = 1;
+        // Each level reads the previous one, so levels stay sequential
+        if (jobSystem && levelHeight > MIP_ROWS_PER_JOB) {
+            JobSystem::Counter counter;
+            jobSystem->parallelFor(counter, levelHeight, MIP_ROWS_PER_JOB, filterRows);
+            jobSystem->wait(counter);
+        }
+        else {
+            filterRows(0, levelHeight);
+        }
+    }
+    return chain;
+}
 
-    VkCommandBuffer commandBuffer;
-    vkAllocateCommandBuffers(m_device, &allocInfo, &commandBuffer);
+void TextureManager::generateProceduralRows(const ProceduralTexture& params, uint32_t rowBegin, uint32_t rowEnd,
+                                            uint8_t* pixels) {
+    const uint32_t width = params.width;
+    const uint32_t cells = std::max(params.duneCells, 1u);
+    const uint32_t darkSeed = params.seed ^ 0x9E3779B9u;
+    const uint32_t duneSeed = params.seed + 0x632BE5ABu;
+
+    // Separate streams per row keep the shading kernel branch-free
+    std::vector<float> grain(width), dark(width), dune(width, 0.0f);
+    std::vector<float> duneRow(cells + 1);
+
+    for (uint32_t y = rowBegin; y < rowEnd; y++) {
+        for (uint32_t x = 0; x < width; x++) {
+            grain[x] = unitFloat(hashTexel(x, y, params.seed)) * 0.2f - 0.1f;
+            dark[x] = unitFloat(hashTexel(x, y, darkSeed)) < params.darkGrainChance ? 1.0f : 0.0f;
+        }
 
-    VkCommandBufferBeginInfo beginInfo{};
-    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        // Tileable value noise: lattice wraps every duneCells, interpolated
+        // along y once per row, then along x per texel
+        if (params.duneStrength != 0.0f) {
+            float fy = (static_cast<float>(y) + 0.5f) / static_cast<float>(params.height) * static_cast<float>(cells);
+            uint32_t cy = std::min(static_cast<uint32_t>(fy), cells - 1);
+            float ty = smoothstep01(fy - static_cast<float>(cy));
+            for (uint32_t cx = 0; cx <= cells; cx++) {
+                float top = unitFloat(hashTexel(cx % cells, cy, duneSeed));
+                float bottom = unitFloat(hashTexel(cx % cells, (cy + 1) % cells, duneSeed));
+                duneRow[cx] = (top + (bottom - top) * ty) * 2.0f - 1.0f;
+            }
+            for (uint32_t x = 0; x < width; x++) {
+                float fx = (static_cast<float>(x) + 0.5f) / static_cast<float>(width) * static_cast<float>(cells);
+                uint32_t cx = std::min(static_cast<uint32_t>(fx), cells - 1);
+                float tx = smoothstep01(fx - static_cast<float>(cx));
+                dune[x] = duneRow[cx] + (duneRow[cx + 1] - duneRow[cx]) * tx;
+            }
+        }
 
-    vkBeginCommandBuffer(commandBuffer, &beginInfo);
-    return commandBuffer;
+        uint32_t* row = reinterpret_cast<uint32_t*>(pixels + static_cast<size_t>(y) * width * 4);
+        shadeRow(grain.data(), dark.data(), dune.data(), width, params, row);
+    }
 }
 
-void TextureManager::endSingleTimeCommands(VkCommandBuffer commandBuffer) {
-    vkEndCommandBuffer(commandBuffer);
-
-    VkSubmitInfo submitInfo{};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &commandBuffer;
-
-    vkQueueSubmit(m_graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
-    vkQueueWaitIdle(m_graphicsQueue);
+bool TextureManager::loadCachedChain(uint64_t key, const ProceduralTexture& params, std::vector<uint8_t>& chain) {
+    if (!m_cacheEnabled) return false;
+
+    std::vector<VkBufferImageCopy> regions;
+    uint32_t mipLevels = calculateMipLevels(params.width, params.height);
+    size_t chainSize = rgba8ChainLayout(params.width, params.height, mipLevels, regions);
+
+    MappedFile file;
+    TextureCacheHeader header{};
+    bool valid = file.open(CacheFile::pathFor(m_cacheDirectory, key, ".stex")) && file.size() == sizeof(TextureCacheHeader) + chainSize;
+    if (valid) {
+        std::memcpy(&header, file.data(), sizeof(header));
+        valid = std::memcmp(header.magic, TEXTURE_CACHE_MAGIC, sizeof(TEXTURE_CACHE_MAGIC)) == 0 &&
+                header.version == TEXTURE_CACHE_VERSION &&
+                header.key == key &&
+                header.width == params.width && header.height == params.height &&
+                header.mipLevels == mipLevels &&
+                header.contentHash == CacheFile::hashBytes(file.data() + sizeof(header), chainSize);
+    }
+    if (!valid) {
+        m_cacheMisses++;
+        return false;
+    }
 
-    vkFreeCommandBuffers(m_device, m_commandPool, 1, &commandBuffer);
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(file.data() + sizeof(header));
+    chain.assign(bytes, bytes + chainSize);
+    m_cacheHits++;
+    return true;
 }
 
-uint32_t TextureManager::findMemoryType(uint32_t typeFilter,
-                                         VkMemoryPropertyFlags properties) {
-    VkPhysicalDeviceMemoryProperties memProperties;
-    vkGetPhysicalDeviceMemoryProperties(m_physicalDevice, &memProperties);
+bool TextureManager::storeCachedChain(uint64_t key, const ProceduralTexture& params,
+                                      const std::vector<uint8_t>& chain) const {
+    if (!m_cacheEnabled) return false;
+
+    TextureCacheHeader header{};
+    std::memcpy(header.magic, TEXTURE_CACHE_MAGIC, sizeof(TEXTURE_CACHE_MAGIC));
+    header.version = TEXTURE_CACHE_VERSION;
+    header.key = key;
+    header.contentHash = CacheFile::hashBytes(chain.data(), chain.size());
+    header.width = params.width;
+    header.height = params.height;
+    header.mipLevels = calculateMipLevels(params.width, params.height);
+
+    return CacheFile::writeFileAtomically(CacheFile::pathFor(m_cacheDirectory, key, ".stex"), header,
+                                          chain.data(), chain.size());
+}
 
-    for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
-        if ((typeFilter & (1 << i)) &&
-            (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
-            return i;
-        }
-    }
+void TextureManager::createImage(uint32_t width, uint32_t height, uint32_t mipLevels, VkFormat format,
+                                  VkImageTiling tiling, VkImageUsageFlags usage,
+                                  DeviceMemoryAllocator::Pool pool, VkImage& image,
+                                  DeviceMemoryAllocator::Allocation& allocation) {
+    VkImageCreateInfo imageInfo{};
+    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.extent.width = width;
+    imageInfo.extent.height = height;
+    imageInfo.extent.depth = 1;
+    imageInfo.mipLevels = mipLevels;
+    imageInfo.arrayLayers = 1;
+    imageInfo.format = format;
+    imageInfo.tiling = tiling;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    imageInfo.usage = usage;
+    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
-    throw std::runtime_error("Failed to find suitable memory type!");
+    m_allocator->createImage(imageInfo, pool, image, allocation);
 }
 
-VkImageView TextureManager::createImageView(VkImage image, VkFormat format) {
+VkImageView TextureManager::createImageView(VkImage image, VkFormat format, uint32_t mipLevels) {
     VkImageViewCreateInfo viewInfo{};
     viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
     viewInfo.image = image;
@@ -398,7 +739,7 @@ VkImageView TextureManager::createImageView(VkImage image, VkFormat format) {
     viewInfo.format = format;
     viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
     viewInfo.subresourceRange.baseMipLevel = 0;
-    viewInfo.subresourceRange.levelCount = 1;
+    viewInfo.subresourceRange.levelCount = mipLevels;
     viewInfo.subresourceRange.baseArrayLayer = 0;
     viewInfo.subresourceRange.layerCount = 1;
 
@@ -410,7 +751,7 @@ VkImageView TextureManager::createImageView(VkImage image, VkFormat format) {
     return imageView;
 }
 
-VkSampler TextureManager::createSampler() {
+VkSampler TextureManager::createSampler(uint32_t mipLevels) {
     VkSamplerCreateInfo samplerInfo{};
     samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
     samplerInfo.magFilter = VK_FILTER_LINEAR;
@@ -418,12 +759,16 @@ VkSampler TextureManager::createSampler() {
     samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
     samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
     samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
-    samplerInfo.anisotropyEnable = VK_FALSE;
-    samplerInfo.maxAnisotropy = 1.0f;
+    // Grazing angles on the ground plane are where anisotropy pays off
+    samplerInfo.anisotropyEnable = m_maxAnisotropy > 1.0f ? VK_TRUE : VK_FALSE;
+    samplerInfo.maxAnisotropy = m_maxAnisotropy;
     samplerInfo.borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
     samplerInfo.unnormalizedCoordinates = VK_FALSE;
     samplerInfo.compareEnable = VK_FALSE;
     samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+    samplerInfo.minLod = 0.0f;
+    samplerInfo.maxLod = static_cast<float>(mipLevels);
+    samplerInfo.mipLodBias = 0.0f;
 
     VkSampler sampler;
     if (vkCreateSampler(m_device, &samplerInfo, nullptr, &sampler) != VK_SUCCESS) {
@@ -5,21 +5,42 @@
 #include <vector>
 #include <unordered_map>
 #include "DayNightCycle.h"
+#include "DeviceMemoryAllocator.h"
+#include "UploadManager.h"
+
+class JobSystem;
 
 /**
  * @brief Manages texture loading and GPU resources
  * 
  * Role: Handle texture lifecycle and provide texture data to shaders
  * Responsibilities:
- * - Load images from disk (PNG, JPG, etc.)
+ * - Load images from disk (PNG, JPG, etc.) and pre-compressed KTX2 files
+ * - Build full mip chains and anisotropic samplers
  * - Create Vulkan images, views, and samplers
- * - Manage texture memory efficiently
+ * - Manage texture memory efficiently (sub-allocated, see DeviceMemoryAllocator)
  * - Provide descriptors for shader binding
  * 
  * Design Notes:
  * - Single Responsibility: Only handles textures
  * - Low coupling: Receives Vulkan handles via init()
+ * - Pixel uploads are batched through UploadManager (no queue idling)
  * - Supports future texture caching via path lookup
+ * - Mip chains are filtered on the CPU (2x2 box in linear space, since
+ *   the images are sRGB) and uploaded with the base level: a blit would
+ *   need the graphics queue, uploads may run on the transfer queue
+ * - KTX2 files (BC1-7, ETC2/EAC, ASTC LDR or plain 8-bit, when the
+ *   device can sample them) are uploaded as stored, levels included, each
+ *   level checked against the size its format needs; supercompressed
+ *   KTX2 (Basis/zstd) is not supported
+ * - Procedural textures use counter-based (hashed) noise, so any row can
+ *   be generated independently: rows are split across the JobSystem and
+ *   shaded 4 texels at a time, and the output never depends on the
+ *   thread count. Finished mip chains are cached on disk, keyed by the
+ *   generator parameters (see initCache)
+ * - Loading is split into decodeFile() (CPU only, thread-safe) and
+ *   createFromData() (Vulkan, render thread), which is how AssetStreamer
+ *   decodes on its loader threads; releaseTexture() frees a slot for reuse
  */
 class TextureManager {
 public:
@@ -28,14 +49,52 @@ public:
      */
     struct Texture {
         VkImage image = VK_NULL_HANDLE;
-        VkDeviceMemory memory = VK_NULL_HANDLE;
+        DeviceMemoryAllocator::Allocation allocation;
         VkImageView view = VK_NULL_HANDLE;
         VkSampler sampler = VK_NULL_HANDLE;
         uint32_t width = 0;
         uint32_t height = 0;
+        uint32_t mipLevels = 1;
+        VkFormat format = VK_FORMAT_R8G8B8A8_SRGB;
         std::string path;
     };
 
+    /**
+     * @brief Parameters of a procedural grain texture (sand, snow, ...)
+     *
+     * Texel = base * (1 + dune * duneStrength) + grain * grainStrength,
+     * minus darkGrainColor for the darkGrainChance fraction of texels.
+     * Every field is part of the cache key.
+     */
+    struct ProceduralTexture {
+        uint32_t width = 512;
+        uint32_t height = 512;
+        uint32_t seed = 42;
+        float baseColor[3] = { 0.76f, 0.70f, 0.50f };
+        float grainStrength[3] = { 0.15f, 0.12f, 0.10f };      // Scales per-texel noise in [-0.1, 0.1]
+        float darkGrainChance = 0.1f;
+        float darkGrainColor[3] = { 0.05f, 0.05f, 0.03f };     // Negative = brighter (sparkle)
+        float duneStrength = 0.0f;                             // Low-frequency brightness swing
+        uint32_t duneCells = 8;                                // Dune noise period; tiles seamlessly
+
+        static ProceduralTexture sand(uint32_t size, uint32_t variant = 0);
+        static ProceduralTexture snow(uint32_t size, uint32_t variant = 0);
+    };
+
+    static constexpr uint32_t PROCEDURAL_REVISION = 1;     // Bump when generator output changes
+
+    /**
+     * @brief Decoded texture ready for upload: every level in one blob
+     */
+    struct TextureData {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t mipLevels = 1;
+        VkFormat format = VK_FORMAT_R8G8B8A8_SRGB;
+        std::vector<uint8_t> data;
+        std::vector<VkBufferImageCopy> regions;    // One per level, offsets into data
+    };
+
     TextureManager() = default;
     ~TextureManager() = default;
 
@@ -46,14 +105,27 @@ public:
     /**
      * @brief Initialize with Vulkan handles
      * Must be called before any texture operations
+     * @param maxAnisotropy Sampler anisotropy; 1 = off (use 1 unless the
+     *        samplerAnisotropy feature was enabled on the device)
+     */
+    void init(VkDevice device, VkPhysicalDevice physicalDevice,
+              DeviceMemoryAllocator& allocator, UploadManager& uploadManager,
+              float maxAnisotropy = 1.0f);
+
+    /**
+     * @brief Set the procedural texture cache directory (created on first store)
+     * @param enabled False = always generate, never read or write
      */
-    void init(VkDevice device, VkPhysicalDevice physicalDevice, 
-              VkCommandPool commandPool, VkQueue graphicsQueue);
+    void initCache(const std::string& directory, bool enabled = true);
 
     /**
-     * @brief Load a texture from file
-     * @param filepath Path to image file (PNG, JPG, BMP, TGA)
-     * @return Index of loaded texture, or -1 on failure
+     * @brief Load a texture from file, synchronously
+     * Meant for startup textures: the result is cached by path until
+     * releaseTexture() or cleanup(). Scene files stream through
+     * AssetStreamer instead (background decode, budgeted, evictable).
+     * @param filepath Path to image file (PNG, JPG, BMP, TGA) or .ktx2
+     * @return Index of loaded texture, or -1 on failure (including a KTX2
+     *         format the device cannot sample)
      */
     int32_t loadTexture(const std::string& filepath);
 
@@ -62,18 +134,46 @@ public:
      * @param width Texture width in pixels
      * @param height Texture height in pixels
      * @param data RGBA pixel data
+     * @param generateMipmaps Build and upload the full mip chain
      * @return Index of created texture
      */
     int32_t createTexture(uint32_t width, uint32_t height, 
-                          const std::vector<uint8_t>& data);
+                          const std::vector<uint8_t>& data, bool generateMipmaps = true);
 
     /**
      * @brief Generate a procedural sand texture
      * @param width Texture width
      * @param height Texture height
+     * @param jobSystem Generates rows on its workers; nullptr = calling thread only
      * @return Index of created texture
      */
-    int32_t generateSandTexture(uint32_t width, uint32_t height);
+    int32_t generateSandTexture(uint32_t width, uint32_t height, JobSystem* jobSystem = nullptr);
+
+    /**
+     * @brief Generate (or load from the cache) a procedural texture with mips
+     * @param jobSystem Generates rows on its workers; nullptr = calling thread only
+     * @return Index of created texture
+     */
+    int32_t generateProceduralTexture(const ProceduralTexture& params, JobSystem* jobSystem = nullptr);
+
+    /**
+     * @brief Decode an image file (with mips) or KTX2 file; no Vulkan calls, any thread
+     * @return false if the file is missing or malformed
+     */
+    static bool decodeFile(const std::string& filepath, TextureData& out);
+
+    /**
+     * @brief Create the image, view and sampler and queue the upload
+     * @param path Recorded in Texture::path (may be empty)
+     * @param streamed See UploadManager::uploadImageLevels
+     * @return Index of created texture, or -1 if the device cannot sample the format
+     */
+    int32_t createFromData(const TextureData& data, const std::string& path, bool streamed = false);
+
+    /**
+     * @brief Destroy one texture's GPU resources (no frame may still use it)
+     */
+    void releaseTexture(int32_t index);
 
     /**
      * @brief Get texture by index
@@ -95,32 +195,62 @@ public:
      */
     size_t getTextureCount() const { return m_textures.size(); }
 
+    /**
+     * @brief Bumped whenever a texture is created in or released from the slot
+     * View handles may be reused by the driver, so descriptor sets compare
+     * versions, not views, to find slots that need rewriting.
+     */
+    uint32_t getSlotVersion(int32_t index) const { return m_slotVersions.at(static_cast<size_t>(index)); }
+    uint32_t getCacheHits() const { return m_cacheHits; }
+    uint32_t getCacheMisses() const { return m_cacheMisses; }
+
+    /**
+     * @brief Levels in a full mip chain down to 1x1
+     */
+    static uint32_t calculateMipLevels(uint32_t width, uint32_t height);
+
 private:
     VkDevice m_device = VK_NULL_HANDLE;
     VkPhysicalDevice m_physicalDevice = VK_NULL_HANDLE;
-    VkCommandPool m_commandPool = VK_NULL_HANDLE;
-    VkQueue m_graphicsQueue = VK_NULL_HANDLE;
+    DeviceMemoryAllocator* m_allocator = nullptr;
+    UploadManager* m_uploadManager = nullptr;
+    float m_maxAnisotropy = 1.0f;
+
+    std::string m_cacheDirectory;
+    bool m_cacheEnabled = false;
+    uint32_t m_cacheHits = 0;
+    uint32_t m_cacheMisses = 0;
 
     std::vector<Texture> m_textures;
     std::unordered_map<std::string, int32_t> m_textureCache;
+    std::vector<int32_t> m_freeSlots;       // Released indices, reused first
+    std::vector<uint32_t> m_slotVersions;   // Per index, see getSlotVersion()
 
     // Helper functions
-    void createImage(uint32_t width, uint32_t height, VkFormat format,
-                     VkImageTiling tiling, VkImageUsageFlags usage,
-                     VkMemoryPropertyFlags properties, VkImage& image,
-                     VkDeviceMemory& memory);
+    static bool decodeKtx2(const std::string& filepath, TextureData& out);
+    int32_t uploadTexture(Texture& texture, const TextureData& data, bool streamed);
 
-    void transitionImageLayout(VkImage image, VkFormat format,
-                               VkImageLayout oldLayout, VkImageLayout newLayout);
+    /**
+     * @brief RGBA8 sRGB mip chain, level 0 first, with one copy region per level
+     */
+    static std::vector<uint8_t> generateMipChain(const uint8_t* pixels, uint32_t width, uint32_t height,
+                                                 uint32_t mipLevels, std::vector<VkBufferImageCopy>& regions,
+                                                 JobSystem* jobSystem = nullptr);
 
-    void copyBufferToImage(VkBuffer buffer, VkImage image,
-                           uint32_t width, uint32_t height);
+    /**
+     * @brief Write rows [rowBegin, rowEnd) of a procedural texture as RGBA8
+     */
+    static void generateProceduralRows(const ProceduralTexture& params, uint32_t rowBegin, uint32_t rowEnd,
+                                       uint8_t* pixels);
 
-    VkCommandBuffer beginSingleTimeCommands();
-    void endSingleTimeCommands(VkCommandBuffer commandBuffer);
+    bool loadCachedChain(uint64_t key, const ProceduralTexture& params, std::vector<uint8_t>& chain);
+    bool storeCachedChain(uint64_t key, const ProceduralTexture& params, const std::vector<uint8_t>& chain) const;
 
-    uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
+    void createImage(uint32_t width, uint32_t height, uint32_t mipLevels, VkFormat format,
+                     VkImageTiling tiling, VkImageUsageFlags usage,
+                     DeviceMemoryAllocator::Pool pool, VkImage& image,
+                     DeviceMemoryAllocator::Allocation& allocation);
 
-    VkImageView createImageView(VkImage image, VkFormat format);
-    VkSampler createSampler();
+    VkImageView createImageView(VkImage image, VkFormat format, uint32_t mipLevels);
+    VkSampler createSampler(uint32_t mipLevels);
 };
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include "ThreadCommandPools.h"
+#include <stdexcept>
+
+void ThreadCommandPools::init(VkDevice device, uint32_t queueFamily, uint32_t threadCount, uint32_t frameCount) {
+    m_device = device;
+    m_threadCount = threadCount;
+    m_frameCount = frameCount;
+    m_frameIndex = 0;
+    m_pools = std::vector<Pool>(static_cast<size_t>(threadCount) * frameCount);
+
+    // Transient: buffers live for one frame and are reset with their pool
+    VkCommandPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    poolInfo.queueFamilyIndex = queueFamily;
+
+    for (Pool& pool : m_pools) {
+        if (vkCreateCommandPool(m_device, &poolInfo, nullptr, &pool.pool) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create thread command pool!");
+        }
+    }
+}
+
+void ThreadCommandPools::cleanup() {
+    // Destroying a pool frees its command buffers
+    for (Pool& pool : m_pools) {
+        if (pool.pool != VK_NULL_HANDLE) {
+            vkDestroyCommandPool(m_device, pool.pool, nullptr);
+        }
+    }
+    m_pools.clear();
+}
+
+void ThreadCommandPools::beginFrame(uint32_t frameIndex) {
+    m_frameIndex = frameIndex % m_frameCount;
+    for (uint32_t thread = 0; thread < m_threadCount; thread++) {
+        Pool& pool = m_pools[m_frameIndex * m_threadCount + thread];
+        if (pool.used == 0) continue;   // Nothing recorded: already in the initial state
+
+        vkResetCommandPool(m_device, pool.pool, 0);
+        pool.used = 0;
+    }
+}
+
+VkCommandBuffer ThreadCommandPools::acquireSecondary(uint32_t threadIndex) {
+    Pool& pool = m_pools.at(m_frameIndex * m_threadCount + threadIndex);
+    if (pool.used == pool.buffers.size()) {
+        VkCommandBufferAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.commandPool = pool.pool;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+        allocInfo.commandBufferCount = 1;
+
+        VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+        if (vkAllocateCommandBuffers(m_device, &allocInfo, &commandBuffer) != VK_SUCCESS) {
+            return VK_NULL_HANDLE;
+        }
+        pool.buffers.push_back(commandBuffer);
+    }
+    return pool.buffers[pool.used++];
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Command pools for recording secondary command buffers on many threads
+ *
+ * Role: Let job system threads record parts of a frame at the same time
+ * Responsibilities:
+ * - Own one VkCommandPool per recording thread per frame in flight
+ * - Hand out secondary command buffers from the calling thread's pool,
+ *   allocating more the first time a frame needs them
+ * - Reset a frame's pools in one call once that frame's fence has signalled
+ *
+ * Design Notes:
+ * - Command pools are externally synchronized; giving every thread its
+ *   own pool (indexed by JobSystem::getThreadIndex()) means recording
+ *   never takes a lock
+ * - Buffers are recycled, not freed: vkResetCommandPool resets all of a
+ *   slot's buffers at once, which is cheaper than resetting each one
+ * - Pool records are cache-line aligned so threads bumping their own
+ *   counters don't share lines
+ */
+class ThreadCommandPools {
+public:
+    ThreadCommandPools() = default;
+    ~ThreadCommandPools() = default;
+
+    // Non-copyable
+    ThreadCommandPools(const ThreadCommandPools&) = delete;
+    ThreadCommandPools& operator=(const ThreadCommandPools&) = delete;
+
+    /**
+     * @brief Create threadCount * frameCount pools on queueFamily
+     * @param threadCount Threads that may record (JobSystem workers + 1)
+     */
+    void init(VkDevice device, uint32_t queueFamily, uint32_t threadCount, uint32_t frameCount);
+    void cleanup();
+
+    /**
+     * @brief Reset every pool of a frame slot and make it current
+     * Call only after that frame's fence has signalled
+     */
+    void beginFrame(uint32_t frameIndex);
+
+    /**
+     * @brief Next unused secondary command buffer of threadIndex's pool
+     * Only threadIndex may call this between two beginFrame() calls
+     * @return VK_NULL_HANDLE if a new buffer could not be allocated
+     */
+    VkCommandBuffer acquireSecondary(uint32_t threadIndex);
+
+    uint32_t getThreadCount() const { return m_threadCount; }
+
+private:
+    struct alignas(64) Pool {
+        VkCommandPool pool = VK_NULL_HANDLE;
+        std::vector<VkCommandBuffer> buffers;
+        uint32_t used = 0;                  // Handed out since the last reset
+    };
+
+    VkDevice m_device = VK_NULL_HANDLE;
+    uint32_t m_threadCount = 0;
+    uint32_t m_frameCount = 0;
+    uint32_t m_frameIndex = 0;
+    std::vector<Pool> m_pools;              // [frame * threadCount + thread]
+};
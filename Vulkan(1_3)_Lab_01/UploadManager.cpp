@@ -0,0 +1,395 @@
+#include "UploadManager.h"
+#include <cstring>
+#include <stdexcept>
+
+void UploadManager::init(VkDevice device, DeviceMemoryAllocator& allocator,
+                         uint32_t graphicsFamily, VkQueue graphicsQueue,
+                         uint32_t transferFamily, VkQueue transferQueue) {
+    m_device = device;
+    m_allocator = &allocator;
+    m_graphicsFamily = graphicsFamily;
+    m_graphicsQueue = graphicsQueue;
+    m_transferFamily = transferFamily;
+    m_transferQueue = transferQueue;
+
+    m_transferPool = createPool(m_transferFamily);
+    if (hasDedicatedTransferQueue()) {
+        m_graphicsPool = createPool(m_graphicsFamily);
+    }
+
+    VkSemaphoreTypeCreateInfo timelineInfo{};
+    timelineInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+    timelineInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    timelineInfo.initialValue = 0;
+
+    VkSemaphoreCreateInfo semaphoreInfo{};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphoreInfo.pNext = &timelineInfo;
+
+    if (vkCreateSemaphore(m_device, &semaphoreInfo, nullptr, &m_timeline) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create upload timeline semaphore!");
+    }
+}
+
+void UploadManager::uploadBuffer(VkBuffer dst, const void* data, VkDeviceSize size,
+                                 VkDeviceSize dstOffset, bool streamed) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    beginBatch();
+    m_open.waitedByFrames |= !streamed;
+
+    StagingBuffer staging = createStaging(data, size);
+
+    VkBufferCopy copyRegion{};
+    copyRegion.dstOffset = dstOffset;
+    copyRegion.size = size;
+    vkCmdCopyBuffer(m_open.transferCommands, staging.buffer, dst, 1, &copyRegion);
+    m_open.staging.push_back(staging);
+
+    // Make the copy visible to any later graphics/compute read
+    VkBufferMemoryBarrier2 barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+    barrier.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+    barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    barrier.dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+    barrier.dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.buffer = dst;
+    barrier.offset = dstOffset;
+    barrier.size = size;
+
+    if (hasDedicatedTransferQueue()) {
+        // Release here; the destination access scope belongs to the acquire
+        barrier.srcQueueFamilyIndex = m_transferFamily;
+        barrier.dstQueueFamilyIndex = m_graphicsFamily;
+
+        VkBufferMemoryBarrier2 acquire = barrier;
+        acquire.srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+        acquire.srcAccessMask = 0;
+        m_bufferAcquires.push_back(acquire);
+
+        barrier.dstStageMask = VK_PIPELINE_STAGE_2_NONE;
+        barrier.dstAccessMask = 0;
+    }
+    m_bufferReleases.push_back(barrier);
+}
+
+void UploadManager::uploadImage(VkImage dst, const void* data, VkDeviceSize size,
+                                uint32_t width, uint32_t height) {
+    VkBufferImageCopy region{};
+    region.bufferOffset = 0;
+    region.bufferRowLength = 0;
+    region.bufferImageHeight = 0;
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.mipLevel = 0;
+    region.imageSubresource.baseArrayLayer = 0;
+    region.imageSubresource.layerCount = 1;
+    region.imageOffset = { 0, 0, 0 };
+    region.imageExtent = { width, height, 1 };
+    uploadImageLevels(dst, data, size, { region }, 1);
+}
+
+void UploadManager::uploadImageLevels(VkImage dst, const void* data, VkDeviceSize size,
+                                      const std::vector<VkBufferImageCopy>& regions, uint32_t mipLevels,
+                                      bool streamed) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    beginBatch();
+    m_open.waitedByFrames |= !streamed;
+
+    StagingBuffer staging = createStaging(data, size);
+
+    VkImageMemoryBarrier2 barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = dst;
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.baseMipLevel = 0;
+    barrier.subresourceRange.levelCount = mipLevels;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount = 1;
+
+    VkDependencyInfo dependency{};
+    dependency.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependency.imageMemoryBarrierCount = 1;
+    dependency.pImageMemoryBarriers = &barrier;
+
+    // UNDEFINED -> TRANSFER_DST
+    barrier.srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+    barrier.srcAccessMask = 0;
+    barrier.dstStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+    barrier.dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    vkCmdPipelineBarrier2(m_open.transferCommands, &dependency);
+
+    vkCmdCopyBufferToImage(m_open.transferCommands, staging.buffer, dst,
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           static_cast<uint32_t>(regions.size()), regions.data());
+    m_open.staging.push_back(staging);
+
+    // TRANSFER_DST -> SHADER_READ_ONLY (split into release/acquire across families)
+    barrier.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+    barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    barrier.dstStageMask = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT;
+    barrier.dstAccessMask = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+    if (hasDedicatedTransferQueue()) {
+        barrier.srcQueueFamilyIndex = m_transferFamily;
+        barrier.dstQueueFamilyIndex = m_graphicsFamily;
+
+        VkImageMemoryBarrier2 acquire = barrier;
+        acquire.srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+        acquire.srcAccessMask = 0;
+        m_imageAcquires.push_back(acquire);
+
+        barrier.dstStageMask = VK_PIPELINE_STAGE_2_NONE;
+        barrier.dstAccessMask = 0;
+    }
+    m_imageReleases.push_back(barrier);
+}
+
+UploadManager::Ticket UploadManager::submit() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_open.transferCommands == VK_NULL_HANDLE) {
+        return m_lastTicket;
+    }
+
+    // One barrier for the whole batch: copy writes -> readers (or ownership release)
+    VkDependencyInfo releaseDependency{};
+    releaseDependency.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    releaseDependency.bufferMemoryBarrierCount = static_cast<uint32_t>(m_bufferReleases.size());
+    releaseDependency.pBufferMemoryBarriers = m_bufferReleases.data();
+    releaseDependency.imageMemoryBarrierCount = static_cast<uint32_t>(m_imageReleases.size());
+    releaseDependency.pImageMemoryBarriers = m_imageReleases.data();
+    vkCmdPipelineBarrier2(m_open.transferCommands, &releaseDependency);
+    m_bufferReleases.clear();
+    m_imageReleases.clear();
+
+    if (vkEndCommandBuffer(m_open.transferCommands) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to record upload command buffer!");
+    }
+
+    VkCommandBufferSubmitInfo transferCommandInfo{};
+    transferCommandInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+    transferCommandInfo.commandBuffer = m_open.transferCommands;
+
+    VkSemaphoreSubmitInfo transferSignal{};
+    transferSignal.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+    transferSignal.semaphore = m_timeline;
+    transferSignal.value = ++m_timelineValue;
+    transferSignal.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+
+    VkSubmitInfo2 transferSubmit{};
+    transferSubmit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+    transferSubmit.commandBufferInfoCount = 1;
+    transferSubmit.pCommandBufferInfos = &transferCommandInfo;
+    transferSubmit.signalSemaphoreInfoCount = 1;
+    transferSubmit.pSignalSemaphoreInfos = &transferSignal;
+
+    if (vkQueueSubmit2(m_transferQueue, 1, &transferSubmit, VK_NULL_HANDLE) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to submit upload batch!");
+    }
+
+    if (hasDedicatedTransferQueue()) {
+        // Ownership acquire on the graphics queue, GPU-waits for the copies
+        m_open.acquireCommands = allocateCommands(m_graphicsPool);
+
+        VkDependencyInfo dependency{};
+        dependency.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+        dependency.bufferMemoryBarrierCount = static_cast<uint32_t>(m_bufferAcquires.size());
+        dependency.pBufferMemoryBarriers = m_bufferAcquires.data();
+        dependency.imageMemoryBarrierCount = static_cast<uint32_t>(m_imageAcquires.size());
+        dependency.pImageMemoryBarriers = m_imageAcquires.data();
+        vkCmdPipelineBarrier2(m_open.acquireCommands, &dependency);
+
+        if (vkEndCommandBuffer(m_open.acquireCommands) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to record upload acquire command buffer!");
+        }
+
+        VkCommandBufferSubmitInfo acquireCommandInfo{};
+        acquireCommandInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+        acquireCommandInfo.commandBuffer = m_open.acquireCommands;
+
+        VkSemaphoreSubmitInfo acquireWait = transferSignal;
+        VkSemaphoreSubmitInfo acquireSignal = transferSignal;
+        acquireSignal.value = ++m_timelineValue;
+
+        VkSubmitInfo2 acquireSubmit{};
+        acquireSubmit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+        acquireSubmit.waitSemaphoreInfoCount = 1;
+        acquireSubmit.pWaitSemaphoreInfos = &acquireWait;
+        acquireSubmit.commandBufferInfoCount = 1;
+        acquireSubmit.pCommandBufferInfos = &acquireCommandInfo;
+        acquireSubmit.signalSemaphoreInfoCount = 1;
+        acquireSubmit.pSignalSemaphoreInfos = &acquireSignal;
+
+        if (vkQueueSubmit2(m_graphicsQueue, 1, &acquireSubmit, VK_NULL_HANDLE) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to submit upload acquire!");
+        }
+
+        m_bufferAcquires.clear();
+        m_imageAcquires.clear();
+    }
+
+    m_open.ticket = m_timelineValue;
+    m_lastTicket = m_open.ticket;
+    if (m_open.waitedByFrames) {
+        m_lastFrameTicket = m_open.ticket;
+    }
+    m_inFlight.push_back(std::move(m_open));
+    m_open = Batch{};
+
+    return m_lastTicket;
+}
+
+void UploadManager::update() {
+    submit();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    collectCompleted();
+}
+
+bool UploadManager::isComplete(Ticket ticket) const {
+    return completedValue() >= ticket;
+}
+
+void UploadManager::wait(Ticket ticket) {
+    VkSemaphoreWaitInfo waitInfo{};
+    waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores = &m_timeline;
+    waitInfo.pValues = &ticket;
+    vkWaitSemaphores(m_device, &waitInfo, UINT64_MAX);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    collectCompleted();
+}
+
+bool UploadManager::getPendingWait(VkSemaphoreSubmitInfo& waitInfo) const {
+    uint64_t lastTicket;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        lastTicket = m_lastFrameTicket;
+    }
+    if (lastTicket == 0 || isComplete(lastTicket)) return false;
+
+    waitInfo = VkSemaphoreSubmitInfo{};
+    waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+    waitInfo.semaphore = m_timeline;
+    waitInfo.value = lastTicket;
+    waitInfo.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+    return true;
+}
+
+void UploadManager::cleanup() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_open.transferCommands != VK_NULL_HANDLE) {
+        // Recorded but never submitted: just drop it
+        releaseBatch(m_open);
+        m_open = Batch{};
+        m_bufferReleases.clear();
+        m_imageReleases.clear();
+        m_bufferAcquires.clear();
+        m_imageAcquires.clear();
+    }
+    for (Batch& batch : m_inFlight) {
+        releaseBatch(batch);
+    }
+    m_inFlight.clear();
+
+    if (m_timeline != VK_NULL_HANDLE) {
+        vkDestroySemaphore(m_device, m_timeline, nullptr);
+        m_timeline = VK_NULL_HANDLE;
+    }
+    if (m_graphicsPool != VK_NULL_HANDLE) {
+        vkDestroyCommandPool(m_device, m_graphicsPool, nullptr);
+        m_graphicsPool = VK_NULL_HANDLE;
+    }
+    if (m_transferPool != VK_NULL_HANDLE) {
+        vkDestroyCommandPool(m_device, m_transferPool, nullptr);
+        m_transferPool = VK_NULL_HANDLE;
+    }
+}
+
+// Private helper implementations
+
+void UploadManager::beginBatch() {
+    if (m_open.transferCommands != VK_NULL_HANDLE) return;
+    m_open.transferCommands = allocateCommands(m_transferPool);
+}
+
+UploadManager::StagingBuffer UploadManager::createStaging(const void* data, VkDeviceSize size) {
+    StagingBuffer staging;
+    m_allocator->createBuffer(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                              DeviceMemoryAllocator::Pool::Staging,
+                              staging.buffer, staging.allocation);
+    memcpy(staging.allocation.mapped, data, static_cast<size_t>(size));
+    return staging;
+}
+
+VkCommandPool UploadManager::createPool(uint32_t family) {
+    VkCommandPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    poolInfo.queueFamilyIndex = family;
+
+    VkCommandPool pool;
+    if (vkCreateCommandPool(m_device, &poolInfo, nullptr, &pool) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create upload command pool!");
+    }
+    return pool;
+}
+
+VkCommandBuffer UploadManager::allocateCommands(VkCommandPool pool) {
+    VkCommandBufferAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocInfo.commandPool = pool;
+    allocInfo.commandBufferCount = 1;
+
+    VkCommandBuffer commandBuffer;
+    if (vkAllocateCommandBuffers(m_device, &allocInfo, &commandBuffer) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to allocate upload command buffer!");
+    }
+
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(commandBuffer, &beginInfo);
+
+    return commandBuffer;
+}
+
+void UploadManager::collectCompleted() {
+    uint64_t completed = completedValue();
+    while (!m_inFlight.empty() && m_inFlight.front().ticket <= completed) {
+        releaseBatch(m_inFlight.front());
+        m_inFlight.pop_front();
+    }
+}
+
+void UploadManager::releaseBatch(Batch& batch) {
+    for (StagingBuffer& staging : batch.staging) {
+        m_allocator->destroyBuffer(staging.buffer, staging.allocation);
+    }
+    batch.staging.clear();
+
+    if (batch.transferCommands != VK_NULL_HANDLE) {
+        vkFreeCommandBuffers(m_device, m_transferPool, 1, &batch.transferCommands);
+        batch.transferCommands = VK_NULL_HANDLE;
+    }
+    if (batch.acquireCommands != VK_NULL_HANDLE) {
+        vkFreeCommandBuffers(m_device, m_graphicsPool, 1, &batch.acquireCommands);
+        batch.acquireCommands = VK_NULL_HANDLE;
+    }
+}
+
+uint64_t UploadManager::completedValue() const {
+    uint64_t value = 0;
+    vkGetSemaphoreCounterValue(m_device, m_timeline, &value);
+    return value;
+}
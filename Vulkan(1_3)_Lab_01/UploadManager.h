@@ -0,0 +1,159 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+#include "DeviceMemoryAllocator.h"
+
+/**
+ * @brief Batched, asynchronous staging uploads
+ * 
+ * Role: Move CPU data into device-local buffers and images without
+ *       stalling the CPU or idling a queue
+ * Responsibilities:
+ * - Copy source data into staging memory immediately (caller may free it)
+ * - Record every copy and layout transition of a batch into one command buffer
+ * - Submit on a dedicated transfer queue family when the device has one
+ * - Signal completion on a timeline semaphore; rendering waits on it GPU-side
+ * - Release staging memory once the GPU has finished with it
+ * 
+ * Design Notes:
+ * - A batch is open until submit(); uploads can be recorded at any time,
+ *   including mid-frame for streaming, and are picked up by update()
+ * - With a dedicated transfer family, resources are EXCLUSIVE, so each
+ *   batch ends with a queue family ownership release on the transfer
+ *   queue and a matching acquire submitted on the graphics queue
+ * - A Ticket is a timeline value: the resource is ready once the
+ *   semaphore reaches it (isComplete / wait / getPendingWait)
+ * - Uploads may be recorded from any thread; submit()/update() touch the
+ *   graphics queue and must run on the render thread
+ * - Streamed uploads (see AssetStreamer) are not waited on by frames:
+ *   getPendingWait() only covers batches holding at least one regular
+ *   upload, and the streamer polls isComplete() before using the data
+ */
+class UploadManager {
+public:
+    using Ticket = uint64_t;
+
+    UploadManager() = default;
+    ~UploadManager() = default;
+
+    // Non-copyable
+    UploadManager(const UploadManager&) = delete;
+    UploadManager& operator=(const UploadManager&) = delete;
+
+    /**
+     * @brief Initialize with Vulkan handles
+     * Pass the graphics family/queue as transfer if there is no dedicated one
+     */
+    void init(VkDevice device, DeviceMemoryAllocator& allocator,
+              uint32_t graphicsFamily, VkQueue graphicsQueue,
+              uint32_t transferFamily, VkQueue transferQueue);
+
+    /**
+     * @brief Queue a copy into a device-local buffer
+     * @param dstOffset Byte offset in the destination buffer
+     * @param streamed True = frames don't wait for it; poll isComplete() before use
+     */
+    void uploadBuffer(VkBuffer dst, const void* data, VkDeviceSize size,
+                      VkDeviceSize dstOffset = 0, bool streamed = false);
+
+    /**
+     * @brief Queue a copy into mip 0 of a 2D image
+     * The image ends in SHADER_READ_ONLY_OPTIMAL once the ticket completes
+     */
+    void uploadImage(VkImage dst, const void* data, VkDeviceSize size,
+                     uint32_t width, uint32_t height);
+
+    /**
+     * @brief Queue copies into several mip levels of a 2D image from one blob
+     * @param regions One per level; bufferOffset is relative to data
+     * @param mipLevels Levels the image has (all move to SHADER_READ_ONLY_OPTIMAL)
+     * @param streamed True = frames don't wait for it; poll isComplete() before use
+     */
+    void uploadImageLevels(VkImage dst, const void* data, VkDeviceSize size,
+                           const std::vector<VkBufferImageCopy>& regions, uint32_t mipLevels,
+                           bool streamed = false);
+
+    /**
+     * @brief Submit the open batch (no-op if empty)
+     * @return Ticket for the batch, or the last ticket if nothing was queued
+     */
+    Ticket submit();
+
+    /**
+     * @brief Per-frame housekeeping: submit queued uploads, free finished batches
+     */
+    void update();
+
+    bool isComplete(Ticket ticket) const;
+
+    /**
+     * @brief Block the CPU until a ticket has completed (avoid in the frame loop)
+     */
+    void wait(Ticket ticket);
+
+    /**
+     * @brief Semaphore wait a graphics submit needs so it sees every submitted
+     *        (non-streamed) upload
+     * @return false if all of them have already completed
+     */
+    bool getPendingWait(VkSemaphoreSubmitInfo& waitInfo) const;
+
+    bool hasDedicatedTransferQueue() const { return m_graphicsFamily != m_transferFamily; }
+
+    /**
+     * @brief Release all resources (device must be idle)
+     */
+    void cleanup();
+
+private:
+    struct StagingBuffer {
+        VkBuffer buffer = VK_NULL_HANDLE;
+        DeviceMemoryAllocator::Allocation allocation;
+    };
+
+    struct Batch {
+        Ticket ticket = 0;
+        VkCommandBuffer transferCommands = VK_NULL_HANDLE;
+        VkCommandBuffer acquireCommands = VK_NULL_HANDLE;   // Graphics queue, dedicated transfer only
+        std::vector<StagingBuffer> staging;
+        bool waitedByFrames = false;    // Holds at least one non-streamed upload
+    };
+
+    VkDevice m_device = VK_NULL_HANDLE;
+    DeviceMemoryAllocator* m_allocator = nullptr;
+
+    uint32_t m_graphicsFamily = 0;
+    uint32_t m_transferFamily = 0;
+    VkQueue m_graphicsQueue = VK_NULL_HANDLE;
+    VkQueue m_transferQueue = VK_NULL_HANDLE;
+    VkCommandPool m_transferPool = VK_NULL_HANDLE;
+    VkCommandPool m_graphicsPool = VK_NULL_HANDLE;
+
+    VkSemaphore m_timeline = VK_NULL_HANDLE;
+    uint64_t m_timelineValue = 0;       // Last value a submit will signal
+    Ticket m_lastTicket = 0;
+    Ticket m_lastFrameTicket = 0;       // Last batch frames must wait for
+
+    // Open batch: copies recorded so far, the barriers that end it and
+    // (dedicated transfer only) the ownership acquires for the graphics queue
+    Batch m_open;
+    std::vector<VkBufferMemoryBarrier2> m_bufferReleases;
+    std::vector<VkImageMemoryBarrier2> m_imageReleases;
+    std::vector<VkBufferMemoryBarrier2> m_bufferAcquires;
+    std::vector<VkImageMemoryBarrier2> m_imageAcquires;
+
+    std::deque<Batch> m_inFlight;
+    mutable std::mutex m_mutex;
+
+    void beginBatch();
+    StagingBuffer createStaging(const void* data, VkDeviceSize size);
+    VkCommandPool createPool(uint32_t family);
+    VkCommandBuffer allocateCommands(VkCommandPool pool);
+    void collectCompleted();
+    void releaseBatch(Batch& batch);
+    uint64_t completedValue() const;
+};
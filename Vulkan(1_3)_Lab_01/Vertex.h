@@ -3,6 +3,8 @@
 #include <glm/glm.hpp>
 #include <vulkan/vulkan.h>
 #include <array>
+#include <cstdint>
+#include <cstring>
 
 /**
  * @brief Vertex structure for rendering with full attribute support
@@ -14,6 +16,7 @@
  * - Aligned for efficient GPU access
  * - Static methods provide Vulkan binding descriptions
  * - Extensible for future attributes (tangents, etc.)
+ * - PackedVertex (PackedVertex.h) is the 20-byte quantized GPU layout
  */
 struct Vertex {
     glm::vec3 position;
@@ -68,14 +71,30 @@ struct Vertex {
 };
 
 // Hash function for Vertex (needed for std::unordered_map deduplication)
+// Covers every attribute operator== compares. -0.0f is folded into 0.0f
+// (they compare equal), then each float's bits are mixed in with a
+// 64-bit multiply-xorshift so nearby values land in different buckets.
 namespace std {
     template<> struct hash<Vertex> {
         size_t operator()(const Vertex& vertex) const {
-            size_t h1 = hash<float>()(vertex.position.x) ^ (hash<float>()(vertex.position.y) << 1);
-            size_t h2 = hash<float>()(vertex.position.z) ^ (hash<float>()(vertex.normal.x) << 1);
-            size_t h3 = hash<float>()(vertex.normal.y) ^ (hash<float>()(vertex.normal.z) << 1);
-            size_t h4 = hash<float>()(vertex.texCoord.x) ^ (hash<float>()(vertex.texCoord.y) << 1);
-            return h1 ^ (h2 << 1) ^ (h3 << 2) ^ (h4 << 3);
+            const float values[] = {
+                vertex.position.x, vertex.position.y, vertex.position.z,
+                vertex.normal.x, vertex.normal.y, vertex.normal.z,
+                vertex.texCoord.x, vertex.texCoord.y,
+                vertex.color.x, vertex.color.y, vertex.color.z
+            };
+
+            uint64_t h = 0x9E3779B97F4A7C15ull;
+            for (float value : values) {
+                value += 0.0f;  // -0.0f -> 0.0f
+                uint32_t bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+                h = (h ^ bits) * 0xBF58476D1CE4E5B9ull;
+                h ^= h >> 29;
+            }
+            h *= 0x94D049BB133111EBull;
+            h ^= h >> 32;
+            return static_cast<size_t>(h);
         }
     };
-}
\ No newline at end of file
+}